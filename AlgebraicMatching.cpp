@@ -0,0 +1,411 @@
+/*
+ * File: AlgebraicMatching.cpp Author: Nicolas Gioanni Purpose:
+ * Implementation of the AlgebraicMatching class, providing methods for
+ * maximum bipartite matchings by linear algebra over a prime field.
+ *
+ * Functionality/Features:
+ * - Substitute a hashed nonzero element of GF(2^31 - 1) for every
+ *   edge of the Edmonds matrix.
+ * - Find the rank by row reduction, streaming the pivot row through
+ *   every row below it with the SimdKernels field kernel.
+ * - Recover a matching with the Rabin-Vazirani pivoting rule on the
+ *   inverse of the full-rank submatrix.
+ *
+ * Assumptions:
+ * - Products of two field elements fit in 62 bits and are reduced with
+ *   the Mersenne shift-and-add identity.
+ */
+
+#include "AlgebraicMatching.h"
+#include "SimdKernels.h"
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+namespace
+{
+    // The Mersenne prime 2^31 - 1, the order of the field
+    const std::uint32_t fieldPrime = 0x7fffffffU;
+
+    // Returns a * b modulo the field prime
+    inline std::uint32_t multiplyMod(std::uint32_t a, std::uint32_t b)
+    {
+        std::uint64_t product = static_cast<std::uint64_t>(a) * b;
+        std::uint64_t folded = (product & fieldPrime) + (product >> 31);
+        return static_cast<std::uint32_t>(
+            folded >= fieldPrime ? folded - fieldPrime : folded);
+    }
+
+    // Returns the inverse of a nonzero element by Fermat's little theorem
+    std::uint32_t inverseMod(std::uint32_t value)
+    {
+        std::uint32_t result = 1;
+        for (std::uint32_t power = fieldPrime - 2; power > 0; power >>= 1)
+        {
+            if (power & 1U)
+            {
+                result = multiplyMod(result, value);
+            }
+            value = multiplyMod(value, value);
+        }
+        return result;
+    }
+}
+
+/**
+ * Constructor for the AlgebraicMatching class.
+ *
+ * Method Name: AlgebraicMatching
+ *
+ * Purpose: Stores the adjacency of the left nodes and the seed of the
+ * random substitution.
+ *
+ * Parameters:
+ * - leftNodes: An integer representing the number of left nodes.
+ * - rightNodes: An integer representing the number of right nodes.
+ * - offsets: A constant reference to the start of the neighbors of
+ *   every left node, with one extra entry at the end.
+ * - targets: A constant reference to the right neighbors.
+ * - seed: The seed of the random field elements.
+ *
+ * Preconditions:
+ * - The offsets are non-decreasing and end at the target count.
+ *
+ * Postconditions:
+ * - A new instance of the AlgebraicMatching class is created.
+ * - An exception is thrown if the adjacency is invalid.
+ */
+AlgebraicMatching::AlgebraicMatching(int leftNodes,
+                                     int rightNodes,
+                                     const std::vector<int> &offsets,
+                                     const std::vector<int> &targets,
+                                     unsigned long long seed)
+    : leftNodes(leftNodes),
+      rightNodes(rightNodes),
+      offsets(offsets),
+      targets(targets),
+      seed(seed),
+      leftMatch(leftNodes < 0 ? 0 : leftNodes, -1),
+      rightMatch(rightNodes < 0 ? 0 : rightNodes, -1)
+{
+    // Check if the adjacency describes the two sides
+    bool valid = leftNodes >= 0 && rightNodes >= 0 &&
+                 static_cast<int>(offsets.size()) == leftNodes + 1 &&
+                 offsets[0] == 0 &&
+                 offsets[leftNodes] == static_cast<int>(targets.size());
+    for (int node = 0; valid && node < leftNodes; ++node)
+    {
+        valid = offsets[node] <= offsets[node + 1];
+    }
+    for (size_t edge = 0; valid && edge < targets.size(); ++edge)
+    {
+        valid = targets[edge] >= 0 && targets[edge] < rightNodes;
+    }
+    if (!valid)
+    {
+        std::cerr << "ERROR: Bipartite adjacency is Invalid." << std::endl;
+        throw std::invalid_argument("Bipartite adjacency is Invalid.");
+    }
+}
+
+/**
+ * Calculates the size of a maximum matching.
+ *
+ * Method Name: calculateMaxMatching
+ *
+ * Purpose: Fills the Edmonds matrix with a random nonzero element per
+ * edge and finds its rank by row reduction. If asked, inverts the
+ * submatrix of the pivot rows and columns and peels matched pairs off
+ * it one at a time.
+ *
+ * Parameters:
+ * - recover: True to also find a matching of that size.
+ *
+ * Returns: The size of a maximum matching, with high probability.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The matching is stored if it was recovered; otherwise every node is
+ *   left free.
+ * - An exception is thrown if the matrix is too large.
+ */
+int AlgebraicMatching::calculateMaxMatching(bool recover)
+{
+    try
+    {
+        std::fill(leftMatch.begin(), leftMatch.end(), -1);
+        std::fill(rightMatch.begin(), rightMatch.end(), -1);
+
+        std::vector<std::uint32_t> matrix = buildMatrix();
+        std::vector<std::uint32_t> reduced = matrix;
+
+        // Row reduce through a row order, so rows are never copied
+        std::vector<int> order(leftNodes);
+        for (int row = 0; row < leftNodes; ++row)
+        {
+            order[row] = row;
+        }
+        std::vector<int> pivotRows;
+        std::vector<int> pivotColumns;
+        int rank = 0;
+        for (int column = 0; column < rightNodes && rank < leftNodes;
+             ++column)
+        {
+            int found = rank;
+            while (found < leftNodes &&
+                   reduced[static_cast<size_t>(order[found]) * rightNodes +
+                           column] == 0)
+            {
+                ++found;
+            }
+            if (found == leftNodes)
+            {
+                continue;
+            }
+            std::swap(order[rank], order[found]);
+
+            // Clear the column below the pivot with the pivot row
+            const std::uint32_t *pivot =
+                &reduced[static_cast<size_t>(order[rank]) * rightNodes];
+            std::uint32_t inverse = inverseMod(pivot[column]);
+            for (int below = rank + 1; below < leftNodes; ++below)
+            {
+                std::uint32_t *row =
+                    &reduced[static_cast<size_t>(order[below]) * rightNodes];
+                if (row[column] != 0)
+                {
+                    std::uint32_t factor =
+                        fieldPrime - multiplyMod(row[column], inverse);
+                    SimdKernels::addScaledRow(row + column, pivot + column,
+                                              factor, rightNodes - column);
+                }
+            }
+            pivotRows.push_back(order[rank]);
+            pivotColumns.push_back(column);
+            ++rank;
+        }
+
+        if (recover)
+        {
+            recoverMatching(matrix, pivotRows, pivotColumns);
+        }
+        return rank;
+    }
+    catch (const std::exception &e)
+    {
+        // Output an error message if the calculation fails
+        std::cerr
+            << "ERROR: Error in calculateMaxMatching: "
+            << e.what()
+            << std::endl;
+        throw std::runtime_error("Error in calculateMaxMatching: " +
+                                 std::string(e.what()));
+    }
+}
+
+/**
+ * Get the partners of the left nodes.
+ *
+ * Method Name: getLeftMatch
+ *
+ * Purpose: Returns the right partner of every left node.
+ *
+ * Preconditions:
+ * - calculateMaxMatching was called with recover set.
+ *
+ * Postconditions:
+ * - The partners are returned.
+ *
+ * Returns: The right partner of every left node, -1 for free nodes.
+ */
+const std::vector<int> &AlgebraicMatching::getLeftMatch() const
+{
+    return leftMatch;
+}
+
+/**
+ * Get the partners of the right nodes.
+ *
+ * Method Name: getRightMatch
+ *
+ * Purpose: Returns the left partner of every right node.
+ *
+ * Preconditions:
+ * - calculateMaxMatching was called with recover set.
+ *
+ * Postconditions:
+ * - The partners are returned.
+ *
+ * Returns: The left partner of every right node, -1 for free nodes.
+ */
+const std::vector<int> &AlgebraicMatching::getRightMatch() const
+{
+    return rightMatch;
+}
+
+/**
+ * Builds the substituted Edmonds matrix.
+ *
+ * Method Name: buildMatrix
+ *
+ * Purpose: Fills a row per left node with the field element of every
+ * edge and zero elsewhere.
+ *
+ * Returns: The matrix in row-major order.
+ *
+ * Preconditions:
+ * - The matrix fits in memory.
+ *
+ * Postconditions:
+ * - Parallel edges share one element.
+ */
+std::vector<std::uint32_t> AlgebraicMatching::buildMatrix() const
+{
+    std::vector<std::uint32_t> matrix(
+        static_cast<size_t>(leftNodes) * rightNodes, 0);
+    for (int left = 0; left < leftNodes; ++left)
+    {
+        for (int edge = offsets[left]; edge < offsets[left + 1]; ++edge)
+        {
+            // Hash the node pair with SplitMix64 into 1 .. prime - 1
+            size_t cell = static_cast<size_t>(left) * rightNodes +
+                          targets[edge];
+            std::uint64_t value = seed + 0x9e3779b97f4a7c15ULL * (cell + 1);
+            value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+            value ^= value >> 31;
+            matrix[cell] =
+                static_cast<std::uint32_t>(value % (fieldPrime - 1)) + 1;
+        }
+    }
+    return matrix;
+}
+
+/**
+ * Recovers a perfect matching of a full-rank submatrix.
+ *
+ * Method Name: recoverMatching
+ *
+ * Purpose: Inverts the submatrix, then repeatedly matches a row i to a
+ * column j where both the submatrix and its inverse at (j, i) are
+ * nonzero, so the rest stays full rank, and updates the inverse of the
+ * rest with a rank one correction.
+ *
+ * Parameters:
+ * - matrix: A constant reference to the substituted matrix.
+ * - rows: A constant reference to the pivot rows.
+ * - columns: A constant reference to the pivot columns.
+ *
+ * Preconditions:
+ * - The submatrix of the rows and columns is nonsingular.
+ *
+ * Postconditions:
+ * - Every pivot row is matched to a pivot column.
+ */
+void AlgebraicMatching::recoverMatching(
+    const std::vector<std::uint32_t> &matrix,
+    const std::vector<int> &rows,
+    const std::vector<int> &columns)
+{
+    int size = static_cast<int>(rows.size());
+    int width = 2 * size;
+    std::vector<std::uint32_t> sub(static_cast<size_t>(size) * size);
+    for (int i = 0; i < size; ++i)
+    {
+        for (int j = 0; j < size; ++j)
+        {
+            sub[static_cast<size_t>(i) * size + j] =
+                matrix[static_cast<size_t>(rows[i]) * rightNodes +
+                       columns[j]];
+        }
+    }
+
+    // Gauss-Jordan on the submatrix next to the identity
+    std::vector<std::uint32_t> joined(static_cast<size_t>(size) * width, 0);
+    for (int i = 0; i < size; ++i)
+    {
+        std::copy(sub.begin() + static_cast<size_t>(i) * size,
+                  sub.begin() + static_cast<size_t>(i + 1) * size,
+                  joined.begin() + static_cast<size_t>(i) * width);
+        joined[static_cast<size_t>(i) * width + size + i] = 1;
+    }
+    for (int column = 0; column < size; ++column)
+    {
+        int found = column;
+        while (found < size &&
+               joined[static_cast<size_t>(found) * width + column] == 0)
+        {
+            ++found;
+        }
+        if (found == size)
+        {
+            std::cerr << "ERROR: Submatrix is singular." << std::endl;
+            throw std::logic_error("Submatrix is singular.");
+        }
+        std::swap_ranges(
+            joined.begin() + static_cast<size_t>(found) * width,
+            joined.begin() + static_cast<size_t>(found + 1) * width,
+            joined.begin() + static_cast<size_t>(column) * width);
+
+        std::uint32_t *pivot = &joined[static_cast<size_t>(column) * width];
+        std::uint32_t inverse = inverseMod(pivot[column]);
+        for (int k = 0; k < width; ++k)
+        {
+            pivot[k] = multiplyMod(pivot[k], inverse);
+        }
+        for (int other = 0; other < size; ++other)
+        {
+            std::uint32_t *row = &joined[static_cast<size_t>(other) * width];
+            if (other != column && row[column] != 0)
+            {
+                SimdKernels::addScaledRow(row, pivot,
+                                          fieldPrime - row[column], width);
+            }
+        }
+    }
+    std::vector<std::uint32_t> inverse(static_cast<size_t>(size) * size);
+    for (int i = 0; i < size; ++i)
+    {
+        std::copy(joined.begin() + static_cast<size_t>(i) * width + size,
+                  joined.begin() + static_cast<size_t>(i + 1) * width,
+                  inverse.begin() + static_cast<size_t>(i) * size);
+    }
+    joined.clear();
+    joined.shrink_to_fit();
+
+    // Match every row where the rest keeps a nonzero determinant
+    std::vector<bool> columnUsed(size, false);
+    for (int i = 0; i < size; ++i)
+    {
+        int j = 0;
+        while (j < size &&
+               (columnUsed[j] || sub[static_cast<size_t>(i) * size + j] == 0 ||
+                inverse[static_cast<size_t>(j) * size + i] == 0))
+        {
+            ++j;
+        }
+        if (j == size)
+        {
+            std::cerr << "ERROR: Submatrix is singular." << std::endl;
+            throw std::logic_error("Submatrix is singular.");
+        }
+        leftMatch[rows[i]] = columns[j];
+        rightMatch[columns[j]] = rows[i];
+        columnUsed[j] = true;
+
+        // The inverse of the rest is the inverse minus a rank one term
+        const std::uint32_t *pivot = &inverse[static_cast<size_t>(j) * size];
+        std::uint32_t scale = inverseMod(pivot[i]);
+        for (int k = 0; k < size; ++k)
+        {
+            std::uint32_t *row = &inverse[static_cast<size_t>(k) * size];
+            if (!columnUsed[k] && row[i] != 0)
+            {
+                SimdKernels::addScaledRow(row, pivot,
+                             fieldPrime - multiplyMod(row[i], scale), size);
+            }
+        }
+    }
+}
@@ -0,0 +1,187 @@
+/*
+ * File: AlgebraicMatching.h Author: Nicolas Gioanni Purpose:
+ * Declaration of the AlgebraicMatching class for finding the size of a
+ * maximum bipartite matching as the rank of a randomly substituted
+ * Edmonds matrix over a prime field.
+ *
+ * Functionality/Features:
+ * - Declare methods for computing the matching size with dense
+ *   Gaussian elimination, at a cost that does not depend on the
+ *   structure of augmenting paths.
+ * - Declare methods for recovering a maximum matching from the inverse
+ *   of a full-rank submatrix.
+ * - Declare methods for reading the matching.
+ *
+ * Assumptions:
+ * - The graph is given in the compressed sparse row form used by
+ *   HopcroftKarp and is small and dense enough for a leftNodes by
+ *   rightNodes matrix of 32-bit words to fit in memory.
+ * - Arithmetic is modulo the prime 2^31 - 1, so the size is too small
+ *   with probability at most min(leftNodes, rightNodes) / (2^31 - 1);
+ *   a recovered matching is always valid.
+ */
+
+#ifndef ALGEBRAICMATCHING_H
+#define ALGEBRAICMATCHING_H
+
+#include <cstdint>
+#include <vector>
+
+class AlgebraicMatching
+{
+public:
+    /**
+     * Constructor for the AlgebraicMatching class.
+     *
+     * Method Name: AlgebraicMatching
+     *
+     * Purpose: Stores the adjacency of the left nodes and the seed of
+     * the random substitution.
+     *
+     * Parameters:
+     * - leftNodes: An integer representing the number of left nodes.
+     * - rightNodes: An integer representing the number of right nodes.
+     * - offsets: A constant reference to the start of the neighbors of
+     *   every left node, with one extra entry at the end.
+     * - targets: A constant reference to the right neighbors.
+     * - seed: The seed of the random field elements.
+     *
+     * Preconditions:
+     * - The offsets are non-decreasing and end at the target count.
+     *
+     * Postconditions:
+     * - A new instance of the AlgebraicMatching class is created.
+     * - An exception is thrown if the adjacency is invalid.
+     */
+    AlgebraicMatching(int leftNodes,
+                      int rightNodes,
+                      const std::vector<int> &offsets,
+                      const std::vector<int> &targets,
+                      unsigned long long seed = 1);
+
+    /**
+     * Calculates the size of a maximum matching.
+     *
+     * Method Name: calculateMaxMatching
+     *
+     * Purpose: Fills the Edmonds matrix with a random nonzero element
+     * per edge and finds its rank by row reduction. If asked, inverts
+     * the submatrix of the pivot rows and columns and peels matched
+     * pairs off it one at a time.
+     *
+     * Parameters:
+     * - recover: True to also find a matching of that size.
+     *
+     * Returns: The size of a maximum matching, with high probability.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The matching is stored if it was recovered; otherwise every
+     *   node is left free.
+     * - An exception is thrown if the matrix is too large.
+     */
+    int calculateMaxMatching(bool recover = false);
+
+    /**
+     * Get the partners of the left nodes.
+     *
+     * Method Name: getLeftMatch
+     *
+     * Purpose: Returns the right partner of every left node.
+     *
+     * Preconditions:
+     * - calculateMaxMatching was called with recover set.
+     *
+     * Postconditions:
+     * - The partners are returned.
+     *
+     * Returns: The right partner of every left node, -1 for free nodes.
+     */
+    const std::vector<int> &getLeftMatch() const;
+
+    /**
+     * Get the partners of the right nodes.
+     *
+     * Method Name: getRightMatch
+     *
+     * Purpose: Returns the left partner of every right node.
+     *
+     * Preconditions:
+     * - calculateMaxMatching was called with recover set.
+     *
+     * Postconditions:
+     * - The partners are returned.
+     *
+     * Returns: The left partner of every right node, -1 for free nodes.
+     */
+    const std::vector<int> &getRightMatch() const;
+
+private:
+    // The number of left nodes
+    int leftNodes;
+
+    // The number of right nodes
+    int rightNodes;
+
+    // The start of the neighbors of every left node
+    std::vector<int> offsets;
+
+    // The right end of every edge
+    std::vector<int> targets;
+
+    // The seed of the random field elements
+    unsigned long long seed;
+
+    // The right partner of every left node
+    std::vector<int> leftMatch;
+
+    // The left partner of every right node
+    std::vector<int> rightMatch;
+
+    /**
+     * Builds the substituted Edmonds matrix.
+     *
+     * Method Name: buildMatrix
+     *
+     * Purpose: Fills a row per left node with the field element of
+     * every edge and zero elsewhere.
+     *
+     * Returns: The matrix in row-major order.
+     *
+     * Preconditions:
+     * - The matrix fits in memory.
+     *
+     * Postconditions:
+     * - Parallel edges share one element.
+     */
+    std::vector<std::uint32_t> buildMatrix() const;
+
+    /**
+     * Recovers a perfect matching of a full-rank submatrix.
+     *
+     * Method Name: recoverMatching
+     *
+     * Purpose: Inverts the submatrix, then repeatedly matches a row i
+     * to a column j where both the submatrix and its inverse at (j, i)
+     * are nonzero, so the rest stays full rank, and updates the
+     * inverse of the rest with a rank one correction.
+     *
+     * Parameters:
+     * - matrix: A constant reference to the substituted matrix.
+     * - rows: A constant reference to the pivot rows.
+     * - columns: A constant reference to the pivot columns.
+     *
+     * Preconditions:
+     * - The submatrix of the rows and columns is nonsingular.
+     *
+     * Postconditions:
+     * - Every pivot row is matched to a pivot column.
+     */
+    void recoverMatching(const std::vector<std::uint32_t> &matrix,
+                         const std::vector<int> &rows,
+                         const std::vector<int> &columns);
+};
+
+#endif
@@ -5,8 +5,8 @@
  *
  * Functionality/Features:
  * - Read graph data from a specified file.
- * - Solve the bipartite matching problem using the Ford-Fulkerson
- *   algorithm.
+ * - Solve the bipartite matching problem using the engine registered
+ *   under the chosen name, Ford-Fulkerson by default.
  * - Print the results of the matching process.
  *
  * Assumptions:
@@ -16,6 +16,8 @@
  */
 
 #include "BipartiteMatcher.h"
+#include "EngineRegistry.h"
+#include <algorithm>
 #include <iostream>
 #include <stdexcept>
 
@@ -32,9 +34,11 @@
  * Postconditions:
  * - A new instance of the BipartiteMatcher class is created.
  * - The graph and algorithm pointers are set to nullptr.
+ * - The Ford-Fulkerson engine is chosen.
  */
 BipartiteMatcher::BipartiteMatcher() : graph(nullptr),
-                                       algorithm(nullptr) {}
+                                       algorithm(nullptr),
+                                       engineName("fordfulkerson") {}
 
 /**
  * Reads the graph data from a specified file.
@@ -80,8 +84,37 @@ void BipartiteMatcher::fileRead(const std::string &filename)
 }
 
 /**
- * Solves the bipartite matching problem using the Ford-Fulkerson
- * algorithm.
+ * Chooses the engine.
+ *
+ * Method Name: setEngine
+ *
+ * Purpose: Sets the name of the registered engine that solve uses,
+ * "auto" to pick one from the shape of the graph.
+ *
+ * Parameters:
+ * - name: A constant reference to the name of the engine.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The engine is used by the next solve.
+ * - An exception is thrown if no engine has the name.
+ */
+void BipartiteMatcher::setEngine(const std::string &name)
+{
+    // Check if an engine is registered under the name
+    std::vector<std::string> names = EngineRegistry::getNames();
+    if (std::find(names.begin(), names.end(), name) == names.end())
+    {
+        std::cerr << "ERROR: Engine name is Invalid: " << name << std::endl;
+        throw std::invalid_argument("Engine name is Invalid: " + name);
+    }
+    engineName = name;
+}
+
+/**
+ * Solves the bipartite matching problem using the chosen engine.
  *
  * Method Name: solve
  *
@@ -121,9 +154,8 @@ void BipartiteMatcher::solve()
         // Connect the source and sink nodes in the graph
         graph->connectSourceAndSinkNodes(0, nodes + 1);
 
-        // Create a unique pointer to a FordFulkerson algorithm object
-        // using the graph
-        algorithm = std::make_unique<FordFulkerson>(*graph);
+        // Create the chosen engine for the graph
+        algorithm = EngineRegistry::create(engineName, *graph);
 
         // Calculate the maximum flow from the source to the sink node
         algorithm->calculateMaxFlow(0, nodes + 1);
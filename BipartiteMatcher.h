@@ -1,13 +1,13 @@
 /*
  * File: BipartiteMatcher.h Author: Nicolas Gioanni Purpose:
  * Declaration of the BipartiteMatcher class for solving the bipartite
- * matching problem using Ford-Fulkerson algorithm.
+ * matching problem using a max-flow engine chosen by name.
  *
  * Functionality/Features:
  * - Declare methods for reading graph data from a file.
  * - Declare methods for solving the bipartite matching problem.
- * - Utilize Ford-Fulkerson algorithm to find the maximum matching in
- *   the bipartite graph.
+ * - Declare methods for choosing the engine that finds the maximum
+ *   matching, Ford-Fulkerson by default.
  *
  * Assumptions:
  * - The input file format is correct and contains valid graph data.
@@ -18,9 +18,10 @@
 #define BIPARTITEMATCHER_H
 
 #include "Graph.h"
-#include "FordFulkerson.h"
 #include "GraphPrepare.h"
+#include "MaxFlowEngine.h"
 #include <memory>
+#include <string>
 
 class BipartiteMatcher
 {
@@ -65,8 +66,27 @@ public:
     void fileRead(const std::string &filename);
 
     /**
-     * Solves the bipartite matching problem using the Ford-Fulkerson
-     * algorithm.
+     * Chooses the engine.
+     *
+     * Method Name: setEngine
+     *
+     * Purpose: Sets the name of the registered engine that solve uses,
+     * "auto" to pick one from the shape of the graph.
+     *
+     * Parameters:
+     * - name: A constant reference to the name of the engine.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The engine is used by the next solve.
+     * - An exception is thrown if no engine has the name.
+     */
+    void setEngine(const std::string &name);
+
+    /**
+     * Solves the bipartite matching problem using the chosen engine.
      *
      * Method Name: solve
      *
@@ -84,9 +104,12 @@ public:
     void solve();
 
 private:
-    // Unique pointers to Graph and FordFulkerson objects
+    // Unique pointers to Graph and engine objects
     std::unique_ptr<Graph> graph;
-    std::unique_ptr<FordFulkerson> algorithm;
+    std::unique_ptr<MaxFlowEngine> algorithm;
+
+    // The name of the engine used by solve
+    std::string engineName;
 
     // GraphPrepare object for reading graph data
     GraphPrepare readGraph;
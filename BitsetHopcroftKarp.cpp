@@ -0,0 +1,378 @@
+/*
+ * File: BitsetHopcroftKarp.cpp Author: Nicolas Gioanni Purpose:
+ * Implementation of the BitsetHopcroftKarp class, providing methods for
+ * calculating maximum matchings of dense bipartite graphs.
+ *
+ * Functionality/Features:
+ * - Advance the breadth first frontier with whole-row OR kernels and
+ *   AND NOT word loops.
+ * - Pick neighbors in the depth first search with a trailing zero count
+ *   on the first nonzero word of row AND layer, found by the
+ *   SimdKernels word scan.
+ *
+ * Assumptions:
+ * - A right node is tried at most once per phase, so it is cleared
+ *   from its layer as soon as the search reaches it.
+ * - Every left node is in at most one layer, so its scan word only
+ *   moves forward during a phase.
+ */
+
+#include "BitsetHopcroftKarp.h"
+#include "SimdKernels.h"
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+namespace
+{
+    // Returns the index of the lowest set bit of a nonzero word
+    inline int lowestBit(std::uint64_t word)
+    {
+        return __builtin_ctzll(word);
+    }
+}
+
+/**
+ * Constructor for the BitsetHopcroftKarp class.
+ *
+ * Method Name: BitsetHopcroftKarp
+ *
+ * Purpose: Builds the bitset rows of the left nodes and starts from the
+ * empty matching.
+ *
+ * Parameters:
+ * - leftNodes: An integer representing the number of left nodes.
+ * - rightNodes: An integer representing the number of right nodes.
+ * - offsets: A constant reference to the start of the neighbors of
+ *   every left node, with one extra entry at the end.
+ * - targets: A constant reference to the right neighbors.
+ *
+ * Preconditions:
+ * - The offsets are non-decreasing and end at the target count.
+ *
+ * Postconditions:
+ * - A new instance of the BitsetHopcroftKarp class is created.
+ * - An exception is thrown if the adjacency is invalid.
+ */
+BitsetHopcroftKarp::BitsetHopcroftKarp(int leftNodes,
+                                       int rightNodes,
+                                       const std::vector<int> &offsets,
+                                       const std::vector<int> &targets)
+    : leftNodes(leftNodes),
+      rightNodes(rightNodes),
+      words(rightNodes < 0 ? 0 : (rightNodes + 63) / 64),
+      leftMatch(leftNodes < 0 ? 0 : leftNodes, -1),
+      rightMatch(rightNodes < 0 ? 0 : rightNodes, -1),
+      freeRight(words, 0),
+      layerCount(0),
+      scanWord(leftNodes < 0 ? 0 : leftNodes, 0)
+{
+    // Check if the adjacency describes the two sides
+    bool valid = leftNodes >= 0 && rightNodes >= 0 &&
+                 static_cast<int>(offsets.size()) == leftNodes + 1 &&
+                 offsets[0] == 0 &&
+                 offsets[leftNodes] == static_cast<int>(targets.size());
+    for (int node = 0; valid && node < leftNodes; ++node)
+    {
+        valid = offsets[node] <= offsets[node + 1];
+    }
+    for (size_t edge = 0; valid && edge < targets.size(); ++edge)
+    {
+        valid = targets[edge] >= 0 && targets[edge] < rightNodes;
+    }
+    if (!valid)
+    {
+        std::cerr << "ERROR: Bipartite adjacency is Invalid." << std::endl;
+        throw std::invalid_argument("Bipartite adjacency is Invalid.");
+    }
+
+    // Set one bit per edge and mark every right node free
+    adjacency.assign(static_cast<size_t>(leftNodes) * words, 0);
+    for (int node = 0; node < leftNodes; ++node)
+    {
+        std::uint64_t *row =
+            adjacency.data() + static_cast<size_t>(node) * words;
+        for (int edge = offsets[node]; edge < offsets[node + 1]; ++edge)
+        {
+            row[targets[edge] >> 6] |= 1ULL << (targets[edge] & 63);
+        }
+    }
+    for (int right = 0; right < rightNodes; ++right)
+    {
+        freeRight[right >> 6] |= 1ULL << (right & 63);
+    }
+}
+
+/**
+ * Calculates a maximum matching.
+ *
+ * Method Name: calculateMaxMatching
+ *
+ * Purpose: Matches free left nodes greedily and then augments along
+ * shortest alternating paths, a whole phase of disjoint paths at a time,
+ * starting from the matching already held.
+ *
+ * Returns: The size of the maximum matching.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The matching is maximum.
+ */
+int BitsetHopcroftKarp::calculateMaxMatching()
+{
+    int size = 0;
+
+    // Match every free left node to its first free neighbor
+    for (int node = 0; node < leftNodes; ++node)
+    {
+        const std::uint64_t *row =
+            adjacency.data() + static_cast<size_t>(node) * words;
+        int word = SimdKernels::findCommonWord(row, freeRight.data(), 0,
+                                               words);
+        if (word < words)
+        {
+            int right = word * 64 + lowestBit(row[word] & freeRight[word]);
+            leftMatch[node] = right;
+            rightMatch[right] = node;
+            freeRight[word] &= ~(1ULL << (right & 63));
+        }
+        if (leftMatch[node] != -1)
+        {
+            ++size;
+        }
+    }
+
+    // Augment a phase of shortest paths at a time
+    while (buildLayers())
+    {
+        for (int node = 0; node < leftNodes; ++node)
+        {
+            if (leftMatch[node] == -1 && augmentFrom(node))
+            {
+                ++size;
+            }
+        }
+    }
+    return size;
+}
+
+/**
+ * Get the partner of every left node.
+ *
+ * Method Name: getLeftMatch
+ *
+ * Purpose: Returns the right partner of every left node.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The partners are returned.
+ *
+ * Returns: The right partner of every left node, -1 for free nodes.
+ */
+const std::vector<int> &BitsetHopcroftKarp::getLeftMatch() const
+{
+    return leftMatch;
+}
+
+/**
+ * Get the partner of every right node.
+ *
+ * Method Name: getRightMatch
+ *
+ * Purpose: Returns the left partner of every right node.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The partners are returned.
+ *
+ * Returns: The left partner of every right node, -1 for free nodes.
+ */
+const std::vector<int> &BitsetHopcroftKarp::getRightMatch() const
+{
+    return rightMatch;
+}
+
+/**
+ * Builds the layers of the shortest alternating paths.
+ *
+ * Method Name: buildLayers
+ *
+ * Purpose: Starts from all free left nodes and moves the frontier to the
+ * union of its rows minus the right nodes already seen, then back to the
+ * left along matched edges, until a layer holds a free right node. Only
+ * those free nodes are kept in the last layer.
+ *
+ * Returns: True if a free right node was reached.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The layers and scan words are reset for the phase.
+ */
+bool BitsetHopcroftKarp::buildLayers()
+{
+    std::vector<int> frontier;
+    for (int node = 0; node < leftNodes; ++node)
+    {
+        scanWord[node] = 0;
+        if (leftMatch[node] == -1)
+        {
+            frontier.push_back(node);
+        }
+    }
+
+    std::vector<std::uint64_t> seen(words, 0);
+    std::vector<std::uint64_t> next(words);
+    layers.clear();
+    layerCount = 0;
+    while (!frontier.empty())
+    {
+        // The new right nodes are the rows of the frontier minus seen
+        std::fill(next.begin(), next.end(), 0);
+        for (int node : frontier)
+        {
+            SimdKernels::orWords(
+                next.data(),
+                adjacency.data() + static_cast<size_t>(node) * words, words);
+        }
+        bool freeReached = false;
+        bool anyNew = false;
+        for (int word = 0; word < words; ++word)
+        {
+            next[word] &= ~seen[word];
+            seen[word] |= next[word];
+            anyNew = anyNew || next[word] != 0;
+            freeReached = freeReached || (next[word] & freeRight[word]) != 0;
+        }
+        if (!anyNew)
+        {
+            return false;
+        }
+
+        // The last layer keeps only its free right nodes
+        if (freeReached)
+        {
+            for (int word = 0; word < words; ++word)
+            {
+                next[word] &= freeRight[word];
+            }
+            layers.insert(layers.end(), next.begin(), next.end());
+            ++layerCount;
+            return true;
+        }
+        layers.insert(layers.end(), next.begin(), next.end());
+        ++layerCount;
+
+        // Step back to the left along the matched edges
+        frontier.clear();
+        for (int word = 0; word < words; ++word)
+        {
+            for (std::uint64_t bits = next[word]; bits != 0;
+                 bits &= bits - 1)
+            {
+                frontier.push_back(rightMatch[word * 64 + lowestBit(bits)]);
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * Augments along one path from a free left node.
+ *
+ * Method Name: augmentFrom
+ *
+ * Purpose: Searches the layered graph depth first without recursion,
+ * taking every right node out of its layer when it is tried, and flips
+ * the matching along the first path that ends at a free right node.
+ *
+ * Parameters:
+ * - root: An integer representing the free left node.
+ *
+ * Returns: True if the matching grew.
+ *
+ * Preconditions:
+ * - buildLayers was called in this phase.
+ *
+ * Postconditions:
+ * - The layers and scan words are advanced.
+ */
+bool BitsetHopcroftKarp::augmentFrom(int root)
+{
+    std::vector<int> leftPath(1, root);
+    std::vector<int> rightPath;
+    while (!leftPath.empty())
+    {
+        int depth = static_cast<int>(leftPath.size()) - 1;
+        int right = nextRight(leftPath.back(), depth);
+        if (right == -1)
+        {
+            // Nothing left below this node in the current phase
+            leftPath.pop_back();
+            if (!rightPath.empty())
+            {
+                rightPath.pop_back();
+            }
+            continue;
+        }
+        layers[static_cast<size_t>(depth) * words + (right >> 6)] &=
+            ~(1ULL << (right & 63));
+        rightPath.push_back(right);
+
+        if (depth == layerCount - 1)
+        {
+            // Flip the matching along the path
+            for (size_t i = 0; i < leftPath.size(); ++i)
+            {
+                leftMatch[leftPath[i]] = rightPath[i];
+                rightMatch[rightPath[i]] = leftPath[i];
+            }
+            freeRight[right >> 6] &= ~(1ULL << (right & 63));
+            return true;
+        }
+        leftPath.push_back(rightMatch[right]);
+    }
+    return false;
+}
+
+/**
+ * Finds the next usable neighbor of a left node.
+ *
+ * Method Name: nextRight
+ *
+ * Purpose: Scans the row of the node against a layer from the scan word
+ * of the node and returns the lowest common bit.
+ *
+ * Parameters:
+ * - node: An integer representing the left node.
+ * - layer: The layer of the right nodes to use.
+ *
+ * Returns: The right node, -1 if there is none.
+ *
+ * Preconditions:
+ * - The layer exists in this phase.
+ *
+ * Postconditions:
+ * - The scan word of the node skips the empty words.
+ */
+int BitsetHopcroftKarp::nextRight(int node, int layer)
+{
+    const std::uint64_t *row =
+        adjacency.data() + static_cast<size_t>(node) * words;
+    const std::uint64_t *open =
+        layers.data() + static_cast<size_t>(layer) * words;
+    int &word = scanWord[node];
+    word = SimdKernels::findCommonWord(row, open, word, words);
+    if (word == words)
+    {
+        return -1;
+    }
+    return word * 64 + lowestBit(row[word] & open[word]);
+}
@@ -0,0 +1,207 @@
+/*
+ * File: BitsetHopcroftKarp.h Author: Nicolas Gioanni Purpose:
+ * Declaration of the BitsetHopcroftKarp class for calculating maximum
+ * matchings of dense bipartite graphs with the Hopcroft-Karp algorithm
+ * on a bitset adjacency matrix.
+ *
+ * Functionality/Features:
+ * - Declare methods for calculating a maximum matching, continuing from
+ *   the matching already held.
+ * - Declare methods for reading the matched partner of every node.
+ *
+ * Assumptions:
+ * - The graph is given in the compressed sparse row form used by
+ *   HopcroftKarp and is copied into one row of 64-bit words per left
+ *   node, so memory grows with leftNodes * rightNodes / 8 bytes.
+ * - The breadth first search moves a whole frontier of right nodes at
+ *   a time with word operations, and the depth first search finds the
+ *   next usable neighbor with a word scan and a trailing zero count.
+ */
+
+#ifndef BITSETHOPCROFTKARP_H
+#define BITSETHOPCROFTKARP_H
+
+#include <cstdint>
+#include <vector>
+
+class BitsetHopcroftKarp
+{
+public:
+    /**
+     * Constructor for the BitsetHopcroftKarp class.
+     *
+     * Method Name: BitsetHopcroftKarp
+     *
+     * Purpose: Builds the bitset rows of the left nodes and starts from
+     * the empty matching.
+     *
+     * Parameters:
+     * - leftNodes: An integer representing the number of left nodes.
+     * - rightNodes: An integer representing the number of right nodes.
+     * - offsets: A constant reference to the start of the neighbors of
+     *   every left node, with one extra entry at the end.
+     * - targets: A constant reference to the right neighbors.
+     *
+     * Preconditions:
+     * - The offsets are non-decreasing and end at the target count.
+     *
+     * Postconditions:
+     * - A new instance of the BitsetHopcroftKarp class is created.
+     * - An exception is thrown if the adjacency is invalid.
+     */
+    BitsetHopcroftKarp(int leftNodes,
+                       int rightNodes,
+                       const std::vector<int> &offsets,
+                       const std::vector<int> &targets);
+
+    /**
+     * Calculates a maximum matching.
+     *
+     * Method Name: calculateMaxMatching
+     *
+     * Purpose: Matches free left nodes greedily and then augments along
+     * shortest alternating paths, a whole phase of disjoint paths at a
+     * time, starting from the matching already held.
+     *
+     * Returns: The size of the maximum matching.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The matching is maximum.
+     */
+    int calculateMaxMatching();
+
+    /**
+     * Get the partner of every left node.
+     *
+     * Method Name: getLeftMatch
+     *
+     * Purpose: Returns the right partner of every left node.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The partners are returned.
+     *
+     * Returns: The right partner of every left node, -1 for free nodes.
+     */
+    const std::vector<int> &getLeftMatch() const;
+
+    /**
+     * Get the partner of every right node.
+     *
+     * Method Name: getRightMatch
+     *
+     * Purpose: Returns the left partner of every right node.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The partners are returned.
+     *
+     * Returns: The left partner of every right node, -1 for free nodes.
+     */
+    const std::vector<int> &getRightMatch() const;
+
+private:
+    // The number of left nodes
+    int leftNodes;
+
+    // The number of right nodes
+    int rightNodes;
+
+    // The number of 64-bit words in a row of right nodes
+    int words;
+
+    // The neighbors of every left node, one row of words per node
+    std::vector<std::uint64_t> adjacency;
+
+    // The right partner of every left node
+    std::vector<int> leftMatch;
+
+    // The left partner of every right node
+    std::vector<int> rightMatch;
+
+    // The free right nodes
+    std::vector<std::uint64_t> freeRight;
+
+    // The right nodes of every layer not yet tried in this phase
+    std::vector<std::uint64_t> layers;
+
+    // The number of layers of right nodes in this phase
+    int layerCount;
+
+    // The first word of the row of every left node still worth scanning
+    std::vector<int> scanWord;
+
+    /**
+     * Builds the layers of the shortest alternating paths.
+     *
+     * Method Name: buildLayers
+     *
+     * Purpose: Starts from all free left nodes and moves the frontier
+     * to the union of its rows minus the right nodes already seen, then
+     * back to the left along matched edges, until a layer holds a free
+     * right node. Only those free nodes are kept in the last layer.
+     *
+     * Returns: True if a free right node was reached.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The layers and scan words are reset for the phase.
+     */
+    bool buildLayers();
+
+    /**
+     * Augments along one path from a free left node.
+     *
+     * Method Name: augmentFrom
+     *
+     * Purpose: Searches the layered graph depth first without recursion,
+     * taking every right node out of its layer when it is tried, and
+     * flips the matching along the first path that ends at a free right
+     * node.
+     *
+     * Parameters:
+     * - root: An integer representing the free left node.
+     *
+     * Returns: True if the matching grew.
+     *
+     * Preconditions:
+     * - buildLayers was called in this phase.
+     *
+     * Postconditions:
+     * - The layers and scan words are advanced.
+     */
+    bool augmentFrom(int root);
+
+    /**
+     * Finds the next usable neighbor of a left node.
+     *
+     * Method Name: nextRight
+     *
+     * Purpose: Scans the row of the node against a layer from the scan
+     * word of the node and returns the lowest common bit.
+     *
+     * Parameters:
+     * - node: An integer representing the left node.
+     * - layer: The layer of the right nodes to use.
+     *
+     * Returns: The right node, -1 if there is none.
+     *
+     * Preconditions:
+     * - The layer exists in this phase.
+     *
+     * Postconditions:
+     * - The scan word of the node skips the empty words.
+     */
+    int nextRight(int node, int layer);
+};
+
+#endif
@@ -0,0 +1,528 @@
+/*
+ * File: BoykovKolmogorov.cpp Author: Nicolas Gioanni Purpose:
+ * Implementation of the BoykovKolmogorov class, providing methods for
+ * calculating maximum flow with persistent search trees.
+ *
+ * Functionality/Features:
+ * - Grow a source tree and a sink tree from their active nodes.
+ * - Augment along the path where the trees meet.
+ * - Adopt orphaned nodes into their tree again, preferring parents
+ *   close to the root.
+ *
+ * Assumptions:
+ * - The parent arc of a node leaves the node. In the source tree the
+ *   reverse of that arc carries the flow, in the sink tree the arc
+ *   itself does.
+ */
+
+#include "BoykovKolmogorov.h"
+#include <climits>
+#include <iostream>
+#include <stdexcept>
+
+/**
+ * Constructor for the BoykovKolmogorov class.
+ *
+ * Method Name: BoykovKolmogorov
+ *
+ * Purpose: Initializes a new instance of the BoykovKolmogorov class.
+ *
+ * Parameters:
+ * - network: A reference to the network to solve. The solver keeps the
+ *   flow in the network.
+ *
+ * Preconditions:
+ * - The network is built.
+ *
+ * Postconditions:
+ * - A new instance of the BoykovKolmogorov class is created.
+ */
+template <typename Network>
+BoykovKolmogorov<Network>::BoykovKolmogorov(Network &network)
+    : network(network), currentTime(0)
+{
+}
+
+/**
+ * Calculates the maximum flow in the flow network.
+ *
+ * Method Name: calculateMaxFlow
+ *
+ * Purpose: Removes any previous flow, then grows a search tree from the
+ * source and one from the sink until they touch, augments along the
+ * path where they meet and repairs the trees by adopting the nodes cut
+ * off by saturated tree arcs, instead of searching again from scratch.
+ *
+ * Parameters:
+ * - source: An integer representing the source node.
+ * - sink: An integer representing the sink node.
+ *
+ * Returns: The value of the maximum flow.
+ *
+ * Preconditions:
+ * - The source and sink nodes are within the valid range.
+ *
+ * Postconditions:
+ * - The network carries a maximum flow.
+ * - An exception is thrown if the calculation process fails.
+ */
+template <typename Network>
+long long BoykovKolmogorov<Network>::calculateMaxFlow(int source, int sink)
+{
+    try
+    {
+        int nodes = network.getNodes();
+
+        // Check if source and sink are within valid range
+        if (source < 0 || source >= nodes || sink < 0 || sink >= nodes ||
+            source == sink)
+        {
+            std::cerr
+                << "ERROR: Source or sink node is out of range."
+                << std::endl;
+            throw std::
+                out_of_range("Source or sink node is out of range.");
+        }
+
+        network.resetFlow();
+        tree.assign(nodes, FREE_NODE);
+        parentArc.assign(nodes, ORPHAN);
+        timestamp.assign(nodes, 0);
+        distance.assign(nodes, 0);
+        queued.assign(nodes, false);
+        currentArc.assign(nodes, 0);
+        active.clear();
+        orphans.clear();
+        currentTime = 0;
+
+        // Each tree starts at its terminal
+        tree[source] = SOURCE_TREE;
+        parentArc[source] = TERMINAL;
+        tree[sink] = SINK_TREE;
+        parentArc[sink] = TERMINAL;
+        activate(source);
+        activate(sink);
+
+        long long maxFlow = 0;
+        while (true)
+        {
+            int bridge = growTrees();
+            if (bridge < 0)
+            {
+                break;
+            }
+
+            currentTime++;
+            maxFlow += augmentFlowAlongPath(bridge);
+            adoptOrphans();
+        }
+
+        return maxFlow;
+    }
+    catch (const std::exception &e)
+    {
+        // Output an error message if the calculation fails
+        std::cerr
+            << "ERROR: Error in calculateMaxFlow: "
+            << e.what()
+            << std::endl;
+        throw std::runtime_error("Error in calculateMaxFlow: " +
+                                 std::string(e.what()));
+    }
+}
+
+/**
+ * Get the source side of the minimum cut.
+ *
+ * Method Name: getSourceSide
+ *
+ * Purpose: Returns the nodes of the source tree, which are the nodes
+ * reachable from the source in the residual network.
+ *
+ * Preconditions:
+ * - calculateMaxFlow was called.
+ *
+ * Postconditions:
+ * - The source side is returned.
+ *
+ * Returns: A vector with true for every node on the source side.
+ */
+template <typename Network>
+std::vector<bool> BoykovKolmogorov<Network>::getSourceSide() const
+{
+    std::vector<bool> sourceSide(tree.size(), false);
+    for (size_t node = 0; node < tree.size(); ++node)
+    {
+        sourceSide[node] = tree[node] == SOURCE_TREE;
+    }
+    return sourceSide;
+}
+
+/**
+ * Grows the trees until they touch.
+ *
+ * Method Name: growTrees
+ *
+ * Purpose: Lets the active nodes claim their free residual neighbors
+ * for their tree until an arc from the source tree to the sink tree is
+ * found.
+ *
+ * Returns: The arc from the source tree to the sink tree, -1 if the
+ * trees cannot grow any more.
+ *
+ * Preconditions:
+ * - The trees are valid.
+ *
+ * Postconditions:
+ * - Nodes that cannot grow are no longer active.
+ */
+template <typename Network>
+int BoykovKolmogorov<Network>::growTrees()
+{
+    while (!active.empty())
+    {
+        int node = active.front();
+        if (tree[node] == FREE_NODE)
+        {
+            active.pop_front();
+            queued[node] = false;
+            continue;
+        }
+
+        // Continue where the last scan of this activation stopped
+        for (int &arc = currentArc[node]; arc < network.arcEnd(node); ++arc)
+        {
+            // The source tree grows along arcs, the sink tree against
+            int head = network.getHead(arc);
+            int reverse = network.getReverse(arc);
+            long long residual = tree[node] == SOURCE_TREE
+                                     ? network.getResidual(arc)
+                                     : network.getResidual(reverse);
+            if (residual <= 0)
+            {
+                continue;
+            }
+
+            if (tree[head] == FREE_NODE)
+            {
+                tree[head] = tree[node];
+                parentArc[head] = reverse;
+                timestamp[head] = timestamp[node];
+                distance[head] = distance[node] + 1;
+
+                // A freed node may still be queued from its old tree
+                currentArc[head] = network.arcBegin(head);
+                activate(head);
+            }
+            else if (tree[head] != tree[node])
+            {
+                // The trees touch; the node stays active on this arc
+                return tree[node] == SOURCE_TREE ? arc : reverse;
+            }
+            else if (timestamp[head] <= timestamp[node] &&
+                     distance[head] > distance[node])
+            {
+                // Move the neighbor under the node, closer to the root
+                parentArc[head] = reverse;
+                timestamp[head] = timestamp[node];
+                distance[head] = distance[node] + 1;
+            }
+        }
+
+        active.pop_front();
+        queued[node] = false;
+    }
+    return -1;
+}
+
+/**
+ * Augments along the path through an arc.
+ *
+ * Method Name: augmentFlowAlongPath
+ *
+ * Purpose: Pushes the bottleneck of the tree path from the source
+ * through the arc to the sink, and orphans the nodes whose tree arc was
+ * saturated.
+ *
+ * Parameters:
+ * - bridge: The arc from the source tree to the sink tree.
+ *
+ * Returns: The amount of flow pushed.
+ *
+ * Preconditions:
+ * - The arc has residual capacity.
+ *
+ * Postconditions:
+ * - The orphans are queued for adoption.
+ */
+template <typename Network>
+long long BoykovKolmogorov<Network>::augmentFlowAlongPath(int bridge)
+{
+    int sourceEnd = getTail(bridge);
+    int sinkEnd = network.getHead(bridge);
+
+    // Find the bottleneck on both halves of the path
+    long long bottleneck = network.getResidual(bridge);
+    for (int node = sourceEnd; parentArc[node] != TERMINAL;
+         node = network.getHead(parentArc[node]))
+    {
+        long long residual =
+            network.getResidual(network.getReverse(parentArc[node]));
+        if (residual < bottleneck)
+        {
+            bottleneck = residual;
+        }
+    }
+    for (int node = sinkEnd; parentArc[node] != TERMINAL;
+         node = network.getHead(parentArc[node]))
+    {
+        long long residual = network.getResidual(parentArc[node]);
+        if (residual < bottleneck)
+        {
+            bottleneck = residual;
+        }
+    }
+
+    // Push the bottleneck and orphan the nodes below saturated arcs
+    network.push(bridge, bottleneck);
+    int node = sourceEnd;
+    while (parentArc[node] != TERMINAL)
+    {
+        int arc = parentArc[node];
+        int parent = network.getHead(arc);
+        network.push(network.getReverse(arc), bottleneck);
+        if (network.getResidual(network.getReverse(arc)) == 0)
+        {
+            parentArc[node] = ORPHAN;
+            orphans.push_back(node);
+        }
+        node = parent;
+    }
+    node = sinkEnd;
+    while (parentArc[node] != TERMINAL)
+    {
+        int arc = parentArc[node];
+        int parent = network.getHead(arc);
+        network.push(arc, bottleneck);
+        if (network.getResidual(arc) == 0)
+        {
+            parentArc[node] = ORPHAN;
+            orphans.push_back(node);
+        }
+        node = parent;
+    }
+
+    return bottleneck;
+}
+
+/**
+ * Finds new parents for the orphans.
+ *
+ * Method Name: adoptOrphans
+ *
+ * Purpose: Gives every orphan the closest parent in its tree that still
+ * leads to the root, or frees it and orphans its children if there is
+ * none.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - No orphan is left and the trees are valid.
+ */
+template <typename Network>
+void BoykovKolmogorov<Network>::adoptOrphans()
+{
+    while (!orphans.empty())
+    {
+        int node = orphans.front();
+        orphans.pop_front();
+        int nodeTree = tree[node];
+
+        // Look for the neighbor closest to the root that can be the
+        // parent
+        int bestArc = -1;
+        int bestDistance = INT_MAX;
+        for (int arc = network.arcBegin(node);
+             arc < network.arcEnd(node);
+             ++arc)
+        {
+            int head = network.getHead(arc);
+            if (tree[head] != nodeTree)
+            {
+                continue;
+            }
+            long long residual =
+                nodeTree == SOURCE_TREE
+                    ? network.getResidual(network.getReverse(arc))
+                    : network.getResidual(arc);
+            if (residual <= 0)
+            {
+                continue;
+            }
+
+            int headDistance = distanceToRoot(head);
+            if (headDistance >= 0 && headDistance < bestDistance)
+            {
+                bestArc = arc;
+                bestDistance = headDistance;
+            }
+        }
+
+        if (bestArc >= 0)
+        {
+            parentArc[node] = bestArc;
+            timestamp[node] = currentTime;
+            distance[node] = bestDistance + 1;
+            continue;
+        }
+
+        // No parent is left; free the node and orphan its children
+        tree[node] = FREE_NODE;
+        for (int arc = network.arcBegin(node);
+             arc < network.arcEnd(node);
+             ++arc)
+        {
+            int head = network.getHead(arc);
+            if (tree[head] != nodeTree)
+            {
+                continue;
+            }
+
+            // Neighbors that could reach the node may claim it later
+            long long residual =
+                nodeTree == SOURCE_TREE
+                    ? network.getResidual(network.getReverse(arc))
+                    : network.getResidual(arc);
+            if (residual > 0)
+            {
+                // A queued neighbor may have scanned past the node
+                // already, so it rewinds to the arc that reaches it
+                int back = network.getReverse(arc);
+                if (queued[head] && currentArc[head] > back)
+                {
+                    currentArc[head] = back;
+                }
+                activate(head);
+            }
+
+            if (parentArc[head] >= 0 &&
+                network.getHead(parentArc[head]) == node)
+            {
+                parentArc[head] = ORPHAN;
+                orphans.push_back(head);
+            }
+        }
+    }
+}
+
+/**
+ * Check the distance from a node to the root of its tree.
+ *
+ * Method Name: distanceToRoot
+ *
+ * Purpose: Follows the parent arcs to the root, stopping early at nodes
+ * checked during the same augmentation, and stores the distances along
+ * the way.
+ *
+ * Parameters:
+ * - node: An integer representing the node.
+ *
+ * Returns: The number of tree arcs to the root, -1 if the path ends at
+ * an orphan.
+ *
+ * Preconditions:
+ * - The node is in a tree.
+ *
+ * Postconditions:
+ * - The distances on a path to the root are stored.
+ */
+template <typename Network>
+int BoykovKolmogorov<Network>::distanceToRoot(int node)
+{
+    int steps = 0;
+    int current = node;
+    while (timestamp[current] != currentTime)
+    {
+        int arc = parentArc[current];
+        if (arc == ORPHAN)
+        {
+            return -1;
+        }
+        if (arc == TERMINAL)
+        {
+            timestamp[current] = currentTime;
+            distance[current] = 0;
+            break;
+        }
+        steps++;
+        current = network.getHead(arc);
+    }
+    steps += distance[current];
+
+    // Store the distances on the checked path
+    int remaining = steps;
+    for (current = node; timestamp[current] != currentTime;
+         current = network.getHead(parentArc[current]))
+    {
+        timestamp[current] = currentTime;
+        distance[current] = remaining--;
+    }
+    return steps;
+}
+
+/**
+ * Adds a node to the active queue.
+ *
+ * Method Name: activate
+ *
+ * Purpose: Queues the node if it is not queued yet, with its scan
+ * starting over at its first arc.
+ *
+ * Parameters:
+ * - node: An integer representing the node.
+ *
+ * Preconditions:
+ * - The node is in a tree.
+ *
+ * Postconditions:
+ * - The node is queued.
+ */
+template <typename Network>
+void BoykovKolmogorov<Network>::activate(int node)
+{
+    if (!queued[node])
+    {
+        queued[node] = true;
+        currentArc[node] = network.arcBegin(node);
+        active.push_back(node);
+    }
+}
+
+/**
+ * Get the node an arc leaves.
+ *
+ * Method Name: getTail
+ *
+ * Purpose: Returns the head of the reverse arc.
+ *
+ * Parameters:
+ * - arc: The index of the arc.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The tail is returned.
+ *
+ * Returns: The node the arc leaves.
+ */
+template <typename Network>
+int BoykovKolmogorov<Network>::getTail(int arc) const
+{
+    return network.getHead(network.getReverse(arc));
+}
+
+// The engine over the owned network and over caller arrays
+template class BoykovKolmogorov<FlowNetwork>;
+template class BoykovKolmogorov<CsrNetworkView>;
@@ -0,0 +1,267 @@
+/*
+ * File: BoykovKolmogorov.h Author: Nicolas Gioanni Purpose:
+ * Declaration of the BoykovKolmogorov class for calculating maximum
+ * flow with the Boykov-Kolmogorov algorithm, which suits grid networks
+ * from image and volume segmentation.
+ *
+ * Functionality/Features:
+ * - Declare methods for calculating the maximum flow with a source
+ *   and a sink search tree that are kept between augmentations.
+ * - Declare methods for reading the source side of the minimum cut.
+ *
+ * Assumptions:
+ * - The network is a FlowNetwork, a CsrNetworkView over caller
+ *   arrays, or any type with the same arc methods, and its arcs are
+ *   paired with reverse arcs.
+ * - The class is a template over the network, defined in
+ *   BoykovKolmogorov.cpp for FlowNetwork and CsrNetworkView.
+ * - Capacities are non-negative integers.
+ */
+
+#ifndef BOYKOVKOLMOGOROV_H
+#define BOYKOVKOLMOGOROV_H
+
+#include "CsrNetworkView.h"
+#include "FlowNetwork.h"
+#include <deque>
+#include <vector>
+
+template <typename Network = FlowNetwork>
+class BoykovKolmogorov
+{
+public:
+    /**
+     * Constructor for the BoykovKolmogorov class.
+     *
+     * Method Name: BoykovKolmogorov
+     *
+     * Purpose: Initializes a new instance of the BoykovKolmogorov
+     * class.
+     *
+     * Parameters:
+     * - network: A reference to the network to solve. The solver
+     *   keeps the flow in the network.
+     *
+     * Preconditions:
+     * - The network is built.
+     *
+     * Postconditions:
+     * - A new instance of the BoykovKolmogorov class is created.
+     */
+    BoykovKolmogorov(Network &network);
+
+    /**
+     * Calculates the maximum flow in the flow network.
+     *
+     * Method Name: calculateMaxFlow
+     *
+     * Purpose: Removes any previous flow, then grows a search tree
+     * from the source and one from the sink until they touch, augments
+     * along the path where they meet and repairs the trees by adopting
+     * the nodes cut off by saturated tree arcs, instead of searching
+     * again from scratch.
+     *
+     * Parameters:
+     * - source: An integer representing the source node.
+     * - sink: An integer representing the sink node.
+     *
+     * Returns: The value of the maximum flow.
+     *
+     * Preconditions:
+     * - The source and sink nodes are within the valid range.
+     *
+     * Postconditions:
+     * - The network carries a maximum flow.
+     * - An exception is thrown if the calculation process fails.
+     */
+    long long calculateMaxFlow(int source, int sink);
+
+    /**
+     * Get the source side of the minimum cut.
+     *
+     * Method Name: getSourceSide
+     *
+     * Purpose: Returns the nodes of the source tree, which are the
+     * nodes reachable from the source in the residual network.
+     *
+     * Preconditions:
+     * - calculateMaxFlow was called.
+     *
+     * Postconditions:
+     * - The source side is returned.
+     *
+     * Returns: A vector with true for every node on the source side.
+     */
+    std::vector<bool> getSourceSide() const;
+
+private:
+    // Tree of nodes that belong to neither tree
+    static constexpr int FREE_NODE = 0;
+
+    // Tree of nodes reached from the source
+    static constexpr int SOURCE_TREE = 1;
+
+    // Tree of nodes that reach the sink
+    static constexpr int SINK_TREE = 2;
+
+    // Parent arc of a node that lost its parent
+    static constexpr int ORPHAN = -1;
+
+    // Parent arc of the source and the sink
+    static constexpr int TERMINAL = -2;
+
+    // The network holding the flow
+    Network &network;
+
+    // The tree of every node
+    std::vector<int> tree;
+
+    // The arc from every node to its tree parent
+    std::vector<int> parentArc;
+
+    // The augmentation at which every distance was last checked
+    std::vector<int> timestamp;
+
+    // The number of tree arcs between every node and its root
+    std::vector<int> distance;
+
+    // The next arc every active node scans, kept between augmentations
+    // so a node with many arcs, such as a terminal, is scanned once per
+    // activation instead of once per augmentation
+    std::vector<int> currentArc;
+
+    // The nodes at the edge of the trees that may still grow
+    std::deque<int> active;
+
+    // True for nodes that are in the active queue
+    std::vector<bool> queued;
+
+    // The nodes waiting for a new parent
+    std::deque<int> orphans;
+
+    // The number of augmentations so far
+    int currentTime;
+
+    /**
+     * Grows the trees until they touch.
+     *
+     * Method Name: growTrees
+     *
+     * Purpose: Lets the active nodes claim their free residual
+     * neighbors for their tree until an arc from the source tree to
+     * the sink tree is found.
+     *
+     * Returns: The arc from the source tree to the sink tree, -1 if the
+     * trees cannot grow any more.
+     *
+     * Preconditions:
+     * - The trees are valid.
+     *
+     * Postconditions:
+     * - Nodes that cannot grow are no longer active.
+     */
+    int growTrees();
+
+    /**
+     * Augments along the path through an arc.
+     *
+     * Method Name: augmentFlowAlongPath
+     *
+     * Purpose: Pushes the bottleneck of the tree path from the source
+     * through the arc to the sink, and orphans the nodes whose tree
+     * arc was saturated.
+     *
+     * Parameters:
+     * - bridge: The arc from the source tree to the sink tree.
+     *
+     * Returns: The amount of flow pushed.
+     *
+     * Preconditions:
+     * - The arc has residual capacity.
+     *
+     * Postconditions:
+     * - The orphans are queued for adoption.
+     */
+    long long augmentFlowAlongPath(int bridge);
+
+    /**
+     * Finds new parents for the orphans.
+     *
+     * Method Name: adoptOrphans
+     *
+     * Purpose: Gives every orphan the closest parent in its tree that
+     * still leads to the root, or frees it and orphans its children if
+     * there is none.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - No orphan is left and the trees are valid.
+     */
+    void adoptOrphans();
+
+    /**
+     * Check the distance from a node to the root of its tree.
+     *
+     * Method Name: distanceToRoot
+     *
+     * Purpose: Follows the parent arcs to the root, stopping early at
+     * nodes checked during the same augmentation, and stores the
+     * distances along the way.
+     *
+     * Parameters:
+     * - node: An integer representing the node.
+     *
+     * Returns: The number of tree arcs to the root, -1 if the path ends
+     * at an orphan.
+     *
+     * Preconditions:
+     * - The node is in a tree.
+     *
+     * Postconditions:
+     * - The distances on a path to the root are stored.
+     */
+    int distanceToRoot(int node);
+
+    /**
+     * Adds a node to the active queue.
+     *
+     * Method Name: activate
+     *
+     * Purpose: Queues the node if it is not queued yet, with its scan
+     * starting over at its first arc.
+     *
+     * Parameters:
+     * - node: An integer representing the node.
+     *
+     * Preconditions:
+     * - The node is in a tree.
+     *
+     * Postconditions:
+     * - The node is queued.
+     */
+    void activate(int node);
+
+    /**
+     * Get the node an arc leaves.
+     *
+     * Method Name: getTail
+     *
+     * Purpose: Returns the head of the reverse arc.
+     *
+     * Parameters:
+     * - arc: The index of the arc.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The tail is returned.
+     *
+     * Returns: The node the arc leaves.
+     */
+    int getTail(int arc) const;
+};
+
+#endif
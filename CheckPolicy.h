@@ -0,0 +1,40 @@
+/*
+ * File: CheckPolicy.h Author: Nicolas Gioanni Purpose: Declaration of
+ * the policies that decide at compile time how much checking a solver
+ * does inside its loops.
+ *
+ * Functionality/Features:
+ * - Declare CheckedPolicy, which validates every helper call and wraps
+ *   every error with the name of the helper it passed through.
+ * - Declare UncheckedPolicy, which validates once at the public methods
+ *   and leaves the helpers free of checks and exception handlers.
+ * - Declare DefaultCheckPolicy, which follows the NDEBUG build flag.
+ *
+ * Assumptions:
+ * - A solver reads CHECKED with if constexpr, so the unused branch is
+ *   never compiled into the build.
+ */
+
+#ifndef CHECKPOLICY_H
+#define CHECKPOLICY_H
+
+struct CheckedPolicy
+{
+    // Every helper validates its input and names itself in errors
+    static constexpr bool CHECKED = true;
+};
+
+struct UncheckedPolicy
+{
+    // Only the public methods validate their input
+    static constexpr bool CHECKED = false;
+};
+
+// Release builds drop the helper checks, all other builds keep them
+#ifdef NDEBUG
+typedef UncheckedPolicy DefaultCheckPolicy;
+#else
+typedef CheckedPolicy DefaultCheckPolicy;
+#endif
+
+#endif
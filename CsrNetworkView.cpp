@@ -0,0 +1,173 @@
+/*
+ * File: CsrNetworkView.cpp Author: Nicolas Gioanni Purpose:
+ * Implementation of the CsrNetworkView class, providing methods for
+ * solving a flow network held in caller-owned CSR arrays.
+ *
+ * Functionality/Features:
+ * - Check the arrays once when the view is made, so the engines can
+ *   index them without checks afterwards.
+ * - Change capacities, find arcs and remove the flow in place.
+ *
+ * Assumptions:
+ * - Nothing is copied; every method reads and writes the arrays of the
+ *   caller.
+ */
+
+#include "CsrNetworkView.h"
+#include <iostream>
+#include <stdexcept>
+
+/**
+ * Constructor for the CsrNetworkView class.
+ *
+ * Method Name: CsrNetworkView
+ *
+ * Purpose: Wraps caller-owned CSR arrays and checks that every arc is
+ * paired with a reverse arc that leads back.
+ *
+ * Parameters:
+ * - nodes: An integer representing the number of nodes.
+ * - arcs: An integer representing the number of arcs.
+ * - offsets: A pointer to nodes + 1 arc offsets.
+ * - heads: A pointer to the node every arc enters.
+ * - reverse: A pointer to the paired reverse arc of every arc.
+ * - capacity: A pointer to the capacity of every arc.
+ * - residual: A pointer to the residual capacity of every arc, which
+ *   holds the flow the solve starts from.
+ *
+ * Preconditions:
+ * - Every array holds as many entries as its size describes.
+ *
+ * Postconditions:
+ * - A new instance of the CsrNetworkView class is created.
+ * - An exception is thrown if the arrays do not describe a paired
+ *   network.
+ */
+CsrNetworkView::CsrNetworkView(int nodes,
+                               int arcs,
+                               const int *offsets,
+                               const int *heads,
+                               const int *reverse,
+                               long long *capacity,
+                               long long *residual)
+    : nodes(nodes),
+      arcs(arcs),
+      offsets(offsets),
+      heads(heads),
+      reverse(reverse),
+      capacity(capacity),
+      residual(residual)
+{
+    // Check if the offsets cover exactly the arcs
+    bool valid = nodes >= 0 && arcs >= 0 && offsets != nullptr &&
+                 (arcs == 0 || (heads != nullptr && reverse != nullptr &&
+                                capacity != nullptr && residual != nullptr));
+    valid = valid && offsets[0] == 0 && offsets[nodes] == arcs;
+    for (int node = 0; valid && node < nodes; ++node)
+    {
+        valid = offsets[node] <= offsets[node + 1];
+    }
+
+    // Check if every reverse arc leads back to the tail of its arc
+    for (int tail = 0; valid && tail < nodes; ++tail)
+    {
+        for (int arc = offsets[tail]; valid && arc < offsets[tail + 1];
+             ++arc)
+        {
+            int back = reverse[arc];
+            valid = heads[arc] >= 0 && heads[arc] < nodes &&
+                    back >= 0 && back < arcs && back != arc &&
+                    reverse[back] == arc && heads[back] == tail &&
+                    back >= offsets[heads[arc]] &&
+                    back < offsets[heads[arc] + 1];
+        }
+    }
+    if (!valid)
+    {
+        std::cerr << "ERROR: CSR network is Invalid." << std::endl;
+        throw std::invalid_argument("CSR network is Invalid.");
+    }
+}
+
+/**
+ * Set the capacity of an arc.
+ *
+ * Method Name: setCapacity
+ *
+ * Purpose: Changes the capacity of the arc while keeping its flow, so
+ * the residual capacity may become negative.
+ *
+ * Parameters:
+ * - arc: The index of the arc.
+ * - value: The new capacity.
+ *
+ * Preconditions:
+ * - The arc is within the valid range.
+ *
+ * Postconditions:
+ * - The capacity and residual capacity of the arc are updated.
+ */
+void CsrNetworkView::setCapacity(int arc, long long value)
+{
+    residual[arc] += value - capacity[arc];
+    capacity[arc] = value;
+}
+
+/**
+ * Find the arc between two nodes.
+ *
+ * Method Name: findArc
+ *
+ * Purpose: Returns the arc leaving tail and entering head.
+ *
+ * Parameters:
+ * - tail: An integer representing the node the arc leaves.
+ * - head: An integer representing the node the arc enters.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The index of the arc is returned.
+ *
+ * Returns: The index of the arc, -1 if there is none.
+ */
+int CsrNetworkView::findArc(int tail, int head) const
+{
+    // Check if the tail is within valid range
+    if (tail < 0 || tail >= nodes)
+    {
+        return -1;
+    }
+
+    // Scan the arcs of the tail for the head
+    for (int arc = offsets[tail]; arc < offsets[tail + 1]; ++arc)
+    {
+        if (heads[arc] == head)
+        {
+            return arc;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Remove all flow from the network.
+ *
+ * Method Name: resetFlow
+ *
+ * Purpose: Sets every residual capacity back to the capacity.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The network carries no flow.
+ */
+void CsrNetworkView::resetFlow()
+{
+    for (int arc = 0; arc < arcs; ++arc)
+    {
+        residual[arc] = capacity[arc];
+    }
+}
@@ -0,0 +1,344 @@
+/*
+ * File: CsrNetworkView.h Author: Nicolas Gioanni Purpose: Declaration
+ * of the CsrNetworkView class for solving a residual flow network that
+ * lives in CSR arrays owned by the caller, without copying it.
+ *
+ * Functionality/Features:
+ * - Declare methods for wrapping caller arrays given as pointer and
+ *   size, checked once when the view is made.
+ * - Declare the same arc methods as FlowNetwork, so the engines that
+ *   are templates over their network run on the view unchanged.
+ *
+ * Assumptions:
+ * - A network type for the engines provides getNodes, getArcs,
+ *   arcBegin, arcEnd, getHead, getReverse, getResidual, getCapacity,
+ *   getFlow, push, setCapacity, findArc and resetFlow with the meaning
+ *   they have in FlowNetwork.
+ * - The caller keeps the arrays alive and unchanged in size while the
+ *   view is used. The flow is written straight into the residual
+ *   array of the caller.
+ */
+
+#ifndef CSRNETWORKVIEW_H
+#define CSRNETWORKVIEW_H
+
+class CsrNetworkView
+{
+public:
+    /**
+     * Constructor for the CsrNetworkView class.
+     *
+     * Method Name: CsrNetworkView
+     *
+     * Purpose: Wraps caller-owned CSR arrays and checks that every arc
+     * is paired with a reverse arc that leads back.
+     *
+     * Parameters:
+     * - nodes: An integer representing the number of nodes.
+     * - arcs: An integer representing the number of arcs.
+     * - offsets: A pointer to nodes + 1 arc offsets.
+     * - heads: A pointer to the node every arc enters.
+     * - reverse: A pointer to the paired reverse arc of every arc.
+     * - capacity: A pointer to the capacity of every arc.
+     * - residual: A pointer to the residual capacity of every arc,
+     *   which holds the flow the solve starts from.
+     *
+     * Preconditions:
+     * - Every array holds as many entries as its size describes.
+     *
+     * Postconditions:
+     * - A new instance of the CsrNetworkView class is created.
+     * - An exception is thrown if the arrays do not describe a paired
+     *   network.
+     */
+    CsrNetworkView(int nodes,
+                   int arcs,
+                   const int *offsets,
+                   const int *heads,
+                   const int *reverse,
+                   long long *capacity,
+                   long long *residual);
+
+    /**
+     * Get the number of nodes in the network.
+     *
+     * Method Name: getNodes
+     *
+     * Purpose: Returns the number of nodes in the network.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The number of nodes is returned.
+     *
+     * Returns: An integer representing the number of nodes.
+     */
+    int getNodes() const { return nodes; }
+
+    /**
+     * Get the number of arcs in the network.
+     *
+     * Method Name: getArcs
+     *
+     * Purpose: Returns the number of arcs, reverse arcs included.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The number of arcs is returned.
+     *
+     * Returns: An integer representing the number of arcs.
+     */
+    int getArcs() const { return arcs; }
+
+    /**
+     * Get the first arc of a node.
+     *
+     * Method Name: arcBegin
+     *
+     * Purpose: Returns the index of the first arc leaving the node.
+     *
+     * Parameters:
+     * - node: An integer representing the node.
+     *
+     * Preconditions:
+     * - The node is within the valid range.
+     *
+     * Postconditions:
+     * - The index is returned.
+     *
+     * Returns: The index of the first arc of the node.
+     */
+    int arcBegin(int node) const { return offsets[node]; }
+
+    /**
+     * Get the end of the arcs of a node.
+     *
+     * Method Name: arcEnd
+     *
+     * Purpose: Returns one past the index of the last arc leaving the
+     * node.
+     *
+     * Parameters:
+     * - node: An integer representing the node.
+     *
+     * Preconditions:
+     * - The node is within the valid range.
+     *
+     * Postconditions:
+     * - The index is returned.
+     *
+     * Returns: One past the last arc of the node.
+     */
+    int arcEnd(int node) const { return offsets[node + 1]; }
+
+    /**
+     * Get the head of an arc.
+     *
+     * Method Name: getHead
+     *
+     * Purpose: Returns the node the arc enters.
+     *
+     * Parameters:
+     * - arc: The index of the arc.
+     *
+     * Preconditions:
+     * - The arc is within the valid range.
+     *
+     * Postconditions:
+     * - The head is returned.
+     *
+     * Returns: The node the arc enters.
+     */
+    int getHead(int arc) const { return heads[arc]; }
+
+    /**
+     * Get the reverse of an arc.
+     *
+     * Method Name: getReverse
+     *
+     * Purpose: Returns the paired arc that runs the other way.
+     *
+     * Parameters:
+     * - arc: The index of the arc.
+     *
+     * Preconditions:
+     * - The arc is within the valid range.
+     *
+     * Postconditions:
+     * - The reverse arc is returned.
+     *
+     * Returns: The index of the reverse arc.
+     */
+    int getReverse(int arc) const { return reverse[arc]; }
+
+    /**
+     * Get the residual capacity of an arc.
+     *
+     * Method Name: getResidual
+     *
+     * Purpose: Returns how much more flow the arc can carry.
+     *
+     * Parameters:
+     * - arc: The index of the arc.
+     *
+     * Preconditions:
+     * - The arc is within the valid range.
+     *
+     * Postconditions:
+     * - The residual capacity is returned.
+     *
+     * Returns: The residual capacity of the arc.
+     */
+    long long getResidual(int arc) const { return residual[arc]; }
+
+    /**
+     * Get the capacity of an arc.
+     *
+     * Method Name: getCapacity
+     *
+     * Purpose: Returns the capacity of the arc.
+     *
+     * Parameters:
+     * - arc: The index of the arc.
+     *
+     * Preconditions:
+     * - The arc is within the valid range.
+     *
+     * Postconditions:
+     * - The capacity is returned.
+     *
+     * Returns: The capacity of the arc.
+     */
+    long long getCapacity(int arc) const { return capacity[arc]; }
+
+    /**
+     * Get the flow on an arc.
+     *
+     * Method Name: getFlow
+     *
+     * Purpose: Returns the flow on the arc, which is negative when the
+     * flow runs along the reverse arc.
+     *
+     * Parameters:
+     * - arc: The index of the arc.
+     *
+     * Preconditions:
+     * - The arc is within the valid range.
+     *
+     * Postconditions:
+     * - The flow is returned.
+     *
+     * Returns: The flow on the arc.
+     */
+    long long getFlow(int arc) const
+    {
+        return capacity[arc] - residual[arc];
+    }
+
+    /**
+     * Push flow along an arc.
+     *
+     * Method Name: push
+     *
+     * Purpose: Moves residual capacity from the arc to its reverse arc
+     * in the arrays of the caller.
+     *
+     * Parameters:
+     * - arc: The index of the arc.
+     * - amount: The amount of flow to push.
+     *
+     * Preconditions:
+     * - The amount does not exceed the residual capacity of the arc.
+     *
+     * Postconditions:
+     * - The flow on the arc is increased by the amount.
+     */
+    void push(int arc, long long amount)
+    {
+        residual[arc] -= amount;
+        residual[reverse[arc]] += amount;
+    }
+
+    /**
+     * Set the capacity of an arc.
+     *
+     * Method Name: setCapacity
+     *
+     * Purpose: Changes the capacity of the arc while keeping its flow,
+     * so the residual capacity may become negative.
+     *
+     * Parameters:
+     * - arc: The index of the arc.
+     * - value: The new capacity.
+     *
+     * Preconditions:
+     * - The arc is within the valid range.
+     *
+     * Postconditions:
+     * - The capacity and residual capacity of the arc are updated.
+     */
+    void setCapacity(int arc, long long value);
+
+    /**
+     * Find the arc between two nodes.
+     *
+     * Method Name: findArc
+     *
+     * Purpose: Returns the arc leaving tail and entering head.
+     *
+     * Parameters:
+     * - tail: An integer representing the node the arc leaves.
+     * - head: An integer representing the node the arc enters.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The index of the arc is returned.
+     *
+     * Returns: The index of the arc, -1 if there is none.
+     */
+    int findArc(int tail, int head) const;
+
+    /**
+     * Remove all flow from the network.
+     *
+     * Method Name: resetFlow
+     *
+     * Purpose: Sets every residual capacity back to the capacity.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The network carries no flow.
+     */
+    void resetFlow();
+
+private:
+    // The number of nodes
+    int nodes;
+
+    // The number of arcs, reverse arcs included
+    int arcs;
+
+    // The first arc of every node, with one extra entry at the end
+    const int *offsets;
+
+    // The node every arc enters
+    const int *heads;
+
+    // The paired reverse arc of every arc
+    const int *reverse;
+
+    // The capacity of every arc
+    long long *capacity;
+
+    // The residual capacity of every arc
+    long long *residual;
+};
+
+#endif
@@ -0,0 +1,187 @@
+/*
+ * File: DagPathCover.cpp Author: Nicolas Gioanni Purpose:
+ * Implementation of the DagPathCover class, providing methods for
+ * covering a DAG with the fewest vertex-disjoint chains.
+ *
+ * Functionality/Features:
+ * - Build the adjacency of the DAG with a counting sort and check it
+ *   for cycles.
+ * - Solve the split graph with the Hopcroft-Karp engine.
+ * - Stitch the matched pairs into chains in linear time.
+ *
+ * Assumptions:
+ * - Every node has at most one matched successor and one matched
+ *   predecessor, and the graph has no cycle, so the matched pairs form
+ *   simple paths.
+ */
+
+#include "DagPathCover.h"
+#include <iostream>
+#include <stdexcept>
+
+/**
+ * Constructor for the DagPathCover class.
+ *
+ * Method Name: DagPathCover
+ *
+ * Purpose: Builds the adjacency of the DAG and checks that it has no
+ * cycle.
+ *
+ * Parameters:
+ * - nodes: An integer representing the number of nodes.
+ * - arcs: A constant reference to the arcs (u, v) of the DAG.
+ *
+ * Preconditions:
+ * - Every node index is within the range of the nodes.
+ *
+ * Postconditions:
+ * - The matching engine is set up on the split graph.
+ * - An exception is thrown if an arc is invalid or the graph has a
+ *   cycle.
+ */
+DagPathCover::DagPathCover(int nodes,
+                           const std::vector<std::pair<int, int>> &arcs)
+    : nodes(nodes)
+{
+    // Check if every arc is within range
+    if (nodes < 0)
+    {
+        std::cerr << "ERROR: Node count is Invalid." << std::endl;
+        throw std::invalid_argument("Node count is Invalid.");
+    }
+    for (const std::pair<int, int> &arc : arcs)
+    {
+        if (arc.first < 0 || arc.first >= nodes ||
+            arc.second < 0 || arc.second >= nodes)
+        {
+            std::cerr << "ERROR: Arc is out of valid range." << std::endl;
+            throw std::out_of_range("Arc is out of valid range.");
+        }
+    }
+
+    // Group the arcs by tail with a counting sort
+    std::vector<int> offsets(nodes + 1, 0);
+    for (const std::pair<int, int> &arc : arcs)
+    {
+        ++offsets[arc.first + 1];
+    }
+    for (int node = 0; node < nodes; ++node)
+    {
+        offsets[node + 1] += offsets[node];
+    }
+    std::vector<int> targets(arcs.size());
+    std::vector<int> position(offsets.begin(), offsets.end() - 1);
+    for (const std::pair<int, int> &arc : arcs)
+    {
+        targets[position[arc.first]++] = arc.second;
+    }
+
+    // Remove nodes without predecessors until none is left
+    std::vector<int> inDegree(nodes, 0);
+    for (int target : targets)
+    {
+        ++inDegree[target];
+    }
+    std::vector<int> queue;
+    queue.reserve(nodes);
+    for (int node = 0; node < nodes; ++node)
+    {
+        if (inDegree[node] == 0)
+        {
+            queue.push_back(node);
+        }
+    }
+    for (size_t front = 0; front < queue.size(); ++front)
+    {
+        int node = queue[front];
+        for (int edge = offsets[node]; edge < offsets[node + 1]; ++edge)
+        {
+            if (--inDegree[targets[edge]] == 0)
+            {
+                queue.push_back(targets[edge]);
+            }
+        }
+    }
+    if (static_cast<int>(queue.size()) != nodes)
+    {
+        std::cerr << "ERROR: Graph has a cycle." << std::endl;
+        throw std::invalid_argument("Graph has a cycle.");
+    }
+
+    // The left adjacency of the split graph is the DAG adjacency
+    matcher = std::make_unique<HopcroftKarp>(nodes, nodes, offsets, targets);
+}
+
+/**
+ * Calculates the minimum path cover.
+ *
+ * Method Name: solve
+ *
+ * Purpose: Matches the split graph and stitches every matched pair
+ * (u, v) into a chain where v follows u.
+ *
+ * Returns: The number of chains.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The chains are stored.
+ * - An exception is thrown if solving fails.
+ */
+int DagPathCover::solve()
+{
+    try
+    {
+        int matched = matcher->calculateMaxMatching();
+        const std::vector<int> &next = matcher->getLeftMatch();
+        const std::vector<int> &previous = matcher->getRightMatch();
+
+        // Every node without a matched predecessor starts a chain
+        chains.clear();
+        chains.reserve(nodes - matched);
+        for (int node = 0; node < nodes; ++node)
+        {
+            if (previous[node] != -1)
+            {
+                continue;
+            }
+            chains.emplace_back();
+            for (int current = node; current != -1; current = next[current])
+            {
+                chains.back().push_back(current);
+            }
+        }
+        return static_cast<int>(chains.size());
+    }
+    catch (const std::exception &e)
+    {
+        // Output an error message if the cover cannot be found
+        std::cerr
+            << "ERROR: Error in solve: "
+            << e.what()
+            << std::endl;
+        throw std::runtime_error("Error in solve: " +
+                                 std::string(e.what()));
+    }
+}
+
+/**
+ * Get the chains of the cover.
+ *
+ * Method Name: getChains
+ *
+ * Purpose: Returns the chains found by solve.
+ *
+ * Preconditions:
+ * - solve was called.
+ *
+ * Postconditions:
+ * - The chains are returned.
+ *
+ * Returns: The nodes of every chain in path order.
+ */
+const std::vector<std::vector<int>> &DagPathCover::getChains() const
+{
+    return chains;
+}
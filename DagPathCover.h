@@ -0,0 +1,98 @@
+/*
+ * File: DagPathCover.h Author: Nicolas Gioanni Purpose: Declaration of
+ * the DagPathCover class for covering the nodes of a directed acyclic
+ * graph with the fewest vertex-disjoint chains.
+ *
+ * Functionality/Features:
+ * - Declare methods for calculating the minimum path cover as the node
+ *   count minus a maximum matching of the split bipartite graph.
+ * - Declare methods for reading the chains of the cover.
+ *
+ * Assumptions:
+ * - The split graph has a left and a right copy of every node and an
+ *   edge from the left copy of u to the right copy of v for every arc
+ *   (u, v). Its left adjacency is the adjacency of the DAG itself, so
+ *   it is never built as a separate graph.
+ */
+
+#ifndef DAGPATHCOVER_H
+#define DAGPATHCOVER_H
+
+#include "HopcroftKarp.h"
+#include <memory>
+#include <utility>
+#include <vector>
+
+class DagPathCover
+{
+public:
+    /**
+     * Constructor for the DagPathCover class.
+     *
+     * Method Name: DagPathCover
+     *
+     * Purpose: Builds the adjacency of the DAG and checks that it has
+     * no cycle.
+     *
+     * Parameters:
+     * - nodes: An integer representing the number of nodes.
+     * - arcs: A constant reference to the arcs (u, v) of the DAG.
+     *
+     * Preconditions:
+     * - Every node index is within the range of the nodes.
+     *
+     * Postconditions:
+     * - The matching engine is set up on the split graph.
+     * - An exception is thrown if an arc is invalid or the graph has a
+     *   cycle.
+     */
+    DagPathCover(int nodes, const std::vector<std::pair<int, int>> &arcs);
+
+    /**
+     * Calculates the minimum path cover.
+     *
+     * Method Name: solve
+     *
+     * Purpose: Matches the split graph and stitches every matched pair
+     * (u, v) into a chain where v follows u.
+     *
+     * Returns: The number of chains.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The chains are stored.
+     * - An exception is thrown if solving fails.
+     */
+    int solve();
+
+    /**
+     * Get the chains of the cover.
+     *
+     * Method Name: getChains
+     *
+     * Purpose: Returns the chains found by solve.
+     *
+     * Preconditions:
+     * - solve was called.
+     *
+     * Postconditions:
+     * - The chains are returned.
+     *
+     * Returns: The nodes of every chain in path order.
+     */
+    const std::vector<std::vector<int>> &getChains() const;
+
+private:
+    // The number of nodes
+    int nodes;
+
+    // The matching engine on the split graph
+    std::unique_ptr<HopcroftKarp> matcher;
+
+    // The chains of the last cover
+    std::vector<std::vector<int>> chains;
+};
+
+#endif
@@ -0,0 +1,769 @@
+/*
+ * File: DiskAdjacency.cpp Author: Nicolas Gioanni Purpose:
+ * Implementation of the DiskAdjacency class, providing methods for
+ * writing, reading and updating a file-resident CSR arc file.
+ *
+ * Functionality/Features:
+ * - Write arc files from a Graph or from an edge list file.
+ * - Read arcs through a least-recently-used cache of aligned blocks.
+ * - Update residual capacities with write-back of dirty blocks.
+ *
+ * Assumptions:
+ * - The file layout is an 8-byte magic, the node and arc counts, the
+ *   node offsets, padding up to a 4096-byte boundary and then the
+ *   arc records in node order.
+ */
+
+#include "DiskAdjacency.h"
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <cstring>
+
+namespace
+{
+    // The magic string at the start of every arc file
+    const char arcFileMagic[8] = {'N', 'F', 'O', 'C', 'S', 'R', '0', '1'};
+
+    // The alignment of the arc region and of every block
+    const long long blockAlignment = 4096;
+
+    // The number of records that fill a whole number of aligned pages
+    const long long recordsPerAlignment = 512;
+
+    // Returns the byte position of the first arc record
+    long long arcRegionStart(int nodes)
+    {
+        long long headerBytes = sizeof(arcFileMagic) +
+                                2 * sizeof(long long) +
+                                (nodes + 1) * sizeof(long long);
+        return (headerBytes + blockAlignment - 1) /
+               blockAlignment * blockAlignment;
+    }
+
+    // The number of arcs of one bucket of the edge list conversion,
+    // which is filled in memory and written once
+    const long long bucketArcs = 1 << 20;
+
+    // The number of records staged in memory per bucket before they
+    // are appended to its file
+    const size_t stagedRecords = 512;
+
+    // An arc record together with its final position in the arc file
+    struct PlacedArc
+    {
+        // The index of the arc in the arc file
+        long long position;
+
+        // The arc record
+        DiskArc arc;
+    };
+
+    // Returns the name of the temporary file of a bucket
+    std::string bucketFilename(const std::string &filename, size_t bucket)
+    {
+        return filename + ".bucket" + std::to_string(bucket);
+    }
+
+    // Appends the staged records of a bucket to its file
+    void appendBucket(const std::string &filename,
+                      size_t bucket,
+                      std::vector<PlacedArc> &staged)
+    {
+        std::ofstream output(bucketFilename(filename, bucket),
+                             std::ios::binary | std::ios::app);
+        output.write(reinterpret_cast<const char *>(staged.data()),
+                     staged.size() * sizeof(PlacedArc));
+        if (!output)
+        {
+            std::cerr << "ERROR: Writing a bucket file failed." << std::endl;
+            throw std::runtime_error("Writing a bucket file failed.");
+        }
+        staged.clear();
+    }
+}
+
+/**
+ * Constructor for the DiskAdjacency class.
+ *
+ * Method Name: DiskAdjacency
+ *
+ * Purpose: Opens an arc file written by build or buildFromEdgeList and
+ * loads the node offsets into memory.
+ *
+ * Parameters:
+ * - filename: A constant reference to a string representing the name
+ *   of the arc file.
+ * - blockArcs: The number of arcs per cached block. It is rounded up
+ *   to a multiple of 512 so blocks stay 4096-byte aligned.
+ * - cachedBlocks: The number of blocks kept in memory at once.
+ *
+ * Preconditions:
+ * - The file exists and was written by this class.
+ *
+ * Postconditions:
+ * - The offsets are loaded and the block cache is empty.
+ * - An exception is thrown if the file cannot be opened or is not an
+ *   arc file.
+ */
+DiskAdjacency::DiskAdjacency(const std::string &filename,
+                             long long blockArcs,
+                             int cachedBlocks)
+    : nodes(0), arcs(0), arcStart(0), blockArcs(0), tick(0)
+{
+    // Open the arc file for reading and writing
+    file.open(filename,
+              std::ios::in | std::ios::out | std::ios::binary);
+    if (!file.is_open())
+    {
+        std::cerr << "ERROR: Error opening the arc file." << std::endl;
+        throw std::runtime_error("Error opening the arc file.");
+    }
+
+    // Check the magic string and read the counts
+    char magic[sizeof(arcFileMagic)];
+    long long nodeCount = 0;
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char *>(&nodeCount), sizeof(nodeCount));
+    file.read(reinterpret_cast<char *>(&arcs), sizeof(arcs));
+    if (!file ||
+        std::memcmp(magic, arcFileMagic, sizeof(magic)) != 0 ||
+        nodeCount < 0 ||
+        arcs < 0)
+    {
+        std::cerr << "ERROR: File is not an arc file." << std::endl;
+        throw std::runtime_error("File is not an arc file.");
+    }
+    nodes = static_cast<int>(nodeCount);
+
+    // Load the node offsets, which is the only per-node state kept
+    offsets.resize(nodes + 1);
+    file.read(reinterpret_cast<char *>(offsets.data()),
+              offsets.size() * sizeof(long long));
+    if (!file || offsets[nodes] != arcs)
+    {
+        std::cerr << "ERROR: Arc file offsets are corrupt." << std::endl;
+        throw std::runtime_error("Arc file offsets are corrupt.");
+    }
+    arcStart = arcRegionStart(nodes);
+
+    // Round the block size to whole aligned pages
+    if (blockArcs < 1 || cachedBlocks < 1)
+    {
+        std::cerr
+            << "ERROR: Block size and cache size must be positive."
+            << std::endl;
+        throw std::
+            invalid_argument("Block size and cache size must be positive.");
+    }
+    this->blockArcs = (blockArcs + recordsPerAlignment - 1) /
+                      recordsPerAlignment * recordsPerAlignment;
+
+    // Set up the empty cache
+    long long blocks = (arcs + this->blockArcs - 1) / this->blockArcs;
+    slotOfBlock.assign(blocks, -1);
+    cache.resize(cachedBlocks);
+    for (CachedBlock &slot : cache)
+    {
+        slot.block = -1;
+        slot.dirty = false;
+        slot.lastUse = 0;
+    }
+}
+
+/**
+ * Destructor for the DiskAdjacency class.
+ *
+ * Method Name: ~DiskAdjacency
+ *
+ * Purpose: Writes every dirty block back to the arc file.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - All residual updates are stored in the file.
+ */
+DiskAdjacency::~DiskAdjacency()
+{
+    try
+    {
+        flush();
+    }
+    catch (const std::exception &e)
+    {
+        // Destructors must not throw, so only report the failure
+        std::cerr
+            << "ERROR: Error flushing the arc file: "
+            << e.what()
+            << std::endl;
+    }
+}
+
+/**
+ * Writes the arc file for a graph held in memory.
+ *
+ * Method Name: build
+ *
+ * Purpose: Converts the adjacency matrix of the graph into a CSR arc
+ * file, pairing every arc with its reverse arc.
+ *
+ * Parameters:
+ * - graph: A constant reference to the graph to convert.
+ * - filename: A constant reference to a string representing the name
+ *   of the arc file to write.
+ *
+ * Preconditions:
+ * - The graph is initialized with valid capacities.
+ *
+ * Postconditions:
+ * - The arc file is written in node order.
+ * - An exception is thrown if the file cannot be written.
+ */
+void DiskAdjacency::build(const Graph &graph, const std::string &filename)
+{
+    const std::vector<std::vector<int>> &matrix =
+        graph.getAdjacencyMatrix();
+    int totalNodes = graph.getNodes();
+
+    // Every node pair with capacity in either direction is one arc
+    // pair, with one arc stored at each end
+    std::vector<long long> offsets(totalNodes + 1, 0);
+    for (int u = 0; u < totalNodes; ++u)
+    {
+        for (int v = 0; v < totalNodes; ++v)
+        {
+            if (u != v && (matrix[u][v] > 0 || matrix[v][u] > 0))
+            {
+                offsets[u + 1]++;
+            }
+        }
+    }
+    for (int u = 0; u < totalNodes; ++u)
+    {
+        offsets[u + 1] += offsets[u];
+    }
+    writeLayout(filename, offsets);
+
+    std::ofstream output(filename,
+                         std::ios::in | std::ios::out | std::ios::binary);
+    if (!output.is_open())
+    {
+        std::cerr << "ERROR: Error opening the arc file." << std::endl;
+        throw std::runtime_error("Error opening the arc file.");
+    }
+    output.seekp(arcRegionStart(totalNodes));
+
+    // The neighbors of every node are written in increasing order, so
+    // when u is visited in increasing order the arc (v, u) is always
+    // the next unclaimed arc of v
+    std::vector<long long> reverseFill(offsets.begin(), offsets.end() - 1);
+    for (int u = 0; u < totalNodes; ++u)
+    {
+        for (int v = 0; v < totalNodes; ++v)
+        {
+            if (u != v && (matrix[u][v] > 0 || matrix[v][u] > 0))
+            {
+                DiskArc record;
+                record.residual = matrix[u][v] > 0 ? matrix[u][v] : 0;
+                record.reverse = reverseFill[v]++;
+                record.head = v;
+                record.reserved = 0;
+                output.write(reinterpret_cast<const char *>(&record),
+                             sizeof(record));
+            }
+        }
+    }
+
+    if (!output)
+    {
+        std::cerr << "ERROR: Writing the arc file failed." << std::endl;
+        throw std::runtime_error("Writing the arc file failed.");
+    }
+}
+
+/**
+ * Writes the arc file for a graph stored as an edge list file.
+ *
+ * Method Name: buildFromEdgeList
+ *
+ * Purpose: Converts an edge list file into a CSR arc file without
+ * holding the edges in memory. One pass counts the arcs of every node,
+ * a second sorts the arcs by final position into temporary bucket
+ * files, and a third fills every bucket in memory and writes it once.
+ *
+ * Parameters:
+ * - edgeFilename: A constant reference to a string representing the
+ *   name of the edge list file. The first line holds the number of
+ *   nodes, every other line holds "tail head capacity".
+ * - filename: A constant reference to a string representing the name
+ *   of the arc file to write.
+ *
+ * Preconditions:
+ * - The edge list file exists and is correctly formatted.
+ *
+ * Postconditions:
+ * - The arc file is written.
+ * - An exception is thrown if either file cannot be processed.
+ */
+void DiskAdjacency::buildFromEdgeList(const std::string &edgeFilename,
+                                      const std::string &filename)
+{
+    std::ifstream input(edgeFilename);
+    if (!input.is_open())
+    {
+        std::cerr << "ERROR: Error opening the edge file." << std::endl;
+        throw std::runtime_error("Error opening the edge file.");
+    }
+
+    // Read the number of nodes
+    std::string line;
+    int totalNodes = 0;
+    if (!std::getline(input, line) ||
+        (totalNodes = std::stoi(line)) < 1)
+    {
+        std::cerr
+            << "ERROR: Reading number of nodes failed."
+            << std::endl;
+        throw std::runtime_error("Reading number of nodes failed.");
+    }
+
+    // First pass: count the arcs at every node
+    std::vector<long long> offsets(totalNodes + 1, 0);
+    while (std::getline(input, line))
+    {
+        std::istringstream ss(line);
+        int tail, head;
+        long long capacity;
+        if (!(ss >> tail >> head >> capacity))
+        {
+            continue;
+        }
+        if (tail < 0 || tail >= totalNodes ||
+            head < 0 || head >= totalNodes ||
+            capacity < 0)
+        {
+            std::cerr << "ERROR: Edge is Invalid." << std::endl;
+            throw std::invalid_argument("Edge is Invalid.");
+        }
+        offsets[tail + 1]++;
+        offsets[head + 1]++;
+    }
+    for (int u = 0; u < totalNodes; ++u)
+    {
+        offsets[u + 1] += offsets[u];
+    }
+    writeLayout(filename, offsets);
+
+    // Second pass: sort every arc and its reverse arc into the bucket
+    // of its final position, so no arc is written into the file alone
+    input.clear();
+    input.seekg(0);
+    std::getline(input, line);
+    long long totalArcs = offsets[totalNodes];
+    size_t buckets =
+        static_cast<size_t>((totalArcs + bucketArcs - 1) / bucketArcs);
+    std::vector<std::vector<PlacedArc>> staged(buckets);
+    std::vector<long long> fill(offsets.begin(), offsets.end() - 1);
+    try
+    {
+        while (std::getline(input, line))
+        {
+            std::istringstream ss(line);
+            int tail, head;
+            long long capacity;
+            if (!(ss >> tail >> head >> capacity))
+            {
+                continue;
+            }
+            long long forward = fill[tail]++;
+            long long backward = fill[head]++;
+            PlacedArc placed[2] = {{forward, {capacity, backward, head, 0}},
+                                   {backward, {0, forward, tail, 0}}};
+            for (const PlacedArc &arc : placed)
+            {
+                size_t bucket = static_cast<size_t>(arc.position / bucketArcs);
+                staged[bucket].push_back(arc);
+                if (staged[bucket].size() == stagedRecords)
+                {
+                    appendBucket(filename, bucket, staged[bucket]);
+                }
+            }
+        }
+        for (size_t bucket = 0; bucket < buckets; ++bucket)
+        {
+            if (!staged[bucket].empty())
+            {
+                appendBucket(filename, bucket, staged[bucket]);
+            }
+        }
+        staged.clear();
+
+        // Third pass: fill every bucket in memory with one sequential
+        // read of its file and write it to the arc file in one piece
+        std::ofstream output(filename,
+                             std::ios::in | std::ios::out | std::ios::binary);
+        if (!output.is_open())
+        {
+            std::cerr << "ERROR: Error opening the arc file." << std::endl;
+            throw std::runtime_error("Error opening the arc file.");
+        }
+        std::vector<DiskArc> arcs;
+        std::vector<PlacedArc> chunk(stagedRecords);
+        for (size_t bucket = 0; bucket < buckets; ++bucket)
+        {
+            long long first = static_cast<long long>(bucket) * bucketArcs;
+            long long count = std::min(bucketArcs, totalArcs - first);
+            arcs.assign(count, DiskArc{0, 0, 0, 0});
+
+            std::ifstream bucketInput(bucketFilename(filename, bucket),
+                                      std::ios::binary);
+            while (bucketInput.read(reinterpret_cast<char *>(chunk.data()),
+                                    chunk.size() * sizeof(PlacedArc)) ||
+                   bucketInput.gcount() > 0)
+            {
+                size_t read = static_cast<size_t>(bucketInput.gcount()) /
+                              sizeof(PlacedArc);
+                for (size_t i = 0; i < read; ++i)
+                {
+                    arcs[chunk[i].position - first] = chunk[i].arc;
+                }
+            }
+            bucketInput.close();
+            std::remove(bucketFilename(filename, bucket).c_str());
+
+            output.seekp(arcRegionStart(totalNodes) +
+                         first * static_cast<long long>(sizeof(DiskArc)));
+            output.write(reinterpret_cast<const char *>(arcs.data()),
+                         count * sizeof(DiskArc));
+        }
+        if (!output)
+        {
+            std::cerr << "ERROR: Writing the arc file failed." << std::endl;
+            throw std::runtime_error("Writing the arc file failed.");
+        }
+    }
+    catch (...)
+    {
+        // Leave no bucket files behind
+        for (size_t bucket = 0; bucket < buckets; ++bucket)
+        {
+            std::remove(bucketFilename(filename, bucket).c_str());
+        }
+        throw;
+    }
+}
+
+/**
+ * Get the number of nodes in the arc file.
+ *
+ * Method Name: getNodes
+ *
+ * Purpose: Returns the number of nodes in the arc file.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The number of nodes is returned.
+ *
+ * Returns: An integer representing the number of nodes.
+ */
+int DiskAdjacency::getNodes() const
+{
+    return nodes;
+}
+
+/**
+ * Get the first arc of a node.
+ *
+ * Method Name: arcBegin
+ *
+ * Purpose: Returns the index of the first arc leaving the node.
+ *
+ * Parameters:
+ * - node: An integer representing the node.
+ *
+ * Preconditions:
+ * - The node is within the valid range.
+ *
+ * Postconditions:
+ * - The index of the first arc is returned.
+ *
+ * Returns: The index of the first arc leaving the node.
+ */
+long long DiskAdjacency::arcBegin(int node) const
+{
+    return offsets[node];
+}
+
+/**
+ * Get the end of the arcs of a node.
+ *
+ * Method Name: arcEnd
+ *
+ * Purpose: Returns one past the index of the last arc leaving the
+ * node.
+ *
+ * Parameters:
+ * - node: An integer representing the node.
+ *
+ * Preconditions:
+ * - The node is within the valid range.
+ *
+ * Postconditions:
+ * - One past the index of the last arc is returned.
+ *
+ * Returns: One past the index of the last arc leaving the node.
+ */
+long long DiskAdjacency::arcEnd(int node) const
+{
+    return offsets[node + 1];
+}
+
+/**
+ * Read an arc record.
+ *
+ * Method Name: readArc
+ *
+ * Purpose: Returns the arc record with the given index, loading its
+ * block into the cache if needed.
+ *
+ * Parameters:
+ * - arc: The index of the arc.
+ *
+ * Preconditions:
+ * - The arc index is within the valid range.
+ *
+ * Postconditions:
+ * - The block holding the arc is cached.
+ *
+ * Returns: A copy of the arc record.
+ */
+DiskArc DiskAdjacency::readArc(long long arc)
+{
+    int slot = loadBlock(arc / blockArcs);
+    return cache[slot].arcs[arc % blockArcs];
+}
+
+/**
+ * Push flow along an arc.
+ *
+ * Method Name: pushFlow
+ *
+ * Purpose: Lowers the residual capacity of the arc and raises the
+ * residual capacity of its reverse arc by the given amount.
+ *
+ * Parameters:
+ * - arc: The index of the arc.
+ * - amount: The amount of flow to push.
+ *
+ * Preconditions:
+ * - The amount does not exceed the residual capacity of the arc.
+ *
+ * Postconditions:
+ * - Both blocks are marked dirty and written back when evicted.
+ */
+void DiskAdjacency::pushFlow(long long arc, long long amount)
+{
+    // Lower the residual capacity of the arc
+    int slot = loadBlock(arc / blockArcs);
+    DiskArc &forward = cache[slot].arcs[arc % blockArcs];
+    forward.residual -= amount;
+    cache[slot].dirty = true;
+    long long reverse = forward.reverse;
+
+    // Raise the residual capacity of the reverse arc
+    slot = loadBlock(reverse / blockArcs);
+    cache[slot].arcs[reverse % blockArcs].residual += amount;
+    cache[slot].dirty = true;
+}
+
+/**
+ * Write all dirty blocks back to the arc file.
+ *
+ * Method Name: flush
+ *
+ * Purpose: Writes all dirty blocks back to the arc file.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The file holds every residual update made so far.
+ * - An exception is thrown if writing fails.
+ */
+void DiskAdjacency::flush()
+{
+    for (int slot = 0; slot < static_cast<int>(cache.size()); ++slot)
+    {
+        if (cache[slot].block != -1 && cache[slot].dirty)
+        {
+            writeBlock(slot);
+        }
+    }
+    file.flush();
+}
+
+/**
+ * Get the cache slot holding a block.
+ *
+ * Method Name: loadBlock
+ *
+ * Purpose: Returns the cache slot of a block, evicting the least
+ * recently used block if the block is not cached yet.
+ *
+ * Parameters:
+ * - block: The index of the block.
+ *
+ * Preconditions:
+ * - The block index is within the valid range.
+ *
+ * Postconditions:
+ * - The block is cached.
+ * - An exception is thrown if reading or writing back fails.
+ *
+ * Returns: The cache slot of the block.
+ */
+int DiskAdjacency::loadBlock(long long block)
+{
+    // Return the slot directly if the block is cached
+    int slot = slotOfBlock[block];
+    if (slot != -1)
+    {
+        cache[slot].lastUse = ++tick;
+        return slot;
+    }
+
+    // Pick the least recently used slot as the victim
+    slot = 0;
+    for (int i = 1; i < static_cast<int>(cache.size()); ++i)
+    {
+        if (cache[i].lastUse < cache[slot].lastUse)
+        {
+            slot = i;
+        }
+    }
+    CachedBlock &victim = cache[slot];
+    if (victim.block != -1)
+    {
+        if (victim.dirty)
+        {
+            writeBlock(slot);
+        }
+        slotOfBlock[victim.block] = -1;
+    }
+
+    // Read the whole block with one aligned read
+    long long first = block * blockArcs;
+    long long count = std::min(blockArcs, arcs - first);
+    victim.arcs.resize(blockArcs);
+    file.clear();
+    file.seekg(arcStart + first * static_cast<long long>(sizeof(DiskArc)));
+    file.read(reinterpret_cast<char *>(victim.arcs.data()),
+              count * sizeof(DiskArc));
+    if (!file)
+    {
+        std::cerr << "ERROR: Reading an arc block failed." << std::endl;
+        throw std::runtime_error("Reading an arc block failed.");
+    }
+
+    victim.block = block;
+    victim.dirty = false;
+    victim.lastUse = ++tick;
+    slotOfBlock[block] = slot;
+    return slot;
+}
+
+/**
+ * Write a cached block back to the file.
+ *
+ * Method Name: writeBlock
+ *
+ * Purpose: Writes a dirty cached block back to the file.
+ *
+ * Parameters:
+ * - slot: The cache slot to write.
+ *
+ * Preconditions:
+ * - The slot holds a block.
+ *
+ * Postconditions:
+ * - The block is clean.
+ * - An exception is thrown if writing fails.
+ */
+void DiskAdjacency::writeBlock(int slot)
+{
+    CachedBlock &cached = cache[slot];
+    long long first = cached.block * blockArcs;
+    long long count = std::min(blockArcs, arcs - first);
+    file.clear();
+    file.seekp(arcStart + first * static_cast<long long>(sizeof(DiskArc)));
+    file.write(reinterpret_cast<const char *>(cached.arcs.data()),
+               count * sizeof(DiskArc));
+    if (!file)
+    {
+        std::cerr << "ERROR: Writing an arc block failed." << std::endl;
+        throw std::runtime_error("Writing an arc block failed.");
+    }
+    cached.dirty = false;
+}
+
+/**
+ * Write the header and node offsets of a new arc file.
+ *
+ * Method Name: writeLayout
+ *
+ * Purpose: Creates the arc file with its header, node offsets and a
+ * zeroed arc region.
+ *
+ * Parameters:
+ * - filename: A constant reference to a string representing the name
+ *   of the arc file.
+ * - offsets: A constant reference to the node offsets.
+ *
+ * Preconditions:
+ * - The offsets are non-decreasing and start at 0.
+ *
+ * Postconditions:
+ * - The file is created with room for every arc.
+ * - An exception is thrown if the file cannot be written.
+ */
+void DiskAdjacency::writeLayout(const std::string &filename,
+                                const std::vector<long long> &offsets)
+{
+    std::ofstream output(filename, std::ios::binary | std::ios::trunc);
+    if (!output.is_open())
+    {
+        std::cerr << "ERROR: Error creating the arc file." << std::endl;
+        throw std::runtime_error("Error creating the arc file.");
+    }
+
+    // Write the header and the offsets
+    long long nodeCount = static_cast<long long>(offsets.size()) - 1;
+    long long arcCount = offsets.back();
+    output.write(arcFileMagic, sizeof(arcFileMagic));
+    output.write(reinterpret_cast<const char *>(&nodeCount),
+                 sizeof(nodeCount));
+    output.write(reinterpret_cast<const char *>(&arcCount),
+                 sizeof(arcCount));
+    output.write(reinterpret_cast<const char *>(offsets.data()),
+                 offsets.size() * sizeof(long long));
+
+    // Extend the file to its full size so every block can be read
+    long long end = arcRegionStart(static_cast<int>(nodeCount)) +
+                    arcCount * static_cast<long long>(sizeof(DiskArc));
+    if (end > output.tellp())
+    {
+        output.seekp(end - 1);
+        output.put('\0');
+    }
+
+    if (!output)
+    {
+        std::cerr << "ERROR: Writing the arc file failed." << std::endl;
+        throw std::runtime_error("Writing the arc file failed.");
+    }
+}
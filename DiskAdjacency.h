@@ -0,0 +1,365 @@
+/*
+ * File: DiskAdjacency.h Author: Nicolas Gioanni Purpose: Declaration
+ * of the DiskAdjacency class for storing the residual topology of a
+ * flow network in a file instead of in memory.
+ *
+ * Functionality/Features:
+ * - Declare methods for writing a CSR (compressed sparse row) arc
+ *   file from a Graph or from an edge list file.
+ * - Declare methods for opening an arc file and reading its arcs
+ *   through a cache of large aligned blocks.
+ * - Declare methods for updating residual capacities with write-back
+ *   of dirty blocks.
+ *
+ * Assumptions:
+ * - The per-node state (one offset per node) fits in memory, the
+ *   arcs do not have to.
+ * - Arcs of a node are stored contiguously and nodes are stored in
+ *   increasing order, so a scan over increasing nodes reads the file
+ *   sequentially.
+ */
+
+#ifndef DISKADJACENCY_H
+#define DISKADJACENCY_H
+
+#include "Graph.h"
+#include <fstream>
+#include <string>
+#include <vector>
+
+// A single arc record as it is laid out in the arc file
+struct DiskArc
+{
+    // The remaining capacity of the arc
+    long long residual;
+
+    // The index of the paired arc in the opposite direction
+    long long reverse;
+
+    // The node the arc points to
+    int head;
+
+    // Padding that keeps records 8-byte aligned
+    int reserved;
+};
+
+class DiskAdjacency
+{
+public:
+    /**
+     * Constructor for the DiskAdjacency class.
+     *
+     * Method Name: DiskAdjacency
+     *
+     * Purpose: Opens an arc file written by build or
+     * buildFromEdgeList and loads the node offsets into memory.
+     *
+     * Parameters:
+     * - filename: A constant reference to a string representing the
+     *   name of the arc file.
+     * - blockArcs: The number of arcs per cached block. It is rounded
+     *   up to a multiple of 512 so blocks stay 4096-byte aligned.
+     * - cachedBlocks: The number of blocks kept in memory at once.
+     *
+     * Preconditions:
+     * - The file exists and was written by this class.
+     *
+     * Postconditions:
+     * - The offsets are loaded and the block cache is empty.
+     * - An exception is thrown if the file cannot be opened or is not
+     *   an arc file.
+     */
+    DiskAdjacency(const std::string &filename,
+                  long long blockArcs = 1 << 16,
+                  int cachedBlocks = 64);
+
+    /**
+     * Destructor for the DiskAdjacency class.
+     *
+     * Method Name: ~DiskAdjacency
+     *
+     * Purpose: Writes every dirty block back to the arc file.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - All residual updates are stored in the file.
+     */
+    ~DiskAdjacency();
+
+    /**
+     * Writes the arc file for a graph held in memory.
+     *
+     * Method Name: build
+     *
+     * Purpose: Converts the adjacency matrix of the graph into a CSR
+     * arc file, pairing every arc with its reverse arc.
+     *
+     * Parameters:
+     * - graph: A constant reference to the graph to convert.
+     * - filename: A constant reference to a string representing the
+     *   name of the arc file to write.
+     *
+     * Preconditions:
+     * - The graph is initialized with valid capacities.
+     *
+     * Postconditions:
+     * - The arc file is written in node order.
+     * - An exception is thrown if the file cannot be written.
+     */
+    static void build(const Graph &graph, const std::string &filename);
+
+    /**
+     * Writes the arc file for a graph stored as an edge list file.
+     *
+     * Method Name: buildFromEdgeList
+     *
+     * Purpose: Converts an edge list file into a CSR arc file without
+     * holding the edges in memory. One pass counts the arcs of every
+     * node, a second sorts the arcs by final position into temporary
+     * bucket files next to the arc file, and a third fills every bucket
+     * in memory and writes it once.
+     *
+     * Parameters:
+     * - edgeFilename: A constant reference to a string representing
+     *   the name of the edge list file. The first line holds the
+     *   number of nodes, every other line holds "tail head capacity".
+     * - filename: A constant reference to a string representing the
+     *   name of the arc file to write.
+     *
+     * Preconditions:
+     * - The edge list file exists and is correctly formatted.
+     *
+     * Postconditions:
+     * - The arc file is written.
+     * - An exception is thrown if either file cannot be processed.
+     */
+    static void buildFromEdgeList(const std::string &edgeFilename,
+                                  const std::string &filename);
+
+    /**
+     * Get the number of nodes in the arc file.
+     *
+     * Method Name: getNodes
+     *
+     * Purpose: Returns the number of nodes in the arc file.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The number of nodes is returned.
+     *
+     * Returns: An integer representing the number of nodes.
+     */
+    int getNodes() const;
+
+    /**
+     * Get the first arc of a node.
+     *
+     * Method Name: arcBegin
+     *
+     * Purpose: Returns the index of the first arc leaving the node.
+     *
+     * Parameters:
+     * - node: An integer representing the node.
+     *
+     * Preconditions:
+     * - The node is within the valid range.
+     *
+     * Postconditions:
+     * - The index of the first arc is returned.
+     *
+     * Returns: The index of the first arc leaving the node.
+     */
+    long long arcBegin(int node) const;
+
+    /**
+     * Get the end of the arcs of a node.
+     *
+     * Method Name: arcEnd
+     *
+     * Purpose: Returns one past the index of the last arc leaving the
+     * node.
+     *
+     * Parameters:
+     * - node: An integer representing the node.
+     *
+     * Preconditions:
+     * - The node is within the valid range.
+     *
+     * Postconditions:
+     * - One past the index of the last arc is returned.
+     *
+     * Returns: One past the index of the last arc leaving the node.
+     */
+    long long arcEnd(int node) const;
+
+    /**
+     * Read an arc record.
+     *
+     * Method Name: readArc
+     *
+     * Purpose: Returns the arc record with the given index, loading
+     * its block into the cache if needed.
+     *
+     * Parameters:
+     * - arc: The index of the arc.
+     *
+     * Preconditions:
+     * - The arc index is within the valid range.
+     *
+     * Postconditions:
+     * - The block holding the arc is cached.
+     *
+     * Returns: A copy of the arc record.
+     */
+    DiskArc readArc(long long arc);
+
+    /**
+     * Push flow along an arc.
+     *
+     * Method Name: pushFlow
+     *
+     * Purpose: Lowers the residual capacity of the arc and raises the
+     * residual capacity of its reverse arc by the given amount.
+     *
+     * Parameters:
+     * - arc: The index of the arc.
+     * - amount: The amount of flow to push.
+     *
+     * Preconditions:
+     * - The amount does not exceed the residual capacity of the arc.
+     *
+     * Postconditions:
+     * - Both blocks are marked dirty and written back when evicted.
+     */
+    void pushFlow(long long arc, long long amount);
+
+    /**
+     * Write all dirty blocks back to the arc file.
+     *
+     * Method Name: flush
+     *
+     * Purpose: Writes all dirty blocks back to the arc file.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The file holds every residual update made so far.
+     * - An exception is thrown if writing fails.
+     */
+    void flush();
+
+private:
+    // A block of consecutive arcs held in memory
+    struct CachedBlock
+    {
+        // The index of the block in the file, -1 when unused
+        long long block;
+
+        // True if the block was changed since it was read
+        bool dirty;
+
+        // The access tick used for least-recently-used eviction
+        unsigned long long lastUse;
+
+        // The arc records of the block
+        std::vector<DiskArc> arcs;
+    };
+
+    // The arc file
+    std::fstream file;
+
+    // The number of nodes in the file
+    int nodes;
+
+    // The number of arcs in the file
+    long long arcs;
+
+    // The byte position where the arc records start
+    long long arcStart;
+
+    // The first arc of every node, plus the total number of arcs
+    std::vector<long long> offsets;
+
+    // The number of arcs per block
+    long long blockArcs;
+
+    // The cached blocks
+    std::vector<CachedBlock> cache;
+
+    // The cache slot of every block, -1 when the block is not cached
+    std::vector<int> slotOfBlock;
+
+    // The access counter used for eviction
+    unsigned long long tick;
+
+    /**
+     * Get the cache slot holding a block.
+     *
+     * Method Name: loadBlock
+     *
+     * Purpose: Returns the cache slot of a block, evicting the least
+     * recently used block if the block is not cached yet.
+     *
+     * Parameters:
+     * - block: The index of the block.
+     *
+     * Preconditions:
+     * - The block index is within the valid range.
+     *
+     * Postconditions:
+     * - The block is cached.
+     * - An exception is thrown if reading or writing back fails.
+     *
+     * Returns: The cache slot of the block.
+     */
+    int loadBlock(long long block);
+
+    /**
+     * Write a cached block back to the file.
+     *
+     * Method Name: writeBlock
+     *
+     * Purpose: Writes a dirty cached block back to the file.
+     *
+     * Parameters:
+     * - slot: The cache slot to write.
+     *
+     * Preconditions:
+     * - The slot holds a block.
+     *
+     * Postconditions:
+     * - The block is clean.
+     * - An exception is thrown if writing fails.
+     */
+    void writeBlock(int slot);
+
+    /**
+     * Write the header and node offsets of a new arc file.
+     *
+     * Method Name: writeLayout
+     *
+     * Purpose: Creates the arc file with its header, node offsets and
+     * a zeroed arc region.
+     *
+     * Parameters:
+     * - filename: A constant reference to a string representing the
+     *   name of the arc file.
+     * - offsets: A constant reference to the node offsets.
+     *
+     * Preconditions:
+     * - The offsets are non-decreasing and start at 0.
+     *
+     * Postconditions:
+     * - The file is created with room for every arc.
+     * - An exception is thrown if the file cannot be written.
+     */
+    static void writeLayout(const std::string &filename,
+                            const std::vector<long long> &offsets);
+};
+
+#endif
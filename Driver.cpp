@@ -5,6 +5,8 @@
  * Functionality/Features:
  * - Creates a BipartiteMatcher object.
  * - Reads graph data from a specified file.
+ * - Chooses the engine named by the first argument, if any, and the
+ *   history file of the learned engine from the second.
  * - Solves the bipartite matching problem.
  *
  * Assumptions:
@@ -14,6 +16,7 @@
 
 #include <iostream>
 #include "BipartiteMatcher.h"
+#include "EngineRegistry.h"
 
 /**
  * Main function of the program.
@@ -24,6 +27,12 @@
  *          object, reads the graph data from a file, and solves the
  *          bipartite matching problem.
  *
+ * Parameters:
+ * - argc: The number of arguments.
+ * - argv: The arguments; the first, if given, names the engine, such
+ *   as "pushrelabel" or "auto", and the second the history file of
+ *   the "learned" engine.
+ *
  * Preconditions:
  * - The program must have access to the "program3data.txt" file.
  *
@@ -32,13 +41,23 @@
  * - If an error occurs, an error message is printed to the standard
  *   error stream.
  */
-int main()
+int main(int argc, char *argv[])
 {
     try
     {
         // Create a BipartiteMatcher object
         BipartiteMatcher bipartiteSolver;
 
+        // Choose the engine named on the command line
+        if (argc > 1)
+        {
+            bipartiteSolver.setEngine(argv[1]);
+        }
+        if (argc > 2)
+        {
+            EngineRegistry::setHistoryFile(argv[2]);
+        }
+
         // Read the graph data from the specified file
         bipartiteSolver.fileRead("program3data.txt");
 
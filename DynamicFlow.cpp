@@ -0,0 +1,838 @@
+/*
+ * File: DynamicFlow.cpp Author: Nicolas Gioanni Purpose:
+ * Implementation of the DynamicFlow class, providing methods for
+ * maximum flows over time and quickest flows.
+ *
+ * Functionality/Features:
+ * - Number the copy of node v at time t as v * (horizon + 1) + t and
+ *   decode its residual steps from the CSR template on the fly.
+ * - Run Dinic's algorithm on the implicit time-expanded network, with
+ *   an iterative path stack and a current step per node copy. Waiting
+ *   a time step adds nothing to the level, so the number of phases
+ *   follows the arcs on a path and not the horizon.
+ * - Search the quickest time by doubling and bisecting the horizon,
+ *   growing the flow of the largest horizon that falls short into the
+ *   next trial instead of starting from zero.
+ *
+ * Assumptions:
+ * - An arc with capacity 0 has no copies.
+ * - Waiting at a node is unbounded, so it never limits the flow, and a
+ *   flow for one horizon stays feasible for a later one by waiting at
+ *   the sink.
+ */
+
+#include "DynamicFlow.h"
+#include <algorithm>
+#include <climits>
+#include <iostream>
+#include <deque>
+#include <queue>
+#include <stdexcept>
+
+namespace
+{
+    // The capacity of waiting at a node
+    const long long UNBOUNDED = LLONG_MAX / 4;
+}
+
+/**
+ * Constructor for the DynamicFlow class.
+ *
+ * Method Name: DynamicFlow
+ *
+ * Purpose: Builds the static template from an arc list, where both
+ * directions of an arc take the same transit time.
+ *
+ * Parameters:
+ * - nodes: An integer representing the number of nodes.
+ * - arcs: A constant reference to the arcs, with their capacities per
+ *   time step.
+ * - transitTimes: A constant reference to the transit time of every
+ *   arc.
+ *
+ * Preconditions:
+ * - There is one transit time per arc.
+ *
+ * Postconditions:
+ * - A new instance of the DynamicFlow class is created.
+ * - An exception is thrown if an arc or transit time is invalid.
+ */
+DynamicFlow::DynamicFlow(int nodes,
+                         const std::vector<FlowArc> &arcs,
+                         const std::vector<int> &transitTimes)
+    : network(nodes, arcs),
+      transit(network.getArcs(), 0),
+      layers(0),
+      flowValue(0)
+{
+    // Check if there is one valid transit time per arc
+    if (transitTimes.size() != arcs.size())
+    {
+        std::cerr << "ERROR: Transit time count does not match the arcs."
+                  << std::endl;
+        throw std::invalid_argument(
+            "Transit time count does not match the arcs.");
+    }
+    for (int i = 0; i < static_cast<int>(arcs.size()); ++i)
+    {
+        if (transitTimes[i] < 0)
+        {
+            std::cerr << "ERROR: Transit time is negative." << std::endl;
+            throw std::invalid_argument("Transit time is negative.");
+        }
+        int arc = network.getInputArc(i);
+        transit[arc] = transitTimes[i];
+        transit[network.getReverse(arc)] = transitTimes[i];
+    }
+}
+
+/**
+ * Constructor for the DynamicFlow class.
+ *
+ * Method Name: DynamicFlow
+ *
+ * Purpose: Builds the static template from the adjacency matrix of a
+ * graph, with the transit time from u to v read from row u and column v
+ * of a matrix of the same size.
+ *
+ * Parameters:
+ * - graph: A constant reference to the graph.
+ * - transitTimes: A constant reference to the transit time matrix.
+ *
+ * Preconditions:
+ * - The matrix has one row and one column per node.
+ *
+ * Postconditions:
+ * - A new instance of the DynamicFlow class is created.
+ * - An exception is thrown if the transit time matrix is invalid.
+ */
+DynamicFlow::DynamicFlow(const Graph &graph,
+                         const std::vector<std::vector<int>> &transitTimes)
+    : network(graph),
+      transit(network.getArcs(), 0),
+      layers(0),
+      flowValue(0)
+{
+    int nodes = network.getNodes();
+
+    // Check if the matrix is square with the size of the graph
+    bool valid = static_cast<int>(transitTimes.size()) == nodes;
+    for (int u = 0; valid && u < nodes; ++u)
+    {
+        valid = static_cast<int>(transitTimes[u].size()) == nodes;
+    }
+    if (!valid)
+    {
+        std::cerr << "ERROR: Transit time matrix does not match the graph."
+                  << std::endl;
+        throw std::invalid_argument(
+            "Transit time matrix does not match the graph.");
+    }
+
+    // Read the transit time of every template arc from its two ends
+    for (int u = 0; u < nodes; ++u)
+    {
+        for (int arc = network.arcBegin(u); arc < network.arcEnd(u); ++arc)
+        {
+            int time = transitTimes[u][network.getHead(arc)];
+            if (time < 0)
+            {
+                std::cerr << "ERROR: Transit time is negative." << std::endl;
+                throw std::invalid_argument("Transit time is negative.");
+            }
+            transit[arc] = time;
+        }
+    }
+}
+
+/**
+ * Calculates the maximum flow over time.
+ *
+ * Method Name: calculateMaxFlow
+ *
+ * Purpose: Finds the largest amount that can leave the source from time
+ * 0 and reach the sink by the horizon, with Dinic's algorithm on the
+ * implicit time-expanded network.
+ *
+ * Parameters:
+ * - source: An integer representing the source node.
+ * - sink: An integer representing the sink node.
+ * - horizon: The last time step at which flow may arrive.
+ *
+ * Returns: The maximum amount that reaches the sink by the horizon.
+ *
+ * Preconditions:
+ * - The source and sink are distinct nodes.
+ *
+ * Postconditions:
+ * - The flow of every arc copy is stored.
+ * - An exception is thrown if a parameter is invalid.
+ */
+long long DynamicFlow::calculateMaxFlow(int source, int sink, int horizon)
+{
+    try
+    {
+        checkTerminals(source, sink);
+        if (horizon < 0)
+        {
+            std::cerr << "ERROR: Horizon is negative." << std::endl;
+            throw std::invalid_argument("Horizon is negative.");
+        }
+        return solve(source, sink, horizon, UNBOUNDED);
+    }
+    catch (const std::exception &e)
+    {
+        // Output an error message if the calculation fails
+        std::cerr
+            << "ERROR: Error in calculateMaxFlow: "
+            << e.what()
+            << std::endl;
+        throw std::runtime_error("Error in calculateMaxFlow: " +
+                                 std::string(e.what()));
+    }
+}
+
+/**
+ * Calculates the quickest time to send an amount.
+ *
+ * Method Name: calculateQuickestTime
+ *
+ * Purpose: Doubles the horizon until the maximum flow over time reaches
+ * the amount, then binary searches the smallest such horizon. Every
+ * trial stops as soon as the amount is reached, and starts from the
+ * flow of the largest horizon known to fall short.
+ *
+ * Parameters:
+ * - source: An integer representing the source node.
+ * - sink: An integer representing the sink node.
+ * - amount: The amount that has to reach the sink.
+ *
+ * Returns: The smallest horizon by which the amount can arrive.
+ *
+ * Preconditions:
+ * - The source and sink are distinct nodes.
+ *
+ * Postconditions:
+ * - The flow sending the amount by the returned horizon is stored.
+ * - An exception is thrown if a parameter is invalid or the sink cannot
+ *   be reached.
+ */
+int DynamicFlow::calculateQuickestTime(int source, int sink, long long amount)
+{
+    try
+    {
+        checkTerminals(source, sink);
+        if (amount < 0)
+        {
+            std::cerr << "ERROR: Amount is negative." << std::endl;
+            throw std::invalid_argument("Amount is negative.");
+        }
+
+        // Every horizon fails if the sink is not reachable in the template
+        std::vector<bool> reached(network.getNodes(), false);
+        std::queue<int> queue;
+        reached[source] = true;
+        queue.push(source);
+        while (!queue.empty())
+        {
+            int node = queue.front();
+            queue.pop();
+            for (int arc = network.arcBegin(node); arc < network.arcEnd(node);
+                 ++arc)
+            {
+                int head = network.getHead(arc);
+                if (network.getCapacity(arc) > 0 && !reached[head])
+                {
+                    reached[head] = true;
+                    queue.push(head);
+                }
+            }
+        }
+        if (!reached[sink])
+        {
+            std::cerr << "ERROR: Sink is not reachable." << std::endl;
+            throw std::logic_error("Sink is not reachable.");
+        }
+
+        if (solve(source, sink, 0, amount) >= amount)
+        {
+            return 0;
+        }
+
+        // A maximum flow that falls short of the amount stays feasible
+        // for every later horizon, so each trial grows the flow of the
+        // largest horizon known to fall short
+        int failed = 0;
+        std::vector<long long> failedArcFlow = arcFlow;
+        std::vector<long long> failedHoldFlow = holdFlow;
+        long long failedValue = flowValue;
+        auto tryHorizon = [&](int horizon)
+        {
+            if (layers - 1 != failed)
+            {
+                layers = failed + 1;
+                arcFlow = failedArcFlow;
+                holdFlow = failedHoldFlow;
+                flowValue = failedValue;
+            }
+            growHorizon(sink, horizon);
+            if (augment(source, sink, amount) >= amount)
+            {
+                return true;
+            }
+            failed = horizon;
+            failedArcFlow = arcFlow;
+            failedHoldFlow = holdFlow;
+            failedValue = flowValue;
+            return false;
+        };
+
+        // Double the horizon until the amount arrives, then bisect
+        int horizon = 1;
+        while (!tryHorizon(horizon))
+        {
+            if (horizon > INT_MAX / 2)
+            {
+                std::cerr << "ERROR: Horizon is too large." << std::endl;
+                throw std::length_error("Horizon is too large.");
+            }
+            horizon *= 2;
+        }
+        while (horizon - failed > 1)
+        {
+            int middle = failed + (horizon - failed) / 2;
+            if (tryHorizon(middle))
+            {
+                horizon = middle;
+            }
+        }
+
+        // Keep the flow of the answer
+        if (layers - 1 != horizon)
+        {
+            tryHorizon(horizon);
+        }
+        return horizon;
+    }
+    catch (const std::exception &e)
+    {
+        // Output an error message if the calculation fails
+        std::cerr
+            << "ERROR: Error in calculateQuickestTime: "
+            << e.what()
+            << std::endl;
+        throw std::runtime_error("Error in calculateQuickestTime: " +
+                                 std::string(e.what()));
+    }
+}
+
+/**
+ * Get the flow entering an arc at a time.
+ *
+ * Method Name: getFlow
+ *
+ * Purpose: Returns the flow that leaves the tail along the arc at the
+ * given time and reaches the head one transit time later.
+ *
+ * Parameters:
+ * - tail: An integer representing the tail node.
+ * - head: An integer representing the head node.
+ * - time: The time step the flow leaves the tail.
+ *
+ * Preconditions:
+ * - A flow was calculated.
+ *
+ * Postconditions:
+ * - The flow is returned.
+ * - An exception is thrown if the arc or time is invalid.
+ *
+ * Returns: The flow on the copy of the arc leaving at the time.
+ */
+long long DynamicFlow::getFlow(int tail, int head, int time) const
+{
+    // Check if the arc exists and the time is within the horizon
+    int arc = network.findArc(tail, head);
+    if (arc < 0)
+    {
+        std::cerr << "ERROR: Arc does not exist." << std::endl;
+        throw std::invalid_argument("Arc does not exist.");
+    }
+    if (time < 0 || time >= layers)
+    {
+        std::cerr << "ERROR: Time is out of valid range." << std::endl;
+        throw std::out_of_range("Time is out of valid range.");
+    }
+
+    return arcFlow[static_cast<size_t>(arc) * layers + time];
+}
+
+/**
+ * Solves the maximum flow over time up to a limit.
+ *
+ * Method Name: solve
+ *
+ * Purpose: Sizes the flow arrays to the horizon with no flow and runs
+ * Dinic phases from (source, 0) to (sink, horizon) until no augmenting
+ * path is left or the limit is reached.
+ *
+ * Parameters:
+ * - source: An integer representing the source node.
+ * - sink: An integer representing the sink node.
+ * - horizon: The last time step at which flow may arrive.
+ * - limit: The amount after which the search stops.
+ *
+ * Returns: The amount sent, at most the limit.
+ *
+ * Preconditions:
+ * - The parameters are valid.
+ *
+ * Postconditions:
+ * - The flow of every arc copy is stored.
+ */
+long long DynamicFlow::solve(int source, int sink, int horizon,
+                             long long limit)
+{
+    layers = 0;
+    arcFlow.clear();
+    holdFlow.clear();
+    flowValue = 0;
+    growHorizon(sink, horizon);
+    return augment(source, sink, limit);
+}
+
+/**
+ * Moves the stored flow to a later horizon.
+ *
+ * Method Name: growHorizon
+ *
+ * Purpose: Sizes the flow arrays to the horizon, keeps the flow of every
+ * arc copy and waiting step, and lets the flow that reached the sink by
+ * the old horizon wait there until the new one.
+ *
+ * Parameters:
+ * - sink: An integer representing the sink node.
+ * - horizon: The new horizon.
+ *
+ * Preconditions:
+ * - The horizon is not below the current one.
+ *
+ * Postconditions:
+ * - The stored flow sends the same amount by the new horizon.
+ * - The levels and current steps are reset.
+ * - An exception is thrown if the time-expanded network is too large.
+ */
+void DynamicFlow::growHorizon(int sink, int horizon)
+{
+    // Node copies are indexed with int, so their count has to fit
+    int nodes = network.getNodes();
+    int arcs = network.getArcs();
+    long long copies = static_cast<long long>(std::max(nodes, arcs)) *
+                       (static_cast<long long>(horizon) + 1);
+    if (copies > INT_MAX)
+    {
+        std::cerr << "ERROR: Time-expanded network is too large." << std::endl;
+        throw std::length_error("Time-expanded network is too large.");
+    }
+
+    // Copy every row of the flow arrays into its longer place
+    int oldLayers = layers;
+    layers = horizon + 1;
+    std::vector<long long> oldArcFlow;
+    std::vector<long long> oldHoldFlow;
+    oldArcFlow.swap(arcFlow);
+    oldHoldFlow.swap(holdFlow);
+    arcFlow.assign(static_cast<size_t>(arcs) * layers, 0);
+    holdFlow.assign(static_cast<size_t>(nodes) * layers, 0);
+    for (int arc = 0; arc < arcs && oldLayers > 0; ++arc)
+    {
+        std::copy(oldArcFlow.begin() + static_cast<size_t>(arc) * oldLayers,
+                  oldArcFlow.begin() + static_cast<size_t>(arc + 1) * oldLayers,
+                  arcFlow.begin() + static_cast<size_t>(arc) * layers);
+    }
+    for (int node = 0; node < nodes && oldLayers > 0; ++node)
+    {
+        std::copy(oldHoldFlow.begin() + static_cast<size_t>(node) * oldLayers,
+                  oldHoldFlow.begin() +
+                      static_cast<size_t>(node + 1) * oldLayers,
+                  holdFlow.begin() + static_cast<size_t>(node) * layers);
+    }
+
+    // The flow that arrived by the old horizon waits at the sink
+    for (int time = oldLayers - 1; time >= 0 && time < horizon; ++time)
+    {
+        holdFlow[static_cast<size_t>(sink) * layers + time] += flowValue;
+    }
+
+    level.assign(static_cast<size_t>(nodes) * layers, -1);
+    currentStep.assign(static_cast<size_t>(nodes) * layers, 0);
+    reached.clear();
+}
+
+/**
+ * Adds flow until a limit.
+ *
+ * Method Name: augment
+ *
+ * Purpose: Runs Dinic phases on the stored flow from (source, 0) to
+ * (sink, horizon) until no augmenting path is left or the stored flow
+ * sends the limit.
+ *
+ * Parameters:
+ * - source: An integer representing the source node.
+ * - sink: An integer representing the sink node.
+ * - limit: The amount after which the search stops.
+ *
+ * Returns: The amount the stored flow sends, at most the limit unless
+ * it sent more before.
+ *
+ * Preconditions:
+ * - The flow arrays are sized to the horizon.
+ *
+ * Postconditions:
+ * - The flow of every arc copy is stored.
+ */
+long long DynamicFlow::augment(int source, int sink, long long limit)
+{
+    int sourceIndex = source * layers;
+    int sinkIndex = sink * layers + layers - 1;
+    while (flowValue < limit && buildLevels(sourceIndex, sinkIndex))
+    {
+        flowValue += blockingFlow(sourceIndex, sinkIndex, limit - flowValue);
+    }
+    return flowValue;
+}
+
+/**
+ * Builds the levels of a phase.
+ *
+ * Method Name: buildLevels
+ *
+ * Purpose: Runs a breadth first search over the residual steps from the
+ * source copy, stopping at the level of the sink copy. Waiting is free
+ * and every other step adds one, so waiting copies go to the front of
+ * the queue. Only the copies the previous search reached are reset
+ * first.
+ *
+ * Parameters:
+ * - sourceIndex: The index of the source copy.
+ * - sinkIndex: The index of the sink copy.
+ *
+ * Returns: True if the sink copy is reachable.
+ *
+ * Preconditions:
+ * - The flow arrays are sized to the horizon.
+ *
+ * Postconditions:
+ * - The levels and current steps are reset for the phase.
+ */
+bool DynamicFlow::buildLevels(int sourceIndex, int sinkIndex)
+{
+    // No other copy has a level or a current step from the last phase
+    for (int index : reached)
+    {
+        level[index] = -1;
+        currentStep[index] = 0;
+    }
+    reached.assign(1, sourceIndex);
+
+    std::deque<int> queue(1, sourceIndex);
+    level[sourceIndex] = 0;
+    while (!queue.empty())
+    {
+        int index = queue.front();
+        queue.pop_front();
+
+        // Copies past the level of the sink copy are never used
+        if (level[sinkIndex] >= 0 && level[index] >= level[sinkIndex])
+        {
+            break;
+        }
+
+        int node = index / layers;
+        int steps = 2 * (network.arcEnd(node) - network.arcBegin(node)) + 2;
+        for (int step = 0; step < steps; ++step)
+        {
+            int next = -1;
+            if (stepResidual(index, step, next) <= 0)
+            {
+                continue;
+            }
+
+            // Waiting keeps the level; a copy may be lowered once a
+            // path with fewer steps reaches it
+            int length = step == steps - 2 ? 0 : 1;
+            if (level[next] >= 0 && level[next] <= level[index] + length)
+            {
+                continue;
+            }
+            if (level[next] < 0)
+            {
+                reached.push_back(next);
+            }
+            level[next] = level[index] + length;
+            if (length == 0)
+            {
+                queue.push_front(next);
+            }
+            else
+            {
+                queue.push_back(next);
+            }
+        }
+    }
+    return level[sinkIndex] >= 0;
+}
+
+/**
+ * Sends a blocking flow along the levels.
+ *
+ * Method Name: blockingFlow
+ *
+ * Purpose: Walks forward along residual steps that raise the level by
+ * their length with an explicit path stack, augments whenever the sink
+ * copy is met, and removes dead node copies from the phase. After an
+ * augment the walk goes on from the tail of the first step it
+ * saturated.
+ *
+ * Parameters:
+ * - sourceIndex: The index of the source copy.
+ * - sinkIndex: The index of the sink copy.
+ * - limit: The largest amount to send.
+ *
+ * Returns: The amount sent in the phase.
+ *
+ * Preconditions:
+ * - buildLevels reached the sink copy.
+ *
+ * Postconditions:
+ * - The flow arrays are updated.
+ */
+long long DynamicFlow::blockingFlow(int sourceIndex, int sinkIndex,
+                                    long long limit)
+{
+    long long total = 0;
+    std::vector<int> path(1, sourceIndex);
+    std::vector<int> pathSteps;
+
+    while (!path.empty() && total < limit)
+    {
+        int index = path.back();
+
+        // Augment by the smallest residual capacity on the path
+        if (index == sinkIndex)
+        {
+            long long amount = limit - total;
+            int next = -1;
+            for (size_t i = 0; i < pathSteps.size(); ++i)
+            {
+                amount = std::min(amount,
+                                  stepResidual(path[i], pathSteps[i], next));
+            }
+            for (size_t i = 0; i < pathSteps.size(); ++i)
+            {
+                pushStep(path[i], pathSteps[i], amount);
+            }
+            total += amount;
+
+            // The path up to the first saturated step can still carry
+            // flow, so keep it
+            size_t keep = 0;
+            while (keep < pathSteps.size() &&
+                   stepResidual(path[keep], pathSteps[keep], next) > 0)
+            {
+                ++keep;
+            }
+            if (keep == pathSteps.size())
+            {
+                keep = 0;
+            }
+            path.resize(keep + 1);
+            pathSteps.resize(keep);
+            continue;
+        }
+
+        // Advance along the first usable step, or retreat from a dead copy
+        int node = index / layers;
+        int steps = 2 * (network.arcEnd(node) - network.arcBegin(node)) + 2;
+        bool advanced = false;
+        for (int &step = currentStep[index]; step < steps; ++step)
+        {
+            int next = -1;
+            int length = step == steps - 2 ? 0 : 1;
+            if (stepResidual(index, step, next) > 0 &&
+                level[next] == level[index] + length)
+            {
+                path.push_back(next);
+                pathSteps.push_back(step);
+                advanced = true;
+                break;
+            }
+        }
+        if (!advanced)
+        {
+            level[index] = -1;
+            path.pop_back();
+            if (!pathSteps.empty())
+            {
+                pathSteps.pop_back();
+                ++currentStep[path.back()];
+            }
+        }
+    }
+    return total;
+}
+
+/**
+ * Get the residual capacity of a step.
+ *
+ * Method Name: stepResidual
+ *
+ * Purpose: Decodes a step from a node copy. For a node of degree d,
+ * steps below d follow a template arc forward in time, steps below 2d
+ * undo flow on the reverse of a template arc, and the last two steps
+ * wait one time step or undo waiting.
+ *
+ * Parameters:
+ * - index: The index of the node copy.
+ * - step: The step to decode.
+ * - next: A reference that receives the index of the copy reached.
+ *
+ * Returns: The residual capacity of the step, 0 if it leaves the time
+ * range.
+ *
+ * Preconditions:
+ * - The step is below twice the degree plus two.
+ *
+ * Postconditions:
+ * - next is set if the residual capacity is positive.
+ */
+long long DynamicFlow::stepResidual(int index, int step, int &next) const
+{
+    int node = index / layers;
+    int time = index % layers;
+    int begin = network.arcBegin(node);
+    int degree = network.arcEnd(node) - begin;
+
+    if (step < degree)
+    {
+        // Leave along a template arc and arrive one transit time later
+        int arc = begin + step;
+        long long capacity = network.getCapacity(arc);
+        if (capacity <= 0 || transit[arc] > layers - 1 - time)
+        {
+            return 0;
+        }
+        next = network.getHead(arc) * layers + time + transit[arc];
+        return capacity - arcFlow[static_cast<size_t>(arc) * layers + time];
+    }
+    if (step < 2 * degree)
+    {
+        // Undo flow that arrived along the reverse of a template arc
+        int arc = network.getReverse(begin + step - degree);
+        int start = time - transit[arc];
+        if (start < 0)
+        {
+            return 0;
+        }
+        next = network.getHead(begin + step - degree) * layers + start;
+        return arcFlow[static_cast<size_t>(arc) * layers + start];
+    }
+    if (step == 2 * degree)
+    {
+        // Wait at the node for one time step
+        if (time == layers - 1)
+        {
+            return 0;
+        }
+        next = index + 1;
+        return UNBOUNDED - holdFlow[index];
+    }
+
+    // Undo waiting that arrived from the previous time step
+    if (time == 0)
+    {
+        return 0;
+    }
+    next = index - 1;
+    return holdFlow[index - 1];
+}
+
+/**
+ * Pushes flow along a step.
+ *
+ * Method Name: pushStep
+ *
+ * Purpose: Adds the amount to the arc copy or waiting flow of the step,
+ * or subtracts it for the undoing steps.
+ *
+ * Parameters:
+ * - index: The index of the node copy.
+ * - step: The step to push along.
+ * - amount: The amount of flow to push.
+ *
+ * Preconditions:
+ * - The amount is at most the residual capacity of the step.
+ *
+ * Postconditions:
+ * - The flow arrays are updated.
+ */
+void DynamicFlow::pushStep(int index, int step, long long amount)
+{
+    int node = index / layers;
+    int time = index % layers;
+    int begin = network.arcBegin(node);
+    int degree = network.arcEnd(node) - begin;
+
+    if (step < degree)
+    {
+        arcFlow[static_cast<size_t>(begin + step) * layers + time] += amount;
+    }
+    else if (step < 2 * degree)
+    {
+        int arc = network.getReverse(begin + step - degree);
+        arcFlow[static_cast<size_t>(arc) * layers + time - transit[arc]] -=
+            amount;
+    }
+    else if (step == 2 * degree)
+    {
+        holdFlow[index] += amount;
+    }
+    else
+    {
+        holdFlow[index - 1] -= amount;
+    }
+}
+
+/**
+ * Checks that the source and sink are valid.
+ *
+ * Method Name: checkTerminals
+ *
+ * Purpose: Throws if either terminal is out of range or both are the
+ * same node.
+ *
+ * Parameters:
+ * - source: An integer representing the source node.
+ * - sink: An integer representing the sink node.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - An exception is thrown if the terminals are invalid.
+ */
+void DynamicFlow::checkTerminals(int source, int sink) const
+{
+    int nodes = network.getNodes();
+    if (source < 0 || source >= nodes || sink < 0 || sink >= nodes)
+    {
+        std::cerr << "ERROR: Source or sink is out of valid range."
+                  << std::endl;
+        throw std::out_of_range("Source or sink is out of valid range.");
+    }
+    if (source == sink)
+    {
+        std::cerr << "ERROR: Source and sink are the same node." << std::endl;
+        throw std::invalid_argument("Source and sink are the same node.");
+    }
+}
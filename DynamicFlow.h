@@ -0,0 +1,378 @@
+/*
+ * File: DynamicFlow.h Author: Nicolas Gioanni Purpose: Declaration of
+ * the DynamicFlow class for solving flows over time, where every arc
+ * has a transit time as well as a capacity per time step.
+ *
+ * Functionality/Features:
+ * - Declare methods for building the static template from an arc list
+ *   or from the Graph loaded by GraphPrepare.
+ * - Declare methods for finding the maximum flow that reaches the sink
+ *   by a time horizon.
+ * - Declare methods for finding the quickest time to send an amount.
+ * - Declare methods for reading the flow entering an arc at a time.
+ *
+ * Assumptions:
+ * - The time-expanded network is never built: the copy (node, time) of
+ *   a node and the arcs leaving it are computed from the template when
+ *   they are needed. Only the flow of every arc copy is stored.
+ * - Flow may wait at any node for any number of time steps.
+ * - Transit times are non-negative integers.
+ */
+
+#ifndef DYNAMICFLOW_H
+#define DYNAMICFLOW_H
+
+#include "FlowNetwork.h"
+#include "Graph.h"
+#include <vector>
+
+class DynamicFlow
+{
+public:
+    /**
+     * Constructor for the DynamicFlow class.
+     *
+     * Method Name: DynamicFlow
+     *
+     * Purpose: Builds the static template from an arc list, where both
+     * directions of an arc take the same transit time.
+     *
+     * Parameters:
+     * - nodes: An integer representing the number of nodes.
+     * - arcs: A constant reference to the arcs, with their capacities
+     *   per time step.
+     * - transitTimes: A constant reference to the transit time of
+     *   every arc.
+     *
+     * Preconditions:
+     * - There is one transit time per arc.
+     *
+     * Postconditions:
+     * - A new instance of the DynamicFlow class is created.
+     * - An exception is thrown if an arc or transit time is invalid.
+     */
+    DynamicFlow(int nodes,
+                const std::vector<FlowArc> &arcs,
+                const std::vector<int> &transitTimes);
+
+    /**
+     * Constructor for the DynamicFlow class.
+     *
+     * Method Name: DynamicFlow
+     *
+     * Purpose: Builds the static template from the adjacency matrix of
+     * a graph, with the transit time from u to v read from row u and
+     * column v of a matrix of the same size.
+     *
+     * Parameters:
+     * - graph: A constant reference to the graph.
+     * - transitTimes: A constant reference to the transit time matrix.
+     *
+     * Preconditions:
+     * - The matrix has one row and one column per node.
+     *
+     * Postconditions:
+     * - A new instance of the DynamicFlow class is created.
+     * - An exception is thrown if the transit time matrix is invalid.
+     */
+    DynamicFlow(const Graph &graph,
+                const std::vector<std::vector<int>> &transitTimes);
+
+    /**
+     * Calculates the maximum flow over time.
+     *
+     * Method Name: calculateMaxFlow
+     *
+     * Purpose: Finds the largest amount that can leave the source from
+     * time 0 and reach the sink by the horizon, with Dinic's algorithm
+     * on the implicit time-expanded network.
+     *
+     * Parameters:
+     * - source: An integer representing the source node.
+     * - sink: An integer representing the sink node.
+     * - horizon: The last time step at which flow may arrive.
+     *
+     * Returns: The maximum amount that reaches the sink by the horizon.
+     *
+     * Preconditions:
+     * - The source and sink are distinct nodes.
+     *
+     * Postconditions:
+     * - The flow of every arc copy is stored.
+     * - An exception is thrown if a parameter is invalid.
+     */
+    long long calculateMaxFlow(int source, int sink, int horizon);
+
+    /**
+     * Calculates the quickest time to send an amount.
+     *
+     * Method Name: calculateQuickestTime
+     *
+     * Purpose: Doubles the horizon until the maximum flow over time
+     * reaches the amount, then binary searches the smallest such
+     * horizon. Every trial stops as soon as the amount is reached, and
+     * starts from the flow of the largest horizon known to fall short.
+     *
+     * Parameters:
+     * - source: An integer representing the source node.
+     * - sink: An integer representing the sink node.
+     * - amount: The amount that has to reach the sink.
+     *
+     * Returns: The smallest horizon by which the amount can arrive.
+     *
+     * Preconditions:
+     * - The source and sink are distinct nodes.
+     *
+     * Postconditions:
+     * - The flow sending the amount by the returned horizon is stored.
+     * - An exception is thrown if a parameter is invalid or the sink
+     *   cannot be reached.
+     */
+    int calculateQuickestTime(int source, int sink, long long amount);
+
+    /**
+     * Get the flow entering an arc at a time.
+     *
+     * Method Name: getFlow
+     *
+     * Purpose: Returns the flow that leaves the tail along the arc at
+     * the given time and reaches the head one transit time later.
+     *
+     * Parameters:
+     * - tail: An integer representing the tail node.
+     * - head: An integer representing the head node.
+     * - time: The time step the flow leaves the tail.
+     *
+     * Preconditions:
+     * - A flow was calculated.
+     *
+     * Postconditions:
+     * - The flow is returned.
+     * - An exception is thrown if the arc or time is invalid.
+     *
+     * Returns: The flow on the copy of the arc leaving at the time.
+     */
+    long long getFlow(int tail, int head, int time) const;
+
+private:
+    // The static template
+    FlowNetwork network;
+
+    // The transit time of every template arc
+    std::vector<int> transit;
+
+    // The number of time layers, one more than the horizon
+    int layers;
+
+    // The flow on the copy of every template arc leaving at every time
+    std::vector<long long> arcFlow;
+
+    // The flow waiting at every node from every time to the next
+    std::vector<long long> holdFlow;
+
+    // The amount the stored flow sends to the sink
+    long long flowValue;
+
+    // The level of every node copy in the current phase
+    std::vector<int> level;
+
+    // The next step to try from every node copy in the current phase
+    std::vector<int> currentStep;
+
+    // The node copies the last breadth first search gave a level
+    std::vector<int> reached;
+
+    /**
+     * Solves the maximum flow over time up to a limit.
+     *
+     * Method Name: solve
+     *
+     * Purpose: Sizes the flow arrays to the horizon with no flow and
+     * runs Dinic phases from (source, 0) to (sink, horizon) until no
+     * augmenting path is left or the limit is reached.
+     *
+     * Parameters:
+     * - source: An integer representing the source node.
+     * - sink: An integer representing the sink node.
+     * - horizon: The last time step at which flow may arrive.
+     * - limit: The amount after which the search stops.
+     *
+     * Returns: The amount sent, at most the limit.
+     *
+     * Preconditions:
+     * - The parameters are valid.
+     *
+     * Postconditions:
+     * - The flow of every arc copy is stored.
+     */
+    long long solve(int source, int sink, int horizon, long long limit);
+
+    /**
+     * Moves the stored flow to a later horizon.
+     *
+     * Method Name: growHorizon
+     *
+     * Purpose: Sizes the flow arrays to the horizon, keeps the flow of
+     * every arc copy and waiting step, and lets the flow that reached
+     * the sink by the old horizon wait there until the new one.
+     *
+     * Parameters:
+     * - sink: An integer representing the sink node.
+     * - horizon: The new horizon.
+     *
+     * Preconditions:
+     * - The horizon is not below the current one.
+     *
+     * Postconditions:
+     * - The stored flow sends the same amount by the new horizon.
+     * - The levels and current steps are reset.
+     * - An exception is thrown if the time-expanded network is too
+     *   large.
+     */
+    void growHorizon(int sink, int horizon);
+
+    /**
+     * Adds flow until a limit.
+     *
+     * Method Name: augment
+     *
+     * Purpose: Runs Dinic phases on the stored flow from (source, 0) to
+     * (sink, horizon) until no augmenting path is left or the stored
+     * flow sends the limit.
+     *
+     * Parameters:
+     * - source: An integer representing the source node.
+     * - sink: An integer representing the sink node.
+     * - limit: The amount after which the search stops.
+     *
+     * Returns: The amount the stored flow sends, at most the limit
+     * unless it sent more before.
+     *
+     * Preconditions:
+     * - The flow arrays are sized to the horizon.
+     *
+     * Postconditions:
+     * - The flow of every arc copy is stored.
+     */
+    long long augment(int source, int sink, long long limit);
+
+    /**
+     * Builds the levels of a phase.
+     *
+     * Method Name: buildLevels
+     *
+     * Purpose: Runs a breadth first search over the residual steps from
+     * the source copy, stopping at the level of the sink copy. Waiting
+     * is free and every other step adds one, so waiting copies go to
+     * the front of the queue. Only the copies the previous search
+     * reached are reset first.
+     *
+     * Parameters:
+     * - sourceIndex: The index of the source copy.
+     * - sinkIndex: The index of the sink copy.
+     *
+     * Returns: True if the sink copy is reachable.
+     *
+     * Preconditions:
+     * - The flow arrays are sized to the horizon.
+     *
+     * Postconditions:
+     * - The levels and current steps are reset for the phase.
+     */
+    bool buildLevels(int sourceIndex, int sinkIndex);
+
+    /**
+     * Sends a blocking flow along the levels.
+     *
+     * Method Name: blockingFlow
+     *
+     * Purpose: Walks forward along residual steps that raise the level
+     * by their length with an explicit path stack, augments whenever
+     * the sink copy is met, and removes dead node copies from the
+     * phase. After an augment the walk goes on from the tail of the
+     * first step it saturated.
+     *
+     * Parameters:
+     * - sourceIndex: The index of the source copy.
+     * - sinkIndex: The index of the sink copy.
+     * - limit: The largest amount to send.
+     *
+     * Returns: The amount sent in the phase.
+     *
+     * Preconditions:
+     * - buildLevels reached the sink copy.
+     *
+     * Postconditions:
+     * - The flow arrays are updated.
+     */
+    long long blockingFlow(int sourceIndex, int sinkIndex, long long limit);
+
+    /**
+     * Get the residual capacity of a step.
+     *
+     * Method Name: stepResidual
+     *
+     * Purpose: Decodes a step from a node copy. For a node of degree d,
+     * steps below d follow a template arc forward in time, steps below
+     * 2d undo flow on the reverse of a template arc, and the last two
+     * steps wait one time step or undo waiting.
+     *
+     * Parameters:
+     * - index: The index of the node copy.
+     * - step: The step to decode.
+     * - next: A reference that receives the index of the copy reached.
+     *
+     * Returns: The residual capacity of the step, 0 if it leaves the
+     * time range.
+     *
+     * Preconditions:
+     * - The step is below twice the degree plus two.
+     *
+     * Postconditions:
+     * - next is set if the residual capacity is positive.
+     */
+    long long stepResidual(int index, int step, int &next) const;
+
+    /**
+     * Pushes flow along a step.
+     *
+     * Method Name: pushStep
+     *
+     * Purpose: Adds the amount to the arc copy or waiting flow of the
+     * step, or subtracts it for the undoing steps.
+     *
+     * Parameters:
+     * - index: The index of the node copy.
+     * - step: The step to push along.
+     * - amount: The amount of flow to push.
+     *
+     * Preconditions:
+     * - The amount is at most the residual capacity of the step.
+     *
+     * Postconditions:
+     * - The flow arrays are updated.
+     */
+    void pushStep(int index, int step, long long amount);
+
+    /**
+     * Checks that the source and sink are valid.
+     *
+     * Method Name: checkTerminals
+     *
+     * Purpose: Throws if either terminal is out of range or both are
+     * the same node.
+     *
+     * Parameters:
+     * - source: An integer representing the source node.
+     * - sink: An integer representing the sink node.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - An exception is thrown if the terminals are invalid.
+     */
+    void checkTerminals(int source, int sink) const;
+};
+
+#endif
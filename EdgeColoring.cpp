@@ -0,0 +1,423 @@
+/*
+ * File: EdgeColoring.cpp Author: Nicolas Gioanni Purpose:
+ * Implementation of the EdgeColoring class, providing methods for
+ * coloring the edges of a bipartite multigraph with the maximum degree
+ * number of colors.
+ *
+ * Functionality/Features:
+ * - Merge nodes of each side with next-fit packing so that at most
+ *   2E / D + 1 nodes remain per side, with D the maximum degree.
+ * - Pad the merged graph with dummy edges to make it D-regular.
+ * - Halve even degrees with Euler partitions and peel perfect matchings
+ *   only at odd degrees, so at most one matching is needed per level
+ *   of the recursion.
+ *
+ * Assumptions:
+ * - Dummy edges take colors like real edges and are dropped at the end.
+ */
+
+#include "EdgeColoring.h"
+#include "HopcroftKarp.h"
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+/**
+ * Constructor for the EdgeColoring class.
+ *
+ * Method Name: EdgeColoring
+ *
+ * Purpose: Stores the edges of the bipartite multigraph.
+ *
+ * Parameters:
+ * - leftNodes: An integer representing the number of left nodes.
+ * - rightNodes: An integer representing the number of right nodes.
+ * - edges: A constant reference to the edges, each a pair of a left and
+ *   a right node.
+ *
+ * Preconditions:
+ * - Every node index is within the range of its side.
+ *
+ * Postconditions:
+ * - A new instance of the EdgeColoring class is created.
+ * - An exception is thrown if an edge is invalid.
+ */
+EdgeColoring::EdgeColoring(int leftNodes,
+                           int rightNodes,
+                           const std::vector<std::pair<int, int>> &edges)
+    : leftNodes(leftNodes), rightNodes(rightNodes), edges(edges),
+      sideNodes(0)
+{
+    // Check if every edge is within range
+    for (const std::pair<int, int> &edge : edges)
+    {
+        if (edge.first < 0 || edge.first >= leftNodes ||
+            edge.second < 0 || edge.second >= rightNodes)
+        {
+            std::cerr << "ERROR: Edge is out of valid range." << std::endl;
+            throw std::out_of_range("Edge is out of valid range.");
+        }
+    }
+}
+
+/**
+ * Colors the edges.
+ *
+ * Method Name: solve
+ *
+ * Purpose: Merges small nodes, pads the graph to a regular one and
+ * colors it by divide and conquer: even degrees are halved with an
+ * Euler partition and odd degrees peel off one perfect matching.
+ *
+ * Returns: The number of colors, which is the maximum degree.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The colors are stored.
+ * - An exception is thrown if solving fails.
+ */
+int EdgeColoring::solve()
+{
+    try
+    {
+        std::vector<int> leftDegree(leftNodes, 0);
+        std::vector<int> rightDegree(rightNodes, 0);
+        for (const std::pair<int, int> &edge : edges)
+        {
+            ++leftDegree[edge.first];
+            ++rightDegree[edge.second];
+        }
+        int maxDegree = 0;
+        for (int degree : leftDegree)
+        {
+            maxDegree = std::max(maxDegree, degree);
+        }
+        for (int degree : rightDegree)
+        {
+            maxDegree = std::max(maxDegree, degree);
+        }
+        colors.assign(edges.size(), 0);
+        if (maxDegree == 0)
+        {
+            return 0;
+        }
+
+        // Pack the nodes of each side into merged nodes of degree at
+        // most the maximum degree
+        auto pack = [maxDegree](const std::vector<int> &degree,
+                                std::vector<int> &merged,
+                                std::vector<int> &mergedDegree)
+        {
+            merged.assign(degree.size(), 0);
+            mergedDegree.assign(1, 0);
+            for (size_t node = 0; node < degree.size(); ++node)
+            {
+                if (mergedDegree.back() + degree[node] > maxDegree)
+                {
+                    mergedDegree.push_back(0);
+                }
+                merged[node] = static_cast<int>(mergedDegree.size()) - 1;
+                mergedDegree.back() += degree[node];
+            }
+        };
+        std::vector<int> leftMerged, rightMerged;
+        std::vector<int> leftMergedDegree, rightMergedDegree;
+        pack(leftDegree, leftMerged, leftMergedDegree);
+        pack(rightDegree, rightMerged, rightMergedDegree);
+        sideNodes = static_cast<int>(std::max(leftMergedDegree.size(),
+                                              rightMergedDegree.size()));
+        leftMergedDegree.resize(sideNodes, 0);
+        rightMergedDegree.resize(sideNodes, 0);
+
+        edgeLeft.clear();
+        edgeRight.clear();
+        for (const std::pair<int, int> &edge : edges)
+        {
+            edgeLeft.push_back(leftMerged[edge.first]);
+            edgeRight.push_back(rightMerged[edge.second]);
+        }
+
+        // Pad the merged graph to a regular one with dummy edges; both
+        // sides miss the same total degree
+        int left = 0;
+        int right = 0;
+        while (true)
+        {
+            while (left < sideNodes && leftMergedDegree[left] == maxDegree)
+            {
+                ++left;
+            }
+            while (right < sideNodes &&
+                   rightMergedDegree[right] == maxDegree)
+            {
+                ++right;
+            }
+            if (left == sideNodes || right == sideNodes)
+            {
+                break;
+            }
+            edgeLeft.push_back(left);
+            edgeRight.push_back(right);
+            ++leftMergedDegree[left];
+            ++rightMergedDegree[right];
+        }
+
+        std::vector<int> all(edgeLeft.size());
+        for (size_t edge = 0; edge < all.size(); ++edge)
+        {
+            all[edge] = static_cast<int>(edge);
+        }
+        edgeColor.assign(edgeLeft.size(), -1);
+        colorRegular(all, maxDegree, 0);
+
+        for (size_t edge = 0; edge < edges.size(); ++edge)
+        {
+            colors[edge] = edgeColor[edge];
+        }
+        return maxDegree;
+    }
+    catch (const std::exception &e)
+    {
+        // Output an error message if the coloring fails
+        std::cerr
+            << "ERROR: Error in solve: "
+            << e.what()
+            << std::endl;
+        throw std::runtime_error("Error in solve: " +
+                                 std::string(e.what()));
+    }
+}
+
+/**
+ * Get the color of every edge.
+ *
+ * Method Name: getColors
+ *
+ * Purpose: Returns the colors found by solve.
+ *
+ * Preconditions:
+ * - solve was called.
+ *
+ * Postconditions:
+ * - The colors are returned.
+ *
+ * Returns: The color of every edge, from 0 to the maximum degree minus
+ * 1, in input order.
+ */
+const std::vector<int> &EdgeColoring::getColors() const
+{
+    return colors;
+}
+
+/**
+ * Colors a regular subgraph.
+ *
+ * Method Name: colorRegular
+ *
+ * Purpose: Colors the edges with the colors from the first color on,
+ * splitting the subgraph in two halves while its degree is even and
+ * peeling a perfect matching when it is odd.
+ *
+ * Parameters:
+ * - subgraph: A constant reference to the edges of the subgraph.
+ * - degree: The degree of every node of the subgraph.
+ * - firstColor: The first color to use.
+ *
+ * Preconditions:
+ * - Every node has the given degree in the subgraph.
+ *
+ * Postconditions:
+ * - The edges are colored with degree colors.
+ */
+void EdgeColoring::colorRegular(const std::vector<int> &subgraph,
+                                int degree,
+                                int firstColor)
+{
+    if (degree == 0)
+    {
+        return;
+    }
+    if (degree == 1)
+    {
+        for (int edge : subgraph)
+        {
+            edgeColor[edge] = firstColor;
+        }
+        return;
+    }
+
+    if (degree % 2 == 1)
+    {
+        // Peel one perfect matching to make the degree even
+        std::vector<int> matching = perfectMatching(subgraph);
+        for (int edge : matching)
+        {
+            edgeColor[edge] = firstColor;
+        }
+        std::vector<int> rest;
+        rest.reserve(subgraph.size() - matching.size());
+        for (int edge : subgraph)
+        {
+            if (edgeColor[edge] == -1)
+            {
+                rest.push_back(edge);
+            }
+        }
+        colorRegular(rest, degree - 1, firstColor + 1);
+        return;
+    }
+
+    std::vector<int> first;
+    std::vector<int> second;
+    eulerSplit(subgraph, first, second);
+    colorRegular(first, degree / 2, firstColor);
+    colorRegular(second, degree / 2, firstColor + degree / 2);
+}
+
+/**
+ * Splits an even regular subgraph in two halves.
+ *
+ * Method Name: eulerSplit
+ *
+ * Purpose: Walks closed trails of unused edges and puts the edges of
+ * every trail into the two halves in turn. Trails of a bipartite graph
+ * have even length, so every node keeps half of its edges in each half.
+ *
+ * Parameters:
+ * - subgraph: A constant reference to the edges of the subgraph.
+ * - first: A reference to the vector that receives one half.
+ * - second: A reference to the vector that receives the other.
+ *
+ * Preconditions:
+ * - Every node has the same even degree in the subgraph.
+ *
+ * Postconditions:
+ * - The halves are regular with half the degree.
+ */
+void EdgeColoring::eulerSplit(const std::vector<int> &subgraph,
+                              std::vector<int> &first,
+                              std::vector<int> &second) const
+{
+    // Left nodes are 0 to sideNodes - 1, right nodes follow them
+    int nodes = 2 * sideNodes;
+    int count = static_cast<int>(subgraph.size());
+    std::vector<int> offsets(nodes + 1, 0);
+    for (int edge : subgraph)
+    {
+        ++offsets[edgeLeft[edge] + 1];
+        ++offsets[sideNodes + edgeRight[edge] + 1];
+    }
+    for (int node = 0; node < nodes; ++node)
+    {
+        offsets[node + 1] += offsets[node];
+    }
+    std::vector<int> incident(2 * count);
+    std::vector<int> position(offsets.begin(), offsets.end() - 1);
+    for (int local = 0; local < count; ++local)
+    {
+        int edge = subgraph[local];
+        incident[position[edgeLeft[edge]]++] = local;
+        incident[position[sideNodes + edgeRight[edge]]++] = local;
+    }
+
+    std::vector<bool> used(count, false);
+    std::vector<int> next(offsets.begin(), offsets.end() - 1);
+    first.clear();
+    second.clear();
+    first.reserve(count / 2);
+    second.reserve(count / 2);
+    for (int start = 0; start < nodes; ++start)
+    {
+        // Every trail from an even-degree node ends where it started
+        int current = start;
+        bool toFirst = true;
+        while (true)
+        {
+            while (next[current] < offsets[current + 1] &&
+                   used[incident[next[current]]])
+            {
+                ++next[current];
+            }
+            if (next[current] == offsets[current + 1])
+            {
+                break;
+            }
+
+            int local = incident[next[current]];
+            int edge = subgraph[local];
+            used[local] = true;
+            (toFirst ? first : second).push_back(edge);
+            toFirst = !toFirst;
+            current = current < sideNodes ? sideNodes + edgeRight[edge]
+                                          : edgeLeft[edge];
+        }
+    }
+}
+
+/**
+ * Finds a perfect matching of a regular subgraph.
+ *
+ * Method Name: perfectMatching
+ *
+ * Purpose: Runs the Hopcroft-Karp engine on the subgraph, which has a
+ * perfect matching by Hall's theorem.
+ *
+ * Parameters:
+ * - subgraph: A constant reference to the edges of the subgraph.
+ *
+ * Returns: The edges of the matching.
+ *
+ * Preconditions:
+ * - Every node has the same positive degree in the subgraph.
+ *
+ * Postconditions:
+ * - An exception is thrown if the matching is not perfect.
+ */
+std::vector<int> EdgeColoring::perfectMatching(
+    const std::vector<int> &subgraph) const
+{
+    // Group the edges by left node
+    std::vector<int> offsets(sideNodes + 1, 0);
+    for (int edge : subgraph)
+    {
+        ++offsets[edgeLeft[edge] + 1];
+    }
+    for (int node = 0; node < sideNodes; ++node)
+    {
+        offsets[node + 1] += offsets[node];
+    }
+    std::vector<int> targets(subgraph.size());
+    std::vector<int> edgeAt(subgraph.size());
+    std::vector<int> position(offsets.begin(), offsets.end() - 1);
+    for (int edge : subgraph)
+    {
+        int slot = position[edgeLeft[edge]]++;
+        targets[slot] = edgeRight[edge];
+        edgeAt[slot] = edge;
+    }
+
+    HopcroftKarp matcher(sideNodes, sideNodes, offsets, targets);
+    if (matcher.calculateMaxMatching() != sideNodes)
+    {
+        std::cerr << "ERROR: Regular graph has no perfect matching."
+                  << std::endl;
+        throw std::logic_error("Regular graph has no perfect matching.");
+    }
+
+    // Pick one of the parallel edges behind every matched pair
+    const std::vector<int> &leftMatch = matcher.getLeftMatch();
+    std::vector<int> matching;
+    matching.reserve(sideNodes);
+    for (int node = 0; node < sideNodes; ++node)
+    {
+        int slot = offsets[node];
+        while (targets[slot] != leftMatch[node])
+        {
+            ++slot;
+        }
+        matching.push_back(edgeAt[slot]);
+    }
+    return matching;
+}
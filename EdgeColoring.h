@@ -0,0 +1,186 @@
+/*
+ * File: EdgeColoring.h Author: Nicolas Gioanni Purpose: Declaration of
+ * the EdgeColoring class for coloring the edges of a bipartite
+ * multigraph with as many colors as its maximum degree.
+ *
+ * Functionality/Features:
+ * - Declare methods for calculating a proper edge coloring with the
+ *   maximum degree number of colors, which is optimal by Konig's
+ *   theorem.
+ * - Declare methods for reading the color of every edge.
+ *
+ * Assumptions:
+ * - Parallel edges are allowed; every edge gets its own color.
+ * - Nodes of one side whose degrees fit within the maximum degree
+ *   together may share a color class, so they are merged before the
+ *   graph is made regular.
+ */
+
+#ifndef EDGECOLORING_H
+#define EDGECOLORING_H
+
+#include <utility>
+#include <vector>
+
+class EdgeColoring
+{
+public:
+    /**
+     * Constructor for the EdgeColoring class.
+     *
+     * Method Name: EdgeColoring
+     *
+     * Purpose: Stores the edges of the bipartite multigraph.
+     *
+     * Parameters:
+     * - leftNodes: An integer representing the number of left nodes.
+     * - rightNodes: An integer representing the number of right nodes.
+     * - edges: A constant reference to the edges, each a pair of a left
+     *   and a right node.
+     *
+     * Preconditions:
+     * - Every node index is within the range of its side.
+     *
+     * Postconditions:
+     * - A new instance of the EdgeColoring class is created.
+     * - An exception is thrown if an edge is invalid.
+     */
+    EdgeColoring(int leftNodes,
+                 int rightNodes,
+                 const std::vector<std::pair<int, int>> &edges);
+
+    /**
+     * Colors the edges.
+     *
+     * Method Name: solve
+     *
+     * Purpose: Merges small nodes, pads the graph to a regular one and
+     * colors it by divide and conquer: even degrees are halved with an
+     * Euler partition and odd degrees peel off one perfect matching.
+     *
+     * Returns: The number of colors, which is the maximum degree.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The colors are stored.
+     * - An exception is thrown if solving fails.
+     */
+    int solve();
+
+    /**
+     * Get the color of every edge.
+     *
+     * Method Name: getColors
+     *
+     * Purpose: Returns the colors found by solve.
+     *
+     * Preconditions:
+     * - solve was called.
+     *
+     * Postconditions:
+     * - The colors are returned.
+     *
+     * Returns: The color of every edge, from 0 to the maximum degree
+     * minus 1, in input order.
+     */
+    const std::vector<int> &getColors() const;
+
+private:
+    // The number of left nodes
+    int leftNodes;
+
+    // The number of right nodes
+    int rightNodes;
+
+    // The edges as given
+    std::vector<std::pair<int, int>> edges;
+
+    // The number of nodes per side of the regular graph
+    int sideNodes;
+
+    // The left end of every edge of the regular graph
+    std::vector<int> edgeLeft;
+
+    // The right end of every edge of the regular graph
+    std::vector<int> edgeRight;
+
+    // The color of every edge of the regular graph
+    std::vector<int> edgeColor;
+
+    // The color of every input edge
+    std::vector<int> colors;
+
+    /**
+     * Colors a regular subgraph.
+     *
+     * Method Name: colorRegular
+     *
+     * Purpose: Colors the edges with the colors from the first color
+     * on, splitting the subgraph in two halves while its degree is
+     * even and peeling a perfect matching when it is odd.
+     *
+     * Parameters:
+     * - subgraph: A constant reference to the edges of the subgraph.
+     * - degree: The degree of every node of the subgraph.
+     * - firstColor: The first color to use.
+     *
+     * Preconditions:
+     * - Every node has the given degree in the subgraph.
+     *
+     * Postconditions:
+     * - The edges are colored with degree colors.
+     */
+    void colorRegular(const std::vector<int> &subgraph,
+                      int degree,
+                      int firstColor);
+
+    /**
+     * Splits an even regular subgraph in two halves.
+     *
+     * Method Name: eulerSplit
+     *
+     * Purpose: Walks closed trails of unused edges and puts the edges
+     * of every trail into the two halves in turn. Trails of a
+     * bipartite graph have even length, so every node keeps half of
+     * its edges in each half.
+     *
+     * Parameters:
+     * - subgraph: A constant reference to the edges of the subgraph.
+     * - first: A reference to the vector that receives one half.
+     * - second: A reference to the vector that receives the other.
+     *
+     * Preconditions:
+     * - Every node has the same even degree in the subgraph.
+     *
+     * Postconditions:
+     * - The halves are regular with half the degree.
+     */
+    void eulerSplit(const std::vector<int> &subgraph,
+                    std::vector<int> &first,
+                    std::vector<int> &second) const;
+
+    /**
+     * Finds a perfect matching of a regular subgraph.
+     *
+     * Method Name: perfectMatching
+     *
+     * Purpose: Runs the Hopcroft-Karp engine on the subgraph, which has
+     * a perfect matching by Hall's theorem.
+     *
+     * Parameters:
+     * - subgraph: A constant reference to the edges of the subgraph.
+     *
+     * Returns: The edges of the matching.
+     *
+     * Preconditions:
+     * - Every node has the same positive degree in the subgraph.
+     *
+     * Postconditions:
+     * - An exception is thrown if the matching is not perfect.
+     */
+    std::vector<int> perfectMatching(const std::vector<int> &subgraph) const;
+};
+
+#endif
@@ -0,0 +1,401 @@
+/*
+ * File: EngineHistory.cpp Author: Nicolas Gioanni Purpose:
+ * Implementation of the EngineHistory class, providing the history file
+ * of measured solves and the nearest neighbor choice of an engine.
+ *
+ * Functionality/Features:
+ * - Read and append the history file one solve per line.
+ * - Predict runtimes from the inverse distance weighted logarithmic
+ *   runtimes of the nearest solves.
+ * - Fall back to the static rules of EngineRegistry where the history
+ *   knows nothing.
+ *
+ * Assumptions:
+ * - Runtimes grow roughly as a power of the graph size, so logarithms
+ *   of both are compared and averaged.
+ */
+
+#include "EngineHistory.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+    // Writes one solve as a line of the history file
+    void writeRecord(std::ostream &output,
+                     const std::string &engine,
+                     const GraphShape &shape,
+                     double milliseconds)
+    {
+        output << engine << ' ' << shape.nodes << ' ' << shape.edges << ' '
+               << shape.density << ' ' << shape.degreeSkew << ' '
+               << shape.minCapacity << ' ' << shape.maxCapacity << ' '
+               << (shape.unitBipartite ? 1 : 0) << ' ' << shape.leftNodes
+               << ' ' << shape.rightNodes << ' ' << shape.sideDensity << ' '
+               << milliseconds << '\n';
+    }
+}
+
+/**
+ * Constructor for the EngineHistory class.
+ *
+ * Method Name: EngineHistory
+ *
+ * Purpose: Loads the newest solves of a history file, and rewrites the
+ * file with only those once it holds twice as many.
+ *
+ * Parameters:
+ * - filename: A constant reference to the name of the history file.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - A new instance of the EngineHistory class is created.
+ * - Lines that do not hold a solve are skipped.
+ */
+EngineHistory::EngineHistory(const std::string &filename)
+    : filename(filename), solveCount(0)
+{
+    std::ifstream input(filename);
+    std::string line;
+    int lines = 0;
+    while (std::getline(input, line))
+    {
+        ++lines;
+        std::istringstream fields(line);
+        Record entry;
+        int unitBipartite = 0;
+        fields >> entry.engine >> entry.shape.nodes >> entry.shape.edges >>
+            entry.shape.density >> entry.shape.degreeSkew >>
+            entry.shape.minCapacity >> entry.shape.maxCapacity >>
+            unitBipartite >> entry.shape.leftNodes >>
+            entry.shape.rightNodes >> entry.shape.sideDensity >>
+            entry.milliseconds;
+
+        // A line torn by an interrupted run holds no solve
+        if (!fields || entry.milliseconds < 0)
+        {
+            continue;
+        }
+        entry.shape.unitBipartite = unitBipartite != 0;
+        records.push_back(entry);
+    }
+    input.close();
+    solveCount = static_cast<long long>(records.size());
+
+    if (static_cast<int>(records.size()) > MAX_RECORDS)
+    {
+        records.erase(records.begin(), records.end() - MAX_RECORDS);
+    }
+
+    // Keep the file from growing without bound
+    if (lines > 2 * MAX_RECORDS)
+    {
+        std::ofstream output(filename, std::ios::trunc);
+        for (const Record &entry : records)
+        {
+            writeRecord(output, entry.engine, entry.shape,
+                        entry.milliseconds);
+        }
+    }
+}
+
+/**
+ * Records a solve.
+ *
+ * Method Name: record
+ *
+ * Purpose: Adds a solve to the history and appends it to the file.
+ *
+ * Parameters:
+ * - shape: A constant reference to the shape of the graph.
+ * - engine: A constant reference to the name of the engine.
+ * - milliseconds: The runtime of the solve.
+ *
+ * Preconditions:
+ * - The engine name holds no spaces.
+ *
+ * Postconditions:
+ * - The solve is used by later predictions.
+ * - An exception is thrown if the file cannot be written.
+ */
+void EngineHistory::record(const GraphShape &shape,
+                           const std::string &engine,
+                           double milliseconds)
+{
+    std::ofstream output(filename, std::ios::app);
+    if (!output)
+    {
+        std::cerr << "ERROR: Error opening the history file." << std::endl;
+        throw std::runtime_error("Error opening the history file.");
+    }
+    writeRecord(output, engine, shape, milliseconds);
+
+    records.push_back(Record{engine, shape, milliseconds});
+    ++solveCount;
+    if (static_cast<int>(records.size()) > MAX_RECORDS)
+    {
+        records.erase(records.begin());
+    }
+}
+
+/**
+ * Predicts the runtime of an engine.
+ *
+ * Method Name: predict
+ *
+ * Purpose: Averages the logarithmic runtimes of the nearest solves of
+ * the engine, weighted by inverse feature distance.
+ *
+ * Parameters:
+ * - shape: A constant reference to the shape of the graph.
+ * - engine: A constant reference to the name of the engine.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The prediction is returned.
+ *
+ * Returns: The predicted milliseconds, -1 if no solve of the engine is
+ * near enough.
+ */
+double EngineHistory::predict(const GraphShape &shape,
+                              const std::string &engine) const
+{
+    // Collect the near solves of the engine by distance
+    std::vector<std::pair<double, double>> near;
+    for (const Record &entry : records)
+    {
+        if (entry.engine != engine)
+        {
+            continue;
+        }
+        double gap = distance(shape, entry.shape);
+        if (gap <= NEAR_DISTANCE)
+        {
+            near.emplace_back(gap, std::log(entry.milliseconds + 1e-3));
+        }
+    }
+    if (near.empty())
+    {
+        return -1.0;
+    }
+
+    size_t count = std::min(near.size(), static_cast<size_t>(NEIGHBORS));
+    std::partial_sort(near.begin(), near.begin() + count, near.end());
+    double weights = 0.0;
+    double total = 0.0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        double weight = 1.0 / (near[i].first + 0.1);
+        weights += weight;
+        total += weight * near[i].second;
+    }
+    return std::exp(total / weights);
+}
+
+/**
+ * Chooses an engine.
+ *
+ * Method Name: chooseEngine
+ *
+ * Purpose: Returns the candidate with the lowest predicted runtime. The
+ * static choice of EngineRegistry stands in while it has no near
+ * solves, and every EXPLORE_PERIOD-th choice returns the candidate with
+ * the fewest near solves instead. The choices are counted by the solves
+ * in the history file, not the solves in use, so the trials go on once
+ * MAX_RECORDS is reached.
+ *
+ * Parameters:
+ * - shape: A constant reference to the shape of the graph.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The name is returned.
+ *
+ * Returns: The name of the engine.
+ */
+std::string EngineHistory::chooseEngine(const GraphShape &shape) const
+{
+    std::vector<std::string> candidates = getCandidates(shape);
+    std::string fallback = EngineRegistry::selectEngine(shape);
+    if (countNear(shape, fallback) == 0)
+    {
+        return fallback;
+    }
+
+    // Now and then try the engine the history knows least about here;
+    // the records in use stop growing at MAX_RECORDS, so count the
+    // solves of the file instead
+    if (solveCount % EXPLORE_PERIOD == EXPLORE_PERIOD - 1)
+    {
+        std::string least = fallback;
+        int fewest = countNear(shape, fallback);
+        for (const std::string &engine : candidates)
+        {
+            int near = countNear(shape, engine);
+            if (near < fewest)
+            {
+                least = engine;
+                fewest = near;
+            }
+        }
+        return least;
+    }
+
+    std::string best = fallback;
+    double fastest = predict(shape, fallback);
+    for (const std::string &engine : candidates)
+    {
+        double cost = predict(shape, engine);
+        if (cost >= 0 && cost < fastest)
+        {
+            best = engine;
+            fastest = cost;
+        }
+    }
+    return best;
+}
+
+/**
+ * Get the number of solves.
+ *
+ * Method Name: getRecordCount
+ *
+ * Purpose: Returns the number of solves in use.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The count is returned.
+ *
+ * Returns: The number of solves.
+ */
+int EngineHistory::getRecordCount() const
+{
+    return static_cast<int>(records.size());
+}
+
+/**
+ * Lists the candidate engines.
+ *
+ * Method Name: getCandidates
+ *
+ * Purpose: Returns the engines that can win on a graph of this shape;
+ * the matching engines only for unit bipartite networks.
+ *
+ * Parameters:
+ * - shape: A constant reference to the shape of the graph.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The names are returned.
+ *
+ * Returns: The names of the candidate engines.
+ */
+std::vector<std::string> EngineHistory::getCandidates(
+    const GraphShape &shape)
+{
+    std::vector<std::string> candidates = {"pushrelabel",
+                                           "boykovkolmogorov"};
+    if (shape.unitBipartite)
+    {
+        candidates.push_back("hopcroftkarp");
+        candidates.push_back("bitsethopcroftkarp");
+        candidates.push_back("hybrid");
+    }
+    return candidates;
+}
+
+/**
+ * Measures the distance between two shapes.
+ *
+ * Method Name: distance
+ *
+ * Purpose: Compares the sizes, skews and capacity ranges on a
+ * logarithmic scale next to the densities, so a step of 1 is about a
+ * doubling.
+ *
+ * Parameters:
+ * - first: A constant reference to the first shape.
+ * - second: A constant reference to the second shape.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The distance is returned.
+ *
+ * Returns: The distance between the shapes.
+ */
+double EngineHistory::distance(const GraphShape &first,
+                               const GraphShape &second)
+{
+    // The features of a shape, scaled so a step of 1 matters about as
+    // much as a doubling of the graph
+    auto features = [](const GraphShape &shape)
+    {
+        return std::vector<double>{
+            std::log2(shape.nodes + 1.0),
+            std::log2(shape.edges + 1.0),
+            std::log2(shape.degreeSkew + 1.0),
+            std::log2(shape.maxCapacity - shape.minCapacity + 1.0) / 8,
+            shape.density * 4,
+            shape.sideDensity * 4,
+            shape.unitBipartite ? 4.0 : 0.0};
+    };
+    std::vector<double> one = features(first);
+    std::vector<double> other = features(second);
+    double sum = 0.0;
+    for (size_t i = 0; i < one.size(); ++i)
+    {
+        sum += (one[i] - other[i]) * (one[i] - other[i]);
+    }
+    return std::sqrt(sum);
+}
+
+/**
+ * Counts the near solves of an engine.
+ *
+ * Method Name: countNear
+ *
+ * Purpose: Counts the solves of the engine within NEAR_DISTANCE of the
+ * shape.
+ *
+ * Parameters:
+ * - shape: A constant reference to the shape of the graph.
+ * - engine: A constant reference to the name of the engine.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The count is returned.
+ *
+ * Returns: The number of near solves.
+ */
+int EngineHistory::countNear(const GraphShape &shape,
+                             const std::string &engine) const
+{
+    int count = 0;
+    for (const Record &entry : records)
+    {
+        if (entry.engine == engine &&
+            distance(shape, entry.shape) <= NEAR_DISTANCE)
+        {
+            ++count;
+        }
+    }
+    return count;
+}
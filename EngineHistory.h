@@ -0,0 +1,249 @@
+/*
+ * File: EngineHistory.h Author: Nicolas Gioanni Purpose: Declaration of
+ * the EngineHistory class for keeping the measured runtime of every
+ * solve in a local file and predicting the fastest engine from it.
+ *
+ * Functionality/Features:
+ * - Declare methods for loading the recent solves from a history file
+ *   and for appending new ones.
+ * - Declare methods for predicting the runtime of an engine on a graph
+ *   from the nearest recorded graphs of that engine.
+ * - Declare methods for choosing an engine, with a periodic trial of
+ *   the least known engine so the history keeps up with the workload.
+ *
+ * Assumptions:
+ * - The history file holds one solve per line as the engine name, the
+ *   ten GraphShape fields and the runtime in milliseconds, separated by
+ *   spaces.
+ * - Only the newest MAX_RECORDS solves are used, so old solves age out
+ *   as the workload drifts.
+ * - The trial of the least known engine is timed by the count of solves
+ *   in the file, which keeps growing past MAX_RECORDS; the count of
+ *   solves in use stops there and would fix the trials on or off.
+ * - A missing file is an empty history.
+ */
+
+#ifndef ENGINEHISTORY_H
+#define ENGINEHISTORY_H
+
+#include "EngineRegistry.h"
+#include <string>
+#include <vector>
+
+class EngineHistory
+{
+public:
+    // The number of newest solves that are kept
+    static constexpr int MAX_RECORDS = 4096;
+
+    // The number of nearest solves of an engine used for a prediction
+    static constexpr int NEIGHBORS = 4;
+
+    // The feature distance beyond which a solve says nothing about a
+    // graph
+    static constexpr double NEAR_DISTANCE = 2.0;
+
+    // One of this many choices tries the least known engine instead
+    static constexpr int EXPLORE_PERIOD = 16;
+
+    /**
+     * Constructor for the EngineHistory class.
+     *
+     * Method Name: EngineHistory
+     *
+     * Purpose: Loads the newest solves of a history file, and rewrites
+     * the file with only those once it holds twice as many.
+     *
+     * Parameters:
+     * - filename: A constant reference to the name of the history file.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - A new instance of the EngineHistory class is created.
+     * - Lines that do not hold a solve are skipped.
+     */
+    explicit EngineHistory(const std::string &filename);
+
+    /**
+     * Records a solve.
+     *
+     * Method Name: record
+     *
+     * Purpose: Adds a solve to the history and appends it to the file.
+     *
+     * Parameters:
+     * - shape: A constant reference to the shape of the graph.
+     * - engine: A constant reference to the name of the engine.
+     * - milliseconds: The runtime of the solve.
+     *
+     * Preconditions:
+     * - The engine name holds no spaces.
+     *
+     * Postconditions:
+     * - The solve is used by later predictions.
+     * - An exception is thrown if the file cannot be written.
+     */
+    void record(const GraphShape &shape,
+                const std::string &engine,
+                double milliseconds);
+
+    /**
+     * Predicts the runtime of an engine.
+     *
+     * Method Name: predict
+     *
+     * Purpose: Averages the logarithmic runtimes of the nearest solves
+     * of the engine, weighted by inverse feature distance.
+     *
+     * Parameters:
+     * - shape: A constant reference to the shape of the graph.
+     * - engine: A constant reference to the name of the engine.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The prediction is returned.
+     *
+     * Returns: The predicted milliseconds, -1 if no solve of the engine
+     * is near enough.
+     */
+    double predict(const GraphShape &shape, const std::string &engine) const;
+
+    /**
+     * Chooses an engine.
+     *
+     * Method Name: chooseEngine
+     *
+     * Purpose: Returns the candidate with the lowest predicted runtime.
+     * The static choice of EngineRegistry stands in while it has no
+     * near solves, and every EXPLORE_PERIOD-th choice returns the
+     * candidate with the fewest near solves instead. The choices are
+     * counted by the solves in the history file, not the solves in
+     * use, so the trials go on once MAX_RECORDS is reached.
+     *
+     * Parameters:
+     * - shape: A constant reference to the shape of the graph.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The name is returned.
+     *
+     * Returns: The name of the engine.
+     */
+    std::string chooseEngine(const GraphShape &shape) const;
+
+    /**
+     * Get the number of solves.
+     *
+     * Method Name: getRecordCount
+     *
+     * Purpose: Returns the number of solves in use.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The count is returned.
+     *
+     * Returns: The number of solves.
+     */
+    int getRecordCount() const;
+
+private:
+    // One recorded solve
+    struct Record
+    {
+        // The name of the engine
+        std::string engine;
+
+        // The shape of the graph
+        GraphShape shape;
+
+        // The runtime in milliseconds
+        double milliseconds;
+    };
+
+    // The name of the history file
+    std::string filename;
+
+    // The solves in use, oldest first
+    std::vector<Record> records;
+
+    // The number of solves in the history file, including the ones too
+    // old to be in use
+    long long solveCount;
+
+    /**
+     * Lists the candidate engines.
+     *
+     * Method Name: getCandidates
+     *
+     * Purpose: Returns the engines that can win on a graph of this
+     * shape; the matching engines only for unit bipartite networks.
+     *
+     * Parameters:
+     * - shape: A constant reference to the shape of the graph.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The names are returned.
+     *
+     * Returns: The names of the candidate engines.
+     */
+    static std::vector<std::string> getCandidates(const GraphShape &shape);
+
+    /**
+     * Measures the distance between two shapes.
+     *
+     * Method Name: distance
+     *
+     * Purpose: Compares the sizes, skews and capacity ranges on a
+     * logarithmic scale next to the densities, so a step of 1 is about
+     * a doubling.
+     *
+     * Parameters:
+     * - first: A constant reference to the first shape.
+     * - second: A constant reference to the second shape.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The distance is returned.
+     *
+     * Returns: The distance between the shapes.
+     */
+    static double distance(const GraphShape &first,
+                           const GraphShape &second);
+
+    /**
+     * Counts the near solves of an engine.
+     *
+     * Method Name: countNear
+     *
+     * Purpose: Counts the solves of the engine within NEAR_DISTANCE of
+     * the shape.
+     *
+     * Parameters:
+     * - shape: A constant reference to the shape of the graph.
+     * - engine: A constant reference to the name of the engine.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The count is returned.
+     *
+     * Returns: The number of near solves.
+     */
+    int countNear(const GraphShape &shape, const std::string &engine) const;
+};
+
+#endif
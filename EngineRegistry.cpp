@@ -0,0 +1,601 @@
+/*
+ * File: EngineRegistry.cpp Author: Nicolas Gioanni Purpose:
+ * Implementation of the EngineRegistry class, providing the built-in
+ * engines behind one interface and the automatic choice between them.
+ *
+ * Functionality/Features:
+ * - Wrap the FlowNetwork engines so they build the CSR network from the
+ *   graph and write the residual capacities back into it.
+ * - Wrap the matching engines so they read the two sides of a unit
+ *   bipartite network and write every matched pair back as one unit of
+ *   flow along source, left, right and sink.
+ * - Keep the engines in a name table that is filled on first use.
+ * - Time every solve of the learned engine and add it to the history
+ *   file that its next choice is made from. The file lives in the
+ *   user's cache directory unless another one is set, so solving never
+ *   writes to the working directory.
+ *
+ * Assumptions:
+ * - Every engine leaves the graph in the same residual form as
+ *   FordFulkerson, so the results print the same way.
+ */
+
+#include "EngineRegistry.h"
+#include "BitsetHopcroftKarp.h"
+#include "BoykovKolmogorov.h"
+#include "EngineHistory.h"
+#include "FlowNetwork.h"
+#include "FordFulkerson.h"
+#include "HopcroftKarp.h"
+#include "HybridMatching.h"
+#include "PushRelabel.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+
+namespace
+{
+    // The side product from which the bitset matching engine is faster
+    constexpr long long LARGE_SIDES = 4000000;
+
+    // The side density from which the bitset matching engine is faster
+    constexpr double DENSE_SIDES = 0.1;
+
+    // The highest average degree still solved by Boykov-Kolmogorov
+    constexpr double SPARSE_DEGREE = 16.0;
+
+    // The highest degree skew still solved by Boykov-Kolmogorov
+    constexpr double EVEN_SKEW = 4.0;
+
+    // Checks that the source and sink are nodes of the graph
+    void checkTerminals(const Graph &graph, int source, int sink)
+    {
+        if (source < 0 || source >= graph.getNodes() ||
+            sink < 0 || sink >= graph.getNodes() || source == sink)
+        {
+            std::cerr << "ERROR: Source or sink is out of valid range."
+                      << std::endl;
+            throw std::out_of_range("Source or sink is out of valid range.");
+        }
+    }
+
+    // A FlowNetwork engine solving a graph through a CSR copy
+    template <typename Solver>
+    class NetworkEngine : public MaxFlowEngine
+    {
+    public:
+        // Keeps the graph to solve
+        explicit NetworkEngine(Graph &graph) : graph(graph) {}
+
+        // Solves the CSR copy and writes every residual back
+        void calculateMaxFlow(int source, int sink) override
+        {
+            checkTerminals(graph, source, sink);
+            FlowNetwork network(graph);
+            Solver solver(network);
+            solver.calculateMaxFlow(source, sink);
+
+            std::vector<std::vector<int>> &matrix =
+                graph.adjustAdjacencyMatrix();
+            for (int tail = 0; tail < network.getNodes(); ++tail)
+            {
+                for (int arc = network.arcBegin(tail);
+                     arc < network.arcEnd(tail); ++arc)
+                {
+                    matrix[tail][network.getHead(arc)] =
+                        static_cast<int>(network.getResidual(arc));
+                }
+            }
+        }
+
+    private:
+        // The graph to solve
+        Graph &graph;
+    };
+
+    // A matching engine solving a unit bipartite network
+    template <typename Solver>
+    class MatchingEngine : public MaxFlowEngine
+    {
+    public:
+        // Keeps the graph to solve
+        explicit MatchingEngine(Graph &graph) : graph(graph) {}
+
+        // Matches the two sides and writes every pair back as flow
+        void calculateMaxFlow(int source, int sink) override
+        {
+            GraphShape shape = EngineRegistry::measure(graph, source, sink);
+            if (!shape.unitBipartite)
+            {
+                std::cerr << "ERROR: Graph is not a unit bipartite network."
+                          << std::endl;
+                throw std::invalid_argument(
+                    "Graph is not a unit bipartite network.");
+            }
+
+            // Number the left nodes after the source and the right
+            // nodes before the sink
+            std::vector<std::vector<int>> &matrix =
+                graph.adjustAdjacencyMatrix();
+            int nodes = graph.getNodes();
+            std::vector<int> left;
+            std::vector<int> right;
+            std::vector<int> index(nodes, -1);
+            for (int node = 0; node < nodes; ++node)
+            {
+                if (node != source && node != sink)
+                {
+                    if (matrix[source][node] > 0)
+                    {
+                        index[node] = static_cast<int>(left.size());
+                        left.push_back(node);
+                    }
+                    else if (matrix[node][sink] > 0)
+                    {
+                        index[node] = static_cast<int>(right.size());
+                        right.push_back(node);
+                    }
+                }
+            }
+
+            // Collect the right neighbors of every left node
+            std::vector<int> offsets(1, 0);
+            std::vector<int> targets;
+            for (int node : left)
+            {
+                for (int other : right)
+                {
+                    if (matrix[node][other] > 0)
+                    {
+                        targets.push_back(index[other]);
+                    }
+                }
+                offsets.push_back(static_cast<int>(targets.size()));
+            }
+
+            Solver solver(static_cast<int>(left.size()),
+                          static_cast<int>(right.size()), offsets, targets);
+            solver.calculateMaxMatching();
+
+            // Send one unit along source, left, right and sink per pair
+            const std::vector<int> &leftMatch = solver.getLeftMatch();
+            for (size_t i = 0; i < left.size(); ++i)
+            {
+                if (leftMatch[i] != -1)
+                {
+                    int from = left[i];
+                    int to = right[leftMatch[i]];
+                    matrix[source][from] -= 1;
+                    matrix[from][source] += 1;
+                    matrix[from][to] -= 1;
+                    matrix[to][from] += 1;
+                    matrix[to][sink] -= 1;
+                    matrix[sink][to] += 1;
+                }
+            }
+        }
+
+    private:
+        // The graph to solve
+        Graph &graph;
+    };
+
+    // The engine that measures the graph and hands it to the best fit
+    class AutoEngine : public MaxFlowEngine
+    {
+    public:
+        // Keeps the graph to solve
+        explicit AutoEngine(Graph &graph) : graph(graph) {}
+
+        // Picks an engine from the shape of the graph and runs it
+        void calculateMaxFlow(int source, int sink) override
+        {
+            GraphShape shape = EngineRegistry::measure(graph, source, sink);
+            EngineRegistry::create(EngineRegistry::selectEngine(shape),
+                                   graph)
+                ->calculateMaxFlow(source, sink);
+        }
+
+    private:
+        // The graph to solve
+        Graph &graph;
+    };
+
+    // The name of the history file of the learned engine, empty until
+    // it is set or first resolved to the per-user cache
+    std::string &historyFile()
+    {
+        static std::string name;
+        return name;
+    }
+
+    // Returns the history file, resolving the default under the user's
+    // cache directory and creating that directory on first use; empty
+    // if no cache directory can be found or made
+    std::string resolveHistoryFile()
+    {
+        if (!historyFile().empty())
+        {
+            return historyFile();
+        }
+
+        // The cache directories in order of preference; the last two are
+        // where Windows keeps per-user data when HOME is not set
+        std::filesystem::path directory;
+        const char *cache = std::getenv("XDG_CACHE_HOME");
+        const char *home = std::getenv("HOME");
+        const char *localAppData = std::getenv("LOCALAPPDATA");
+        const char *appData = std::getenv("APPDATA");
+        if (cache != nullptr && std::filesystem::path(cache).is_absolute())
+        {
+            directory = cache;
+        }
+        else if (home != nullptr && home[0] != '\0')
+        {
+            directory = std::filesystem::path(home) / ".cache";
+        }
+        else if (localAppData != nullptr && localAppData[0] != '\0')
+        {
+            directory = localAppData;
+        }
+        else if (appData != nullptr && appData[0] != '\0')
+        {
+            directory = appData;
+        }
+        else
+        {
+            return "";
+        }
+        directory /= "bipartite-matcher";
+
+        std::error_code error;
+        std::filesystem::create_directories(directory, error);
+        if (error)
+        {
+            return "";
+        }
+        historyFile() = (directory / "engine_history.txt").string();
+        return historyFile();
+    }
+
+    // The engine that picks from the measured history of past solves
+    class LearnedEngine : public MaxFlowEngine
+    {
+    public:
+        // Keeps the graph to solve
+        explicit LearnedEngine(Graph &graph) : graph(graph) {}
+
+        // Picks an engine from the history, runs it and records the time
+        void calculateMaxFlow(int source, int sink) override
+        {
+            GraphShape shape = EngineRegistry::measure(graph, source, sink);
+            std::string filename = resolveHistoryFile();
+
+            // Without a history file, solve with the static choice
+            if (filename.empty())
+            {
+                static bool warned = false;
+                if (!warned)
+                {
+                    std::cerr << "WARNING: No history file could be set, "
+                                 "so the learned engine uses the static "
+                                 "choice."
+                              << std::endl;
+                    warned = true;
+                }
+                EngineRegistry::create(EngineRegistry::selectEngine(shape),
+                                       graph)
+                    ->calculateMaxFlow(source, sink);
+                return;
+            }
+
+            EngineHistory history(filename);
+            std::string name = history.chooseEngine(shape);
+            std::unique_ptr<MaxFlowEngine> engine =
+                EngineRegistry::create(name, graph);
+
+            auto start = std::chrono::steady_clock::now();
+            engine->calculateMaxFlow(source, sink);
+            std::chrono::duration<double, std::milli> elapsed =
+                std::chrono::steady_clock::now() - start;
+            history.record(shape, name, elapsed.count());
+        }
+
+    private:
+        // The graph to solve
+        Graph &graph;
+    };
+
+    // Creates an engine of one type
+    template <typename Engine>
+    std::unique_ptr<MaxFlowEngine> makeEngine(Graph &graph)
+    {
+        return std::make_unique<Engine>(graph);
+    }
+
+    // The engines by name, filled with the built-in engines on first use
+    std::map<std::string, EngineRegistry::Factory> &engines()
+    {
+        static std::map<std::string, EngineRegistry::Factory> table = {
+            {"auto", makeEngine<AutoEngine>},
+            {"learned", makeEngine<LearnedEngine>},
+            {"fordfulkerson", makeEngine<FordFulkerson<>>},
+            {"pushrelabel", makeEngine<NetworkEngine<PushRelabel<>>>},
+            {"boykovkolmogorov",
+             makeEngine<NetworkEngine<BoykovKolmogorov<>>>},
+            {"hopcroftkarp", makeEngine<MatchingEngine<HopcroftKarp>>},
+            {"bitsethopcroftkarp",
+             makeEngine<MatchingEngine<BitsetHopcroftKarp>>},
+            {"hybrid", makeEngine<MatchingEngine<HybridMatching>>}};
+        return table;
+    }
+}
+
+/**
+ * Registers an engine.
+ *
+ * Method Name: registerEngine
+ *
+ * Purpose: Adds an engine under a name, or replaces the engine already
+ * registered under it.
+ *
+ * Parameters:
+ * - name: A constant reference to the name of the engine.
+ * - factory: The function that creates the engine.
+ *
+ * Preconditions:
+ * - No engine is being created on another thread.
+ *
+ * Postconditions:
+ * - The engine can be created by name.
+ * - An exception is thrown if the name is empty or the factory is
+ *   missing.
+ */
+void EngineRegistry::registerEngine(const std::string &name,
+                                    Factory factory)
+{
+    // Check if the engine can be created
+    if (name.empty() || factory == nullptr)
+    {
+        std::cerr << "ERROR: Engine is Invalid." << std::endl;
+        throw std::invalid_argument("Engine is Invalid.");
+    }
+    engines()[name] = factory;
+}
+
+/**
+ * Get the names of the engines.
+ *
+ * Method Name: getNames
+ *
+ * Purpose: Returns the names of all registered engines.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The names are returned.
+ *
+ * Returns: The names in alphabetical order.
+ */
+std::vector<std::string> EngineRegistry::getNames()
+{
+    std::vector<std::string> names;
+    for (const auto &entry : engines())
+    {
+        names.push_back(entry.first);
+    }
+    return names;
+}
+
+/**
+ * Creates an engine by name.
+ *
+ * Method Name: create
+ *
+ * Purpose: Creates the engine registered under the name for a graph.
+ *
+ * Parameters:
+ * - name: A constant reference to the name of the engine.
+ * - graph: A reference to the graph the engine solves.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The engine is returned.
+ * - An exception is thrown if no engine has the name.
+ *
+ * Returns: A unique pointer to the new engine.
+ */
+std::unique_ptr<MaxFlowEngine> EngineRegistry::create(const std::string &name,
+                                                      Graph &graph)
+{
+    auto entry = engines().find(name);
+    if (entry == engines().end())
+    {
+        std::cerr << "ERROR: Engine name is Invalid: " << name << std::endl;
+        throw std::invalid_argument("Engine name is Invalid: " + name);
+    }
+    return entry->second(graph);
+}
+
+/**
+ * Measures the shape of a graph.
+ *
+ * Method Name: measure
+ *
+ * Purpose: Collects the node and edge counts, density, degree skew,
+ * capacity range and bipartite layout of the graph in one pass over its
+ * adjacency matrix.
+ *
+ * Parameters:
+ * - graph: A constant reference to the graph.
+ * - source: An integer representing the source node.
+ * - sink: An integer representing the sink node.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The shape is returned.
+ * - An exception is thrown if the source or sink is out of range.
+ *
+ * Returns: The shape of the graph.
+ */
+GraphShape EngineRegistry::measure(const Graph &graph, int source, int sink)
+{
+    checkTerminals(graph, source, sink);
+    const std::vector<std::vector<int>> &matrix = graph.getAdjacencyMatrix();
+    int nodes = graph.getNodes();
+
+    // Mark the nodes fed by the source and the nodes feeding the sink
+    std::vector<int> side(nodes, 0);
+    for (int node = 0; node < nodes; ++node)
+    {
+        if (node != source && node != sink)
+        {
+            side[node] = (matrix[source][node] > 0 ? 1 : 0) |
+                         (matrix[node][sink] > 0 ? 2 : 0);
+        }
+    }
+
+    GraphShape shape = {nodes, 0, 0.0, 1.0, 0, 0, true, 0, 0, 0.0};
+    long long middleEdges = 0;
+    int maxDegree = 0;
+    for (int tail = 0; tail < nodes; ++tail)
+    {
+        int degree = 0;
+        for (int head = 0; head < nodes; ++head)
+        {
+            int capacity = matrix[tail][head];
+            if (capacity <= 0)
+            {
+                continue;
+            }
+            ++degree;
+            shape.minCapacity = shape.edges == 0
+                                    ? capacity
+                                    : std::min(shape.minCapacity, capacity);
+            shape.maxCapacity = std::max(shape.maxCapacity, capacity);
+            ++shape.edges;
+
+            // Every edge must enter the left side, cross or leave the
+            // right side
+            bool middle = side[tail] == 1 && side[head] == 2;
+            middleEdges += middle ? 1 : 0;
+            shape.unitBipartite =
+                shape.unitBipartite &&
+                (middle ||
+                 (tail == source && side[head] == 1 && capacity == 1) ||
+                 (side[tail] == 2 && head == sink && capacity == 1));
+        }
+        maxDegree = std::max(maxDegree, degree);
+    }
+
+    for (int node = 0; node < nodes; ++node)
+    {
+        shape.leftNodes += side[node] == 1 ? 1 : 0;
+        shape.rightNodes += side[node] == 2 ? 1 : 0;
+        shape.unitBipartite = shape.unitBipartite && side[node] != 3;
+    }
+    if (nodes > 1)
+    {
+        shape.density = static_cast<double>(shape.edges) /
+                        (static_cast<double>(nodes) * (nodes - 1));
+    }
+    if (shape.edges > 0)
+    {
+        shape.degreeSkew = maxDegree * static_cast<double>(nodes) /
+                           static_cast<double>(shape.edges);
+    }
+    if (shape.leftNodes > 0 && shape.rightNodes > 0)
+    {
+        shape.sideDensity =
+            static_cast<double>(middleEdges) /
+            (static_cast<double>(shape.leftNodes) * shape.rightNodes);
+    }
+    return shape;
+}
+
+/**
+ * Picks the engine for a shape.
+ *
+ * Method Name: selectEngine
+ *
+ * Purpose: Returns the built-in engine that was fastest on graphs of
+ * this shape in our benchmarks.
+ *
+ * Parameters:
+ * - shape: A constant reference to the shape of the graph.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The name is returned.
+ *
+ * Returns: The name of the engine.
+ */
+std::string EngineRegistry::selectEngine(const GraphShape &shape)
+{
+    // Unit bipartite networks go to a matching engine; the bitset rows
+    // pay off once both sides are large and the sides are not sparse
+    if (shape.unitBipartite)
+    {
+        if (static_cast<long long>(shape.leftNodes) * shape.rightNodes >=
+                LARGE_SIDES &&
+            shape.sideDensity >= DENSE_SIDES)
+        {
+            return "bitsethopcroftkarp";
+        }
+        return "hopcroftkarp";
+    }
+
+    // Boykov-Kolmogorov wins on low, even degrees such as grids; hubs
+    // and higher degrees favor push-relabel
+    double averageDegree =
+        shape.nodes == 0 ? 0.0
+                         : static_cast<double>(shape.edges) / shape.nodes;
+    if (averageDegree <= SPARSE_DEGREE && shape.degreeSkew <= EVEN_SKEW)
+    {
+        return "boykovkolmogorov";
+    }
+    return "pushrelabel";
+}
+
+/**
+ * Sets the history file.
+ *
+ * Method Name: setHistoryFile
+ *
+ * Purpose: Sets the file the learned engine reads its past solves from
+ * and appends every new solve to, in place of the default
+ * $XDG_CACHE_HOME/bipartite-matcher/engine_history.txt, or
+ * ~/.cache/bipartite-matcher/engine_history.txt without that variable,
+ * or the same under %LOCALAPPDATA% or %APPDATA% without HOME. With none
+ * of them the learned engine warns and uses the static choice.
+ *
+ * Parameters:
+ * - filename: A constant reference to the name of the file.
+ *
+ * Preconditions:
+ * - No learned engine is solving on another thread.
+ *
+ * Postconditions:
+ * - The file is used by the next learned solve.
+ * - An exception is thrown if the name is empty.
+ */
+void EngineRegistry::setHistoryFile(const std::string &filename)
+{
+    if (filename.empty())
+    {
+        std::cerr << "ERROR: History file name is Invalid." << std::endl;
+        throw std::invalid_argument("History file name is Invalid.");
+    }
+    historyFile() = filename;
+}
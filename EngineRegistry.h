@@ -0,0 +1,208 @@
+/*
+ * File: EngineRegistry.h Author: Nicolas Gioanni Purpose: Declaration
+ * of the EngineRegistry class for creating maximum flow and matching
+ * engines by name, including an automatic choice from the shape of the
+ * graph.
+ *
+ * Functionality/Features:
+ * - Declare methods for registering engines under a name and for
+ *   listing and creating them.
+ * - Declare methods for measuring cheap statistics of a graph and for
+ *   picking the engine that is fastest for that shape.
+ * - Declare methods for naming the history file of the "learned"
+ *   engine, which picks from the measured runtimes of past solves.
+ *
+ * Assumptions:
+ * - The built-in engines are "auto", "learned", "fordfulkerson",
+ *   "pushrelabel", "boykovkolmogorov", "hopcroftkarp",
+ *   "bitsethopcroftkarp" and "hybrid".
+ * - The three matching engines only accept unit bipartite networks, as
+ *   built by Graph::connectSourceAndSinkNodes.
+ * - Engines are registered before solving starts on other threads.
+ */
+
+#ifndef ENGINEREGISTRY_H
+#define ENGINEREGISTRY_H
+
+#include "Graph.h"
+#include "MaxFlowEngine.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+// Cheap statistics of a graph for choosing an engine
+struct GraphShape
+{
+    // The number of nodes, source and sink included
+    int nodes;
+
+    // The number of node pairs with positive capacity
+    long long edges;
+
+    // The edges over the number of ordered node pairs
+    double density;
+
+    // The largest out-degree over the average out-degree
+    double degreeSkew;
+
+    // The smallest positive capacity, 0 without edges
+    int minCapacity;
+
+    // The largest capacity, 0 without edges
+    int maxCapacity;
+
+    // True if the graph is a unit-capacity bipartite matching network
+    bool unitBipartite;
+
+    // The number of left nodes of a bipartite network
+    int leftNodes;
+
+    // The number of right nodes of a bipartite network
+    int rightNodes;
+
+    // The left to right edges over leftNodes * rightNodes
+    double sideDensity;
+};
+
+class EngineRegistry
+{
+public:
+    // Creates an engine for a graph
+    typedef std::unique_ptr<MaxFlowEngine> (*Factory)(Graph &graph);
+
+    /**
+     * Registers an engine.
+     *
+     * Method Name: registerEngine
+     *
+     * Purpose: Adds an engine under a name, or replaces the engine
+     * already registered under it.
+     *
+     * Parameters:
+     * - name: A constant reference to the name of the engine.
+     * - factory: The function that creates the engine.
+     *
+     * Preconditions:
+     * - No engine is being created on another thread.
+     *
+     * Postconditions:
+     * - The engine can be created by name.
+     * - An exception is thrown if the name is empty or the factory is
+     *   missing.
+     */
+    static void registerEngine(const std::string &name, Factory factory);
+
+    /**
+     * Get the names of the engines.
+     *
+     * Method Name: getNames
+     *
+     * Purpose: Returns the names of all registered engines.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The names are returned.
+     *
+     * Returns: The names in alphabetical order.
+     */
+    static std::vector<std::string> getNames();
+
+    /**
+     * Creates an engine by name.
+     *
+     * Method Name: create
+     *
+     * Purpose: Creates the engine registered under the name for a
+     * graph.
+     *
+     * Parameters:
+     * - name: A constant reference to the name of the engine.
+     * - graph: A reference to the graph the engine solves.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The engine is returned.
+     * - An exception is thrown if no engine has the name.
+     *
+     * Returns: A unique pointer to the new engine.
+     */
+    static std::unique_ptr<MaxFlowEngine> create(const std::string &name,
+                                                 Graph &graph);
+
+    /**
+     * Measures the shape of a graph.
+     *
+     * Method Name: measure
+     *
+     * Purpose: Collects the node and edge counts, density, degree
+     * skew, capacity range and bipartite layout of the graph in one
+     * pass over its adjacency matrix.
+     *
+     * Parameters:
+     * - graph: A constant reference to the graph.
+     * - source: An integer representing the source node.
+     * - sink: An integer representing the sink node.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The shape is returned.
+     * - An exception is thrown if the source or sink is out of range.
+     *
+     * Returns: The shape of the graph.
+     */
+    static GraphShape measure(const Graph &graph, int source, int sink);
+
+    /**
+     * Picks the engine for a shape.
+     *
+     * Method Name: selectEngine
+     *
+     * Purpose: Returns the built-in engine that was fastest on graphs
+     * of this shape in our benchmarks.
+     *
+     * Parameters:
+     * - shape: A constant reference to the shape of the graph.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The name is returned.
+     *
+     * Returns: The name of the engine.
+     */
+    static std::string selectEngine(const GraphShape &shape);
+
+    /**
+     * Sets the history file.
+     *
+     * Method Name: setHistoryFile
+     *
+     * Purpose: Sets the file the learned engine reads its past solves
+     * from and appends every new solve to, in place of the default
+     * $XDG_CACHE_HOME/bipartite-matcher/engine_history.txt, or
+     * ~/.cache/bipartite-matcher/engine_history.txt without that
+     * variable, or the same under %LOCALAPPDATA% or %APPDATA% without
+     * HOME. With none of them the learned engine warns and uses the
+     * static choice.
+     *
+     * Parameters:
+     * - filename: A constant reference to the name of the file.
+     *
+     * Preconditions:
+     * - No learned engine is solving on another thread.
+     *
+     * Postconditions:
+     * - The file is used by the next learned solve.
+     * - An exception is thrown if the name is empty.
+     */
+    static void setHistoryFile(const std::string &filename);
+};
+
+#endif
@@ -0,0 +1,263 @@
+/*
+ * File: ExternalMaxFlow.cpp Author: Nicolas Gioanni Purpose:
+ * Implementation of the ExternalMaxFlow class, providing methods for
+ * calculating maximum flow on a file-resident arc file.
+ *
+ * Functionality/Features:
+ * - Calculate the maximum flow in phases of level graphs.
+ * - Build every level with one ordered sweep over the arc file.
+ * - Augment along level-graph paths with per-node current arcs.
+ *
+ * Assumptions:
+ * - Nodes close in index have their arcs close in the file, so the
+ *   sweeps and the advancing current arcs mostly hit cached blocks.
+ */
+
+#include "ExternalMaxFlow.h"
+#include <algorithm>
+#include <climits>
+#include <iostream>
+#include <stdexcept>
+
+/**
+ * Constructor for the ExternalMaxFlow class.
+ *
+ * Method Name: ExternalMaxFlow
+ *
+ * Purpose: Initializes a new instance of the ExternalMaxFlow class.
+ *
+ * Parameters:
+ * - adjacency: A reference to the opened arc file.
+ *
+ * Preconditions:
+ * - The arc file is opened.
+ *
+ * Postconditions:
+ * - A new instance of the ExternalMaxFlow class is created.
+ * - The per-node state is sized to the number of nodes.
+ */
+ExternalMaxFlow::ExternalMaxFlow(DiskAdjacency &adjacency)
+    : depth(adjacency.getNodes(), -1),
+      currentArc(adjacency.getNodes(), 0),
+      adjacency(adjacency)
+{
+}
+
+/**
+ * Calculates the maximum flow in the flow network.
+ *
+ * Method Name: calculateMaxFlow
+ *
+ * Purpose: Calculates the maximum flow from the source to the sink
+ * node, keeping the residual capacities in the arc file.
+ *
+ * Parameters:
+ * - source: An integer representing the source node.
+ * - sink: An integer representing the sink node.
+ *
+ * Returns: The value of the maximum flow.
+ *
+ * Preconditions:
+ * - The source and sink nodes are within the valid range of the arc
+ *   file.
+ *
+ * Postconditions:
+ * - The arc file holds the residual capacities of a maximum flow.
+ * - An exception is thrown if the calculation process fails.
+ */
+long long ExternalMaxFlow::calculateMaxFlow(int source, int sink)
+{
+    try
+    {
+        // Check if source and sink nodes are within valid range
+        if (source < 0 ||
+            source >= adjacency.getNodes() ||
+            sink < 0 ||
+            sink >= adjacency.getNodes() ||
+            source == sink)
+        {
+            std::cerr
+                << "ERROR: Source or sink is out of valid range."
+                << std::endl;
+            throw std::
+                invalid_argument("Source or sink is out of valid range.");
+        }
+
+        long long totalFlow = 0;
+
+        // Continue finding level graphs and augmenting paths
+        while (levelGraph(source, sink))
+        {
+            // Start every node at its first arc for this phase
+            for (int node = 0; node < adjacency.getNodes(); ++node)
+            {
+                currentArc[node] = adjacency.arcBegin(node);
+            }
+
+            long long pushed;
+            while ((pushed = augmentFlowAlongPath(source, sink)) > 0)
+            {
+                totalFlow += pushed;
+            }
+        }
+
+        // Store the final residual capacities
+        adjacency.flush();
+        return totalFlow;
+    }
+    catch (const std::exception &e)
+    {
+        // Output an error message if max flow calculation fails
+        std::cerr
+            << "ERROR: Error in calculateMaxFlow: "
+            << e.what()
+            << std::endl;
+        throw std::runtime_error("Error in calculateMaxFlow: " +
+                                 std::string(e.what()));
+    }
+}
+
+/**
+ * Constructs a level graph by sweeping the arc file.
+ *
+ * Method Name: levelGraph
+ *
+ * Purpose: Runs a breadth-first search level by level, visiting the
+ * nodes of every level in increasing order so their arcs are read in
+ * file order.
+ *
+ * Parameters:
+ * - source: An integer representing the source node.
+ * - sink: An integer representing the sink node.
+ *
+ * Returns: A boolean value indicating if the sink node is reachable
+ * from the source node.
+ *
+ * Preconditions:
+ * - The source and sink nodes are within the valid range.
+ *
+ * Postconditions:
+ * - The depth vector holds the level of every reached node.
+ */
+bool ExternalMaxFlow::levelGraph(int source, int sink)
+{
+    depth.assign(adjacency.getNodes(), -1);
+    depth[source] = 0;
+
+    std::vector<int> frontier(1, source);
+    std::vector<int> nextFrontier;
+
+    // Expand one level at a time
+    while (!frontier.empty())
+    {
+        // Visit the level in node order, which is file order
+        std::sort(frontier.begin(), frontier.end());
+        nextFrontier.clear();
+
+        for (int node : frontier)
+        {
+            long long end = adjacency.arcEnd(node);
+            for (long long arc = adjacency.arcBegin(node); arc < end; ++arc)
+            {
+                DiskArc record = adjacency.readArc(arc);
+                if (record.residual > 0 && depth[record.head] == -1)
+                {
+                    depth[record.head] = depth[node] + 1;
+                    nextFrontier.push_back(record.head);
+                }
+            }
+        }
+
+        // Nodes deeper than the sink are never on a shortest path
+        if (depth[sink] != -1)
+        {
+            return true;
+        }
+        frontier.swap(nextFrontier);
+    }
+
+    // Sink is not reachable
+    return false;
+}
+
+/**
+ * Finds one augmenting path in the level graph and augments it.
+ *
+ * Method Name: augmentFlowAlongPath
+ *
+ * Purpose: Advances from the source along the current arcs of the
+ * level graph, retreating from dead ends, until the sink is reached,
+ * then pushes the bottleneck flow along the path.
+ *
+ * Parameters:
+ * - source: An integer representing the source node.
+ * - sink: An integer representing the sink node.
+ *
+ * Returns: The amount of flow pushed, 0 if no path is left in the
+ * level graph.
+ *
+ * Preconditions:
+ * - levelGraph returned true in the current phase.
+ *
+ * Postconditions:
+ * - The residual capacities along the path are updated.
+ * - Dead-end nodes are removed from the level graph.
+ */
+long long ExternalMaxFlow::augmentFlowAlongPath(int source, int sink)
+{
+    path.clear();
+    std::vector<int> nodes(1, source);
+    int node = source;
+
+    while (node != sink)
+    {
+        // Advance along the first admissible arc of the node
+        bool advanced = false;
+        long long end = adjacency.arcEnd(node);
+        for (; currentArc[node] < end; ++currentArc[node])
+        {
+            DiskArc record = adjacency.readArc(currentArc[node]);
+            if (record.residual > 0 &&
+                depth[record.head] == depth[node] + 1)
+            {
+                path.emplace_back(currentArc[node], record.residual);
+                node = record.head;
+                nodes.push_back(node);
+                advanced = true;
+                break;
+            }
+        }
+
+        if (advanced)
+        {
+            continue;
+        }
+
+        // Reached the source, no augmenting path left in this phase
+        if (node == source)
+        {
+            return 0;
+        }
+
+        // Remove the dead end and retreat to the previous node
+        depth[node] = -1;
+        nodes.pop_back();
+        path.pop_back();
+        node = nodes.back();
+        ++currentArc[node];
+    }
+
+    // Find the bottleneck along the path
+    long long pathFlow = LLONG_MAX;
+    for (const std::pair<long long, long long> &step : path)
+    {
+        pathFlow = std::min(pathFlow, step.second);
+    }
+
+    // Update the residual capacities along the path
+    for (const std::pair<long long, long long> &step : path)
+    {
+        adjacency.pushFlow(step.first, pathFlow);
+    }
+    return pathFlow;
+}
@@ -0,0 +1,136 @@
+/*
+ * File: ExternalMaxFlow.h Author: Nicolas Gioanni Purpose:
+ * Declaration of the ExternalMaxFlow class for calculating the
+ * maximum flow of a network whose arcs are stored in a DiskAdjacency
+ * file.
+ *
+ * Functionality/Features:
+ * - Declare methods for calculating the maximum flow out of core.
+ * - Declare methods for constructing level graphs by sweeping the
+ *   arc file in file order.
+ * - Declare methods for finding augmenting paths with per-node
+ *   current arcs so every arc is read at most once per phase.
+ *
+ * Assumptions:
+ * - The per-node state (depth and current arc) fits in memory.
+ * - The arc file pairs every arc with its reverse arc.
+ */
+
+#ifndef EXTERNALMAXFLOW_H
+#define EXTERNALMAXFLOW_H
+
+#include "DiskAdjacency.h"
+#include <utility>
+#include <vector>
+
+class ExternalMaxFlow
+{
+public:
+    /**
+     * Constructor for the ExternalMaxFlow class.
+     *
+     * Method Name: ExternalMaxFlow
+     *
+     * Purpose: Initializes a new instance of the ExternalMaxFlow
+     * class.
+     *
+     * Parameters:
+     * - adjacency: A reference to the opened arc file.
+     *
+     * Preconditions:
+     * - The arc file is opened.
+     *
+     * Postconditions:
+     * - A new instance of the ExternalMaxFlow class is created.
+     * - The per-node state is sized to the number of nodes.
+     */
+    ExternalMaxFlow(DiskAdjacency &adjacency);
+
+    /**
+     * Calculates the maximum flow in the flow network.
+     *
+     * Method Name: calculateMaxFlow
+     *
+     * Purpose: Calculates the maximum flow from the source to the
+     * sink node, keeping the residual capacities in the arc file.
+     *
+     * Parameters:
+     * - source: An integer representing the source node.
+     * - sink: An integer representing the sink node.
+     *
+     * Returns: The value of the maximum flow.
+     *
+     * Preconditions:
+     * - The source and sink nodes are within the valid range of the
+     *   arc file.
+     *
+     * Postconditions:
+     * - The arc file holds the residual capacities of a maximum flow.
+     * - An exception is thrown if the calculation process fails.
+     */
+    long long calculateMaxFlow(int source, int sink);
+
+private:
+    // The depth of each node in the level graph
+    std::vector<int> depth;
+
+    // The next arc to try from each node in the current phase
+    std::vector<long long> currentArc;
+
+    // The arcs of the path being built, with their residuals
+    std::vector<std::pair<long long, long long>> path;
+
+    // The arc file holding the residual graph
+    DiskAdjacency &adjacency;
+
+    /**
+     * Constructs a level graph by sweeping the arc file.
+     *
+     * Method Name: levelGraph
+     *
+     * Purpose: Runs a breadth-first search level by level, visiting
+     * the nodes of every level in increasing order so their arcs are
+     * read in file order.
+     *
+     * Parameters:
+     * - source: An integer representing the source node.
+     * - sink: An integer representing the sink node.
+     *
+     * Returns: A boolean value indicating if the sink node is
+     * reachable from the source node.
+     *
+     * Preconditions:
+     * - The source and sink nodes are within the valid range.
+     *
+     * Postconditions:
+     * - The depth vector holds the level of every reached node.
+     */
+    bool levelGraph(int source, int sink);
+
+    /**
+     * Finds one augmenting path in the level graph and augments it.
+     *
+     * Method Name: augmentFlowAlongPath
+     *
+     * Purpose: Advances from the source along the current arcs of the
+     * level graph, retreating from dead ends, until the sink is
+     * reached, then pushes the bottleneck flow along the path.
+     *
+     * Parameters:
+     * - source: An integer representing the source node.
+     * - sink: An integer representing the sink node.
+     *
+     * Returns: The amount of flow pushed, 0 if no path is left in
+     * the level graph.
+     *
+     * Preconditions:
+     * - levelGraph returned true in the current phase.
+     *
+     * Postconditions:
+     * - The residual capacities along the path are updated.
+     * - Dead-end nodes are removed from the level graph.
+     */
+    long long augmentFlowAlongPath(int source, int sink);
+};
+
+#endif
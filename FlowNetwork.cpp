@@ -0,0 +1,301 @@
+/*
+ * File: FlowNetwork.cpp Author: Nicolas Gioanni Purpose:
+ * Implementation of the FlowNetwork class, providing methods for
+ * building and updating a CSR residual flow network.
+ *
+ * Functionality/Features:
+ * - Build the network from an arc list or from a Graph.
+ * - Change capacities and reset the flow.
+ * - Look up arcs by their end nodes.
+ *
+ * Assumptions:
+ * - Arcs of a node are stored in the order they were given.
+ */
+
+#include "FlowNetwork.h"
+#include <iostream>
+#include <stdexcept>
+
+/**
+ * Constructor for the FlowNetwork class.
+ *
+ * Method Name: FlowNetwork
+ *
+ * Purpose: Builds the CSR network from a list of arcs.
+ *
+ * Parameters:
+ * - nodes: An integer representing the number of nodes.
+ * - arcs: A constant reference to the arcs of the network. Arc i of
+ *   the list can be found again with getInputArc(i).
+ *
+ * Preconditions:
+ * - Every tail and head is within the range of the nodes.
+ *
+ * Postconditions:
+ * - The network is built with zero flow.
+ * - An exception is thrown if an arc is invalid.
+ */
+FlowNetwork::FlowNetwork(int nodes, const std::vector<FlowArc> &arcs)
+    : nodes(nodes)
+{
+    // Check if the number of nodes is valid
+    if (nodes < 1)
+    {
+        std::cerr
+            << "ERROR: A flow network needs at least one node."
+            << std::endl;
+        throw std::
+            invalid_argument("A flow network needs at least one node.");
+    }
+
+    buildArcs(arcs);
+}
+
+/**
+ * Constructor for the FlowNetwork class.
+ *
+ * Method Name: FlowNetwork
+ *
+ * Purpose: Builds the CSR network from the adjacency matrix of a
+ * graph, with one arc pair per connected node pair.
+ *
+ * Parameters:
+ * - graph: A constant reference to the graph.
+ *
+ * Preconditions:
+ * - The graph is initialized with valid capacities.
+ *
+ * Postconditions:
+ * - The network is built with zero flow.
+ */
+FlowNetwork::FlowNetwork(const Graph &graph) : nodes(graph.getNodes())
+{
+    const std::vector<std::vector<int>> &matrix =
+        graph.getAdjacencyMatrix();
+
+    // Pair the two directions of every connected node pair
+    std::vector<FlowArc> arcs;
+    for (int u = 0; u < nodes; ++u)
+    {
+        for (int v = u + 1; v < nodes; ++v)
+        {
+            if (matrix[u][v] > 0 || matrix[v][u] > 0)
+            {
+                arcs.push_back({u,
+                                v,
+                                matrix[u][v] > 0 ? matrix[u][v] : 0,
+                                matrix[v][u] > 0 ? matrix[v][u] : 0});
+            }
+        }
+    }
+
+    buildArcs(arcs);
+}
+
+/**
+ * Get the number of nodes in the network.
+ *
+ * Method Name: getNodes
+ *
+ * Purpose: Returns the number of nodes in the network.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The number of nodes is returned.
+ *
+ * Returns: An integer representing the number of nodes.
+ */
+int FlowNetwork::getNodes() const
+{
+    return nodes;
+}
+
+/**
+ * Get the number of arcs in the network.
+ *
+ * Method Name: getArcs
+ *
+ * Purpose: Returns the number of arcs, counting reverse arcs.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The number of arcs is returned.
+ *
+ * Returns: An integer representing the number of arcs.
+ */
+int FlowNetwork::getArcs() const
+{
+    return static_cast<int>(heads.size());
+}
+
+/**
+ * Set the capacity of an arc.
+ *
+ * Method Name: setCapacity
+ *
+ * Purpose: Changes the capacity of the arc while keeping its flow, so
+ * the residual capacity may become negative.
+ *
+ * Parameters:
+ * - arc: The index of the arc.
+ * - value: The new capacity.
+ *
+ * Preconditions:
+ * - The value is not negative.
+ *
+ * Postconditions:
+ * - The capacity and residual capacity of the arc are updated.
+ */
+void FlowNetwork::setCapacity(int arc, long long value)
+{
+    residual[arc] += value - capacity[arc];
+    capacity[arc] = value;
+}
+
+/**
+ * Find the arc between two nodes.
+ *
+ * Method Name: findArc
+ *
+ * Purpose: Returns the arc leaving tail and entering head.
+ *
+ * Parameters:
+ * - tail: An integer representing the node the arc leaves.
+ * - head: An integer representing the node the arc enters.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The index of the arc is returned.
+ *
+ * Returns: The index of the arc, -1 if there is none.
+ */
+int FlowNetwork::findArc(int tail, int head) const
+{
+    // Check if the tail is within valid range
+    if (tail < 0 || tail >= nodes)
+    {
+        return -1;
+    }
+
+    // Scan the arcs of the tail for the head
+    for (int arc = offsets[tail]; arc < offsets[tail + 1]; ++arc)
+    {
+        if (heads[arc] == head)
+        {
+            return arc;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Get the arc built from an input arc.
+ *
+ * Method Name: getInputArc
+ *
+ * Purpose: Returns the CSR index of arc i of the constructor list.
+ *
+ * Parameters:
+ * - index: The position of the arc in the constructor list.
+ *
+ * Preconditions:
+ * - The network was built from an arc list.
+ *
+ * Postconditions:
+ * - The index of the arc is returned.
+ *
+ * Returns: The CSR index of the arc.
+ */
+int FlowNetwork::getInputArc(int index) const
+{
+    return inputArcs[index];
+}
+
+/**
+ * Remove all flow from the network.
+ *
+ * Method Name: resetFlow
+ *
+ * Purpose: Sets every residual capacity back to the capacity.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The network carries no flow.
+ */
+void FlowNetwork::resetFlow()
+{
+    residual = capacity;
+}
+
+/**
+ * Build the CSR arrays from a list of arcs.
+ *
+ * Method Name: buildArcs
+ *
+ * Purpose: Counts the arcs of every node, places every arc and its
+ * reverse arc and links them together.
+ *
+ * Parameters:
+ * - arcs: A constant reference to the arcs of the network.
+ *
+ * Preconditions:
+ * - The number of nodes is set.
+ *
+ * Postconditions:
+ * - The CSR arrays hold the network with zero flow.
+ * - An exception is thrown if an arc is invalid.
+ */
+void FlowNetwork::buildArcs(const std::vector<FlowArc> &arcs)
+{
+    // Count the arcs leaving every node
+    offsets.assign(nodes + 1, 0);
+    for (const FlowArc &arc : arcs)
+    {
+        if (arc.tail < 0 || arc.tail >= nodes ||
+            arc.head < 0 || arc.head >= nodes ||
+            arc.tail == arc.head ||
+            arc.capacity < 0 ||
+            arc.reverseCapacity < 0)
+        {
+            std::cerr << "ERROR: Arc is Invalid." << std::endl;
+            throw std::invalid_argument("Arc is Invalid.");
+        }
+        offsets[arc.tail + 1]++;
+        offsets[arc.head + 1]++;
+    }
+    for (int node = 0; node < nodes; ++node)
+    {
+        offsets[node + 1] += offsets[node];
+    }
+
+    // Place every arc and its reverse arc
+    int total = offsets[nodes];
+    heads.resize(total);
+    reverse.resize(total);
+    capacity.resize(total);
+    inputArcs.resize(arcs.size());
+    std::vector<int> fill(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < arcs.size(); ++i)
+    {
+        int forward = fill[arcs[i].tail]++;
+        int backward = fill[arcs[i].head]++;
+        heads[forward] = arcs[i].head;
+        heads[backward] = arcs[i].tail;
+        reverse[forward] = backward;
+        reverse[backward] = forward;
+        capacity[forward] = arcs[i].capacity;
+        capacity[backward] = arcs[i].reverseCapacity;
+        inputArcs[i] = forward;
+    }
+
+    // Start without flow
+    residual = capacity;
+}
@@ -0,0 +1,408 @@
+/*
+ * File: FlowNetwork.h Author: Nicolas Gioanni Purpose: Declaration of
+ * the FlowNetwork class for representing a residual flow network in
+ * compressed sparse row (CSR) form.
+ *
+ * Functionality/Features:
+ * - Declare methods for building the network from an arc list or
+ *   from the adjacency matrix of a Graph.
+ * - Declare methods for iterating over the arcs leaving a node.
+ * - Declare methods for reading and pushing residual capacities.
+ * - Declare methods for changing capacities and resetting the flow.
+ *
+ * Assumptions:
+ * - Every arc is stored next to its paired reverse arc, and the
+ *   flow on an arc is the negated flow on its reverse arc.
+ * - The topology does not change after construction; only the
+ *   capacities and the flow do.
+ */
+
+#ifndef FLOWNETWORK_H
+#define FLOWNETWORK_H
+
+#include "Graph.h"
+#include <vector>
+
+// An arc given to the FlowNetwork constructor
+struct FlowArc
+{
+    // The node the arc leaves
+    int tail;
+
+    // The node the arc enters
+    int head;
+
+    // The capacity from tail to head
+    long long capacity;
+
+    // The capacity from head to tail of the paired reverse arc
+    long long reverseCapacity;
+};
+
+class FlowNetwork
+{
+public:
+    /**
+     * Constructor for the FlowNetwork class.
+     *
+     * Method Name: FlowNetwork
+     *
+     * Purpose: Builds the CSR network from a list of arcs.
+     *
+     * Parameters:
+     * - nodes: An integer representing the number of nodes.
+     * - arcs: A constant reference to the arcs of the network. Arc i
+     *   of the list can be found again with getInputArc(i).
+     *
+     * Preconditions:
+     * - Every tail and head is within the range of the nodes.
+     *
+     * Postconditions:
+     * - The network is built with zero flow.
+     * - An exception is thrown if an arc is invalid.
+     */
+    FlowNetwork(int nodes, const std::vector<FlowArc> &arcs);
+
+    /**
+     * Constructor for the FlowNetwork class.
+     *
+     * Method Name: FlowNetwork
+     *
+     * Purpose: Builds the CSR network from the adjacency matrix of a
+     * graph, with one arc pair per connected node pair.
+     *
+     * Parameters:
+     * - graph: A constant reference to the graph.
+     *
+     * Preconditions:
+     * - The graph is initialized with valid capacities.
+     *
+     * Postconditions:
+     * - The network is built with zero flow.
+     */
+    FlowNetwork(const Graph &graph);
+
+    /**
+     * Get the number of nodes in the network.
+     *
+     * Method Name: getNodes
+     *
+     * Purpose: Returns the number of nodes in the network.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The number of nodes is returned.
+     *
+     * Returns: An integer representing the number of nodes.
+     */
+    int getNodes() const;
+
+    /**
+     * Get the number of arcs in the network.
+     *
+     * Method Name: getArcs
+     *
+     * Purpose: Returns the number of arcs, counting reverse arcs.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The number of arcs is returned.
+     *
+     * Returns: An integer representing the number of arcs.
+     */
+    int getArcs() const;
+
+    /**
+     * Get the first arc of a node.
+     *
+     * Method Name: arcBegin
+     *
+     * Purpose: Returns the index of the first arc leaving the node.
+     *
+     * Parameters:
+     * - node: An integer representing the node.
+     *
+     * Preconditions:
+     * - The node is within the valid range.
+     *
+     * Postconditions:
+     * - The index of the first arc is returned.
+     *
+     * Returns: The index of the first arc leaving the node.
+     */
+    int arcBegin(int node) const { return offsets[node]; }
+
+    /**
+     * Get the end of the arcs of a node.
+     *
+     * Method Name: arcEnd
+     *
+     * Purpose: Returns one past the index of the last arc leaving the
+     * node.
+     *
+     * Parameters:
+     * - node: An integer representing the node.
+     *
+     * Preconditions:
+     * - The node is within the valid range.
+     *
+     * Postconditions:
+     * - One past the index of the last arc is returned.
+     *
+     * Returns: One past the index of the last arc leaving the node.
+     */
+    int arcEnd(int node) const { return offsets[node + 1]; }
+
+    /**
+     * Get the head of an arc.
+     *
+     * Method Name: getHead
+     *
+     * Purpose: Returns the node the arc enters.
+     *
+     * Parameters:
+     * - arc: The index of the arc.
+     *
+     * Preconditions:
+     * - The arc is within the valid range.
+     *
+     * Postconditions:
+     * - The head of the arc is returned.
+     *
+     * Returns: The node the arc enters.
+     */
+    int getHead(int arc) const { return heads[arc]; }
+
+    /**
+     * Get the reverse of an arc.
+     *
+     * Method Name: getReverse
+     *
+     * Purpose: Returns the paired arc in the opposite direction.
+     *
+     * Parameters:
+     * - arc: The index of the arc.
+     *
+     * Preconditions:
+     * - The arc is within the valid range.
+     *
+     * Postconditions:
+     * - The index of the reverse arc is returned.
+     *
+     * Returns: The index of the reverse arc.
+     */
+    int getReverse(int arc) const { return reverse[arc]; }
+
+    /**
+     * Get the residual capacity of an arc.
+     *
+     * Method Name: getResidual
+     *
+     * Purpose: Returns how much more flow the arc can carry.
+     *
+     * Parameters:
+     * - arc: The index of the arc.
+     *
+     * Preconditions:
+     * - The arc is within the valid range.
+     *
+     * Postconditions:
+     * - The residual capacity is returned.
+     *
+     * Returns: The residual capacity of the arc.
+     */
+    long long getResidual(int arc) const { return residual[arc]; }
+
+    /**
+     * Get the capacity of an arc.
+     *
+     * Method Name: getCapacity
+     *
+     * Purpose: Returns the capacity of the arc.
+     *
+     * Parameters:
+     * - arc: The index of the arc.
+     *
+     * Preconditions:
+     * - The arc is within the valid range.
+     *
+     * Postconditions:
+     * - The capacity is returned.
+     *
+     * Returns: The capacity of the arc.
+     */
+    long long getCapacity(int arc) const { return capacity[arc]; }
+
+    /**
+     * Get the flow on an arc.
+     *
+     * Method Name: getFlow
+     *
+     * Purpose: Returns the flow on the arc, which is negative when
+     * the flow runs along the reverse arc.
+     *
+     * Parameters:
+     * - arc: The index of the arc.
+     *
+     * Preconditions:
+     * - The arc is within the valid range.
+     *
+     * Postconditions:
+     * - The flow is returned.
+     *
+     * Returns: The flow on the arc.
+     */
+    long long getFlow(int arc) const
+    {
+        return capacity[arc] - residual[arc];
+    }
+
+    /**
+     * Push flow along an arc.
+     *
+     * Method Name: push
+     *
+     * Purpose: Moves residual capacity from the arc to its reverse
+     * arc.
+     *
+     * Parameters:
+     * - arc: The index of the arc.
+     * - amount: The amount of flow to push.
+     *
+     * Preconditions:
+     * - The amount does not exceed the residual capacity of the arc.
+     *
+     * Postconditions:
+     * - The flow on the arc is increased by the amount.
+     */
+    void push(int arc, long long amount)
+    {
+        residual[arc] -= amount;
+        residual[reverse[arc]] += amount;
+    }
+
+    /**
+     * Set the capacity of an arc.
+     *
+     * Method Name: setCapacity
+     *
+     * Purpose: Changes the capacity of the arc while keeping its
+     * flow, so the residual capacity may become negative.
+     *
+     * Parameters:
+     * - arc: The index of the arc.
+     * - value: The new capacity.
+     *
+     * Preconditions:
+     * - The value is not negative.
+     *
+     * Postconditions:
+     * - The capacity and residual capacity of the arc are updated.
+     */
+    void setCapacity(int arc, long long value);
+
+    /**
+     * Find the arc between two nodes.
+     *
+     * Method Name: findArc
+     *
+     * Purpose: Returns the arc leaving tail and entering head.
+     *
+     * Parameters:
+     * - tail: An integer representing the node the arc leaves.
+     * - head: An integer representing the node the arc enters.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The index of the arc is returned.
+     *
+     * Returns: The index of the arc, -1 if there is none.
+     */
+    int findArc(int tail, int head) const;
+
+    /**
+     * Get the arc built from an input arc.
+     *
+     * Method Name: getInputArc
+     *
+     * Purpose: Returns the CSR index of arc i of the constructor
+     * list.
+     *
+     * Parameters:
+     * - index: The position of the arc in the constructor list.
+     *
+     * Preconditions:
+     * - The network was built from an arc list.
+     *
+     * Postconditions:
+     * - The index of the arc is returned.
+     *
+     * Returns: The CSR index of the arc.
+     */
+    int getInputArc(int index) const;
+
+    /**
+     * Remove all flow from the network.
+     *
+     * Method Name: resetFlow
+     *
+     * Purpose: Sets every residual capacity back to the capacity.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The network carries no flow.
+     */
+    void resetFlow();
+
+private:
+    // The number of nodes in the network
+    int nodes;
+
+    // The first arc of every node, plus the total number of arcs
+    std::vector<int> offsets;
+
+    // The node every arc enters
+    std::vector<int> heads;
+
+    // The paired reverse arc of every arc
+    std::vector<int> reverse;
+
+    // The capacity of every arc
+    std::vector<long long> capacity;
+
+    // The residual capacity of every arc
+    std::vector<long long> residual;
+
+    // The CSR index of every arc of the constructor list
+    std::vector<int> inputArcs;
+
+    /**
+     * Build the CSR arrays from a list of arcs.
+     *
+     * Method Name: buildArcs
+     *
+     * Purpose: Counts the arcs of every node, places every arc and
+     * its reverse arc and links them together.
+     *
+     * Parameters:
+     * - arcs: A constant reference to the arcs of the network.
+     *
+     * Preconditions:
+     * - The number of nodes is set.
+     *
+     * Postconditions:
+     * - The CSR arrays hold the network with zero flow.
+     * - An exception is thrown if an arc is invalid.
+     */
+    void buildArcs(const std::vector<FlowArc> &arcs);
+};
+
+#endif
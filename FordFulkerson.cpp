@@ -9,6 +9,8 @@
  * - Find augmenting paths and update the residual graph.
  * - Initialize internal data structures for the algorithm.
  * - Handle exceptions and errors during the calculation process.
+ * - Wrap the helpers in error handlers only for CheckedPolicy, so the
+ *   UncheckedPolicy loops carry no handlers or range checks.
  *
  * Assumptions:
  * - The graph is a flow network with defined source and sink nodes.
@@ -21,6 +23,39 @@
 #include <iostream>
 #include <climits>
 
+namespace
+{
+    // Runs the body of a helper; a checked build names the helper in
+    // any error that passes through it
+    template <typename CheckPolicy, typename Body>
+    auto runHelper(const char *method, Body &body) -> decltype(body())
+    {
+        if constexpr (!CheckPolicy::CHECKED)
+        {
+            return body();
+        }
+        else
+        {
+            try
+            {
+                return body();
+            }
+            catch (const std::exception &e)
+            {
+                // Output an error message if the helper fails
+                std::cerr
+                    << "ERROR: Error in "
+                    << method
+                    << ": "
+                    << e.what()
+                    << std::endl;
+                throw std::runtime_error("Error in " + std::string(method) +
+                                         ": " + std::string(e.what()));
+            }
+        }
+    }
+}
+
 /**
  * Constructor for the FordFulkerson class.
  *
@@ -35,7 +70,8 @@
  * - A new instance of the FordFulkerson class is created.
  * - The depth and maxFlow vectors are initialized.
  */
-FordFulkerson::FordFulkerson(Graph &graph) : graph(graph)
+template <typename CheckPolicy>
+FordFulkerson<CheckPolicy>::FordFulkerson(Graph &graph) : graph(graph)
 {
     try
     {
@@ -79,8 +115,8 @@ FordFulkerson::FordFulkerson(Graph &graph) : graph(graph)
  * - The maxFlow matrix is updated with the flow values.
  * - An exception is thrown if the calculation process fails.
  */
-void FordFulkerson::calculateMaxFlow(int source,
-                                     int sink)
+template <typename CheckPolicy>
+void FordFulkerson<CheckPolicy>::calculateMaxFlow(int source, int sink)
 {
     try
     {
@@ -151,9 +187,10 @@ void FordFulkerson::calculateMaxFlow(int source,
  * - An exception is thrown if the level graph construction process
  *   fails.
  */
-bool FordFulkerson::levelGraph(int source, int sink)
+template <typename CheckPolicy>
+bool FordFulkerson<CheckPolicy>::levelGraph(int source, int sink)
 {
-    try
+    auto body = [&]()
     {
         int totalNodes = graph.getNodes();
 
@@ -198,18 +235,8 @@ bool FordFulkerson::levelGraph(int source, int sink)
 
         // Sink is not reachable
         return false;
-    }
-    catch (const std::exception &e)
-    {
-        // Output an error message if level graph calculation fails
-        std::cerr
-            << "ERROR: Error in levelGraph: "
-            << e.what()
-            << std::endl;
-        throw std::
-            runtime_error("Error in levelGraph: " +
-                          std::string(e.what()));
-    }
+    };
+    return runHelper<CheckPolicy>("levelGraph", body);
 }
 
 /**
@@ -240,11 +267,12 @@ bool FordFulkerson::levelGraph(int source, int sink)
  *   otherwise.
  * - An exception is thrown if finding an augmenting path fails.
  */
-bool FordFulkerson::findAugmentingPath(std::vector<int> &path,
-                                       int source,
-                                       int sink)
+template <typename CheckPolicy>
+bool FordFulkerson<CheckPolicy>::findAugmentingPath(std::vector<int> &path,
+                                                    int source,
+                                                    int sink)
 {
-    try
+    auto body = [&]()
     {
         // Initialize the current node to the source node and
         // backtracking flag to false
@@ -274,18 +302,8 @@ bool FordFulkerson::findAugmentingPath(std::vector<int> &path,
 
         // Sink node is not reachable
         return false;
-    }
-    catch (const std::exception &e)
-    {
-        // Output an error message if finding an augmenting path fails
-        std::cerr
-            << "ERROR: Error in findAugmentingPath: "
-            << e.what()
-            << std::endl;
-        throw std::
-            runtime_error("Error in findAugmentingPath: " +
-                          std::string(e.what()));
-    }
+    };
+    return runHelper<CheckPolicy>("findAugmentingPath", body);
 }
 
 /**
@@ -310,17 +328,19 @@ bool FordFulkerson::findAugmentingPath(std::vector<int> &path,
  *   path.
  * - An exception is thrown if updating the residual graph fails.
  */
-void FordFulkerson::updateResidualGraph(int src,
-                                        int dst)
+template <typename CheckPolicy>
+void FordFulkerson<CheckPolicy>::updateResidualGraph(int src, int dst)
 {
-    try
+    auto body = [&]()
     {
         // Check if source and destination nodes are within valid
-        // range
-        if (src < 0 ||
-            src >= graph.getNodes() ||
-            dst < 0 ||
-            dst >= graph.getNodes())
+        // range; the path only holds graph nodes, so release builds
+        // skip this
+        if (CheckPolicy::CHECKED &&
+            (src < 0 ||
+             src >= graph.getNodes() ||
+             dst < 0 ||
+             dst >= graph.getNodes()))
         {
             // Output an error message if source or destination node
             // is out of valid range
@@ -334,19 +354,8 @@ void FordFulkerson::updateResidualGraph(int src,
         // Update the residual graph with the flow along the path
         graph.adjustAdjacencyMatrix()[dst][src] += 1;
         graph.adjustAdjacencyMatrix()[src][dst] -= 1;
-    }
-    catch (const std::exception &e)
-    {
-        // Output an error message if updating the residual graph
-        // fails
-        std::cerr
-            << "ERROR: Error in updateResidualGraph: "
-            << e.what()
-            << std::endl;
-        throw std::
-            runtime_error("Error in updateResidualGraph: " +
-                          std::string(e.what()));
-    }
+    };
+    return runHelper<CheckPolicy>("updateResidualGraph", body);
 }
 
 /**
@@ -369,28 +378,18 @@ void FordFulkerson::updateResidualGraph(int src,
  * - The max flow values at the specified node are cleared.
  * - An exception is thrown if clearing the max flow at a node fails.
  */
-void FordFulkerson::clearMaxFlowAtNode(int node)
+template <typename CheckPolicy>
+void FordFulkerson<CheckPolicy>::clearMaxFlowAtNode(int node)
 {
-    try
+    auto body = [&]()
     {
         // Clear the max flow values at the specified node
         for (int i = 0; i < graph.getNodes(); ++i)
         {
             maxFlow[i][node] = 0;
         }
-    }
-    catch (const std::exception &e)
-    {
-        // Output an error message if clearing max flow at a node
-        // fails
-        std::cerr
-            << "ERROR: Error in clearMaxFlowAtNode: "
-            << e.what()
-            << std::endl;
-        throw std::
-            runtime_error("Error in clearMaxFlowAtNode: " +
-                          std::string(e.what()));
-    }
+    };
+    return runHelper<CheckPolicy>("clearMaxFlowAtNode", body);
 }
 
 /**
@@ -409,25 +408,16 @@ void FordFulkerson::clearMaxFlowAtNode(int node)
  * - The depth vector is initialized with the total number of nodes.
  * - An exception is thrown if initializing the depth vector fails.
  */
-void FordFulkerson::initializeDepth()
+template <typename CheckPolicy>
+void FordFulkerson<CheckPolicy>::initializeDepth()
 {
-    try
+    auto body = [&]()
     {
         // Initialize the depth vector with the total number of nodes
         int totalNodes = graph.getNodes();
         depth.resize(totalNodes);
-    }
-    catch (const std::exception &e)
-    {
-        // Output an error message if initializing depth fails
-        std::cerr
-            << "ERROR: Error in initializeDepth: "
-            << e.what()
-            << std::endl;
-        throw std::
-            runtime_error("Error in initializeDepth: " +
-                          std::string(e.what()));
-    }
+    };
+    return runHelper<CheckPolicy>("initializeDepth", body);
 }
 
 /**
@@ -447,26 +437,17 @@ void FordFulkerson::initializeDepth()
  *   nodes.
  * - An exception is thrown if initializing the max flow matrix fails.
  */
-void FordFulkerson::initializeMaxFlow()
+template <typename CheckPolicy>
+void FordFulkerson<CheckPolicy>::initializeMaxFlow()
 {
-    try
+    auto body = [&]()
     {
         // Initialize the max flow matrix with the total number of
         // nodes
         int totalNodes = graph.getNodes();
         maxFlow.resize(totalNodes, std::vector<int>(totalNodes, 0));
-    }
-    catch (const std::exception &e)
-    {
-        // Output an error message if initializing max flow fails
-        std::cerr
-            << "ERROR: Error in initializeMaxFlow: "
-            << e.what()
-            << std::endl;
-        throw std::
-            runtime_error("Error in initializeMaxFlow: " +
-                          std::string(e.what()));
-    }
+    };
+    return runHelper<CheckPolicy>("initializeMaxFlow", body);
 }
 
 /**
@@ -501,12 +482,13 @@ void FordFulkerson::initializeMaxFlow()
  * - An exception is thrown if finding the next node in the path
  *   fails.
  */
-bool FordFulkerson::findNextNodeInPath(int &node,
-                                       std::vector<int> &path,
-                                       bool &backtracking,
-                                       int source)
+template <typename CheckPolicy>
+bool FordFulkerson<CheckPolicy>::findNextNodeInPath(int &node,
+                                                    std::vector<int> &path,
+                                                    bool &backtracking,
+                                                    int source)
 {
-    try
+    auto body = [&]()
     {
         // Check if backtracking is required
         if (backtracking)
@@ -567,19 +549,8 @@ bool FordFulkerson::findNextNodeInPath(int &node,
         // Backtrack to the previous node
         backtracking = true;
         return true;
-    }
-    catch (const std::exception &e)
-    {
-        // Output an error message if finding the next node in the
-        // path fails
-        std::cerr
-            << "ERROR: Error in findNextNodeInPath: "
-            << e.what()
-            << std::endl;
-        throw std::
-            runtime_error("Error in findNextNodeInPath: " +
-                          std::string(e.what()));
-    }
+    };
+    return runHelper<CheckPolicy>("findNextNodeInPath", body);
 }
 
 /**
@@ -605,11 +576,12 @@ bool FordFulkerson::findNextNodeInPath(int &node,
  * - The residual graph is updated with the flow values.
  * - An exception is thrown if augmenting flow along the path fails.
  */
-void FordFulkerson::augmentFlowAlongPath(std::vector<int> &path,
-                                         int source,
-                                         int sink)
+template <typename CheckPolicy>
+void FordFulkerson<CheckPolicy>::augmentFlowAlongPath(std::vector<int> &path,
+                                                      int source,
+                                                      int sink)
 {
-    try
+    auto body = [&]()
     {
         // Continue while there is an augmenting path
         while (findAugmentingPath(path, source, sink))
@@ -639,17 +611,10 @@ void FordFulkerson::augmentFlowAlongPath(std::vector<int> &path,
             // Clear the path and continue finding augmenting paths
             path.clear();
         }
-    }
-    catch (const std::exception &e)
-    {
-        // Output an error message if augmenting flow along the path
-        // fails
-        std::cerr
-            << "ERROR: Error in augmentFlowAlongPath: "
-            << e.what()
-            << std::endl;
-        throw std::
-            runtime_error("Error in augmentFlowAlongPath: " +
-                          std::string(e.what()));
-    }
+    };
+    return runHelper<CheckPolicy>("augmentFlowAlongPath", body);
 }
+
+// The two builds of the solver
+template class FordFulkerson<CheckedPolicy>;
+template class FordFulkerson<UncheckedPolicy>;
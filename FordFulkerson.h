@@ -14,15 +14,22 @@
  * - The graph is a flow network with defined source and sink nodes.
  * - The graph's adjacency matrix accurately represents the capacities
  *   of the edges.
+ * - The CheckPolicy decides at compile time whether the helpers check
+ *   their input and wrap errors; the public methods always do. The
+ *   class is defined in FordFulkerson.cpp for CheckedPolicy and
+ *   UncheckedPolicy.
  */
 
 #ifndef FORDFULKERSON_H
-#define FORDFULKERSON_Hs
+#define FORDFULKERSON_H
 
+#include "CheckPolicy.h"
 #include "Graph.h"
+#include "MaxFlowEngine.h"
 #include <queue>
 
-class FordFulkerson
+template <typename CheckPolicy = DefaultCheckPolicy>
+class FordFulkerson : public MaxFlowEngine
 {
 public:
     /**
@@ -65,7 +72,7 @@ public:
      * - The maxFlow matrix is updated with the flow values.
      * - An exception is thrown if the calculation process fails.
      */
-    void calculateMaxFlow(int source, int sink);
+    void calculateMaxFlow(int source, int sink) override;
 
 private:
     // The depth of each node in the graph
@@ -0,0 +1,314 @@
+/*
+ * File: GomoryHuTree.cpp Author: Nicolas Gioanni Purpose:
+ * Implementation of the GomoryHuTree class, providing methods for
+ * building Gusfield's minimum cut tree and querying it.
+ *
+ * Functionality/Features:
+ * - Compute the node-to-parent minimum cuts in parallel batches, one
+ *   reusable network and solver per thread.
+ * - Apply the cuts in node order so the tree matches the sequential
+ *   algorithm.
+ * - Answer pair queries with the smallest cut on the tree path.
+ *
+ * Assumptions:
+ * - Parents always have a smaller index than their children, which
+ *   Gusfield's algorithm keeps.
+ */
+
+#include "GomoryHuTree.h"
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+/**
+ * Constructor for the GomoryHuTree class.
+ *
+ * Method Name: GomoryHuTree
+ *
+ * Purpose: Initializes a new instance of the GomoryHuTree class.
+ *
+ * Parameters:
+ * - nodes: An integer representing the number of nodes.
+ * - edges: A constant reference to the undirected edges. The capacity
+ *   of an edge is used in both directions and its reverse capacity is
+ *   ignored.
+ * - threads: The number of cuts to compute at the same time, 0 to use
+ *   every hardware thread.
+ *
+ * Preconditions:
+ * - Every edge is within the range of the nodes.
+ *
+ * Postconditions:
+ * - A new instance of the GomoryHuTree class is created.
+ * - An exception is thrown if an edge is invalid.
+ */
+GomoryHuTree::GomoryHuTree(int nodes,
+                           const std::vector<FlowArc> &edges,
+                           int threads)
+    : nodes(nodes), parent(nodes, 0), cutValue(nodes, 0), depth(nodes, 0)
+{
+    // Use the edge capacity in both directions
+    for (const FlowArc &edge : edges)
+    {
+        arcs.push_back({edge.tail, edge.head, edge.capacity, edge.capacity});
+    }
+
+    if (threads <= 0)
+    {
+        threads = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    if (threads <= 0)
+    {
+        threads = 1;
+    }
+
+    // Give every thread its own copy of the network
+    workspaces.resize(threads);
+    for (Workspace &workspace : workspaces)
+    {
+        workspace.network = std::make_unique<FlowNetwork>(nodes, arcs);
+        workspace.solver =
+            std::make_unique<PushRelabel<>>(*workspace.network);
+    }
+
+    if (nodes > 0)
+    {
+        parent[0] = -1;
+    }
+}
+
+/**
+ * Builds the tree.
+ *
+ * Method Name: build
+ *
+ * Purpose: Computes the minimum cut between every node and its current
+ * tree parent, as in Gusfield's algorithm. Cuts for a batch of
+ * consecutive nodes are computed in parallel, each thread in its own
+ * network and solver. The cuts are then applied in order; a cut whose
+ * node was given a new parent by an earlier cut of the batch is
+ * discarded and computed again in the next batch.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The parent and cut value of every node are set.
+ * - An exception is thrown if a cut computation fails.
+ */
+void GomoryHuTree::build()
+{
+    try
+    {
+        for (int node = 1; node < nodes; ++node)
+        {
+            parent[node] = 0;
+            cutValue[node] = 0;
+        }
+
+        int batchSize = static_cast<int>(workspaces.size());
+        std::vector<int> sinks(batchSize);
+        std::vector<long long> values(batchSize);
+        std::vector<std::vector<bool>> sides(batchSize);
+        std::vector<std::exception_ptr> errors(batchSize);
+
+        int node = 1;
+        while (node < nodes)
+        {
+            int count = std::min(batchSize, nodes - node);
+
+            // Solve the cut of every node in the batch against its
+            // parent as it is now
+            std::vector<std::thread> threads;
+            for (int k = 0; k < count; ++k)
+            {
+                sinks[k] = parent[node + k];
+                errors[k] = nullptr;
+                threads.emplace_back([this, k, node, &sinks, &values,
+                                      &sides, &errors]()
+                {
+                    try
+                    {
+                        PushRelabel<> &solver = *workspaces[k].solver;
+                        values[k] =
+                            solver.calculateMaxFlow(node + k, sinks[k]);
+                        sides[k] = solver.getSourceSide();
+                    }
+                    catch (...)
+                    {
+                        errors[k] = std::current_exception();
+                    }
+                });
+            }
+            for (std::thread &thread : threads)
+            {
+                thread.join();
+            }
+            for (int k = 0; k < count; ++k)
+            {
+                if (errors[k])
+                {
+                    std::rethrow_exception(errors[k]);
+                }
+            }
+
+            // Apply the cuts in order until one was solved against a
+            // parent that has since changed
+            int applied = 0;
+            for (int k = 0; k < count; ++k)
+            {
+                int current = node + k;
+                if (parent[current] != sinks[k])
+                {
+                    break;
+                }
+
+                cutValue[current] = values[k];
+                for (int other = current + 1; other < nodes; ++other)
+                {
+                    if (sides[k][other] && parent[other] == sinks[k])
+                    {
+                        parent[other] = current;
+                    }
+                }
+                applied++;
+            }
+            node += applied;
+        }
+
+        computeDepths();
+    }
+    catch (const std::exception &e)
+    {
+        // Output an error message if building the tree fails
+        std::cerr
+            << "ERROR: Error in build: "
+            << e.what()
+            << std::endl;
+        throw std::runtime_error("Error in build: " +
+                                 std::string(e.what()));
+    }
+}
+
+/**
+ * Get the minimum cut between two nodes.
+ *
+ * Method Name: getMinCut
+ *
+ * Purpose: Returns the smallest cut value on the tree path between the
+ * two nodes, which equals their minimum cut in the graph.
+ *
+ * Parameters:
+ * - u: An integer representing the first node.
+ * - v: An integer representing the second node.
+ *
+ * Returns: The value of the minimum cut, 0 if u equals v.
+ *
+ * Preconditions:
+ * - build was called.
+ *
+ * Postconditions:
+ * - The minimum cut is returned.
+ * - An exception is thrown if a node is out of range.
+ */
+long long GomoryHuTree::getMinCut(int u, int v) const
+{
+    // Check if the nodes are within valid range
+    if (u < 0 || u >= nodes || v < 0 || v >= nodes)
+    {
+        std::cerr << "ERROR: Node is out of range." << std::endl;
+        throw std::out_of_range("Node is out of range.");
+    }
+    if (u == v)
+    {
+        return 0;
+    }
+
+    // Climb from the deeper node until both meet
+    long long minimum = -1;
+    while (u != v)
+    {
+        if (depth[u] < depth[v])
+        {
+            std::swap(u, v);
+        }
+        if (minimum < 0 || cutValue[u] < minimum)
+        {
+            minimum = cutValue[u];
+        }
+        u = parent[u];
+    }
+    return minimum;
+}
+
+/**
+ * Get the tree parent of a node.
+ *
+ * Method Name: getParent
+ *
+ * Purpose: Returns the parent of the node in the tree.
+ *
+ * Parameters:
+ * - node: An integer representing the node.
+ *
+ * Preconditions:
+ * - build was called.
+ *
+ * Postconditions:
+ * - The parent is returned.
+ *
+ * Returns: The parent of the node, -1 for the root node 0.
+ */
+int GomoryHuTree::getParent(int node) const
+{
+    return parent[node];
+}
+
+/**
+ * Get the cut value of the tree edge above a node.
+ *
+ * Method Name: getCutValue
+ *
+ * Purpose: Returns the minimum cut between the node and its parent.
+ *
+ * Parameters:
+ * - node: An integer representing the node.
+ *
+ * Preconditions:
+ * - build was called.
+ *
+ * Postconditions:
+ * - The cut value is returned.
+ *
+ * Returns: The cut value, 0 for the root node 0.
+ */
+long long GomoryHuTree::getCutValue(int node) const
+{
+    return cutValue[node];
+}
+
+/**
+ * Computes the depth of every node in the tree.
+ *
+ * Method Name: computeDepths
+ *
+ * Purpose: Sets the depth of every node from the parents, so path
+ * queries can climb from the deeper node first.
+ *
+ * Preconditions:
+ * - The parents form a tree rooted at node 0.
+ *
+ * Postconditions:
+ * - The depth of every node is set.
+ */
+void GomoryHuTree::computeDepths()
+{
+    // Parents come before their children, so one pass is enough
+    for (int node = 1; node < nodes; ++node)
+    {
+        depth[node] = depth[parent[node]] + 1;
+    }
+}
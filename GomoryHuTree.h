@@ -0,0 +1,185 @@
+/*
+ * File: GomoryHuTree.h Author: Nicolas Gioanni Purpose: Declaration of
+ * the GomoryHuTree class for answering minimum cut queries between all
+ * pairs of nodes of an undirected graph with Gusfield's tree.
+ *
+ * Functionality/Features:
+ * - Declare methods for building the tree with one push-relabel
+ *   minimum cut per node, running independent cuts in parallel.
+ * - Declare methods for reading the minimum cut between any two nodes
+ *   from the tree without solving again.
+ *
+ * Assumptions:
+ * - The graph is undirected; the capacity of every edge is usable in
+ *   both directions.
+ * - Capacities are non-negative integers.
+ */
+
+#ifndef GOMORYHUTREE_H
+#define GOMORYHUTREE_H
+
+#include "FlowNetwork.h"
+#include "PushRelabel.h"
+#include <memory>
+#include <vector>
+
+class GomoryHuTree
+{
+public:
+    /**
+     * Constructor for the GomoryHuTree class.
+     *
+     * Method Name: GomoryHuTree
+     *
+     * Purpose: Initializes a new instance of the GomoryHuTree class.
+     *
+     * Parameters:
+     * - nodes: An integer representing the number of nodes.
+     * - edges: A constant reference to the undirected edges. The
+     *   capacity of an edge is used in both directions and its reverse
+     *   capacity is ignored.
+     * - threads: The number of cuts to compute at the same time, 0 to
+     *   use every hardware thread.
+     *
+     * Preconditions:
+     * - Every edge is within the range of the nodes.
+     *
+     * Postconditions:
+     * - A new instance of the GomoryHuTree class is created.
+     * - An exception is thrown if an edge is invalid.
+     */
+    GomoryHuTree(int nodes,
+                 const std::vector<FlowArc> &edges,
+                 int threads = 0);
+
+    /**
+     * Builds the tree.
+     *
+     * Method Name: build
+     *
+     * Purpose: Computes the minimum cut between every node and its
+     * current tree parent, as in Gusfield's algorithm. Cuts for a batch
+     * of consecutive nodes are computed in parallel, each thread in its
+     * own network and solver. The cuts are then applied in order; a cut
+     * whose node was given a new parent by an earlier cut of the batch
+     * is discarded and computed again in the next batch.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The parent and cut value of every node are set.
+     * - An exception is thrown if a cut computation fails.
+     */
+    void build();
+
+    /**
+     * Get the minimum cut between two nodes.
+     *
+     * Method Name: getMinCut
+     *
+     * Purpose: Returns the smallest cut value on the tree path between
+     * the two nodes, which equals their minimum cut in the graph.
+     *
+     * Parameters:
+     * - u: An integer representing the first node.
+     * - v: An integer representing the second node.
+     *
+     * Returns: The value of the minimum cut, 0 if u equals v.
+     *
+     * Preconditions:
+     * - build was called.
+     *
+     * Postconditions:
+     * - The minimum cut is returned.
+     * - An exception is thrown if a node is out of range.
+     */
+    long long getMinCut(int u, int v) const;
+
+    /**
+     * Get the tree parent of a node.
+     *
+     * Method Name: getParent
+     *
+     * Purpose: Returns the parent of the node in the tree.
+     *
+     * Parameters:
+     * - node: An integer representing the node.
+     *
+     * Preconditions:
+     * - build was called.
+     *
+     * Postconditions:
+     * - The parent is returned.
+     *
+     * Returns: The parent of the node, -1 for the root node 0.
+     */
+    int getParent(int node) const;
+
+    /**
+     * Get the cut value of the tree edge above a node.
+     *
+     * Method Name: getCutValue
+     *
+     * Purpose: Returns the minimum cut between the node and its parent.
+     *
+     * Parameters:
+     * - node: An integer representing the node.
+     *
+     * Preconditions:
+     * - build was called.
+     *
+     * Postconditions:
+     * - The cut value is returned.
+     *
+     * Returns: The cut value, 0 for the root node 0.
+     */
+    long long getCutValue(int node) const;
+
+private:
+    // A network and solver owned by one thread
+    struct Workspace
+    {
+        // The network the thread solves in
+        std::unique_ptr<FlowNetwork> network;
+
+        // The solver reused for every cut of the thread
+        std::unique_ptr<PushRelabel<>> solver;
+    };
+
+    // The number of nodes
+    int nodes;
+
+    // The undirected edges as arc pairs
+    std::vector<FlowArc> arcs;
+
+    // The workspace of every thread
+    std::vector<Workspace> workspaces;
+
+    // The tree parent of every node
+    std::vector<int> parent;
+
+    // The minimum cut between every node and its parent
+    std::vector<long long> cutValue;
+
+    // The depth of every node in the tree
+    std::vector<int> depth;
+
+    /**
+     * Computes the depth of every node in the tree.
+     *
+     * Method Name: computeDepths
+     *
+     * Purpose: Sets the depth of every node from the parents, so path
+     * queries can climb from the deeper node first.
+     *
+     * Preconditions:
+     * - The parents form a tree rooted at node 0.
+     *
+     * Postconditions:
+     * - The depth of every node is set.
+     */
+    void computeDepths();
+};
+
+#endif
@@ -0,0 +1,495 @@
+/*
+ * File: GridMaxFlow.cpp Author: Nicolas Gioanni Purpose:
+ * Implementation of the GridMaxFlow class, providing methods for
+ * calculating maximum flow on an implicit grid with persistent search
+ * trees.
+ *
+ * Functionality/Features:
+ * - Start both trees from every pixel with terminal residual
+ *   capacity.
+ * - Grow the trees over the neighbors computed by the grid.
+ * - Augment through the terminal arcs at both ends of a path.
+ * - Adopt orphaned pixels into their tree again.
+ *
+ * Assumptions:
+ * - The parent direction of a pixel leads from the pixel to its
+ *   parent. In the source tree the arc back from the parent carries
+ *   the flow, in the sink tree the arc to the parent does.
+ */
+
+#include "GridMaxFlow.h"
+#include <climits>
+#include <iostream>
+#include <stdexcept>
+
+/**
+ * Constructor for the GridMaxFlow class.
+ *
+ * Method Name: GridMaxFlow
+ *
+ * Purpose: Initializes a new instance of the GridMaxFlow class.
+ *
+ * Parameters:
+ * - network: A reference to the grid to solve. The solver keeps the
+ *   flow in the grid.
+ *
+ * Preconditions:
+ * - The capacities of the grid are set.
+ *
+ * Postconditions:
+ * - A new instance of the GridMaxFlow class is created.
+ */
+GridMaxFlow::GridMaxFlow(GridNetwork &network)
+    : network(network), currentTime(0), bridgeNode(-1), bridgeDirection(-1)
+{
+}
+
+/**
+ * Calculates the maximum flow in the grid.
+ *
+ * Method Name: calculateMaxFlow
+ *
+ * Purpose: Grows a source and a sink search tree over the pixels,
+ * augments where they meet and adopts the pixels orphaned by saturated
+ * arcs, continuing from the flow already in the grid.
+ *
+ * Returns: The value of the maximum flow.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The grid carries a maximum flow.
+ * - An exception is thrown if the calculation process fails.
+ */
+long long GridMaxFlow::calculateMaxFlow()
+{
+    try
+    {
+        int nodes = network.getNodes();
+        tree.assign(nodes, FREE_NODE);
+        parentDirection.assign(nodes, ORPHAN);
+        timestamp.assign(nodes, 0);
+        distance.assign(nodes, 0);
+        queued.assign(nodes, false);
+        active.clear();
+        orphans.clear();
+        currentTime = 0;
+
+        // Every pixel with terminal capacity is a root
+        for (int node = 0; node < nodes; ++node)
+        {
+            int terminal = network.getTerminal(node);
+            if (terminal != 0)
+            {
+                tree[node] = terminal > 0 ? SOURCE_TREE : SINK_TREE;
+                parentDirection[node] = TERMINAL;
+                distance[node] = 1;
+                activate(node);
+            }
+        }
+
+        while (growTrees())
+        {
+            currentTime++;
+            augmentFlowAlongPath();
+            adoptOrphans();
+        }
+
+        return network.getFlowValue();
+    }
+    catch (const std::exception &e)
+    {
+        // Output an error message if the calculation fails
+        std::cerr
+            << "ERROR: Error in calculateMaxFlow: "
+            << e.what()
+            << std::endl;
+        throw std::runtime_error("Error in calculateMaxFlow: " +
+                                 std::string(e.what()));
+    }
+}
+
+/**
+ * Get the source side of the minimum cut.
+ *
+ * Method Name: getSourceSide
+ *
+ * Purpose: Returns the pixels of the source tree.
+ *
+ * Preconditions:
+ * - calculateMaxFlow was called.
+ *
+ * Postconditions:
+ * - The source side is returned.
+ *
+ * Returns: A vector with true for every pixel on the source side.
+ */
+std::vector<bool> GridMaxFlow::getSourceSide() const
+{
+    std::vector<bool> sourceSide(tree.size(), false);
+    for (size_t node = 0; node < tree.size(); ++node)
+    {
+        sourceSide[node] = tree[node] == SOURCE_TREE;
+    }
+    return sourceSide;
+}
+
+/**
+ * Grows the trees until they touch.
+ *
+ * Method Name: growTrees
+ *
+ * Purpose: Lets the active pixels claim their free residual neighbors
+ * for their tree until an arc from the source tree to the sink tree is
+ * found.
+ *
+ * Returns: True if the trees touch, with the arc stored in the bridge
+ * members.
+ *
+ * Preconditions:
+ * - The trees are valid.
+ *
+ * Postconditions:
+ * - Pixels that cannot grow are no longer active.
+ */
+bool GridMaxFlow::growTrees()
+{
+    int directions = network.getDirections();
+    while (!active.empty())
+    {
+        int node = active.front();
+        if (tree[node] == FREE_NODE)
+        {
+            active.pop_front();
+            queued[node] = false;
+            continue;
+        }
+
+        for (int direction = 0; direction < directions; ++direction)
+        {
+            // The source tree grows along arcs, the sink tree against
+            int neighbor = network.getNeighbor(node, direction);
+            if (neighbor < 0)
+            {
+                continue;
+            }
+            int opposite = network.getOpposite(direction);
+            int residual = tree[node] == SOURCE_TREE
+                               ? network.getResidual(node, direction)
+                               : network.getResidual(neighbor, opposite);
+            if (residual <= 0)
+            {
+                continue;
+            }
+
+            if (tree[neighbor] == FREE_NODE)
+            {
+                tree[neighbor] = tree[node];
+                parentDirection[neighbor] = static_cast<int8_t>(opposite);
+                timestamp[neighbor] = timestamp[node];
+                distance[neighbor] = distance[node] + 1;
+                activate(neighbor);
+            }
+            else if (tree[neighbor] != tree[node])
+            {
+                // The trees touch; the pixel stays active
+                if (tree[node] == SOURCE_TREE)
+                {
+                    bridgeNode = node;
+                    bridgeDirection = direction;
+                }
+                else
+                {
+                    bridgeNode = neighbor;
+                    bridgeDirection = opposite;
+                }
+                return true;
+            }
+            else if (timestamp[neighbor] <= timestamp[node] &&
+                     distance[neighbor] > distance[node])
+            {
+                // Move the neighbor under the pixel, closer to the root
+                parentDirection[neighbor] = static_cast<int8_t>(opposite);
+                timestamp[neighbor] = timestamp[node];
+                distance[neighbor] = distance[node] + 1;
+            }
+        }
+
+        active.pop_front();
+        queued[node] = false;
+    }
+    return false;
+}
+
+/**
+ * Augments along the path through the bridge arc.
+ *
+ * Method Name: augmentFlowAlongPath
+ *
+ * Purpose: Pushes the bottleneck of the path from the source through
+ * the bridge arc to the sink, and orphans the pixels whose tree arc or
+ * terminal arc was saturated.
+ *
+ * Preconditions:
+ * - growTrees found a bridge arc.
+ *
+ * Postconditions:
+ * - The flow value of the grid is raised.
+ * - The orphans are queued for adoption.
+ */
+void GridMaxFlow::augmentFlowAlongPath()
+{
+    int sourceEnd = bridgeNode;
+    int sinkEnd = network.getNeighbor(bridgeNode, bridgeDirection);
+
+    // Find the bottleneck on both halves of the path, terminal arcs
+    // included
+    int bottleneck = network.getResidual(bridgeNode, bridgeDirection);
+    int node = sourceEnd;
+    while (parentDirection[node] != TERMINAL)
+    {
+        int direction = parentDirection[node];
+        int parent = network.getNeighbor(node, direction);
+        int residual =
+            network.getResidual(parent, network.getOpposite(direction));
+        if (residual < bottleneck)
+        {
+            bottleneck = residual;
+        }
+        node = parent;
+    }
+    if (network.getTerminal(node) < bottleneck)
+    {
+        bottleneck = network.getTerminal(node);
+    }
+    node = sinkEnd;
+    while (parentDirection[node] != TERMINAL)
+    {
+        int direction = parentDirection[node];
+        int residual = network.getResidual(node, direction);
+        if (residual < bottleneck)
+        {
+            bottleneck = residual;
+        }
+        node = network.getNeighbor(node, direction);
+    }
+    if (-network.getTerminal(node) < bottleneck)
+    {
+        bottleneck = -network.getTerminal(node);
+    }
+
+    // Push the bottleneck and orphan the pixels below saturated arcs
+    network.push(bridgeNode, bridgeDirection, bottleneck);
+    node = sourceEnd;
+    while (parentDirection[node] != TERMINAL)
+    {
+        int direction = parentDirection[node];
+        int parent = network.getNeighbor(node, direction);
+        int opposite = network.getOpposite(direction);
+        network.push(parent, opposite, bottleneck);
+        if (network.getResidual(parent, opposite) == 0)
+        {
+            parentDirection[node] = ORPHAN;
+            orphans.push_back(node);
+        }
+        node = parent;
+    }
+    network.pushFromSource(node, bottleneck);
+    if (network.getTerminal(node) == 0)
+    {
+        parentDirection[node] = ORPHAN;
+        orphans.push_back(node);
+    }
+
+    node = sinkEnd;
+    while (parentDirection[node] != TERMINAL)
+    {
+        int direction = parentDirection[node];
+        int parent = network.getNeighbor(node, direction);
+        network.push(node, direction, bottleneck);
+        if (network.getResidual(node, direction) == 0)
+        {
+            parentDirection[node] = ORPHAN;
+            orphans.push_back(node);
+        }
+        node = parent;
+    }
+    network.pushToSink(node, bottleneck);
+    if (network.getTerminal(node) == 0)
+    {
+        parentDirection[node] = ORPHAN;
+        orphans.push_back(node);
+    }
+
+    network.addFlow(bottleneck);
+}
+
+/**
+ * Finds new parents for the orphans.
+ *
+ * Method Name: adoptOrphans
+ *
+ * Purpose: Gives every orphan the closest neighbor in its tree that
+ * still leads to the terminal, or frees it and orphans its children if
+ * there is none.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - No orphan is left and the trees are valid.
+ */
+void GridMaxFlow::adoptOrphans()
+{
+    int directions = network.getDirections();
+    while (!orphans.empty())
+    {
+        int node = orphans.front();
+        orphans.pop_front();
+        int8_t nodeTree = tree[node];
+
+        // Look for the neighbor closest to the terminal that can be the
+        // parent
+        int bestDirection = -1;
+        int bestDistance = INT_MAX;
+        for (int direction = 0; direction < directions; ++direction)
+        {
+            int neighbor = network.getNeighbor(node, direction);
+            if (neighbor < 0 || tree[neighbor] != nodeTree)
+            {
+                continue;
+            }
+            int residual =
+                nodeTree == SOURCE_TREE
+                    ? network.getResidual(neighbor,
+                                          network.getOpposite(direction))
+                    : network.getResidual(node, direction);
+            if (residual <= 0)
+            {
+                continue;
+            }
+
+            int neighborDistance = distanceToRoot(neighbor);
+            if (neighborDistance >= 0 && neighborDistance < bestDistance)
+            {
+                bestDirection = direction;
+                bestDistance = neighborDistance;
+            }
+        }
+
+        if (bestDirection >= 0)
+        {
+            parentDirection[node] = static_cast<int8_t>(bestDirection);
+            timestamp[node] = currentTime;
+            distance[node] = bestDistance + 1;
+            continue;
+        }
+
+        // No parent is left; free the pixel and orphan its children
+        tree[node] = FREE_NODE;
+        for (int direction = 0; direction < directions; ++direction)
+        {
+            int neighbor = network.getNeighbor(node, direction);
+            if (neighbor < 0 || tree[neighbor] != nodeTree)
+            {
+                continue;
+            }
+
+            // Neighbors that could reach the pixel may claim it later
+            int opposite = network.getOpposite(direction);
+            int residual = nodeTree == SOURCE_TREE
+                               ? network.getResidual(neighbor, opposite)
+                               : network.getResidual(node, direction);
+            if (residual > 0)
+            {
+                activate(neighbor);
+            }
+
+            if (parentDirection[neighbor] == opposite)
+            {
+                parentDirection[neighbor] = ORPHAN;
+                orphans.push_back(neighbor);
+            }
+        }
+    }
+}
+
+/**
+ * Check the distance from a pixel to its terminal.
+ *
+ * Method Name: distanceToRoot
+ *
+ * Purpose: Follows the parent directions to the terminal, stopping
+ * early at pixels checked during the same augmentation, and stores the
+ * distances along the way.
+ *
+ * Parameters:
+ * - node: An integer representing the pixel.
+ *
+ * Returns: The number of tree arcs to the terminal, -1 if the path ends
+ * at an orphan.
+ *
+ * Preconditions:
+ * - The pixel is in a tree.
+ *
+ * Postconditions:
+ * - The distances on a path to the terminal are stored.
+ */
+int GridMaxFlow::distanceToRoot(int node)
+{
+    int steps = 0;
+    int current = node;
+    while (timestamp[current] != currentTime)
+    {
+        int direction = parentDirection[current];
+        if (direction == ORPHAN)
+        {
+            return -1;
+        }
+        if (direction == TERMINAL)
+        {
+            timestamp[current] = currentTime;
+            distance[current] = 1;
+            break;
+        }
+        steps++;
+        current = network.getNeighbor(current, direction);
+    }
+    steps += distance[current];
+
+    // Store the distances on the checked path
+    int remaining = steps;
+    for (current = node; timestamp[current] != currentTime;
+         current = network.getNeighbor(current, parentDirection[current]))
+    {
+        timestamp[current] = currentTime;
+        distance[current] = remaining--;
+    }
+    return steps;
+}
+
+/**
+ * Adds a pixel to the active queue.
+ *
+ * Method Name: activate
+ *
+ * Purpose: Queues the pixel if it is not queued yet.
+ *
+ * Parameters:
+ * - node: An integer representing the pixel.
+ *
+ * Preconditions:
+ * - The pixel is in a tree.
+ *
+ * Postconditions:
+ * - The pixel is queued.
+ */
+void GridMaxFlow::activate(int node)
+{
+    if (!queued[node])
+    {
+        queued[node] = true;
+        active.push_back(node);
+    }
+}
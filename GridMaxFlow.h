@@ -0,0 +1,232 @@
+/*
+ * File: GridMaxFlow.h Author: Nicolas Gioanni Purpose: Declaration of
+ * the GridMaxFlow class for calculating maximum flow on a GridNetwork
+ * with the Boykov-Kolmogorov algorithm.
+ *
+ * Functionality/Features:
+ * - Declare methods for calculating the maximum flow between the
+ *   implicit source and sink of a grid.
+ * - Declare methods for reading the segmentation given by the minimum
+ *   cut.
+ *
+ * Assumptions:
+ * - Pixels with source residual capacity are roots of the source tree
+ *   and pixels with sink residual capacity are roots of the sink tree,
+ *   so the terminals are never stored as nodes.
+ * - Tree parents are stored as directions, one byte per pixel.
+ */
+
+#ifndef GRIDMAXFLOW_H
+#define GRIDMAXFLOW_H
+
+#include "GridNetwork.h"
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+class GridMaxFlow
+{
+public:
+    /**
+     * Constructor for the GridMaxFlow class.
+     *
+     * Method Name: GridMaxFlow
+     *
+     * Purpose: Initializes a new instance of the GridMaxFlow class.
+     *
+     * Parameters:
+     * - network: A reference to the grid to solve. The solver keeps
+     *   the flow in the grid.
+     *
+     * Preconditions:
+     * - The capacities of the grid are set.
+     *
+     * Postconditions:
+     * - A new instance of the GridMaxFlow class is created.
+     */
+    GridMaxFlow(GridNetwork &network);
+
+    /**
+     * Calculates the maximum flow in the grid.
+     *
+     * Method Name: calculateMaxFlow
+     *
+     * Purpose: Grows a source and a sink search tree over the pixels,
+     * augments where they meet and adopts the pixels orphaned by
+     * saturated arcs, continuing from the flow already in the grid.
+     *
+     * Returns: The value of the maximum flow.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The grid carries a maximum flow.
+     * - An exception is thrown if the calculation process fails.
+     */
+    long long calculateMaxFlow();
+
+    /**
+     * Get the source side of the minimum cut.
+     *
+     * Method Name: getSourceSide
+     *
+     * Purpose: Returns the pixels of the source tree.
+     *
+     * Preconditions:
+     * - calculateMaxFlow was called.
+     *
+     * Postconditions:
+     * - The source side is returned.
+     *
+     * Returns: A vector with true for every pixel on the source side.
+     */
+    std::vector<bool> getSourceSide() const;
+
+private:
+    // Tree of pixels that belong to neither tree
+    static constexpr int8_t FREE_NODE = 0;
+
+    // Tree of pixels reached from the source
+    static constexpr int8_t SOURCE_TREE = 1;
+
+    // Tree of pixels that reach the sink
+    static constexpr int8_t SINK_TREE = 2;
+
+    // Parent direction of a pixel that lost its parent
+    static constexpr int8_t ORPHAN = -1;
+
+    // Parent direction of a pixel attached to its terminal
+    static constexpr int8_t TERMINAL = -2;
+
+    // The grid holding the flow
+    GridNetwork &network;
+
+    // The tree of every pixel
+    std::vector<int8_t> tree;
+
+    // The direction from every pixel to its tree parent
+    std::vector<int8_t> parentDirection;
+
+    // The augmentation at which every distance was last checked
+    std::vector<int> timestamp;
+
+    // The number of tree arcs between every pixel and its terminal
+    std::vector<int> distance;
+
+    // The pixels at the edge of the trees that may still grow
+    std::deque<int> active;
+
+    // True for pixels that are in the active queue
+    std::vector<bool> queued;
+
+    // The pixels waiting for a new parent
+    std::deque<int> orphans;
+
+    // The number of augmentations so far
+    int currentTime;
+
+    // The pixel on the source side of the arc where the trees meet
+    int bridgeNode;
+
+    // The direction of the arc where the trees meet
+    int bridgeDirection;
+
+    /**
+     * Grows the trees until they touch.
+     *
+     * Method Name: growTrees
+     *
+     * Purpose: Lets the active pixels claim their free residual
+     * neighbors for their tree until an arc from the source tree to
+     * the sink tree is found.
+     *
+     * Returns: True if the trees touch, with the arc stored in the
+     * bridge members.
+     *
+     * Preconditions:
+     * - The trees are valid.
+     *
+     * Postconditions:
+     * - Pixels that cannot grow are no longer active.
+     */
+    bool growTrees();
+
+    /**
+     * Augments along the path through the bridge arc.
+     *
+     * Method Name: augmentFlowAlongPath
+     *
+     * Purpose: Pushes the bottleneck of the path from the source
+     * through the bridge arc to the sink, and orphans the pixels whose
+     * tree arc or terminal arc was saturated.
+     *
+     * Preconditions:
+     * - growTrees found a bridge arc.
+     *
+     * Postconditions:
+     * - The flow value of the grid is raised.
+     * - The orphans are queued for adoption.
+     */
+    void augmentFlowAlongPath();
+
+    /**
+     * Finds new parents for the orphans.
+     *
+     * Method Name: adoptOrphans
+     *
+     * Purpose: Gives every orphan the closest neighbor in its tree that
+     * still leads to the terminal, or frees it and orphans its children
+     * if there is none.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - No orphan is left and the trees are valid.
+     */
+    void adoptOrphans();
+
+    /**
+     * Check the distance from a pixel to its terminal.
+     *
+     * Method Name: distanceToRoot
+     *
+     * Purpose: Follows the parent directions to the terminal, stopping
+     * early at pixels checked during the same augmentation, and stores
+     * the distances along the way.
+     *
+     * Parameters:
+     * - node: An integer representing the pixel.
+     *
+     * Returns: The number of tree arcs to the terminal, -1 if the path
+     * ends at an orphan.
+     *
+     * Preconditions:
+     * - The pixel is in a tree.
+     *
+     * Postconditions:
+     * - The distances on a path to the terminal are stored.
+     */
+    int distanceToRoot(int node);
+
+    /**
+     * Adds a pixel to the active queue.
+     *
+     * Method Name: activate
+     *
+     * Purpose: Queues the pixel if it is not queued yet.
+     *
+     * Parameters:
+     * - node: An integer representing the pixel.
+     *
+     * Preconditions:
+     * - The pixel is in a tree.
+     *
+     * Postconditions:
+     * - The pixel is queued.
+     */
+    void activate(int node);
+};
+
+#endif
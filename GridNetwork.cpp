@@ -0,0 +1,244 @@
+/*
+ * File: GridNetwork.cpp Author: Nicolas Gioanni Purpose:
+ * Implementation of the GridNetwork class, providing methods for
+ * building an implicit grid flow network.
+ *
+ * Functionality/Features:
+ * - Build the neighbor directions of a grid.
+ * - Set neighbor and terminal capacities.
+ *
+ * Assumptions:
+ * - Directions are listed in (z, y, x) order of their offsets, so the
+ *   list read backwards gives the opposite directions.
+ */
+
+#include "GridNetwork.h"
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+
+/**
+ * Constructor for the GridNetwork class.
+ *
+ * Method Name: GridNetwork
+ *
+ * Purpose: Initializes a grid with all capacities set to 0.
+ *
+ * Parameters:
+ * - width: An integer representing the number of pixels along x.
+ * - height: An integer representing the number of pixels along y.
+ * - depth: An integer representing the number of pixels along z, 1
+ *   for a 2D grid.
+ * - connectivity: The number of neighbors of an inner pixel: 4 or 8
+ *   for a 2D grid, 6 or 26 for a 3D grid.
+ *
+ * Preconditions:
+ * - The sizes are positive.
+ *
+ * Postconditions:
+ * - The residual arrays are allocated.
+ * - An exception is thrown if the sizes or connectivity are invalid.
+ */
+GridNetwork::GridNetwork(int width, int height, int depth, int connectivity)
+    : width(width), height(height), depth(depth), nodes(0), directions(0),
+      flowValue(0)
+{
+    // Check if the sizes are valid
+    if (width < 1 || height < 1 || depth < 1 ||
+        static_cast<long long>(width) * height * depth > 0x7fffffffLL)
+    {
+        std::cerr << "ERROR: Grid size is Invalid." << std::endl;
+        throw std::invalid_argument("Grid size is Invalid.");
+    }
+
+    // Check if the connectivity fits the dimension
+    bool flat = connectivity == 4 || connectivity == 8;
+    bool volume = connectivity == 6 || connectivity == 26;
+    if (!flat && !volume)
+    {
+        std::cerr << "ERROR: Grid connectivity is Invalid." << std::endl;
+        throw std::invalid_argument("Grid connectivity is Invalid.");
+    }
+
+    // List the offsets in (z, y, x) order
+    for (int dz = -1; dz <= 1; ++dz)
+    {
+        for (int dy = -1; dy <= 1; ++dy)
+        {
+            for (int dx = -1; dx <= 1; ++dx)
+            {
+                int length = std::abs(dx) + std::abs(dy) + std::abs(dz);
+                if (length == 0 || (flat && dz != 0) ||
+                    ((connectivity == 4 || connectivity == 6) &&
+                     length > 1))
+                {
+                    continue;
+                }
+                stepX.push_back(dx);
+                stepY.push_back(dy);
+                stepZ.push_back(dz);
+                step.push_back((dz * height + dy) * width + dx);
+            }
+        }
+    }
+
+    nodes = width * height * depth;
+    directions = connectivity;
+    residual.assign(static_cast<size_t>(directions) * nodes, 0);
+    terminal.assign(nodes, 0);
+}
+
+/**
+ * Set the capacity towards a neighbor.
+ *
+ * Method Name: setCapacity
+ *
+ * Purpose: Sets the capacity of the arc from the pixel in the
+ * direction.
+ *
+ * Parameters:
+ * - node: An integer representing the pixel.
+ * - direction: An integer representing the direction.
+ * - capacity: The non-negative capacity.
+ *
+ * Preconditions:
+ * - No flow was pushed yet.
+ *
+ * Postconditions:
+ * - The residual capacity of the arc is set.
+ * - An exception is thrown if the arc leaves the grid.
+ */
+void GridNetwork::setCapacity(int node, int direction, int capacity)
+{
+    // Check if the arc is inside the grid
+    if (node < 0 || node >= nodes || direction < 0 ||
+        direction >= directions || capacity < 0 ||
+        getNeighbor(node, direction) < 0)
+    {
+        std::cerr << "ERROR: Grid arc is Invalid." << std::endl;
+        throw std::invalid_argument("Grid arc is Invalid.");
+    }
+
+    residual[static_cast<size_t>(direction) * nodes + node] = capacity;
+}
+
+/**
+ * Set the capacities of one direction for every pixel.
+ *
+ * Method Name: setCapacities
+ *
+ * Purpose: Copies a whole array of capacities into the residual array
+ * of the direction, keeping arcs that leave the grid at 0.
+ *
+ * Parameters:
+ * - direction: An integer representing the direction.
+ * - capacities: A constant reference to one capacity per pixel.
+ *
+ * Preconditions:
+ * - No flow was pushed yet.
+ *
+ * Postconditions:
+ * - The residual capacities of the direction are set.
+ * - An exception is thrown if the sizes do not match.
+ */
+void GridNetwork::setCapacities(int direction,
+                                const std::vector<int> &capacities)
+{
+    // Check if there is one capacity per pixel
+    if (direction < 0 || direction >= directions ||
+        static_cast<int>(capacities.size()) != nodes)
+    {
+        std::cerr << "ERROR: Grid capacities are Invalid." << std::endl;
+        throw std::invalid_argument("Grid capacities are Invalid.");
+    }
+
+    int *block = residual.data() + static_cast<size_t>(direction) * nodes;
+    for (int node = 0; node < nodes; ++node)
+    {
+        block[node] = capacities[node] > 0 ? capacities[node] : 0;
+    }
+
+    // Clear the arcs that leave the grid
+    for (int node = 0; node < nodes; ++node)
+    {
+        if (block[node] > 0 && getNeighbor(node, direction) < 0)
+        {
+            block[node] = 0;
+        }
+    }
+}
+
+/**
+ * Set the terminal capacities of a pixel.
+ *
+ * Method Name: setTerminalCapacities
+ *
+ * Purpose: Sends the flow that can go straight from the source through
+ * the pixel to the sink right away and keeps the rest as the terminal
+ * residual capacity.
+ *
+ * Parameters:
+ * - node: An integer representing the pixel.
+ * - source: The non-negative capacity from the source.
+ * - sink: The non-negative capacity to the sink.
+ *
+ * Preconditions:
+ * - The terminal capacities of the pixel are set only once.
+ *
+ * Postconditions:
+ * - The terminal residual capacity and flow value are updated.
+ * - An exception is thrown if a capacity is negative.
+ */
+void GridNetwork::setTerminalCapacities(int node, int source, int sink)
+{
+    // Check if the capacities are valid
+    if (node < 0 || node >= nodes || source < 0 || sink < 0)
+    {
+        std::cerr << "ERROR: Terminal capacity is Invalid." << std::endl;
+        throw std::invalid_argument("Terminal capacity is Invalid.");
+    }
+
+    flowValue += source < sink ? source : sink;
+    terminal[node] = source - sink;
+}
+
+/**
+ * Add to the flow value.
+ *
+ * Method Name: addFlow
+ *
+ * Purpose: Records flow sent from the source to the sink.
+ *
+ * Parameters:
+ * - amount: The amount of flow.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The flow value is raised.
+ */
+void GridNetwork::addFlow(long long amount)
+{
+    flowValue += amount;
+}
+
+/**
+ * Get the flow value.
+ *
+ * Method Name: getFlowValue
+ *
+ * Purpose: Returns the flow sent from the source to the sink.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The flow value is returned.
+ *
+ * Returns: The flow value.
+ */
+long long GridNetwork::getFlowValue() const
+{
+    return flowValue;
+}
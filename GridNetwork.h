@@ -0,0 +1,438 @@
+/*
+ * File: GridNetwork.h Author: Nicolas Gioanni Purpose: Declaration of
+ * the GridNetwork class for representing a 2D or 3D pixel grid flow
+ * network without stored adjacency.
+ *
+ * Functionality/Features:
+ * - Declare methods for computing the neighbors of a pixel from its
+ *   coordinates for 4 and 8 connected 2D grids and 6 and 26 connected
+ *   3D grids.
+ * - Declare methods for setting the capacities between neighbors and
+ *   from the terminals.
+ * - Declare methods for reading and changing the residual
+ *   capacities.
+ *
+ * Assumptions:
+ * - Capacities fit in 32-bit integers, so a 512 x 512 x 512 volume
+ *   with 6 neighbors needs about 3.8 GB.
+ * - The residual capacities of one direction are stored together in
+ *   one dense array, indexed by pixel.
+ */
+
+#ifndef GRIDNETWORK_H
+#define GRIDNETWORK_H
+
+#include <cstddef>
+#include <vector>
+
+class GridNetwork
+{
+public:
+    /**
+     * Constructor for the GridNetwork class.
+     *
+     * Method Name: GridNetwork
+     *
+     * Purpose: Initializes a grid with all capacities set to 0.
+     *
+     * Parameters:
+     * - width: An integer representing the number of pixels along x.
+     * - height: An integer representing the number of pixels along y.
+     * - depth: An integer representing the number of pixels along z,
+     *   1 for a 2D grid.
+     * - connectivity: The number of neighbors of an inner pixel: 4 or
+     *   8 for a 2D grid, 6 or 26 for a 3D grid.
+     *
+     * Preconditions:
+     * - The sizes are positive.
+     *
+     * Postconditions:
+     * - The residual arrays are allocated.
+     * - An exception is thrown if the sizes or connectivity are
+     *   invalid.
+     */
+    GridNetwork(int width, int height, int depth, int connectivity);
+
+    /**
+     * Get the number of pixels.
+     *
+     * Method Name: getNodes
+     *
+     * Purpose: Returns the number of pixels in the grid.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The number of pixels is returned.
+     *
+     * Returns: An integer representing the number of pixels.
+     */
+    int getNodes() const
+    {
+        return nodes;
+    }
+
+    /**
+     * Get the number of neighbor directions.
+     *
+     * Method Name: getDirections
+     *
+     * Purpose: Returns the connectivity of the grid.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The number of directions is returned.
+     *
+     * Returns: An integer representing the number of directions.
+     */
+    int getDirections() const
+    {
+        return directions;
+    }
+
+    /**
+     * Get the pixel at a coordinate.
+     *
+     * Method Name: getNode
+     *
+     * Purpose: Returns the index of the pixel, with x changing fastest.
+     *
+     * Parameters:
+     * - x: An integer representing the x coordinate.
+     * - y: An integer representing the y coordinate.
+     * - z: An integer representing the z coordinate.
+     *
+     * Preconditions:
+     * - The coordinate is inside the grid.
+     *
+     * Postconditions:
+     * - The index is returned.
+     *
+     * Returns: The index of the pixel.
+     */
+    int getNode(int x, int y, int z) const
+    {
+        return (z * height + y) * width + x;
+    }
+
+    /**
+     * Get the neighbor of a pixel in a direction.
+     *
+     * Method Name: getNeighbor
+     *
+     * Purpose: Computes the neighbor from the coordinates of the pixel.
+     *
+     * Parameters:
+     * - node: An integer representing the pixel.
+     * - direction: An integer representing the direction.
+     *
+     * Preconditions:
+     * - The direction is below the connectivity.
+     *
+     * Postconditions:
+     * - The neighbor is returned.
+     *
+     * Returns: The index of the neighbor, -1 if it is outside the
+     * grid.
+     */
+    int getNeighbor(int node, int direction) const
+    {
+        int x = node % width;
+        int rest = node / width;
+        int y = rest % height;
+        int z = rest / height;
+        x += stepX[direction];
+        y += stepY[direction];
+        z += stepZ[direction];
+        if (x < 0 || x >= width || y < 0 || y >= height ||
+            z < 0 || z >= depth)
+        {
+            return -1;
+        }
+        return node + step[direction];
+    }
+
+    /**
+     * Get the opposite of a direction.
+     *
+     * Method Name: getOpposite
+     *
+     * Purpose: Returns the direction back from a neighbor. Directions
+     * are ordered so that opposite directions mirror each other.
+     *
+     * Parameters:
+     * - direction: An integer representing the direction.
+     *
+     * Preconditions:
+     * - The direction is below the connectivity.
+     *
+     * Postconditions:
+     * - The opposite direction is returned.
+     *
+     * Returns: The opposite direction.
+     */
+    int getOpposite(int direction) const
+    {
+        return directions - 1 - direction;
+    }
+
+    /**
+     * Get the residual capacity towards a neighbor.
+     *
+     * Method Name: getResidual
+     *
+     * Purpose: Returns the residual capacity of the arc from the pixel
+     * in the direction.
+     *
+     * Parameters:
+     * - node: An integer representing the pixel.
+     * - direction: An integer representing the direction.
+     *
+     * Preconditions:
+     * - The direction is below the connectivity.
+     *
+     * Postconditions:
+     * - The residual capacity is returned.
+     *
+     * Returns: The residual capacity, 0 for arcs leaving the grid.
+     */
+    int getResidual(int node, int direction) const
+    {
+        return residual[static_cast<size_t>(direction) * nodes + node];
+    }
+
+    /**
+     * Push flow towards a neighbor.
+     *
+     * Method Name: push
+     *
+     * Purpose: Moves residual capacity from the arc to its reverse arc.
+     *
+     * Parameters:
+     * - node: An integer representing the pixel.
+     * - direction: An integer representing the direction.
+     * - amount: The amount of flow to push.
+     *
+     * Preconditions:
+     * - The neighbor exists and the arc has enough residual capacity.
+     *
+     * Postconditions:
+     * - The residual capacities of the arc and its reverse arc are
+     *   updated.
+     */
+    void push(int node, int direction, int amount)
+    {
+        int neighbor = node + step[direction];
+        residual[static_cast<size_t>(direction) * nodes + node] -= amount;
+        residual[static_cast<size_t>(getOpposite(direction)) * nodes +
+                 neighbor] += amount;
+    }
+
+    /**
+     * Get the terminal residual capacity of a pixel.
+     *
+     * Method Name: getTerminal
+     *
+     * Purpose: Returns the residual capacity from the source if it is
+     * positive, or minus the residual capacity to the sink if it is
+     * negative.
+     *
+     * Parameters:
+     * - node: An integer representing the pixel.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The terminal residual capacity is returned.
+     *
+     * Returns: The signed terminal residual capacity.
+     */
+    int getTerminal(int node) const
+    {
+        return terminal[node];
+    }
+
+    /**
+     * Push flow from the source into a pixel.
+     *
+     * Method Name: pushFromSource
+     *
+     * Purpose: Uses residual capacity of the source arc of the pixel.
+     *
+     * Parameters:
+     * - node: An integer representing the pixel.
+     * - amount: The amount of flow to push.
+     *
+     * Preconditions:
+     * - The terminal residual capacity is at least the amount.
+     *
+     * Postconditions:
+     * - The terminal residual capacity is lowered.
+     */
+    void pushFromSource(int node, int amount)
+    {
+        terminal[node] -= amount;
+    }
+
+    /**
+     * Push flow from a pixel into the sink.
+     *
+     * Method Name: pushToSink
+     *
+     * Purpose: Uses residual capacity of the sink arc of the pixel.
+     *
+     * Parameters:
+     * - node: An integer representing the pixel.
+     * - amount: The amount of flow to push.
+     *
+     * Preconditions:
+     * - Minus the terminal residual capacity is at least the amount.
+     *
+     * Postconditions:
+     * - The terminal residual capacity is raised.
+     */
+    void pushToSink(int node, int amount)
+    {
+        terminal[node] += amount;
+    }
+
+    /**
+     * Set the capacity towards a neighbor.
+     *
+     * Method Name: setCapacity
+     *
+     * Purpose: Sets the capacity of the arc from the pixel in the
+     * direction.
+     *
+     * Parameters:
+     * - node: An integer representing the pixel.
+     * - direction: An integer representing the direction.
+     * - capacity: The non-negative capacity.
+     *
+     * Preconditions:
+     * - No flow was pushed yet.
+     *
+     * Postconditions:
+     * - The residual capacity of the arc is set.
+     * - An exception is thrown if the arc leaves the grid.
+     */
+    void setCapacity(int node, int direction, int capacity);
+
+    /**
+     * Set the capacities of one direction for every pixel.
+     *
+     * Method Name: setCapacities
+     *
+     * Purpose: Copies a whole array of capacities into the residual
+     * array of the direction, keeping arcs that leave the grid at 0.
+     *
+     * Parameters:
+     * - direction: An integer representing the direction.
+     * - capacities: A constant reference to one capacity per pixel.
+     *
+     * Preconditions:
+     * - No flow was pushed yet.
+     *
+     * Postconditions:
+     * - The residual capacities of the direction are set.
+     * - An exception is thrown if the sizes do not match.
+     */
+    void setCapacities(int direction, const std::vector<int> &capacities);
+
+    /**
+     * Set the terminal capacities of a pixel.
+     *
+     * Method Name: setTerminalCapacities
+     *
+     * Purpose: Sends the flow that can go straight from the source
+     * through the pixel to the sink right away and keeps the rest as
+     * the terminal residual capacity.
+     *
+     * Parameters:
+     * - node: An integer representing the pixel.
+     * - source: The non-negative capacity from the source.
+     * - sink: The non-negative capacity to the sink.
+     *
+     * Preconditions:
+     * - The terminal capacities of the pixel are set only once.
+     *
+     * Postconditions:
+     * - The terminal residual capacity and flow value are updated.
+     * - An exception is thrown if a capacity is negative.
+     */
+    void setTerminalCapacities(int node, int source, int sink);
+
+    /**
+     * Add to the flow value.
+     *
+     * Method Name: addFlow
+     *
+     * Purpose: Records flow sent from the source to the sink.
+     *
+     * Parameters:
+     * - amount: The amount of flow.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The flow value is raised.
+     */
+    void addFlow(long long amount);
+
+    /**
+     * Get the flow value.
+     *
+     * Method Name: getFlowValue
+     *
+     * Purpose: Returns the flow sent from the source to the sink.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The flow value is returned.
+     *
+     * Returns: The flow value.
+     */
+    long long getFlowValue() const;
+
+private:
+    // The number of pixels along x
+    int width;
+
+    // The number of pixels along y
+    int height;
+
+    // The number of pixels along z
+    int depth;
+
+    // The number of pixels
+    int nodes;
+
+    // The number of neighbor directions
+    int directions;
+
+    // The x, y and z offsets of every direction
+    std::vector<int> stepX;
+    std::vector<int> stepY;
+    std::vector<int> stepZ;
+
+    // The index offset of every direction
+    std::vector<int> step;
+
+    // The residual capacities, one block of pixels per direction
+    std::vector<int> residual;
+
+    // The signed terminal residual capacity of every pixel
+    std::vector<int> terminal;
+
+    // The flow sent from the source to the sink
+    long long flowValue;
+};
+
+#endif
@@ -0,0 +1,782 @@
+/*
+ * File: HaoOrlin.cpp Author: Nicolas Gioanni Purpose: Implementation
+ * of the HaoOrlin class, providing methods for calculating the global
+ * minimum cut of a directed network.
+ *
+ * Functionality/Features:
+ * - Run push-relabel towards a changing sink, keeping the flow and
+ *   labels between sinks.
+ * - Put nodes that cannot reach the sink to sleep in dormant sets and
+ *   wake them when the awake nodes run out.
+ * - Keep the awake nodes in buckets by label, so the next sink and the
+ *   nodes above a gap are found without a scan of all nodes.
+ * - Discharge the active node with the highest label and refresh the
+ *   labels with a global relabel once the relabels have scanned about
+ *   as many arcs as two global relabels would.
+ * - Move nodes whose excess reaches the smallest cut found into the
+ *   source set without making them sinks, and end a phase as soon as
+ *   its sink holds that much.
+ * - Run on the network and on its reverse to cover both sides of
+ *   node 0.
+ *
+ * Assumptions:
+ * - Labels are only compared between awake nodes, and the sink always
+ *   has the smallest awake label.
+ */
+
+#include "HaoOrlin.h"
+#include <algorithm>
+#include <climits>
+#include <iostream>
+#include <stdexcept>
+
+namespace
+{
+    // The work of a relabel on top of the arcs it scans
+    const long long relabelWork = 12;
+
+    // The work per node a global relabel is counted at on top of its
+    // arcs, following Cherkassky and Goldberg
+    const long long nodeWork = 6;
+}
+
+/**
+ * Constructor for the HaoOrlin class.
+ *
+ * Method Name: HaoOrlin
+ *
+ * Purpose: Initializes a new instance of the HaoOrlin class.
+ *
+ * Parameters:
+ * - nodes: An integer representing the number of nodes.
+ * - arcs: A constant reference to the arcs of the network.
+ *
+ * Preconditions:
+ * - Every arc is within the range of the nodes.
+ *
+ * Postconditions:
+ * - A new instance of the HaoOrlin class is created.
+ */
+HaoOrlin::HaoOrlin(int nodes, const std::vector<FlowArc> &arcs)
+    : nodes(nodes),
+      arcs(arcs),
+      network(nullptr),
+      lowestAwake(0),
+      highestAwake(0),
+      highestActive(-1),
+      workSinceGlobal(0),
+      bestCut(LLONG_MAX)
+{
+}
+
+/**
+ * Calculates the global minimum cut.
+ *
+ * Method Name: calculateMinCut
+ *
+ * Purpose: Finds the smallest cut with node 0 on the source side with
+ * one Hao-Orlin run, in which every node in turn is the sink and keeps
+ * the labels of the previous sinks, then repeats the run on the
+ * reversed network for cuts with node 0 on the sink side.
+ *
+ * Returns: The capacity of the global minimum cut.
+ *
+ * Preconditions:
+ * - The network has at least two nodes.
+ *
+ * Postconditions:
+ * - The source side of the cut is recorded.
+ * - An exception is thrown if the calculation process fails.
+ */
+long long HaoOrlin::calculateMinCut()
+{
+    try
+    {
+        // Check if there is a cut at all
+        if (nodes < 2)
+        {
+            std::cerr
+                << "ERROR: A cut needs at least two nodes."
+                << std::endl;
+            throw std::invalid_argument("A cut needs at least two nodes.");
+        }
+
+        // Swapping the capacities of every arc pair reverses the network
+        std::vector<FlowArc> reversedArcs;
+        reversedArcs.reserve(arcs.size());
+        for (const FlowArc &arc : arcs)
+        {
+            reversedArcs.push_back(
+                {arc.tail, arc.head, arc.reverseCapacity, arc.capacity});
+        }
+        FlowNetwork forwardNetwork(nodes, arcs);
+        FlowNetwork reversedNetwork(nodes, reversedArcs);
+
+        // Cuts with node 0 on the source side
+        std::vector<bool> sinkSide;
+        bestCut = LLONG_MAX;
+        long long best = findMinCutFromSource(forwardNetwork, sinkSide);
+        sourceSide.assign(nodes, false);
+        for (int node = 0; node < nodes; ++node)
+        {
+            sourceSide[node] = !sinkSide[node];
+        }
+
+        // Cuts with node 0 on the sink side are source cuts of the
+        // reversed network, with the sides swapped; the run only looks
+        // for cuts below the best one so far
+        long long reversedBest =
+            findMinCutFromSource(reversedNetwork, sinkSide);
+        if (reversedBest < best)
+        {
+            best = reversedBest;
+            sourceSide = sinkSide;
+        }
+
+        network = nullptr;
+        return best;
+    }
+    catch (const std::exception &e)
+    {
+        // Output an error message if the calculation fails
+        std::cerr
+            << "ERROR: Error in calculateMinCut: "
+            << e.what()
+            << std::endl;
+        throw std::runtime_error("Error in calculateMinCut: " +
+                                 std::string(e.what()));
+    }
+}
+
+/**
+ * Get the source side of the global minimum cut.
+ *
+ * Method Name: getSourceSide
+ *
+ * Purpose: Returns the nodes the minimum cut leaves.
+ *
+ * Preconditions:
+ * - calculateMinCut was called.
+ *
+ * Postconditions:
+ * - The source side is returned.
+ *
+ * Returns: A vector with true for every node on the source side.
+ */
+const std::vector<bool> &HaoOrlin::getSourceSide() const
+{
+    return sourceSide;
+}
+
+/**
+ * Runs the algorithm with node 0 as the first source.
+ *
+ * Method Name: findMinCutFromSource
+ *
+ * Purpose: Moves the nodes into the source set one at a time, each after
+ * being the sink of a push-relabel phase, and keeps the smallest cut
+ * between the source set and the sink. Starts from the smallest cut
+ * around a single node, and skips the phases that cannot beat the
+ * smallest cut found so far.
+ *
+ * Parameters:
+ * - runNetwork: A reference to the network to run on.
+ * - sinkSide: A reference to the vector that receives the sink side of
+ *   the smallest cut.
+ *
+ * Returns: The capacity of the smallest cut found so far, in this run
+ * or an earlier one.
+ *
+ * Preconditions:
+ * - The network carries no flow.
+ *
+ * Postconditions:
+ * - The sink side of the smallest cut is written, or no node if no cut
+ *   of this run is smaller than one found before.
+ */
+long long HaoOrlin::findMinCutFromSource(FlowNetwork &runNetwork,
+                                         std::vector<bool> &sinkSide)
+{
+    network = &runNetwork;
+    label.assign(nodes, 0);
+    excess.assign(nodes, 0);
+    currentArc.resize(nodes);
+    for (int node = 0; node < nodes; ++node)
+    {
+        currentArc[node] = network->arcBegin(node);
+    }
+    inSource.assign(nodes, false);
+    dormantSet.assign(nodes, -1);
+    dormantSets.clear();
+    awakeNodes.clear();
+    awakePosition.assign(nodes, -1);
+    awakeBuckets.assign(2 * nodes + 1, std::vector<int>());
+    bucketPosition.assign(nodes, -1);
+    lowestAwake = 0;
+    highestAwake = 0;
+    activeBuckets.assign(2 * nodes + 1, std::vector<int>());
+    highestActive = -1;
+    queued.assign(nodes, false);
+    searchLabel.assign(nodes, -1);
+
+    // A node alone on the sink side is cut off by its inflow, which
+    // bounds the cuts worth finding from the start
+    std::vector<int> bestSinkSide;
+    for (int node = 1; node < nodes; ++node)
+    {
+        long long inflow = 0;
+        for (int arc = network->arcBegin(node);
+             arc < network->arcEnd(node);
+             ++arc)
+        {
+            inflow += network->getCapacity(network->getReverse(arc));
+        }
+        if (inflow < bestCut)
+        {
+            bestCut = inflow;
+            bestSinkSide.assign(1, node);
+        }
+    }
+
+    inSource[0] = true;
+    for (int node = 1; node < nodes; ++node)
+    {
+        addAwake(node);
+    }
+    addToSource(0);
+    int sink = 1;
+    globalRelabel(sink);
+
+    while (true)
+    {
+        // Move all excess of the awake nodes to the sink, unless the
+        // sink ends up with the smallest cut found or more
+        dischargeActiveNodes(sink);
+
+        // The flow into the awake nodes is the cut around them, and
+        // all of it now sits at the sink
+        if (excess[sink] < bestCut)
+        {
+            bestCut = excess[sink];
+            bestSinkSide = awakeNodes;
+        }
+
+        // The sink joins the source set
+        removeAwake(sink);
+        inSource[sink] = true;
+        if (awakeNodes.empty() && dormantSets.empty())
+        {
+            break;
+        }
+        addToSource(sink);
+
+        // Wake the newest dormant set if no awake node is left
+        if (awakeNodes.empty())
+        {
+            wakeNewestSet();
+        }
+
+        // The next sink is an awake node with the smallest label
+        while (awakeBuckets[lowestAwake].empty())
+        {
+            lowestAwake++;
+        }
+        sink = awakeBuckets[lowestAwake].front();
+    }
+
+    sinkSide.assign(nodes, false);
+    for (int node : bestSinkSide)
+    {
+        sinkSide[node] = true;
+    }
+    return bestCut;
+}
+
+/**
+ * Discharges active nodes until none is left.
+ *
+ * Method Name: dischargeActiveNodes
+ *
+ * Purpose: Repeatedly discharges the active node with the highest
+ * label, running a global relabel once the relabels since the last one
+ * have done twice its work. A node with at least the smallest cut found
+ * as excess joins the source set instead, since every cut between it
+ * and the source set carries that excess.
+ *
+ * Parameters:
+ * - sink: An integer representing the current sink.
+ *
+ * Preconditions:
+ * - The active buckets hold every awake node with excess.
+ *
+ * Postconditions:
+ * - No awake node other than the sink has excess, or the sink holds at
+ *   least the smallest cut found.
+ */
+void HaoOrlin::dischargeActiveNodes(int sink)
+{
+    // No awake node is labeled below the lowest awake label, and a sink
+    // holding the smallest cut found cannot give a smaller one
+    while (highestActive >= lowestAwake && excess[sink] < bestCut)
+    {
+        std::vector<int> &bucket = activeBuckets[highestActive];
+        if (bucket.empty())
+        {
+            highestActive--;
+            continue;
+        }
+
+        int node = bucket.back();
+        bucket.pop_back();
+        queued[node] = false;
+
+        // Skip nodes that fell asleep, were emptied or moved since they
+        // were added
+        if (!isAwake(node) || node == sink || excess[node] <= 0)
+        {
+            continue;
+        }
+        if (label[node] != highestActive)
+        {
+            activate(node);
+            continue;
+        }
+
+        // No cut smaller than the excess separates the node from the
+        // source set
+        if (excess[node] >= bestCut)
+        {
+            removeAwake(node);
+            inSource[node] = true;
+            addToSource(node);
+            continue;
+        }
+
+        discharge(node, sink);
+
+        // Refresh the labels once the relabels have done about twice
+        // the work of a global relabel
+        if (workSinceGlobal > 2 * (nodeWork * nodes + network->getArcs()))
+        {
+            globalRelabel(sink);
+        }
+    }
+}
+
+/**
+ * Recomputes the labels of the awake nodes.
+ *
+ * Method Name: globalRelabel
+ *
+ * Purpose: Sets the label of every awake node to the label of the sink
+ * plus its residual distance to the sink through awake nodes, puts the
+ * awake nodes that cannot reach the sink to sleep as a new dormant set,
+ * and refills the active buckets.
+ *
+ * Parameters:
+ * - sink: An integer representing the current sink.
+ *
+ * Preconditions:
+ * - The sink is awake.
+ *
+ * Postconditions:
+ * - The labels of the awake nodes are exact and valid.
+ * - The active buckets hold every awake node with excess.
+ */
+void HaoOrlin::globalRelabel(int sink)
+{
+    // Search backwards from the sink through the awake nodes
+    std::vector<int> reached(1, sink);
+    searchLabel[sink] = label[sink];
+    for (size_t front = 0; front < reached.size(); ++front)
+    {
+        int node = reached[front];
+        for (int arc = network->arcBegin(node);
+             arc < network->arcEnd(node);
+             ++arc)
+        {
+            int tail = network->getHead(arc);
+            if (searchLabel[tail] == -1 && isAwake(tail) &&
+                network->getResidual(network->getReverse(arc)) > 0)
+            {
+                searchLabel[tail] = searchLabel[node] + 1;
+                reached.push_back(tail);
+            }
+        }
+    }
+
+    // The awake nodes the search missed have no residual arc into the
+    // reached ones, so they sleep with the labels they have
+    std::vector<int> sleeping;
+    for (int node : awakeNodes)
+    {
+        if (searchLabel[node] == -1)
+        {
+            sleeping.push_back(node);
+        }
+    }
+    if (!sleeping.empty())
+    {
+        int setIndex = static_cast<int>(dormantSets.size());
+        for (int node : sleeping)
+        {
+            removeAwake(node);
+            dormantSet[node] = setIndex;
+        }
+        dormantSets.push_back(sleeping);
+    }
+
+    // Move the reached nodes to their new buckets
+    lowestAwake = label[sink];
+    highestAwake = label[sink];
+    for (int node : reached)
+    {
+        removeAwake(node);
+        label[node] = searchLabel[node];
+        searchLabel[node] = -1;
+        currentArc[node] = network->arcBegin(node);
+        addAwake(node);
+    }
+
+    // Refill the active buckets
+    for (std::vector<int> &bucket : activeBuckets)
+    {
+        for (int node : bucket)
+        {
+            queued[node] = false;
+        }
+        bucket.clear();
+    }
+    highestActive = -1;
+    for (int node : reached)
+    {
+        if (node != sink && excess[node] > 0)
+        {
+            activate(node);
+        }
+    }
+    workSinceGlobal = 0;
+}
+
+/**
+ * Wakes the newest dormant set.
+ *
+ * Method Name: wakeNewestSet
+ *
+ * Purpose: Makes the nodes of the newest dormant set awake again with
+ * the labels they slept with, and queues those with excess.
+ *
+ * Preconditions:
+ * - No node is awake and a dormant set is left.
+ *
+ * Postconditions:
+ * - The nodes of the set are awake.
+ */
+void HaoOrlin::wakeNewestSet()
+{
+    std::vector<int> woken = std::move(dormantSets.back());
+    dormantSets.pop_back();
+
+    // The woken labels are only compared with each other
+    lowestAwake = label[woken.front()];
+    highestAwake = label[woken.front()];
+    for (int node : woken)
+    {
+        dormantSet[node] = -1;
+        addAwake(node);
+    }
+    for (int node : woken)
+    {
+        if (excess[node] > 0)
+        {
+            activate(node);
+        }
+    }
+}
+
+/**
+ * Adds a node to the awake nodes.
+ *
+ * Method Name: addAwake
+ *
+ * Purpose: Adds the node to the awake nodes and to the bucket of its
+ * label.
+ *
+ * Parameters:
+ * - node: An integer representing the node.
+ *
+ * Preconditions:
+ * - The node is not in the awake nodes.
+ *
+ * Postconditions:
+ * - The node is in the awake nodes and in its bucket.
+ */
+void HaoOrlin::addAwake(int node)
+{
+    int nodeLabel = label[node];
+    if (nodeLabel >= static_cast<int>(awakeBuckets.size()))
+    {
+        awakeBuckets.resize(nodeLabel + 1);
+        activeBuckets.resize(nodeLabel + 1);
+    }
+    awakePosition[node] = static_cast<int>(awakeNodes.size());
+    awakeNodes.push_back(node);
+    bucketPosition[node] = static_cast<int>(awakeBuckets[nodeLabel].size());
+    awakeBuckets[nodeLabel].push_back(node);
+    lowestAwake = std::min(lowestAwake, nodeLabel);
+    highestAwake = std::max(highestAwake, nodeLabel);
+}
+
+/**
+ * Removes a node from the awake nodes.
+ *
+ * Method Name: removeAwake
+ *
+ * Purpose: Removes the node from the awake nodes and from the bucket of
+ * its label, moving the last entries into the freed places.
+ *
+ * Parameters:
+ * - node: An integer representing the node.
+ *
+ * Preconditions:
+ * - The node is in the awake nodes.
+ *
+ * Postconditions:
+ * - The node is in neither the awake nodes nor its bucket.
+ */
+void HaoOrlin::removeAwake(int node)
+{
+    int last = awakeNodes.back();
+    awakeNodes[awakePosition[node]] = last;
+    awakePosition[last] = awakePosition[node];
+    awakeNodes.pop_back();
+    awakePosition[node] = -1;
+
+    std::vector<int> &bucket = awakeBuckets[label[node]];
+    last = bucket.back();
+    bucket[bucketPosition[node]] = last;
+    bucketPosition[last] = bucketPosition[node];
+    bucket.pop_back();
+    bucketPosition[node] = -1;
+}
+
+/**
+ * Moves a node into the source set.
+ *
+ * Method Name: addToSource
+ *
+ * Purpose: Saturates every residual arc from the node to nodes outside
+ * the source set.
+ *
+ * Parameters:
+ * - node: An integer representing the node.
+ *
+ * Preconditions:
+ * - The node is not awake or dormant any more.
+ *
+ * Postconditions:
+ * - The node is in the source set.
+ * - Awake heads that received excess are queued.
+ */
+void HaoOrlin::addToSource(int node)
+{
+    for (int arc = network->arcBegin(node);
+         arc < network->arcEnd(node);
+         ++arc)
+    {
+        int head = network->getHead(arc);
+        long long amount = network->getResidual(arc);
+        if (amount > 0 && !inSource[head])
+        {
+            network->push(arc, amount);
+            excess[node] -= amount;
+            excess[head] += amount;
+            activate(head);
+        }
+    }
+}
+
+/**
+ * Discharges one node.
+ *
+ * Method Name: discharge
+ *
+ * Purpose: Pushes the excess of the node along admissible arcs into
+ * awake nodes, relabeling it once its arcs run out.
+ *
+ * Parameters:
+ * - node: An integer representing the node.
+ * - sink: An integer representing the current sink.
+ *
+ * Preconditions:
+ * - The node is awake and is not the sink.
+ *
+ * Postconditions:
+ * - The node has no excess, or it was relabeled and queued again, or
+ *   it became dormant.
+ */
+void HaoOrlin::discharge(int node, int sink)
+{
+    while (excess[node] > 0)
+    {
+        if (currentArc[node] == network->arcEnd(node))
+        {
+            // A relabeled node waits for its turn at the new label
+            if (relabel(node))
+            {
+                activate(node);
+            }
+            return;
+        }
+
+        int arc = currentArc[node];
+        int head = network->getHead(arc);
+        long long residual = network->getResidual(arc);
+        if (residual > 0 && isAwake(head) &&
+            label[node] == label[head] + 1)
+        {
+            long long amount =
+                excess[node] < residual ? excess[node] : residual;
+            network->push(arc, amount);
+            excess[node] -= amount;
+            excess[head] += amount;
+            if (head != sink)
+            {
+                activate(head);
+            }
+        }
+        else
+        {
+            currentArc[node]++;
+        }
+    }
+}
+
+/**
+ * Relabels one node or puts it to sleep.
+ *
+ * Method Name: relabel
+ *
+ * Purpose: If the node is the only awake node with its label, makes
+ * every awake node at or above the label a new dormant set. If it has
+ * no residual arc into an awake node, makes it a dormant set on its
+ * own. Otherwise raises its label past its lowest awake residual
+ * neighbor.
+ *
+ * Parameters:
+ * - node: An integer representing the node.
+ *
+ * Returns: True if the node is still awake.
+ *
+ * Preconditions:
+ * - The node has no admissible arc.
+ *
+ * Postconditions:
+ * - The node is relabeled or dormant.
+ */
+bool HaoOrlin::relabel(int node)
+{
+    int oldLabel = label[node];
+    int setIndex = static_cast<int>(dormantSets.size());
+    workSinceGlobal +=
+        relabelWork + network->arcEnd(node) - network->arcBegin(node);
+
+    // No awake node above the gap has a residual arc below it
+    if (awakeBuckets[oldLabel].size() == 1)
+    {
+        std::vector<int> sleeping;
+        for (int level = oldLabel; level <= highestAwake; ++level)
+        {
+            std::vector<int> &bucket = awakeBuckets[level];
+            while (!bucket.empty())
+            {
+                int other = bucket.back();
+                removeAwake(other);
+                dormantSet[other] = setIndex;
+                sleeping.push_back(other);
+            }
+        }
+        highestAwake = oldLabel - 1;
+        dormantSets.push_back(sleeping);
+        return false;
+    }
+
+    // Find the lowest awake residual neighbor
+    int lowest = -1;
+    for (int arc = network->arcBegin(node);
+         arc < network->arcEnd(node);
+         ++arc)
+    {
+        int head = network->getHead(arc);
+        if (network->getResidual(arc) > 0 && isAwake(head) &&
+            (lowest < 0 || label[head] < lowest))
+        {
+            lowest = label[head];
+        }
+    }
+
+    removeAwake(node);
+    if (lowest < 0)
+    {
+        // The node cannot send anything to the awake nodes
+        dormantSet[node] = setIndex;
+        dormantSets.push_back(std::vector<int>(1, node));
+        return false;
+    }
+
+    label[node] = lowest + 1;
+    addAwake(node);
+    currentArc[node] = network->arcBegin(node);
+    return true;
+}
+
+/**
+ * Adds an awake node to the active buckets.
+ *
+ * Method Name: activate
+ *
+ * Purpose: Adds the node to the active bucket of its label if it is
+ * awake and not queued yet.
+ *
+ * Parameters:
+ * - node: An integer representing the node.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The node is queued if it can be discharged.
+ */
+void HaoOrlin::activate(int node)
+{
+    if (isAwake(node) && !queued[node])
+    {
+        queued[node] = true;
+        activeBuckets[label[node]].push_back(node);
+        highestActive = std::max(highestActive, label[node]);
+    }
+}
+
+/**
+ * Check if a node is awake.
+ *
+ * Method Name: isAwake
+ *
+ * Purpose: Returns whether the node is neither in the source set nor
+ * dormant.
+ *
+ * Parameters:
+ * - node: An integer representing the node.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The result is returned.
+ *
+ * Returns: True if the node is awake.
+ */
+bool HaoOrlin::isAwake(int node) const
+{
+    return !inSource[node] && dormantSet[node] == -1;
+}
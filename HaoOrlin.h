@@ -0,0 +1,384 @@
+/*
+ * File: HaoOrlin.h Author: Nicolas Gioanni Purpose: Declaration of the
+ * HaoOrlin class for calculating the global minimum cut of a directed
+ * network with the Hao-Orlin algorithm.
+ *
+ * Functionality/Features:
+ * - Declare methods for calculating the smallest cut over all
+ *   partitions of the nodes, without a fixed source or sink.
+ * - Declare methods for reading the source side of that cut.
+ *
+ * Assumptions:
+ * - Capacities are non-negative integers.
+ * - The network has at least two nodes.
+ */
+
+#ifndef HAOORLIN_H
+#define HAOORLIN_H
+
+#include "FlowNetwork.h"
+#include <vector>
+
+class HaoOrlin
+{
+public:
+    /**
+     * Constructor for the HaoOrlin class.
+     *
+     * Method Name: HaoOrlin
+     *
+     * Purpose: Initializes a new instance of the HaoOrlin class.
+     *
+     * Parameters:
+     * - nodes: An integer representing the number of nodes.
+     * - arcs: A constant reference to the arcs of the network.
+     *
+     * Preconditions:
+     * - Every arc is within the range of the nodes.
+     *
+     * Postconditions:
+     * - A new instance of the HaoOrlin class is created.
+     */
+    HaoOrlin(int nodes, const std::vector<FlowArc> &arcs);
+
+    /**
+     * Calculates the global minimum cut.
+     *
+     * Method Name: calculateMinCut
+     *
+     * Purpose: Finds the smallest cut with node 0 on the source side
+     * with one Hao-Orlin run, in which every node in turn is the sink
+     * and keeps the labels of the previous sinks, then repeats the run
+     * on the reversed network for cuts with node 0 on the sink side.
+     *
+     * Returns: The capacity of the global minimum cut.
+     *
+     * Preconditions:
+     * - The network has at least two nodes.
+     *
+     * Postconditions:
+     * - The source side of the cut is recorded.
+     * - An exception is thrown if the calculation process fails.
+     */
+    long long calculateMinCut();
+
+    /**
+     * Get the source side of the global minimum cut.
+     *
+     * Method Name: getSourceSide
+     *
+     * Purpose: Returns the nodes the minimum cut leaves.
+     *
+     * Preconditions:
+     * - calculateMinCut was called.
+     *
+     * Postconditions:
+     * - The source side is returned.
+     *
+     * Returns: A vector with true for every node on the source side.
+     */
+    const std::vector<bool> &getSourceSide() const;
+
+private:
+    // The number of nodes
+    int nodes;
+
+    // The arcs of the network
+    std::vector<FlowArc> arcs;
+
+    // The source side of the best cut
+    std::vector<bool> sourceSide;
+
+    // The network of the current run
+    FlowNetwork *network;
+
+    // The distance label of every node
+    std::vector<int> label;
+
+    // The flow into every node minus the flow out of it
+    std::vector<long long> excess;
+
+    // The next arc to try from every node
+    std::vector<int> currentArc;
+
+    // True for nodes that joined the source set
+    std::vector<bool> inSource;
+
+    // The dormant set of every node, -1 for nodes that are awake
+    std::vector<int> dormantSet;
+
+    // The dormant sets, the last one is woken first
+    std::vector<std::vector<int>> dormantSets;
+
+    // The awake nodes
+    std::vector<int> awakeNodes;
+
+    // The position of every awake node in the awake nodes
+    std::vector<int> awakePosition;
+
+    // The awake nodes with every label
+    std::vector<std::vector<int>> awakeBuckets;
+
+    // The position of every awake node in the bucket of its label
+    std::vector<int> bucketPosition;
+
+    // No awake node is labeled below this label
+    int lowestAwake;
+
+    // No awake node is labeled above this label
+    int highestAwake;
+
+    // The awake nodes that may have excess, by label
+    std::vector<std::vector<int>> activeBuckets;
+
+    // The highest label that may have an active node
+    int highestActive;
+
+    // True for nodes that are in an active bucket
+    std::vector<bool> queued;
+
+    // The arcs scanned by relabels since the last global relabel, plus
+    // a fixed cost for every relabel
+    long long workSinceGlobal;
+
+    // The smallest cut found so far, in either run
+    long long bestCut;
+
+    // The label found by a global relabel, -1 for nodes not reached
+    std::vector<int> searchLabel;
+
+    /**
+     * Runs the algorithm with node 0 as the first source.
+     *
+     * Method Name: findMinCutFromSource
+     *
+     * Purpose: Moves the nodes into the source set one at a time, each
+     * after being the sink of a push-relabel phase, and keeps the
+     * smallest cut between the source set and the sink. Starts from the
+     * smallest cut around a single node, and skips the phases that
+     * cannot beat the smallest cut found so far.
+     *
+     * Parameters:
+     * - runNetwork: A reference to the network to run on.
+     * - sinkSide: A reference to the vector that receives the sink side
+     *   of the smallest cut.
+     *
+     * Returns: The capacity of the smallest cut found so far, in this
+     * run or an earlier one.
+     *
+     * Preconditions:
+     * - The network carries no flow.
+     *
+     * Postconditions:
+     * - The sink side of the smallest cut is written, or no node if no
+     *   cut of this run is smaller than one found before.
+     */
+    long long findMinCutFromSource(FlowNetwork &runNetwork,
+                                   std::vector<bool> &sinkSide);
+
+    /**
+     * Discharges active nodes until none is left.
+     *
+     * Method Name: dischargeActiveNodes
+     *
+     * Purpose: Repeatedly discharges the active node with the highest
+     * label, running a global relabel once the relabels since the last
+     * one have done twice its work. A node with at least the smallest
+     * cut found as excess joins the source set instead, since every cut
+     * between it and the source set carries that excess.
+     *
+     * Parameters:
+     * - sink: An integer representing the current sink.
+     *
+     * Preconditions:
+     * - The active buckets hold every awake node with excess.
+     *
+     * Postconditions:
+     * - No awake node other than the sink has excess, or the sink holds
+     *   at least the smallest cut found.
+     */
+    void dischargeActiveNodes(int sink);
+
+    /**
+     * Recomputes the labels of the awake nodes.
+     *
+     * Method Name: globalRelabel
+     *
+     * Purpose: Sets the label of every awake node to the label of the
+     * sink plus its residual distance to the sink through awake nodes,
+     * puts the awake nodes that cannot reach the sink to sleep as a new
+     * dormant set, and refills the active buckets.
+     *
+     * Parameters:
+     * - sink: An integer representing the current sink.
+     *
+     * Preconditions:
+     * - The sink is awake.
+     *
+     * Postconditions:
+     * - The labels of the awake nodes are exact and valid.
+     * - The active buckets hold every awake node with excess.
+     */
+    void globalRelabel(int sink);
+
+    /**
+     * Wakes the newest dormant set.
+     *
+     * Method Name: wakeNewestSet
+     *
+     * Purpose: Makes the nodes of the newest dormant set awake again with
+     * the labels they slept with, and queues those with excess.
+     *
+     * Preconditions:
+     * - No node is awake and a dormant set is left.
+     *
+     * Postconditions:
+     * - The nodes of the set are awake.
+     */
+    void wakeNewestSet();
+
+    /**
+     * Adds a node to the awake nodes.
+     *
+     * Method Name: addAwake
+     *
+     * Purpose: Adds the node to the awake nodes and to the bucket of its
+     * label.
+     *
+     * Parameters:
+     * - node: An integer representing the node.
+     *
+     * Preconditions:
+     * - The node is not in the awake nodes.
+     *
+     * Postconditions:
+     * - The node is in the awake nodes and in its bucket.
+     */
+    void addAwake(int node);
+
+    /**
+     * Removes a node from the awake nodes.
+     *
+     * Method Name: removeAwake
+     *
+     * Purpose: Removes the node from the awake nodes and from the bucket
+     * of its label, moving the last entries into the freed places.
+     *
+     * Parameters:
+     * - node: An integer representing the node.
+     *
+     * Preconditions:
+     * - The node is in the awake nodes.
+     *
+     * Postconditions:
+     * - The node is in neither the awake nodes nor its bucket.
+     */
+    void removeAwake(int node);
+
+    /**
+     * Moves a node into the source set.
+     *
+     * Method Name: addToSource
+     *
+     * Purpose: Saturates every residual arc from the node to nodes
+     * outside the source set.
+     *
+     * Parameters:
+     * - node: An integer representing the node.
+     *
+     * Preconditions:
+     * - The node is not awake or dormant any more.
+     *
+     * Postconditions:
+     * - The node is in the source set.
+     * - Awake heads that received excess are queued.
+     */
+    void addToSource(int node);
+
+    /**
+     * Discharges one node.
+     *
+     * Method Name: discharge
+     *
+     * Purpose: Pushes the excess of the node along admissible arcs into
+     * awake nodes, relabeling it once its arcs run out.
+     *
+     * Parameters:
+     * - node: An integer representing the node.
+     * - sink: An integer representing the current sink.
+     *
+     * Preconditions:
+     * - The node is awake and is not the sink.
+     *
+     * Postconditions:
+     * - The node has no excess, or it was relabeled and queued again,
+     *   or it became dormant.
+     */
+    void discharge(int node, int sink);
+
+    /**
+     * Relabels one node or puts it to sleep.
+     *
+     * Method Name: relabel
+     *
+     * Purpose: If the node is the only awake node with its label, makes
+     * every awake node at or above the label a new dormant set. If it
+     * has no residual arc into an awake node, makes it a dormant set on
+     * its own. Otherwise raises its label past its lowest awake
+     * residual neighbor.
+     *
+     * Parameters:
+     * - node: An integer representing the node.
+     *
+     * Returns: True if the node is still awake.
+     *
+     * Preconditions:
+     * - The node has no admissible arc.
+     *
+     * Postconditions:
+     * - The node is relabeled or dormant.
+     */
+    bool relabel(int node);
+
+    /**
+     * Adds an awake node to the active buckets.
+     *
+     * Method Name: activate
+     *
+     * Purpose: Adds the node to the active bucket of its label if it is
+     * awake and not queued yet.
+     *
+     * Parameters:
+     * - node: An integer representing the node.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The node is queued if it can be discharged.
+     */
+    void activate(int node);
+
+    /**
+     * Check if a node is awake.
+     *
+     * Method Name: isAwake
+     *
+     * Purpose: Returns whether the node is neither in the source set
+     * nor dormant.
+     *
+     * Parameters:
+     * - node: An integer representing the node.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The result is returned.
+     *
+     * Returns: True if the node is awake.
+     */
+    bool isAwake(int node) const;
+};
+
+#endif
@@ -0,0 +1,340 @@
+/*
+ * File: HopcroftKarp.cpp Author: Nicolas Gioanni Purpose:
+ * Implementation of the HopcroftKarp class, providing methods for
+ * calculating maximum bipartite matchings on an adjacency list.
+ *
+ * Functionality/Features:
+ * - Start from a greedy matching or from a matching set by the caller.
+ * - Augment along a maximal set of disjoint shortest alternating paths
+ *   per phase.
+ *
+ * Assumptions:
+ * - The depth first search keeps its own stack, so long alternating
+ *   paths do not exhaust the call stack.
+ */
+
+#include "HopcroftKarp.h"
+#include <iostream>
+#include <stdexcept>
+
+/**
+ * Constructor for the HopcroftKarp class.
+ *
+ * Method Name: HopcroftKarp
+ *
+ * Purpose: Stores the adjacency of the left nodes and starts from the
+ * empty matching.
+ *
+ * Parameters:
+ * - leftNodes: An integer representing the number of left nodes.
+ * - rightNodes: An integer representing the number of right nodes.
+ * - offsets: A constant reference to the start of the neighbors of
+ *   every left node, with one extra entry at the end.
+ * - targets: A constant reference to the right neighbors.
+ *
+ * Preconditions:
+ * - The offsets are non-decreasing and end at the target count.
+ *
+ * Postconditions:
+ * - A new instance of the HopcroftKarp class is created.
+ * - An exception is thrown if the adjacency is invalid.
+ */
+HopcroftKarp::HopcroftKarp(int leftNodes,
+                           int rightNodes,
+                           const std::vector<int> &offsets,
+                           const std::vector<int> &targets)
+    : leftNodes(leftNodes),
+      rightNodes(rightNodes),
+      offsets(offsets),
+      targets(targets),
+      leftMatch(leftNodes < 0 ? 0 : leftNodes, -1),
+      rightMatch(rightNodes < 0 ? 0 : rightNodes, -1),
+      layer(leftNodes < 0 ? 0 : leftNodes, -1),
+      currentEdge(leftNodes < 0 ? 0 : leftNodes, 0)
+{
+    // Check if the adjacency describes the two sides
+    bool valid = leftNodes >= 0 && rightNodes >= 0 &&
+                 static_cast<int>(offsets.size()) == leftNodes + 1 &&
+                 offsets[0] == 0 &&
+                 offsets[leftNodes] == static_cast<int>(targets.size());
+    for (int node = 0; valid && node < leftNodes; ++node)
+    {
+        valid = offsets[node] <= offsets[node + 1];
+    }
+    for (size_t edge = 0; valid && edge < targets.size(); ++edge)
+    {
+        valid = targets[edge] >= 0 && targets[edge] < rightNodes;
+    }
+    if (!valid)
+    {
+        std::cerr << "ERROR: Bipartite adjacency is Invalid." << std::endl;
+        throw std::invalid_argument("Bipartite adjacency is Invalid.");
+    }
+}
+
+/**
+ * Calculates a maximum matching.
+ *
+ * Method Name: calculateMaxMatching
+ *
+ * Purpose: Matches free left nodes greedily and then augments along
+ * shortest alternating paths, a whole phase of disjoint paths at a
+ * time, starting from the matching already held.
+ *
+ * Returns: The size of the maximum matching.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The matching is maximum.
+ */
+int HopcroftKarp::calculateMaxMatching()
+{
+    int size = 0;
+
+    // Match every free left node to a free neighbor if it has one
+    for (int node = 0; node < leftNodes; ++node)
+    {
+        for (int edge = offsets[node];
+             leftMatch[node] == -1 && edge < offsets[node + 1];
+             ++edge)
+        {
+            if (rightMatch[targets[edge]] == -1)
+            {
+                leftMatch[node] = targets[edge];
+                rightMatch[targets[edge]] = node;
+            }
+        }
+        if (leftMatch[node] != -1)
+        {
+            ++size;
+        }
+    }
+
+    // Augment a phase of shortest paths at a time
+    while (buildLayers())
+    {
+        for (int node = 0; node < leftNodes; ++node)
+        {
+            currentEdge[node] = offsets[node];
+        }
+        for (int node = 0; node < leftNodes; ++node)
+        {
+            if (leftMatch[node] == -1 && augmentFrom(node))
+            {
+                ++size;
+            }
+        }
+    }
+    return size;
+}
+
+/**
+ * Sets the matching to start from.
+ *
+ * Method Name: setMatching
+ *
+ * Purpose: Replaces the held matching, so a later solve only has to add
+ * the missing pairs.
+ *
+ * Parameters:
+ * - leftMatch: A constant reference to the right partner of every left
+ *   node, -1 for free nodes.
+ *
+ * Preconditions:
+ * - Every pair is an edge and no right node is used twice.
+ *
+ * Postconditions:
+ * - The matching is replaced.
+ * - An exception is thrown if it is not a matching of the graph.
+ */
+void HopcroftKarp::setMatching(const std::vector<int> &leftMatch)
+{
+    std::vector<int> rightMatch(rightNodes, -1);
+    bool valid = static_cast<int>(leftMatch.size()) == leftNodes;
+    for (int node = 0; valid && node < leftNodes; ++node)
+    {
+        int partner = leftMatch[node];
+        if (partner == -1)
+        {
+            continue;
+        }
+        valid = partner >= 0 && partner < rightNodes &&
+                rightMatch[partner] == -1;
+        bool edgeFound = false;
+        for (int edge = offsets[node];
+             valid && !edgeFound && edge < offsets[node + 1];
+             ++edge)
+        {
+            edgeFound = targets[edge] == partner;
+        }
+        valid = valid && edgeFound;
+        if (valid)
+        {
+            rightMatch[partner] = node;
+        }
+    }
+    if (!valid)
+    {
+        std::cerr << "ERROR: Starting matching is Invalid." << std::endl;
+        throw std::invalid_argument("Starting matching is Invalid.");
+    }
+
+    this->leftMatch = leftMatch;
+    this->rightMatch.swap(rightMatch);
+}
+
+/**
+ * Get the partner of every left node.
+ *
+ * Method Name: getLeftMatch
+ *
+ * Purpose: Returns the right partner of every left node.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The partners are returned.
+ *
+ * Returns: The right partner of every left node, -1 for free nodes.
+ */
+const std::vector<int> &HopcroftKarp::getLeftMatch() const
+{
+    return leftMatch;
+}
+
+/**
+ * Get the partner of every right node.
+ *
+ * Method Name: getRightMatch
+ *
+ * Purpose: Returns the left partner of every right node.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The partners are returned.
+ *
+ * Returns: The left partner of every right node, -1 for free nodes.
+ */
+const std::vector<int> &HopcroftKarp::getRightMatch() const
+{
+    return rightMatch;
+}
+
+/**
+ * Builds the layers of the shortest alternating paths.
+ *
+ * Method Name: buildLayers
+ *
+ * Purpose: Runs a BFS from all free left nodes that moves to right nodes
+ * along any edge and back to the left along matched edges.
+ *
+ * Returns: True if a free right node was reached.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The layers are set, with unreached left nodes at -1.
+ */
+bool HopcroftKarp::buildLayers()
+{
+    std::vector<int> queue;
+    queue.reserve(leftNodes);
+    for (int node = 0; node < leftNodes; ++node)
+    {
+        layer[node] = -1;
+        if (leftMatch[node] == -1)
+        {
+            layer[node] = 0;
+            queue.push_back(node);
+        }
+    }
+
+    bool freeReached = false;
+    for (size_t front = 0; front < queue.size(); ++front)
+    {
+        int node = queue[front];
+        for (int edge = offsets[node]; edge < offsets[node + 1]; ++edge)
+        {
+            int partner = rightMatch[targets[edge]];
+            if (partner == -1)
+            {
+                freeReached = true;
+            }
+            else if (layer[partner] == -1)
+            {
+                layer[partner] = layer[node] + 1;
+                queue.push_back(partner);
+            }
+        }
+    }
+    return freeReached;
+}
+
+/**
+ * Augments along one path from a free left node.
+ *
+ * Method Name: augmentFrom
+ *
+ * Purpose: Searches the layered graph depth first without recursion and
+ * flips the matching along the first path that ends at a free right
+ * node. Dead ends are removed from the layers.
+ *
+ * Parameters:
+ * - root: An integer representing the free left node.
+ *
+ * Returns: True if the matching grew.
+ *
+ * Preconditions:
+ * - buildLayers was called in this phase.
+ *
+ * Postconditions:
+ * - The current edges are advanced.
+ */
+bool HopcroftKarp::augmentFrom(int root)
+{
+    std::vector<int> stack(1, root);
+    while (!stack.empty())
+    {
+        int node = stack.back();
+        if (currentEdge[node] == offsets[node + 1])
+        {
+            // Nothing left below this node in the current phase
+            layer[node] = -1;
+            stack.pop_back();
+            if (!stack.empty())
+            {
+                ++currentEdge[stack.back()];
+            }
+            continue;
+        }
+
+        int right = targets[currentEdge[node]];
+        int partner = rightMatch[right];
+        if (partner == -1)
+        {
+            // Flip the matching along the path on the stack
+            for (int pathNode : stack)
+            {
+                int pathRight = targets[currentEdge[pathNode]];
+                leftMatch[pathNode] = pathRight;
+                rightMatch[pathRight] = pathNode;
+            }
+            return true;
+        }
+        if (layer[partner] == layer[node] + 1)
+        {
+            stack.push_back(partner);
+        }
+        else
+        {
+            ++currentEdge[node];
+        }
+    }
+    return false;
+}
@@ -0,0 +1,195 @@
+/*
+ * File: HopcroftKarp.h Author: Nicolas Gioanni Purpose: Declaration of
+ * the HopcroftKarp class for calculating maximum bipartite matchings on
+ * an adjacency list with the Hopcroft-Karp algorithm.
+ *
+ * Functionality/Features:
+ * - Declare methods for calculating a maximum matching, continuing from
+ *   the matching already held.
+ * - Declare methods for setting a starting matching and reading the
+ *   matched partner of every node.
+ *
+ * Assumptions:
+ * - The graph is given in compressed sparse row form: the neighbors of
+ *   left node u are targets[offsets[u]] to targets[offsets[u + 1] - 1],
+ *   and they are indices of right nodes.
+ * - Only the left side lists edges, so no node count squared memory is
+ *   needed.
+ */
+
+#ifndef HOPCROFTKARP_H
+#define HOPCROFTKARP_H
+
+#include <vector>
+
+class HopcroftKarp
+{
+public:
+    /**
+     * Constructor for the HopcroftKarp class.
+     *
+     * Method Name: HopcroftKarp
+     *
+     * Purpose: Stores the adjacency of the left nodes and starts from
+     * the empty matching.
+     *
+     * Parameters:
+     * - leftNodes: An integer representing the number of left nodes.
+     * - rightNodes: An integer representing the number of right nodes.
+     * - offsets: A constant reference to the start of the neighbors of
+     *   every left node, with one extra entry at the end.
+     * - targets: A constant reference to the right neighbors.
+     *
+     * Preconditions:
+     * - The offsets are non-decreasing and end at the target count.
+     *
+     * Postconditions:
+     * - A new instance of the HopcroftKarp class is created.
+     * - An exception is thrown if the adjacency is invalid.
+     */
+    HopcroftKarp(int leftNodes,
+                 int rightNodes,
+                 const std::vector<int> &offsets,
+                 const std::vector<int> &targets);
+
+    /**
+     * Calculates a maximum matching.
+     *
+     * Method Name: calculateMaxMatching
+     *
+     * Purpose: Matches free left nodes greedily and then augments along
+     * shortest alternating paths, a whole phase of disjoint paths at a
+     * time, starting from the matching already held.
+     *
+     * Returns: The size of the maximum matching.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The matching is maximum.
+     */
+    int calculateMaxMatching();
+
+    /**
+     * Sets the matching to start from.
+     *
+     * Method Name: setMatching
+     *
+     * Purpose: Replaces the held matching, so a later solve only has
+     * to add the missing pairs.
+     *
+     * Parameters:
+     * - leftMatch: A constant reference to the right partner of every
+     *   left node, -1 for free nodes.
+     *
+     * Preconditions:
+     * - Every pair is an edge and no right node is used twice.
+     *
+     * Postconditions:
+     * - The matching is replaced.
+     * - An exception is thrown if it is not a matching of the graph.
+     */
+    void setMatching(const std::vector<int> &leftMatch);
+
+    /**
+     * Get the partner of every left node.
+     *
+     * Method Name: getLeftMatch
+     *
+     * Purpose: Returns the right partner of every left node.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The partners are returned.
+     *
+     * Returns: The right partner of every left node, -1 for free nodes.
+     */
+    const std::vector<int> &getLeftMatch() const;
+
+    /**
+     * Get the partner of every right node.
+     *
+     * Method Name: getRightMatch
+     *
+     * Purpose: Returns the left partner of every right node.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The partners are returned.
+     *
+     * Returns: The left partner of every right node, -1 for free nodes.
+     */
+    const std::vector<int> &getRightMatch() const;
+
+private:
+    // The number of left nodes
+    int leftNodes;
+
+    // The number of right nodes
+    int rightNodes;
+
+    // The start of the neighbors of every left node
+    std::vector<int> offsets;
+
+    // The right neighbors of all left nodes
+    std::vector<int> targets;
+
+    // The right partner of every left node, -1 if free
+    std::vector<int> leftMatch;
+
+    // The left partner of every right node, -1 if free
+    std::vector<int> rightMatch;
+
+    // The BFS layer of every left node in the current phase
+    std::vector<int> layer;
+
+    // The next edge to try from every left node in the current phase
+    std::vector<int> currentEdge;
+
+    /**
+     * Builds the layers of the shortest alternating paths.
+     *
+     * Method Name: buildLayers
+     *
+     * Purpose: Runs a BFS from all free left nodes that moves to right
+     * nodes along any edge and back to the left along matched edges.
+     *
+     * Returns: True if a free right node was reached.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The layers are set, with unreached left nodes at -1.
+     */
+    bool buildLayers();
+
+    /**
+     * Augments along one path from a free left node.
+     *
+     * Method Name: augmentFrom
+     *
+     * Purpose: Searches the layered graph depth first without recursion
+     * and flips the matching along the first path that ends at a free
+     * right node. Dead ends are removed from the layers.
+     *
+     * Parameters:
+     * - root: An integer representing the free left node.
+     *
+     * Returns: True if the matching grew.
+     *
+     * Preconditions:
+     * - buildLayers was called in this phase.
+     *
+     * Postconditions:
+     * - The current edges are advanced.
+     */
+    bool augmentFrom(int root);
+};
+
+#endif
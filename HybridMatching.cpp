@@ -0,0 +1,317 @@
+/*
+ * File: HybridMatching.cpp Author: Nicolas Gioanni Purpose:
+ * Implementation of the HybridMatching class, providing the parallel
+ * greedy phase and the hand over to Hopcroft-Karp.
+ *
+ * Functionality/Features:
+ * - Claim right nodes with compare and swap on one atomic owner per
+ *   right node, so threads never share any other state.
+ * - Time every round and stop the greedy phase once its rate of new
+ *   pairs falls well below the best round.
+ *
+ * Assumptions:
+ * - Every left node is in the range of exactly one thread per round and
+ *   is the only writer of its own partner and scan position.
+ * - A right node, once claimed, stays claimed in the greedy phase.
+ */
+
+#include "HybridMatching.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <thread>
+
+namespace
+{
+    // Proposes for a range of free left nodes, keeps the unmatched ones
+    // that still have edges to try and returns the number matched
+    int proposeRange(const int *active,
+                     int count,
+                     const int *offsets,
+                     const int *targets,
+                     int *scan,
+                     int *leftMatch,
+                     std::atomic<int> *owner,
+                     int roundEdges,
+                     std::vector<int> &remaining)
+    {
+        int matched = 0;
+        for (int index = 0; index < count; ++index)
+        {
+            int node = active[index];
+            int end = std::min(offsets[node + 1], scan[node] + roundEdges);
+            for (; scan[node] < end; ++scan[node])
+            {
+                int right = targets[scan[node]];
+                int expected = -1;
+                if (owner[right].load(std::memory_order_relaxed) == -1 &&
+                    owner[right].compare_exchange_strong(
+                        expected, node, std::memory_order_relaxed))
+                {
+                    leftMatch[node] = right;
+                    ++scan[node];
+                    ++matched;
+                    break;
+                }
+            }
+            if (leftMatch[node] == -1 && scan[node] < offsets[node + 1])
+            {
+                remaining.push_back(node);
+            }
+        }
+        return matched;
+    }
+}
+
+/**
+ * Constructor for the HybridMatching class.
+ *
+ * Method Name: HybridMatching
+ *
+ * Purpose: Stores the adjacency of the left nodes and starts from the
+ * empty matching.
+ *
+ * Parameters:
+ * - leftNodes: An integer representing the number of left nodes.
+ * - rightNodes: An integer representing the number of right nodes.
+ * - offsets: A constant reference to the start of the neighbors of
+ *   every left node, with one extra entry at the end.
+ * - targets: A constant reference to the right neighbors.
+ * - threads: The number of threads of the greedy phase, 0 to use every
+ *   hardware thread.
+ *
+ * Preconditions:
+ * - The offsets are non-decreasing and end at the target count.
+ *
+ * Postconditions:
+ * - A new instance of the HybridMatching class is created.
+ * - An exception is thrown if the adjacency is invalid.
+ */
+HybridMatching::HybridMatching(int leftNodes,
+                               int rightNodes,
+                               const std::vector<int> &offsets,
+                               const std::vector<int> &targets,
+                               int threads)
+    : leftNodes(leftNodes),
+      rightNodes(rightNodes),
+      offsets(offsets),
+      targets(targets),
+      threads(threads),
+      finisher(leftNodes, rightNodes, offsets, targets),
+      leftMatch(leftNodes, -1),
+      rightMatch(rightNodes, -1),
+      greedySize(0)
+{
+    if (threads <= 0)
+    {
+        threads = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    this->threads = threads > 0 ? threads : 1;
+}
+
+/**
+ * Calculates a maximum matching.
+ *
+ * Method Name: calculateMaxMatching
+ *
+ * Purpose: Runs rounds in which every free left node claims its next
+ * free neighbors with an atomic compare and swap, split over the
+ * threads, until a round stalls. The partial matching is then handed to
+ * Hopcroft-Karp, which finishes it exactly.
+ *
+ * Returns: The size of the maximum matching.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The matching is maximum.
+ */
+int HybridMatching::calculateMaxMatching()
+{
+    matchGreedily();
+
+    finisher.setMatching(leftMatch);
+    int size = finisher.calculateMaxMatching();
+    leftMatch = finisher.getLeftMatch();
+    rightMatch = finisher.getRightMatch();
+    return size;
+}
+
+/**
+ * Get the partner of every left node.
+ *
+ * Method Name: getLeftMatch
+ *
+ * Purpose: Returns the right partner of every left node.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The partners are returned.
+ *
+ * Returns: The right partner of every left node, -1 for free nodes.
+ */
+const std::vector<int> &HybridMatching::getLeftMatch() const
+{
+    return leftMatch;
+}
+
+/**
+ * Get the partner of every right node.
+ *
+ * Method Name: getRightMatch
+ *
+ * Purpose: Returns the left partner of every right node.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The partners are returned.
+ *
+ * Returns: The left partner of every right node, -1 for free nodes.
+ */
+const std::vector<int> &HybridMatching::getRightMatch() const
+{
+    return rightMatch;
+}
+
+/**
+ * Get the size of the greedy matching.
+ *
+ * Method Name: getGreedySize
+ *
+ * Purpose: Returns the number of pairs the greedy phase of the last
+ * solve handed to the exact phase.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The size is returned.
+ *
+ * Returns: The number of greedy pairs.
+ */
+int HybridMatching::getGreedySize() const
+{
+    return greedySize;
+}
+
+/**
+ * Runs the greedy phase.
+ *
+ * Method Name: matchGreedily
+ *
+ * Purpose: Runs proposal rounds over the free left nodes, timing every
+ * round, until a round stalls or no node has edges left.
+ *
+ * Preconditions:
+ * - The matches describe a matching of the graph.
+ *
+ * Postconditions:
+ * - The matches hold the greedy matching.
+ */
+void HybridMatching::matchGreedily()
+{
+    // Start from the matching already held
+    std::unique_ptr<std::atomic<int>[]> owner(
+        new std::atomic<int>[rightNodes]);
+    for (int right = 0; right < rightNodes; ++right)
+    {
+        owner[right].store(rightMatch[right], std::memory_order_relaxed);
+    }
+    std::vector<int> scan(offsets.begin(), offsets.end() - 1);
+    std::vector<int> active;
+    for (int node = 0; node < leftNodes; ++node)
+    {
+        if (leftMatch[node] == -1 && offsets[node] < offsets[node + 1])
+        {
+            active.push_back(node);
+        }
+    }
+
+    greedySize = leftNodes - static_cast<int>(
+                                 std::count(leftMatch.begin(),
+                                            leftMatch.end(), -1));
+    double bestRate = 0.0;
+    while (!active.empty())
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        // Split the free nodes over the threads the round can use
+        int count = static_cast<int>(active.size());
+        int parts = std::max(1, std::min(threads,
+                                         count / NODES_PER_THREAD));
+        std::vector<std::vector<int>> remaining(parts);
+        std::vector<int> matched(parts, 0);
+        std::vector<std::exception_ptr> errors(parts);
+        auto proposePart = [&](int part)
+        {
+            try
+            {
+                int first = static_cast<int>(
+                    static_cast<long long>(count) * part / parts);
+                int last = static_cast<int>(
+                    static_cast<long long>(count) * (part + 1) / parts);
+                matched[part] = proposeRange(
+                    active.data() + first, last - first, offsets.data(),
+                    targets.data(), scan.data(), leftMatch.data(),
+                    owner.get(), ROUND_EDGES, remaining[part]);
+            }
+            catch (...)
+            {
+                errors[part] = std::current_exception();
+            }
+        };
+        std::vector<std::thread> pool;
+        for (int part = 1; part < parts; ++part)
+        {
+            pool.emplace_back(proposePart, part);
+        }
+        proposePart(0);
+        for (std::thread &thread : pool)
+        {
+            thread.join();
+        }
+        for (const std::exception_ptr &error : errors)
+        {
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+        }
+
+        // Gather the nodes still free with edges left to try
+        int found = 0;
+        active.clear();
+        for (int part = 0; part < parts; ++part)
+        {
+            found += matched[part];
+            active.insert(active.end(), remaining[part].begin(),
+                          remaining[part].end());
+        }
+        greedySize += found;
+
+        // Stop once a round falls well below the best rate of pairs
+        std::chrono::duration<double, std::micro> elapsed =
+            std::chrono::steady_clock::now() - start;
+        double rate = found / std::max(elapsed.count(), 1e-3);
+        bestRate = std::max(bestRate, rate);
+        if (found == 0 || rate < STALL_FRACTION * bestRate)
+        {
+            break;
+        }
+    }
+
+    for (int node = 0; node < leftNodes; ++node)
+    {
+        if (leftMatch[node] != -1)
+        {
+            rightMatch[leftMatch[node]] = node;
+        }
+    }
+}
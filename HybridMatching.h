@@ -0,0 +1,187 @@
+/*
+ * File: HybridMatching.h Author: Nicolas Gioanni Purpose: Declaration of
+ * the HybridMatching class for calculating maximum bipartite matchings
+ * with a parallel greedy phase that hands over to Hopcroft-Karp.
+ *
+ * Functionality/Features:
+ * - Declare methods for calculating a maximum matching in two phases:
+ *   rounds of parallel proposals while they pay off, then exact
+ *   augmenting paths from the partial matching.
+ * - Declare methods for reading the matched partner of every node and
+ *   the number of pairs the greedy phase found.
+ *
+ * Assumptions:
+ * - The graph is given in the same compressed sparse row form as for
+ *   HopcroftKarp.
+ * - The greedy phase stops as soon as a round matches pairs at less
+ *   than STALL_FRACTION of the best rate so far, so the exact phase
+ *   takes over where the strategy that is faster changes.
+ */
+
+#ifndef HYBRIDMATCHING_H
+#define HYBRIDMATCHING_H
+
+#include "HopcroftKarp.h"
+#include <vector>
+
+class HybridMatching
+{
+public:
+    // The number of edges a free left node tries per round
+    static constexpr int ROUND_EDGES = 4;
+
+    // The share of the best rate below which the greedy phase stops
+    static constexpr double STALL_FRACTION = 0.25;
+
+    // The number of left nodes per thread below which no thread is
+    // added
+    static constexpr int NODES_PER_THREAD = 4096;
+
+    /**
+     * Constructor for the HybridMatching class.
+     *
+     * Method Name: HybridMatching
+     *
+     * Purpose: Stores the adjacency of the left nodes and starts from
+     * the empty matching.
+     *
+     * Parameters:
+     * - leftNodes: An integer representing the number of left nodes.
+     * - rightNodes: An integer representing the number of right nodes.
+     * - offsets: A constant reference to the start of the neighbors of
+     *   every left node, with one extra entry at the end.
+     * - targets: A constant reference to the right neighbors.
+     * - threads: The number of threads of the greedy phase, 0 to use
+     *   every hardware thread.
+     *
+     * Preconditions:
+     * - The offsets are non-decreasing and end at the target count.
+     *
+     * Postconditions:
+     * - A new instance of the HybridMatching class is created.
+     * - An exception is thrown if the adjacency is invalid.
+     */
+    HybridMatching(int leftNodes,
+                   int rightNodes,
+                   const std::vector<int> &offsets,
+                   const std::vector<int> &targets,
+                   int threads = 0);
+
+    /**
+     * Calculates a maximum matching.
+     *
+     * Method Name: calculateMaxMatching
+     *
+     * Purpose: Runs rounds in which every free left node claims its
+     * next free neighbors with an atomic compare and swap, split over
+     * the threads, until a round stalls. The partial matching is then
+     * handed to Hopcroft-Karp, which finishes it exactly.
+     *
+     * Returns: The size of the maximum matching.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The matching is maximum.
+     */
+    int calculateMaxMatching();
+
+    /**
+     * Get the partner of every left node.
+     *
+     * Method Name: getLeftMatch
+     *
+     * Purpose: Returns the right partner of every left node.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The partners are returned.
+     *
+     * Returns: The right partner of every left node, -1 for free nodes.
+     */
+    const std::vector<int> &getLeftMatch() const;
+
+    /**
+     * Get the partner of every right node.
+     *
+     * Method Name: getRightMatch
+     *
+     * Purpose: Returns the left partner of every right node.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The partners are returned.
+     *
+     * Returns: The left partner of every right node, -1 for free nodes.
+     */
+    const std::vector<int> &getRightMatch() const;
+
+    /**
+     * Get the size of the greedy matching.
+     *
+     * Method Name: getGreedySize
+     *
+     * Purpose: Returns the number of pairs the greedy phase of the last
+     * solve handed to the exact phase.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The size is returned.
+     *
+     * Returns: The number of greedy pairs.
+     */
+    int getGreedySize() const;
+
+private:
+    // The number of left nodes
+    int leftNodes;
+
+    // The number of right nodes
+    int rightNodes;
+
+    // The start of the neighbors of every left node
+    std::vector<int> offsets;
+
+    // The right neighbors of all left nodes
+    std::vector<int> targets;
+
+    // The number of threads of the greedy phase
+    int threads;
+
+    // The exact phase, which also checks the adjacency
+    HopcroftKarp finisher;
+
+    // The right partner of every left node, -1 if free
+    std::vector<int> leftMatch;
+
+    // The left partner of every right node, -1 if free
+    std::vector<int> rightMatch;
+
+    // The number of pairs found by the greedy phase
+    int greedySize;
+
+    /**
+     * Runs the greedy phase.
+     *
+     * Method Name: matchGreedily
+     *
+     * Purpose: Runs proposal rounds over the free left nodes, timing
+     * every round, until a round stalls or no node has edges left.
+     *
+     * Preconditions:
+     * - The matches describe a matching of the graph.
+     *
+     * Postconditions:
+     * - The matches hold the greedy matching.
+     */
+    void matchGreedily();
+};
+
+#endif
@@ -0,0 +1,651 @@
+/*
+ * File: MatchingEnumerator.cpp Author: Nicolas Gioanni Purpose:
+ * Implementation of the MatchingEnumerator class, providing methods for
+ * listing the maximum matchings of a bipartite graph lazily.
+ *
+ * Functionality/Features:
+ * - Solve the graph once and drop the edges that are in no maximum
+ *   matching.
+ * - Walk Uno's binary partition with an explicit stack of levels, so
+ *   the enumeration can stop after any matching and resume later.
+ * - Keep every subproblem as flags on the one stored graph: the branch
+ *   with an edge removes its two end nodes, the branch without it
+ *   removes the edge.
+ *
+ * Assumptions:
+ * - A maximum matching of the graph without the two end nodes of a
+ *   matched edge stays maximum there, and a second maximum matching
+ *   that avoids an edge is maximum in the graph without that edge.
+ */
+
+#include "MatchingEnumerator.h"
+#include "HopcroftKarp.h"
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+/**
+ * Constructor for the MatchingEnumerator class.
+ *
+ * Method Name: MatchingEnumerator
+ *
+ * Purpose: Stores the graph with sorted, duplicate-free neighbor lists
+ * and a list of incoming edges for every right node.
+ *
+ * Parameters:
+ * - leftNodes: An integer representing the number of left nodes.
+ * - rightNodes: An integer representing the number of right nodes.
+ * - offsets: A constant reference to the start of the neighbors of
+ *   every left node, with one extra entry at the end.
+ * - targets: A constant reference to the right neighbors.
+ *
+ * Preconditions:
+ * - The offsets are non-decreasing and end at the target count.
+ *
+ * Postconditions:
+ * - A new instance of the MatchingEnumerator class is created.
+ * - An exception is thrown if the adjacency is invalid.
+ */
+MatchingEnumerator::MatchingEnumerator(int leftNodes,
+                                       int rightNodes,
+                                       const std::vector<int> &offsets,
+                                       const std::vector<int> &targets)
+    : leftNodes(leftNodes),
+      rightNodes(rightNodes),
+      matchingSize(0),
+      started(false),
+      searchPending(false)
+{
+    // Check if the adjacency describes the two sides
+    bool valid = leftNodes >= 0 && rightNodes >= 0 &&
+                 static_cast<int>(offsets.size()) == leftNodes + 1 &&
+                 offsets[0] == 0 &&
+                 offsets[leftNodes] == static_cast<int>(targets.size());
+    for (int node = 0; valid && node < leftNodes; ++node)
+    {
+        valid = offsets[node] <= offsets[node + 1];
+    }
+    for (size_t edge = 0; valid && edge < targets.size(); ++edge)
+    {
+        valid = targets[edge] >= 0 && targets[edge] < rightNodes;
+    }
+    if (!valid)
+    {
+        std::cerr << "ERROR: Bipartite adjacency is Invalid." << std::endl;
+        throw std::invalid_argument("Bipartite adjacency is Invalid.");
+    }
+
+    // Sort every neighbor list and drop parallel edges
+    this->offsets.assign(1, 0);
+    for (int node = 0; node < leftNodes; ++node)
+    {
+        size_t first = this->targets.size();
+        this->targets.insert(this->targets.end(),
+                             targets.begin() + offsets[node],
+                             targets.begin() + offsets[node + 1]);
+        std::sort(this->targets.begin() + first, this->targets.end());
+        this->targets.erase(std::unique(this->targets.begin() + first,
+                                        this->targets.end()),
+                            this->targets.end());
+        this->offsets.push_back(static_cast<int>(this->targets.size()));
+        this->sources.resize(this->targets.size(), node);
+    }
+
+    // List the incoming edges of every right node
+    int edges = static_cast<int>(this->targets.size());
+    rightOffsets.assign(rightNodes + 1, 0);
+    for (int edge = 0; edge < edges; ++edge)
+    {
+        ++rightOffsets[this->targets[edge] + 1];
+    }
+    for (int node = 0; node < rightNodes; ++node)
+    {
+        rightOffsets[node + 1] += rightOffsets[node];
+    }
+    rightEdges.resize(edges);
+    std::vector<int> position(rightOffsets.begin(), rightOffsets.end() - 1);
+    for (int edge = 0; edge < edges; ++edge)
+    {
+        rightEdges[position[this->targets[edge]]++] = edge;
+    }
+
+    edgeActive.assign(edges, true);
+    leftActive.assign(leftNodes, true);
+    rightActive.assign(rightNodes, true);
+    visitState.assign(leftNodes, 0);
+    scanEdge.assign(leftNodes, 0);
+}
+
+/**
+ * Steps to the next maximum matching.
+ *
+ * Method Name: next
+ *
+ * Purpose: The first call solves the graph with Hopcroft-Karp and
+ * removes the edges that are in no maximum matching, using the strongly
+ * connected components of the alternating graph. Every later call
+ * resumes the binary partition: find a second maximum matching by an
+ * alternating cycle or an alternating path of length two, report it,
+ * and split into the matchings with and without one edge where the two
+ * differ.
+ *
+ * Returns: True if a new matching is available, false once all were
+ * produced.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The current matching is updated.
+ * - An exception is thrown if the enumeration fails.
+ */
+bool MatchingEnumerator::next()
+{
+    try
+    {
+        if (!started)
+        {
+            started = true;
+            HopcroftKarp matcher(leftNodes, rightNodes, offsets, targets);
+            matchingSize = matcher.calculateMaxMatching();
+            leftMatch = matcher.getLeftMatch();
+            rightMatch = matcher.getRightMatch();
+            pruneEdges();
+
+            matching = leftMatch;
+            searchPending = true;
+            return true;
+        }
+
+        while (true)
+        {
+            if (searchPending)
+            {
+                searchPending = false;
+                if (search())
+                {
+                    return true;
+                }
+            }
+            if (frames.empty())
+            {
+                return false;
+            }
+
+            // Move the top level on to its next branch
+            Frame &frame = frames.back();
+            int left = sources[frame.edge];
+            int right = targets[frame.edge];
+            if (frame.stage == 0)
+            {
+                leftActive[left] = false;
+                rightActive[right] = false;
+                frame.stage = 1;
+                searchPending = true;
+            }
+            else if (frame.stage == 1)
+            {
+                leftActive[left] = true;
+                rightActive[right] = true;
+                edgeActive[frame.edge] = false;
+                applyChanges(frame.changes, true);
+                frame.stage = 2;
+                searchPending = true;
+            }
+            else
+            {
+                edgeActive[frame.edge] = true;
+                applyChanges(frame.changes, false);
+                frames.pop_back();
+            }
+        }
+    }
+    catch (const std::exception &e)
+    {
+        // Output an error message if the enumeration fails
+        std::cerr
+            << "ERROR: Error in next: "
+            << e.what()
+            << std::endl;
+        throw std::runtime_error("Error in next: " +
+                                 std::string(e.what()));
+    }
+}
+
+/**
+ * Get the current matching.
+ *
+ * Method Name: getMatching
+ *
+ * Purpose: Returns the matching produced by the last call to next.
+ *
+ * Preconditions:
+ * - next returned true.
+ *
+ * Postconditions:
+ * - The matching is returned.
+ *
+ * Returns: The right partner of every left node, -1 for free nodes.
+ */
+const std::vector<int> &MatchingEnumerator::getMatching() const
+{
+    return matching;
+}
+
+/**
+ * Get the size of the maximum matchings.
+ *
+ * Method Name: getMatchingSize
+ *
+ * Purpose: Returns the number of pairs in every matching produced.
+ *
+ * Preconditions:
+ * - next was called.
+ *
+ * Postconditions:
+ * - The size is returned.
+ *
+ * Returns: The size of a maximum matching.
+ */
+int MatchingEnumerator::getMatchingSize() const
+{
+    return matchingSize;
+}
+
+/**
+ * Removes the edges that are in no maximum matching.
+ *
+ * Method Name: pruneEdges
+ *
+ * Purpose: Keeps the matched edges, the edges to free right nodes, and
+ * every unmatched edge that lies on an alternating cycle or on an even
+ * alternating path from a free node. Cycles are found with the strongly
+ * connected components of the graph on the left nodes that goes from l
+ * to the partner of every other neighbor of l.
+ *
+ * Preconditions:
+ * - The matching is maximum.
+ *
+ * Postconditions:
+ * - Every remaining edge is in some maximum matching.
+ */
+void MatchingEnumerator::pruneEdges()
+{
+    // The left node an unmatched edge leads to, -1 if none
+    auto step = [this](int left, int edge)
+    {
+        int right = targets[edge];
+        return right == leftMatch[left] ? -1 : rightMatch[right];
+    };
+
+    // Left nodes reached from a free left node
+    std::vector<bool> fromFreeLeft(leftNodes, false);
+    std::vector<int> queue;
+    for (int node = 0; node < leftNodes; ++node)
+    {
+        if (leftMatch[node] == -1)
+        {
+            fromFreeLeft[node] = true;
+            queue.push_back(node);
+        }
+    }
+    for (size_t front = 0; front < queue.size(); ++front)
+    {
+        int node = queue[front];
+        for (int edge = offsets[node]; edge < offsets[node + 1]; ++edge)
+        {
+            int nextNode = step(node, edge);
+            if (nextNode != -1 && !fromFreeLeft[nextNode])
+            {
+                fromFreeLeft[nextNode] = true;
+                queue.push_back(nextNode);
+            }
+        }
+    }
+
+    // Left nodes that reach a free right node
+    std::vector<bool> toFreeRight(leftNodes, false);
+    queue.clear();
+    for (int right = 0; right < rightNodes; ++right)
+    {
+        if (rightMatch[right] != -1)
+        {
+            continue;
+        }
+        for (int slot = rightOffsets[right]; slot < rightOffsets[right + 1];
+             ++slot)
+        {
+            int node = sources[rightEdges[slot]];
+            if (!toFreeRight[node])
+            {
+                toFreeRight[node] = true;
+                queue.push_back(node);
+            }
+        }
+    }
+    for (size_t front = 0; front < queue.size(); ++front)
+    {
+        int right = leftMatch[queue[front]];
+        for (int slot = rightOffsets[right]; slot < rightOffsets[right + 1];
+             ++slot)
+        {
+            int node = sources[rightEdges[slot]];
+            if (node != queue[front] && !toFreeRight[node])
+            {
+                toFreeRight[node] = true;
+                queue.push_back(node);
+            }
+        }
+    }
+
+    // Strongly connected components with Tarjan's algorithm
+    std::vector<int> order(leftNodes, -1);
+    std::vector<int> low(leftNodes, 0);
+    std::vector<int> component(leftNodes, -1);
+    std::vector<bool> onStack(leftNodes, false);
+    std::vector<int> stack;
+    std::vector<int> calls;
+    int counter = 0;
+    int components = 0;
+    for (int start = 0; start < leftNodes; ++start)
+    {
+        if (order[start] != -1)
+        {
+            continue;
+        }
+        order[start] = low[start] = counter++;
+        stack.push_back(start);
+        onStack[start] = true;
+        scanEdge[start] = offsets[start];
+        calls.push_back(start);
+        while (!calls.empty())
+        {
+            int node = calls.back();
+            if (scanEdge[node] < offsets[node + 1])
+            {
+                int nextNode = step(node, scanEdge[node]++);
+                if (nextNode == -1)
+                {
+                    continue;
+                }
+                if (order[nextNode] == -1)
+                {
+                    order[nextNode] = low[nextNode] = counter++;
+                    stack.push_back(nextNode);
+                    onStack[nextNode] = true;
+                    scanEdge[nextNode] = offsets[nextNode];
+                    calls.push_back(nextNode);
+                }
+                else if (onStack[nextNode])
+                {
+                    low[node] = std::min(low[node], order[nextNode]);
+                }
+                continue;
+            }
+
+            calls.pop_back();
+            if (!calls.empty())
+            {
+                low[calls.back()] = std::min(low[calls.back()], low[node]);
+            }
+            if (low[node] == order[node])
+            {
+                int member;
+                do
+                {
+                    member = stack.back();
+                    stack.pop_back();
+                    onStack[member] = false;
+                    component[member] = components;
+                } while (member != node);
+                ++components;
+            }
+        }
+    }
+
+    for (int node = 0; node < leftNodes; ++node)
+    {
+        for (int edge = offsets[node]; edge < offsets[node + 1]; ++edge)
+        {
+            int right = targets[edge];
+            if (right == leftMatch[node] || rightMatch[right] == -1)
+            {
+                continue;
+            }
+            int partner = rightMatch[right];
+            edgeActive[edge] = fromFreeLeft[node] || toFreeRight[partner] ||
+                               component[node] == component[partner];
+        }
+    }
+}
+
+/**
+ * Searches the subproblem for a second maximum matching.
+ *
+ * Method Name: search
+ *
+ * Purpose: Looks for an alternating path of length two from a free
+ * node, then for an alternating cycle with a depth first search. If one
+ * is found a new level is opened and the second matching is reported.
+ *
+ * Returns: True if a second matching was found.
+ *
+ * Preconditions:
+ * - The matching is maximum in the subproblem.
+ *
+ * Postconditions:
+ * - The reported matching is updated if one was found.
+ */
+bool MatchingEnumerator::search()
+{
+    std::vector<MatchingChange> changes;
+
+    // A free right node takes the partner of a matched neighbor
+    for (int right = 0; right < rightNodes; ++right)
+    {
+        if (!rightActive[right] || rightMatch[right] != -1)
+        {
+            continue;
+        }
+        for (int slot = rightOffsets[right]; slot < rightOffsets[right + 1];
+             ++slot)
+        {
+            int edge = rightEdges[slot];
+            int left = sources[edge];
+            if (edgeActive[edge] && leftActive[left] &&
+                leftMatch[left] != -1)
+            {
+                changes.push_back({left, leftMatch[left], right});
+                openFrame(changes);
+                return true;
+            }
+        }
+    }
+
+    // A free left node takes the partner of a matched neighbor
+    for (int left = 0; left < leftNodes; ++left)
+    {
+        if (!leftActive[left] || leftMatch[left] != -1)
+        {
+            continue;
+        }
+        for (int edge = offsets[left]; edge < offsets[left + 1]; ++edge)
+        {
+            int right = targets[edge];
+            if (edgeActive[edge] && rightActive[right] &&
+                rightMatch[right] != -1)
+            {
+                changes.push_back({rightMatch[right], right, -1});
+                changes.push_back({left, -1, right});
+                openFrame(changes);
+                return true;
+            }
+        }
+    }
+
+    // Look for an alternating cycle through the matched left nodes
+    std::fill(visitState.begin(), visitState.end(), 0);
+    for (int start = 0; start < leftNodes; ++start)
+    {
+        if (!leftActive[start] || leftMatch[start] == -1 ||
+            visitState[start] != 0)
+        {
+            continue;
+        }
+        visitState[start] = 1;
+        scanEdge[start] = offsets[start];
+        searchPath.assign(1, start);
+        while (!searchPath.empty())
+        {
+            int left = searchPath.back();
+            if (scanEdge[left] == offsets[left + 1])
+            {
+                visitState[left] = 2;
+                searchPath.pop_back();
+                if (!searchPath.empty())
+                {
+                    ++scanEdge[searchPath.back()];
+                }
+                continue;
+            }
+
+            int edge = scanEdge[left];
+            int right = targets[edge];
+            if (!edgeActive[edge] || !rightActive[right] ||
+                right == leftMatch[left] || rightMatch[right] == -1 ||
+                visitState[rightMatch[right]] == 2)
+            {
+                ++scanEdge[left];
+                continue;
+            }
+
+            int nextLeft = rightMatch[right];
+            if (visitState[nextLeft] == 0)
+            {
+                visitState[nextLeft] = 1;
+                scanEdge[nextLeft] = offsets[nextLeft];
+                searchPath.push_back(nextLeft);
+                continue;
+            }
+
+            // The path closes a cycle; shift every partner along it
+            size_t first = searchPath.size() - 1;
+            while (searchPath[first] != nextLeft)
+            {
+                --first;
+            }
+            for (size_t i = first; i < searchPath.size(); ++i)
+            {
+                int node = searchPath[i];
+                changes.push_back({node, leftMatch[node],
+                                   targets[scanEdge[node]]});
+            }
+            openFrame(changes);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Opens a level of the binary partition.
+ *
+ * Method Name: openFrame
+ *
+ * Purpose: Stores the changes to the second matching and the matched
+ * edge of the first left node they change, and reports the second
+ * matching.
+ *
+ * Parameters:
+ * - changes: A reference to the changes, moved into the level.
+ *
+ * Preconditions:
+ * - The first change replaces a matched edge.
+ *
+ * Postconditions:
+ * - The level is on the frame stack.
+ */
+void MatchingEnumerator::openFrame(std::vector<MatchingChange> &changes)
+{
+    matching = leftMatch;
+    for (const MatchingChange &change : changes)
+    {
+        matching[change.left] = change.newRight;
+    }
+
+    Frame frame;
+    frame.edge = findEdge(changes[0].left, changes[0].oldRight);
+    frame.stage = 0;
+    frame.changes.swap(changes);
+    frames.push_back(std::move(frame));
+}
+
+/**
+ * Applies or reverts matching changes.
+ *
+ * Method Name: applyChanges
+ *
+ * Purpose: Frees every old partner first and then sets the new
+ * partners, or the other way around when reverting.
+ *
+ * Parameters:
+ * - changes: A constant reference to the changes.
+ * - forward: True to apply, false to revert.
+ *
+ * Preconditions:
+ * - The matching is the one the changes start from, or end at.
+ *
+ * Postconditions:
+ * - The matching is updated.
+ */
+void MatchingEnumerator::applyChanges(
+    const std::vector<MatchingChange> &changes,
+    bool forward)
+{
+    for (const MatchingChange &change : changes)
+    {
+        int from = forward ? change.oldRight : change.newRight;
+        if (from != -1)
+        {
+            rightMatch[from] = -1;
+        }
+    }
+    for (const MatchingChange &change : changes)
+    {
+        int to = forward ? change.newRight : change.oldRight;
+        leftMatch[change.left] = to;
+        if (to != -1)
+        {
+            rightMatch[to] = change.left;
+        }
+    }
+}
+
+/**
+ * Find the edge between two nodes.
+ *
+ * Method Name: findEdge
+ *
+ * Purpose: Binary searches the sorted neighbors of the left node.
+ *
+ * Parameters:
+ * - left: An integer representing the left node.
+ * - right: An integer representing the right node.
+ *
+ * Preconditions:
+ * - The edge exists.
+ *
+ * Postconditions:
+ * - The index of the edge is returned.
+ *
+ * Returns: The index of the edge.
+ */
+int MatchingEnumerator::findEdge(int left, int right) const
+{
+    return static_cast<int>(
+        std::lower_bound(targets.begin() + offsets[left],
+                         targets.begin() + offsets[left + 1],
+                         right) -
+        targets.begin());
+}
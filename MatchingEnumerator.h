@@ -0,0 +1,302 @@
+/*
+ * File: MatchingEnumerator.h Author: Nicolas Gioanni Purpose:
+ * Declaration of the MatchingEnumerator class for listing every
+ * maximum matching of a bipartite graph one at a time with Uno's
+ * binary partition method.
+ *
+ * Functionality/Features:
+ * - Declare methods for stepping to the next maximum matching, with
+ *   work polynomial in the graph size between two matchings.
+ * - Declare methods for reading the current matching.
+ *
+ * Assumptions:
+ * - The graph is given in the compressed sparse row form used by
+ *   HopcroftKarp; parallel edges are treated as one edge.
+ * - Every maximum matching is produced exactly once.
+ */
+
+#ifndef MATCHINGENUMERATOR_H
+#define MATCHINGENUMERATOR_H
+
+#include <vector>
+
+class MatchingEnumerator
+{
+public:
+    /**
+     * Constructor for the MatchingEnumerator class.
+     *
+     * Method Name: MatchingEnumerator
+     *
+     * Purpose: Stores the graph with sorted, duplicate-free neighbor
+     * lists and a list of incoming edges for every right node.
+     *
+     * Parameters:
+     * - leftNodes: An integer representing the number of left nodes.
+     * - rightNodes: An integer representing the number of right nodes.
+     * - offsets: A constant reference to the start of the neighbors of
+     *   every left node, with one extra entry at the end.
+     * - targets: A constant reference to the right neighbors.
+     *
+     * Preconditions:
+     * - The offsets are non-decreasing and end at the target count.
+     *
+     * Postconditions:
+     * - A new instance of the MatchingEnumerator class is created.
+     * - An exception is thrown if the adjacency is invalid.
+     */
+    MatchingEnumerator(int leftNodes,
+                       int rightNodes,
+                       const std::vector<int> &offsets,
+                       const std::vector<int> &targets);
+
+    /**
+     * Steps to the next maximum matching.
+     *
+     * Method Name: next
+     *
+     * Purpose: The first call solves the graph with Hopcroft-Karp and
+     * removes the edges that are in no maximum matching, using the
+     * strongly connected components of the alternating graph. Every
+     * later call resumes the binary partition: find a second maximum
+     * matching by an alternating cycle or an alternating path of
+     * length two, report it, and split into the matchings with and
+     * without one edge where the two differ.
+     *
+     * Returns: True if a new matching is available, false once all
+     * were produced.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The current matching is updated.
+     * - An exception is thrown if the enumeration fails.
+     */
+    bool next();
+
+    /**
+     * Get the current matching.
+     *
+     * Method Name: getMatching
+     *
+     * Purpose: Returns the matching produced by the last call to next.
+     *
+     * Preconditions:
+     * - next returned true.
+     *
+     * Postconditions:
+     * - The matching is returned.
+     *
+     * Returns: The right partner of every left node, -1 for free nodes.
+     */
+    const std::vector<int> &getMatching() const;
+
+    /**
+     * Get the size of the maximum matchings.
+     *
+     * Method Name: getMatchingSize
+     *
+     * Purpose: Returns the number of pairs in every matching produced.
+     *
+     * Preconditions:
+     * - next was called.
+     *
+     * Postconditions:
+     * - The size is returned.
+     *
+     * Returns: The size of a maximum matching.
+     */
+    int getMatchingSize() const;
+
+private:
+    // One left node whose partner changes between two matchings
+    struct MatchingChange
+    {
+        // The left node
+        int left;
+
+        // The right partner before the change, -1 if free
+        int oldRight;
+
+        // The right partner after the change, -1 if free
+        int newRight;
+    };
+
+    // One level of the binary partition
+    struct Frame
+    {
+        // The matched edge where the two matchings differ
+        int edge;
+
+        // 0 before the branch with the edge, 1 before the branch
+        // without it, 2 when both are done
+        int stage;
+
+        // The changes from the first matching to the second
+        std::vector<MatchingChange> changes;
+    };
+
+    // The number of left nodes
+    int leftNodes;
+
+    // The number of right nodes
+    int rightNodes;
+
+    // The start of the neighbors of every left node
+    std::vector<int> offsets;
+
+    // The right end of every edge, sorted per left node
+    std::vector<int> targets;
+
+    // The left end of every edge
+    std::vector<int> sources;
+
+    // The start of the incoming edges of every right node
+    std::vector<int> rightOffsets;
+
+    // The incoming edges of all right nodes
+    std::vector<int> rightEdges;
+
+    // True for edges that are still in the subproblem
+    std::vector<bool> edgeActive;
+
+    // True for left nodes that are still in the subproblem
+    std::vector<bool> leftActive;
+
+    // True for right nodes that are still in the subproblem
+    std::vector<bool> rightActive;
+
+    // The right partner of every left node in the subproblem
+    std::vector<int> leftMatch;
+
+    // The left partner of every right node in the subproblem
+    std::vector<int> rightMatch;
+
+    // The matching reported by the last call to next
+    std::vector<int> matching;
+
+    // The size of a maximum matching
+    int matchingSize;
+
+    // True once the first matching was produced
+    bool started;
+
+    // True if the current subproblem still has to be searched
+    bool searchPending;
+
+    // The open levels of the binary partition
+    std::vector<Frame> frames;
+
+    // The search state of every left node: 0 new, 1 open, 2 done
+    std::vector<char> visitState;
+
+    // The next edge to scan from every left node in a search
+    std::vector<int> scanEdge;
+
+    // The left nodes on the current search path
+    std::vector<int> searchPath;
+
+    /**
+     * Removes the edges that are in no maximum matching.
+     *
+     * Method Name: pruneEdges
+     *
+     * Purpose: Keeps the matched edges, the edges to free right nodes,
+     * and every unmatched edge that lies on an alternating cycle or on
+     * an even alternating path from a free node. Cycles are found with
+     * the strongly connected components of the graph on the left nodes
+     * that goes from l to the partner of every other neighbor of l.
+     *
+     * Preconditions:
+     * - The matching is maximum.
+     *
+     * Postconditions:
+     * - Every remaining edge is in some maximum matching.
+     */
+    void pruneEdges();
+
+    /**
+     * Searches the subproblem for a second maximum matching.
+     *
+     * Method Name: search
+     *
+     * Purpose: Looks for an alternating path of length two from a free
+     * node, then for an alternating cycle with a depth first search.
+     * If one is found a new level is opened and the second matching
+     * is reported.
+     *
+     * Returns: True if a second matching was found.
+     *
+     * Preconditions:
+     * - The matching is maximum in the subproblem.
+     *
+     * Postconditions:
+     * - The reported matching is updated if one was found.
+     */
+    bool search();
+
+    /**
+     * Opens a level of the binary partition.
+     *
+     * Method Name: openFrame
+     *
+     * Purpose: Stores the changes to the second matching and the
+     * matched edge of the first left node they change, and reports the
+     * second matching.
+     *
+     * Parameters:
+     * - changes: A reference to the changes, moved into the level.
+     *
+     * Preconditions:
+     * - The first change replaces a matched edge.
+     *
+     * Postconditions:
+     * - The level is on the frame stack.
+     */
+    void openFrame(std::vector<MatchingChange> &changes);
+
+    /**
+     * Applies or reverts matching changes.
+     *
+     * Method Name: applyChanges
+     *
+     * Purpose: Frees every old partner first and then sets the new
+     * partners, or the other way around when reverting.
+     *
+     * Parameters:
+     * - changes: A constant reference to the changes.
+     * - forward: True to apply, false to revert.
+     *
+     * Preconditions:
+     * - The matching is the one the changes start from, or end at.
+     *
+     * Postconditions:
+     * - The matching is updated.
+     */
+    void applyChanges(const std::vector<MatchingChange> &changes,
+                      bool forward);
+
+    /**
+     * Find the edge between two nodes.
+     *
+     * Method Name: findEdge
+     *
+     * Purpose: Binary searches the sorted neighbors of the left node.
+     *
+     * Parameters:
+     * - left: An integer representing the left node.
+     * - right: An integer representing the right node.
+     *
+     * Preconditions:
+     * - The edge exists.
+     *
+     * Postconditions:
+     * - The index of the edge is returned.
+     *
+     * Returns: The index of the edge.
+     */
+    int findEdge(int left, int right) const;
+};
+
+#endif
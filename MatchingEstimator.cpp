@@ -0,0 +1,395 @@
+/*
+ * File: MatchingEstimator.cpp Author: Nicolas Gioanni Purpose:
+ * Implementation of the MatchingEstimator class, providing methods for
+ * estimating matching sizes with a local matching oracle.
+ *
+ * Functionality/Features:
+ * - Order the edges by a hash of their index, so the greedy matching
+ *   that scans edges in that order is random and never built.
+ * - Decide locally whether an edge is in that matching by resolving
+ *   only its lower ranked neighbors, caching every answer.
+ * - Size the node sample with the Hoeffding bound for the requested
+ *   error and confidence.
+ *
+ * Assumptions:
+ * - Left nodes are numbered 0 to leftNodes - 1 and right nodes follow
+ *   them.
+ * - Edges are numbered by their position in the targets.
+ */
+
+#include "MatchingEstimator.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+/**
+ * Constructor for the MatchingEstimator class.
+ *
+ * Method Name: MatchingEstimator
+ *
+ * Purpose: Stores the adjacency of the left nodes and builds the list of
+ * incoming edges of every right node.
+ *
+ * Parameters:
+ * - leftNodes: An integer representing the number of left nodes.
+ * - rightNodes: An integer representing the number of right nodes.
+ * - offsets: A constant reference to the start of the neighbors of
+ *   every left node, with one extra entry at the end.
+ * - targets: A constant reference to the right neighbors.
+ * - seed: The seed of the random sampling and edge ranks.
+ *
+ * Preconditions:
+ * - The offsets are non-decreasing and end at the target count.
+ *
+ * Postconditions:
+ * - A new instance of the MatchingEstimator class is created.
+ * - An exception is thrown if the adjacency is invalid.
+ */
+MatchingEstimator::MatchingEstimator(int leftNodes,
+                                     int rightNodes,
+                                     const std::vector<int> &offsets,
+                                     const std::vector<int> &targets,
+                                     unsigned long long seed)
+    : leftNodes(leftNodes),
+      rightNodes(rightNodes),
+      offsets(offsets),
+      targets(targets),
+      random(seed),
+      rankSeed(seed)
+{
+    // Check if the adjacency describes the two sides
+    bool valid = leftNodes >= 0 && rightNodes >= 0 &&
+                 static_cast<int>(offsets.size()) == leftNodes + 1 &&
+                 offsets[0] == 0 &&
+                 offsets[leftNodes] == static_cast<int>(targets.size());
+    for (int node = 0; valid && node < leftNodes; ++node)
+    {
+        valid = offsets[node] <= offsets[node + 1];
+    }
+    for (size_t edge = 0; valid && edge < targets.size(); ++edge)
+    {
+        valid = targets[edge] >= 0 && targets[edge] < rightNodes;
+    }
+    if (!valid)
+    {
+        std::cerr << "ERROR: Bipartite adjacency is Invalid." << std::endl;
+        throw std::invalid_argument("Bipartite adjacency is Invalid.");
+    }
+
+    // Count the incoming edges of every right node and place them
+    rightOffsets.assign(rightNodes + 1, 0);
+    for (int right : targets)
+    {
+        ++rightOffsets[right + 1];
+    }
+    for (int right = 0; right < rightNodes; ++right)
+    {
+        rightOffsets[right + 1] += rightOffsets[right];
+    }
+    rightEdges.resize(targets.size());
+    std::vector<int> fill(rightOffsets.begin(), rightOffsets.end() - 1);
+    for (int edge = 0; edge < static_cast<int>(targets.size()); ++edge)
+    {
+        rightEdges[fill[targets[edge]]++] = edge;
+    }
+}
+
+/**
+ * Estimates the size of a maximal matching.
+ *
+ * Method Name: estimateMatchingSize
+ *
+ * Purpose: Draws fresh random edge ranks, samples nodes uniformly and
+ * asks the local oracle whether each one is matched by the greedy
+ * matching in rank order. Half the matched fraction times the node
+ * count estimates the size of that matching.
+ *
+ * Parameters:
+ * - epsilon: The additive error as a fraction of the node count,
+ *   between 0 and 1 exclusive.
+ * - delta: The probability of a larger error, between 0 and 1
+ *   exclusive.
+ *
+ * Returns: The estimated size of the greedy maximal matching; the
+ * maximum matching is between it and twice it, up to the error.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The oracle answers of this estimate are cached.
+ * - An exception is thrown if a parameter is invalid.
+ */
+double MatchingEstimator::estimateMatchingSize(double epsilon, double delta)
+{
+    try
+    {
+        // Check if the accuracy and confidence are valid
+        if (!(epsilon > 0.0 && epsilon < 1.0) ||
+            !(delta > 0.0 && delta < 1.0))
+        {
+            std::cerr << "ERROR: Epsilon or delta is out of valid range."
+                      << std::endl;
+            throw std::invalid_argument(
+                "Epsilon or delta is out of valid range.");
+        }
+
+        int nodes = leftNodes + rightNodes;
+        if (nodes == 0)
+        {
+            return 0.0;
+        }
+
+        // The matched fraction has to be within 2 epsilon, so Hoeffding
+        // asks for ln(2 / delta) / (8 epsilon^2) samples
+        rankSeed = random();
+        inMatching.clear();
+        long long samples = static_cast<long long>(
+            std::ceil(std::log(2.0 / delta) / (8.0 * epsilon * epsilon)));
+        std::uniform_int_distribution<int> pick(0, nodes - 1);
+        long long matched = 0;
+        for (long long sample = 0; sample < samples; ++sample)
+        {
+            matched += isMatched(pick(random)) ? 1 : 0;
+        }
+        return 0.5 * nodes * static_cast<double>(matched) / samples;
+    }
+    catch (const std::exception &e)
+    {
+        // Output an error message if the estimate fails
+        std::cerr
+            << "ERROR: Error in estimateMatchingSize: "
+            << e.what()
+            << std::endl;
+        throw std::runtime_error("Error in estimateMatchingSize: " +
+                                 std::string(e.what()));
+    }
+}
+
+/**
+ * Checks whether a node is matched.
+ *
+ * Method Name: isMatched
+ *
+ * Purpose: Answers for one node under the edge ranks of the last
+ * estimate, exploring only the edges near the node.
+ *
+ * Parameters:
+ * - node: The node, left nodes first and then right nodes.
+ *
+ * Returns: True if the greedy matching covers the node.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The oracle answers are cached.
+ * - An exception is thrown if the node is out of range.
+ */
+bool MatchingEstimator::isMatched(int node)
+{
+    // Check if the node is within valid range
+    if (node < 0 || node >= leftNodes + rightNodes)
+    {
+        std::cerr << "ERROR: Node is out of valid range." << std::endl;
+        throw std::out_of_range("Node is out of valid range.");
+    }
+
+    // The node is matched by its first matched edge in rank order
+    std::vector<int> edges;
+    incidentEdges(node, -1, ~0ULL, edges);
+    for (int edge : edges)
+    {
+        if (edgeInMatching(edge))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Checks whether an edge is in the greedy matching.
+ *
+ * Method Name: edgeInMatching
+ *
+ * Purpose: An edge is matched when no adjacent edge of lower rank is
+ * matched. The lower ranked edges are resolved with an explicit stack,
+ * in rank order, stopping at the first matched one.
+ *
+ * Parameters:
+ * - edge: The index of the edge.
+ *
+ * Returns: True if the edge is in the matching.
+ *
+ * Preconditions:
+ * - The edge is within the valid range.
+ *
+ * Postconditions:
+ * - The answers of every edge resolved are cached.
+ */
+bool MatchingEstimator::edgeInMatching(int edge)
+{
+    std::unordered_map<int, bool>::const_iterator cached =
+        inMatching.find(edge);
+    if (cached != inMatching.end())
+    {
+        return cached->second;
+    }
+
+    // Ranks fall strictly along the stack, so it cannot cycle
+    std::vector<Query> stack;
+    stack.push_back({edge, std::vector<int>(), 0});
+    incidentEdges(edgeLeft(edge), edge, rank(edge), stack.back().lower);
+    incidentEdges(leftNodes + targets[edge], edge, rank(edge),
+                  stack.back().lower);
+    std::sort(stack.back().lower.begin(), stack.back().lower.end(),
+              [this](int a, int b) { return rank(a) < rank(b); });
+
+    while (!stack.empty())
+    {
+        Query &query = stack.back();
+
+        // No lower ranked neighbor is matched
+        if (query.next == query.lower.size())
+        {
+            inMatching[query.edge] = true;
+            stack.pop_back();
+            continue;
+        }
+
+        int neighbor = query.lower[query.next];
+        cached = inMatching.find(neighbor);
+        if (cached != inMatching.end())
+        {
+            if (cached->second)
+            {
+                inMatching[query.edge] = false;
+                stack.pop_back();
+            }
+            else
+            {
+                ++query.next;
+            }
+            continue;
+        }
+
+        // Resolve the neighbor first
+        Query child = {neighbor, std::vector<int>(), 0};
+        unsigned long long bound = rank(neighbor);
+        incidentEdges(edgeLeft(neighbor), neighbor, bound, child.lower);
+        incidentEdges(leftNodes + targets[neighbor], neighbor, bound,
+                      child.lower);
+        std::sort(child.lower.begin(), child.lower.end(),
+                  [this](int a, int b) { return rank(a) < rank(b); });
+        stack.push_back(std::move(child));
+    }
+    return inMatching[edge];
+}
+
+/**
+ * Get the edges of a node in rank order.
+ *
+ * Method Name: incidentEdges
+ *
+ * Purpose: Collects the edges of a node whose rank is at most a bound,
+ * skipping one edge, and sorts them by rank.
+ *
+ * Parameters:
+ * - node: The node, left nodes first and then right nodes.
+ * - skip: An edge to leave out, -1 for none.
+ * - bound: Only edges of at most this rank are kept.
+ * - edges: A reference to the vector that receives the edges.
+ *
+ * Preconditions:
+ * - The node is within the valid range.
+ *
+ * Postconditions:
+ * - The edges are appended.
+ */
+void MatchingEstimator::incidentEdges(int node, int skip,
+                                      unsigned long long bound,
+                                      std::vector<int> &edges) const
+{
+    size_t first = edges.size();
+    if (node < leftNodes)
+    {
+        for (int edge = offsets[node]; edge < offsets[node + 1]; ++edge)
+        {
+            if (edge != skip && rank(edge) <= bound)
+            {
+                edges.push_back(edge);
+            }
+        }
+    }
+    else
+    {
+        int right = node - leftNodes;
+        for (int i = rightOffsets[right]; i < rightOffsets[right + 1]; ++i)
+        {
+            if (rightEdges[i] != skip && rank(rightEdges[i]) <= bound)
+            {
+                edges.push_back(rightEdges[i]);
+            }
+        }
+    }
+    std::sort(edges.begin() + first, edges.end(),
+              [this](int a, int b) { return rank(a) < rank(b); });
+}
+
+/**
+ * Get the rank of an edge.
+ *
+ * Method Name: rank
+ *
+ * Purpose: Hashes the edge with the rank seed, so ranks are a random
+ * order that is never stored.
+ *
+ * Parameters:
+ * - edge: The index of the edge.
+ *
+ * Returns: The rank of the edge, distinct for distinct edges.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The rank is returned.
+ */
+unsigned long long MatchingEstimator::rank(int edge) const
+{
+    // The SplitMix64 finalizer is a bijection, so no two edges tie
+    unsigned long long value =
+        rankSeed + static_cast<unsigned long long>(edge);
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+
+/**
+ * Get the left end of an edge.
+ *
+ * Method Name: edgeLeft
+ *
+ * Purpose: Binary searches the offsets for the edge.
+ *
+ * Parameters:
+ * - edge: The index of the edge.
+ *
+ * Preconditions:
+ * - The edge is within the valid range.
+ *
+ * Postconditions:
+ * - The left node is returned.
+ *
+ * Returns: The left end of the edge.
+ */
+int MatchingEstimator::edgeLeft(int edge) const
+{
+    return static_cast<int>(
+               std::upper_bound(offsets.begin(), offsets.end(), edge) -
+               offsets.begin()) -
+           1;
+}
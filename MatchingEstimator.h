@@ -0,0 +1,240 @@
+/*
+ * File: MatchingEstimator.h Author: Nicolas Gioanni Purpose:
+ * Declaration of the MatchingEstimator class for estimating the size
+ * of a bipartite matching from a sample of nodes, without solving the
+ * whole graph.
+ *
+ * Functionality/Features:
+ * - Declare methods for estimating the size of the random greedy
+ *   maximal matching within epsilon times the node count, with a
+ *   chosen confidence.
+ * - Declare methods for asking whether a single node is matched.
+ *
+ * Assumptions:
+ * - The graph is given in the compressed sparse row form used by
+ *   HopcroftKarp.
+ * - The greedy matching is maximal, so the maximum matching is at
+ *   least its size and at most twice its size.
+ * - The work depends on the sample size and the local degrees, not on
+ *   the size of the graph, apart from one linear pass in the
+ *   constructor to index the edges of the right nodes.
+ */
+
+#ifndef MATCHINGESTIMATOR_H
+#define MATCHINGESTIMATOR_H
+
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+class MatchingEstimator
+{
+public:
+    /**
+     * Constructor for the MatchingEstimator class.
+     *
+     * Method Name: MatchingEstimator
+     *
+     * Purpose: Stores the adjacency of the left nodes and builds the
+     * list of incoming edges of every right node.
+     *
+     * Parameters:
+     * - leftNodes: An integer representing the number of left nodes.
+     * - rightNodes: An integer representing the number of right nodes.
+     * - offsets: A constant reference to the start of the neighbors of
+     *   every left node, with one extra entry at the end.
+     * - targets: A constant reference to the right neighbors.
+     * - seed: The seed of the random sampling and edge ranks.
+     *
+     * Preconditions:
+     * - The offsets are non-decreasing and end at the target count.
+     *
+     * Postconditions:
+     * - A new instance of the MatchingEstimator class is created.
+     * - An exception is thrown if the adjacency is invalid.
+     */
+    MatchingEstimator(int leftNodes,
+                      int rightNodes,
+                      const std::vector<int> &offsets,
+                      const std::vector<int> &targets,
+                      unsigned long long seed = 1);
+
+    /**
+     * Estimates the size of a maximal matching.
+     *
+     * Method Name: estimateMatchingSize
+     *
+     * Purpose: Draws fresh random edge ranks, samples nodes uniformly
+     * and asks the local oracle whether each one is matched by the
+     * greedy matching in rank order. Half the matched fraction times
+     * the node count estimates the size of that matching.
+     *
+     * Parameters:
+     * - epsilon: The additive error as a fraction of the node count,
+     *   between 0 and 1 exclusive.
+     * - delta: The probability of a larger error, between 0 and 1
+     *   exclusive.
+     *
+     * Returns: The estimated size of the greedy maximal matching; the
+     * maximum matching is between it and twice it, up to the error.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The oracle answers of this estimate are cached.
+     * - An exception is thrown if a parameter is invalid.
+     */
+    double estimateMatchingSize(double epsilon, double delta = 0.05);
+
+    /**
+     * Checks whether a node is matched.
+     *
+     * Method Name: isMatched
+     *
+     * Purpose: Answers for one node under the edge ranks of the last
+     * estimate, exploring only the edges near the node.
+     *
+     * Parameters:
+     * - node: The node, left nodes first and then right nodes.
+     *
+     * Returns: True if the greedy matching covers the node.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The oracle answers are cached.
+     * - An exception is thrown if the node is out of range.
+     */
+    bool isMatched(int node);
+
+private:
+    // One edge whose oracle answer waits for lower ranked edges
+    struct Query
+    {
+        // The edge
+        int edge;
+
+        // The adjacent edges of lower rank, in rank order
+        std::vector<int> lower;
+
+        // The next adjacent edge to check
+        size_t next;
+    };
+
+    // The number of left nodes
+    int leftNodes;
+
+    // The number of right nodes
+    int rightNodes;
+
+    // The start of the neighbors of every left node
+    std::vector<int> offsets;
+
+    // The right end of every edge
+    std::vector<int> targets;
+
+    // The start of the incoming edges of every right node
+    std::vector<int> rightOffsets;
+
+    // The incoming edges of all right nodes
+    std::vector<int> rightEdges;
+
+    // The random source for samples and rank seeds
+    std::mt19937_64 random;
+
+    // The seed of the current edge ranks
+    unsigned long long rankSeed;
+
+    // The cached answer of every edge asked so far
+    std::unordered_map<int, bool> inMatching;
+
+    /**
+     * Checks whether an edge is in the greedy matching.
+     *
+     * Method Name: edgeInMatching
+     *
+     * Purpose: An edge is matched when no adjacent edge of lower rank
+     * is matched. The lower ranked edges are resolved with an explicit
+     * stack, in rank order, stopping at the first matched one.
+     *
+     * Parameters:
+     * - edge: The index of the edge.
+     *
+     * Returns: True if the edge is in the matching.
+     *
+     * Preconditions:
+     * - The edge is within the valid range.
+     *
+     * Postconditions:
+     * - The answers of every edge resolved are cached.
+     */
+    bool edgeInMatching(int edge);
+
+    /**
+     * Get the edges of a node in rank order.
+     *
+     * Method Name: incidentEdges
+     *
+     * Purpose: Collects the edges of a node whose rank is at most a
+     * bound, skipping one edge, and sorts them by rank.
+     *
+     * Parameters:
+     * - node: The node, left nodes first and then right nodes.
+     * - skip: An edge to leave out, -1 for none.
+     * - bound: Only edges of at most this rank are kept.
+     * - edges: A reference to the vector that receives the edges.
+     *
+     * Preconditions:
+     * - The node is within the valid range.
+     *
+     * Postconditions:
+     * - The edges are appended.
+     */
+    void incidentEdges(int node, int skip, unsigned long long bound,
+                       std::vector<int> &edges) const;
+
+    /**
+     * Get the rank of an edge.
+     *
+     * Method Name: rank
+     *
+     * Purpose: Hashes the edge with the rank seed, so ranks are a
+     * random order that is never stored.
+     *
+     * Parameters:
+     * - edge: The index of the edge.
+     *
+     * Returns: The rank of the edge, distinct for distinct edges.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The rank is returned.
+     */
+    unsigned long long rank(int edge) const;
+
+    /**
+     * Get the left end of an edge.
+     *
+     * Method Name: edgeLeft
+     *
+     * Purpose: Binary searches the offsets for the edge.
+     *
+     * Parameters:
+     * - edge: The index of the edge.
+     *
+     * Preconditions:
+     * - The edge is within the valid range.
+     *
+     * Postconditions:
+     * - The left node is returned.
+     *
+     * Returns: The left end of the edge.
+     */
+    int edgeLeft(int edge) const;
+};
+
+#endif
@@ -0,0 +1,62 @@
+/*
+ * File: MaxFlowEngine.h Author: Nicolas Gioanni Purpose: Declaration of
+ * the MaxFlowEngine interface shared by every engine that solves a
+ * Graph in place.
+ *
+ * Functionality/Features:
+ * - Declare the method that calculates the maximum flow between two
+ *   nodes of the graph the engine was made for.
+ *
+ * Assumptions:
+ * - An engine is made for one Graph and leaves the residual capacities
+ *   in its adjacency matrix, so Graph::printResults reads the same
+ *   result whichever engine ran.
+ * - Engines are created by name through EngineRegistry.
+ */
+
+#ifndef MAXFLOWENGINE_H
+#define MAXFLOWENGINE_H
+
+class MaxFlowEngine
+{
+public:
+    /**
+     * Destructor for the MaxFlowEngine class.
+     *
+     * Method Name: ~MaxFlowEngine
+     *
+     * Purpose: Lets an engine be deleted through the interface.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The engine is destroyed.
+     */
+    virtual ~MaxFlowEngine() = default;
+
+    /**
+     * Calculates the maximum flow in the graph.
+     *
+     * Method Name: calculateMaxFlow
+     *
+     * Purpose: Calculates the maximum flow from the source to the sink
+     * node and writes the residual capacities into the graph.
+     *
+     * Parameters:
+     * - source: An integer representing the source node.
+     * - sink: An integer representing the sink node.
+     *
+     * Preconditions:
+     * - The source and sink nodes are within the valid range of the
+     *   graph.
+     *
+     * Postconditions:
+     * - The adjacency matrix of the graph holds the residual
+     *   capacities of a maximum flow.
+     * - An exception is thrown if the calculation fails.
+     */
+    virtual void calculateMaxFlow(int source, int sink) = 0;
+};
+
+#endif
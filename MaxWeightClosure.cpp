@@ -0,0 +1,174 @@
+/*
+ * File: MaxWeightClosure.cpp Author: Nicolas Gioanni Purpose:
+ * Implementation of the MaxWeightClosure class, providing methods for
+ * solving maximum-weight closure problems with a minimum cut.
+ *
+ * Functionality/Features:
+ * - Build the minimum cut network of a closure problem once, with one
+ *   terminal arc per weighted node and one arc per distinct
+ *   precedence.
+ * - Find the maximum-weight closure as the source side of a minimum
+ *   cut.
+ *
+ * Assumptions:
+ * - The weight of the best closure is the sum of the positive weights
+ *   minus the capacity of the minimum cut.
+ * - A capacity of the positive weight plus one can never be cut, so it
+ *   stands in for the unbounded precedence capacity.
+ */
+
+#include "MaxWeightClosure.h"
+#include <algorithm>
+#include <climits>
+#include <iostream>
+#include <stdexcept>
+
+/**
+ * Constructor for the MaxWeightClosure class.
+ *
+ * Method Name: MaxWeightClosure
+ *
+ * Purpose: Builds the minimum cut network: an arc from the source to
+ * every node of positive weight, an arc from every node of negative
+ * weight to the sink, and an arc of unbounded capacity for every
+ * distinct precedence.
+ *
+ * Parameters:
+ * - weights: A constant reference to the weight of every node.
+ * - precedences: A constant reference to the precedence arcs, each a
+ *   pair (u, v) where choosing u requires choosing v.
+ *
+ * Preconditions:
+ * - Every node in a precedence is within the range of the weights.
+ *
+ * Postconditions:
+ * - The network is built; the source is node "weights.size()" and the
+ *   sink is node "weights.size() + 1".
+ * - Repeated precedences and self loops are dropped.
+ * - An exception is thrown if a precedence is invalid or the weights
+ *   are too large.
+ */
+MaxWeightClosure::MaxWeightClosure(
+    const std::vector<long long> &weights,
+    const std::vector<std::pair<int, int>> &precedences)
+    : nodes(static_cast<int>(weights.size())), positiveWeight(0),
+      closure(weights.size(), false)
+{
+    int source = nodes;
+    int sink = nodes + 1;
+
+    // Add up the positive weights, keeping room for the bound
+    for (long long weight : weights)
+    {
+        if (weight > 0 && positiveWeight > LLONG_MAX / 2 - weight)
+        {
+            std::cerr << "ERROR: Closure weights are too large." << std::endl;
+            throw std::overflow_error("Closure weights are too large.");
+        }
+        positiveWeight += weight > 0 ? weight : 0;
+    }
+    long long unbounded = positiveWeight + 1;
+
+    // Keep one copy of every precedence
+    std::vector<std::pair<int, int>> distinct;
+    distinct.reserve(precedences.size());
+    for (const std::pair<int, int> &precedence : precedences)
+    {
+        if (precedence.first < 0 || precedence.first >= nodes ||
+            precedence.second < 0 || precedence.second >= nodes)
+        {
+            std::cerr << "ERROR: Precedence is out of valid range." << std::endl;
+            throw std::out_of_range("Precedence is out of valid range.");
+        }
+        if (precedence.first != precedence.second)
+        {
+            distinct.push_back(precedence);
+        }
+    }
+    std::sort(distinct.begin(), distinct.end());
+    distinct.erase(std::unique(distinct.begin(), distinct.end()),
+                   distinct.end());
+
+    std::vector<FlowArc> arcs;
+    arcs.reserve(weights.size() + distinct.size());
+    for (int node = 0; node < nodes; ++node)
+    {
+        if (weights[node] > 0)
+        {
+            arcs.push_back({source, node, weights[node], 0});
+        }
+        else if (weights[node] < 0)
+        {
+            arcs.push_back({node, sink, -weights[node], 0});
+        }
+    }
+    for (const std::pair<int, int> &precedence : distinct)
+    {
+        arcs.push_back({precedence.first, precedence.second, unbounded, 0});
+    }
+
+    network = std::make_unique<FlowNetwork>(nodes + 2, arcs);
+    solver = std::make_unique<PseudoFlow>(*network);
+}
+
+/**
+ * Finds the closure of maximum weight.
+ *
+ * Method Name: solve
+ *
+ * Purpose: Calculates the minimum cut with the pseudoflow engine and
+ * takes the closure from its source side. Only the cut is needed, so
+ * no flow is recovered.
+ *
+ * Returns: The weight of the maximum-weight closure.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The closure is stored.
+ * - An exception is thrown if solving fails.
+ */
+long long MaxWeightClosure::solve()
+{
+    try
+    {
+        long long cut = solver->calculateMinCut(nodes, nodes + 1);
+        std::vector<bool> sourceSide = solver->getSourceSide();
+        for (int node = 0; node < nodes; ++node)
+        {
+            closure[node] = sourceSide[node];
+        }
+        return positiveWeight - cut;
+    }
+    catch (const std::exception &e)
+    {
+        // Output an error message if the closure cannot be found
+        std::cerr
+            << "ERROR: Error in solve: "
+            << e.what()
+            << std::endl;
+        throw std::runtime_error("Error in solve: " +
+                                 std::string(e.what()));
+    }
+}
+
+/**
+ * Get the maximum-weight closure.
+ *
+ * Method Name: getClosure
+ *
+ * Purpose: Returns the nodes of the closure found by solve.
+ *
+ * Preconditions:
+ * - solve was called.
+ *
+ * Postconditions:
+ * - The closure is returned.
+ *
+ * Returns: A vector with true for every chosen node.
+ */
+const std::vector<bool> &MaxWeightClosure::getClosure() const
+{
+    return closure;
+}
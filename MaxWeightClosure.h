@@ -0,0 +1,113 @@
+/*
+ * File: MaxWeightClosure.h Author: Nicolas Gioanni Purpose: Declaration
+ * of the MaxWeightClosure class for solving maximum-weight closure
+ * (project selection) problems with a minimum cut.
+ *
+ * Functionality/Features:
+ * - Declare methods for describing a closure problem by node weights
+ *   and precedence arcs.
+ * - Declare methods for finding the closure of maximum weight and its
+ *   weight.
+ *
+ * Assumptions:
+ * - A precedence arc (u, v) means that u can only be chosen together
+ *   with v.
+ * - The sum of the positive weights fits in a long long with room to
+ *   spare, since it also bounds the precedence capacities.
+ */
+
+#ifndef MAXWEIGHTCLOSURE_H
+#define MAXWEIGHTCLOSURE_H
+
+#include "FlowNetwork.h"
+#include "PseudoFlow.h"
+#include <memory>
+#include <utility>
+#include <vector>
+
+class MaxWeightClosure
+{
+public:
+    /**
+     * Constructor for the MaxWeightClosure class.
+     *
+     * Method Name: MaxWeightClosure
+     *
+     * Purpose: Builds the minimum cut network: an arc from the source
+     * to every node of positive weight, an arc from every node of
+     * negative weight to the sink, and an arc of unbounded capacity
+     * for every distinct precedence.
+     *
+     * Parameters:
+     * - weights: A constant reference to the weight of every node.
+     * - precedences: A constant reference to the precedence arcs, each
+     *   a pair (u, v) where choosing u requires choosing v.
+     *
+     * Preconditions:
+     * - Every node in a precedence is within the range of the weights.
+     *
+     * Postconditions:
+     * - The network is built; the source is node "weights.size()" and
+     *   the sink is node "weights.size() + 1".
+     * - Repeated precedences and self loops are dropped.
+     * - An exception is thrown if a precedence is invalid or the
+     *   weights are too large.
+     */
+    MaxWeightClosure(const std::vector<long long> &weights,
+                     const std::vector<std::pair<int, int>> &precedences);
+
+    /**
+     * Finds the closure of maximum weight.
+     *
+     * Method Name: solve
+     *
+     * Purpose: Calculates the minimum cut with the pseudoflow engine
+     * and takes the closure from its source side. Only the cut is
+     * needed, so no flow is recovered.
+     *
+     * Returns: The weight of the maximum-weight closure.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The closure is stored.
+     * - An exception is thrown if solving fails.
+     */
+    long long solve();
+
+    /**
+     * Get the maximum-weight closure.
+     *
+     * Method Name: getClosure
+     *
+     * Purpose: Returns the nodes of the closure found by solve.
+     *
+     * Preconditions:
+     * - solve was called.
+     *
+     * Postconditions:
+     * - The closure is returned.
+     *
+     * Returns: A vector with true for every chosen node.
+     */
+    const std::vector<bool> &getClosure() const;
+
+private:
+    // The number of nodes of the closure problem
+    int nodes;
+
+    // The sum of the positive weights
+    long long positiveWeight;
+
+    // The network with the terminal arcs added
+    std::unique_ptr<FlowNetwork> network;
+
+    // The minimum cut solver
+    std::unique_ptr<PseudoFlow> solver;
+
+    // True for every node of the last closure found
+    std::vector<bool> closure;
+};
+
+#endif
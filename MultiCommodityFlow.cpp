@@ -0,0 +1,417 @@
+/*
+ * File: MultiCommodityFlow.cpp Author: Nicolas Gioanni Purpose:
+ * Implementation of the MultiCommodityFlow class, providing methods for
+ * approximating the maximum concurrent multicommodity flow.
+ *
+ * Functionality/Features:
+ * - Bound the optimum with one single-commodity maximum flow per
+ *   commodity, computed on parallel threads.
+ * - Route the demands in phases along Dijkstra shortest paths in the
+ *   CSR network, multiplying the length of every used arc by
+ *   1 + epsilon times its relative load.
+ * - Scale the final flow by its largest arc congestion, so it is
+ *   always feasible.
+ *
+ * Assumptions:
+ * - The arcs with positive capacity are the edges of the problem; arcs
+ *   with capacity 0 are never used.
+ * - Routing is sequential because every path changes the lengths seen
+ *   by the next one.
+ */
+
+#include "MultiCommodityFlow.h"
+#include "PushRelabel.h"
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+/**
+ * Constructor for the MultiCommodityFlow class.
+ *
+ * Method Name: MultiCommodityFlow
+ *
+ * Purpose: Builds the shared network and stores the commodities.
+ *
+ * Parameters:
+ * - nodes: An integer representing the number of nodes.
+ * - arcs: A constant reference to the arcs of the network.
+ * - commodities: A constant reference to the commodities.
+ * - threads: The number of single-commodity bounds to compute at the
+ *   same time, 0 to use every hardware thread.
+ *
+ * Preconditions:
+ * - Every node index is within the range of the nodes.
+ *
+ * Postconditions:
+ * - A new instance of the MultiCommodityFlow class is created.
+ * - An exception is thrown if an arc or commodity is invalid.
+ */
+MultiCommodityFlow::MultiCommodityFlow(
+    int nodes,
+    const std::vector<FlowArc> &arcs,
+    const std::vector<Commodity> &commodities,
+    int threads)
+    : nodes(nodes), arcs(arcs), network(nodes, arcs),
+      commodities(commodities), threads(threads)
+{
+    // Check if every commodity is valid
+    for (const Commodity &commodity : commodities)
+    {
+        if (commodity.source < 0 || commodity.source >= nodes ||
+            commodity.sink < 0 || commodity.sink >= nodes ||
+            commodity.source == commodity.sink || commodity.demand <= 0)
+        {
+            std::cerr << "ERROR: Commodity is Invalid." << std::endl;
+            throw std::invalid_argument("Commodity is Invalid.");
+        }
+    }
+
+    if (this->threads <= 0)
+    {
+        this->threads = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    if (this->threads <= 0)
+    {
+        this->threads = 1;
+    }
+}
+
+/**
+ * Calculates an approximate maximum concurrent flow.
+ *
+ * Method Name: calculateConcurrentFlow
+ *
+ * Purpose: Scales the demands with single-commodity maximum flows so
+ * the optimum lies between 1 and the number of commodities, then routes
+ * every commodity in phases along shortest paths under arc lengths that
+ * grow exponentially with their load. The flow is finally scaled down
+ * to fit the capacities.
+ *
+ * Parameters:
+ * - epsilon: The accuracy, between 0 and 1 exclusive.
+ *
+ * Returns: The fraction of every demand that is routed at the same
+ * time, at least 1 - epsilon times the optimum.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The flow of every commodity is stored.
+ * - An exception is thrown if epsilon is invalid or solving fails.
+ */
+double MultiCommodityFlow::calculateConcurrentFlow(double epsilon)
+{
+    try
+    {
+        // Check if the accuracy is valid
+        if (!(epsilon > 0.0 && epsilon < 1.0))
+        {
+            std::cerr << "ERROR: Epsilon is out of valid range." << std::endl;
+            throw std::invalid_argument("Epsilon is out of valid range.");
+        }
+
+        int count = static_cast<int>(commodities.size());
+        int arcCount = network.getArcs();
+        flows.assign(count, std::vector<double>(arcCount, 0.0));
+        if (count == 0)
+        {
+            return 0.0;
+        }
+
+        // The best single-commodity fraction bounds the optimum from
+        // above, and sharing it evenly bounds it from below
+        std::vector<long long> alone = singleCommodityFlows();
+        double bound = std::numeric_limits<double>::infinity();
+        for (int k = 0; k < count; ++k)
+        {
+            bound = std::min(bound, static_cast<double>(alone[k]) /
+                                        commodities[k].demand);
+        }
+        if (bound == 0.0)
+        {
+            return 0.0;
+        }
+        std::vector<double> demand(count);
+        for (int k = 0; k < count; ++k)
+        {
+            demand[k] = commodities[k].demand * bound / count;
+        }
+
+        // Every arc with capacity starts with length delta / capacity
+        int edges = 0;
+        for (int arc = 0; arc < arcCount; ++arc)
+        {
+            edges += network.getCapacity(arc) > 0 ? 1 : 0;
+        }
+        double delta = (1.0 + epsilon) /
+                       std::pow((1.0 + epsilon) * edges, 1.0 / epsilon);
+        std::vector<double> length(arcCount, 0.0);
+        double volume = 0.0;
+        for (int arc = 0; arc < arcCount; ++arc)
+        {
+            if (network.getCapacity(arc) > 0)
+            {
+                length[arc] = delta / network.getCapacity(arc);
+                volume += delta;
+            }
+        }
+
+        // Route every demand once per phase until the volume reaches 1
+        std::vector<double> routed(count, 0.0);
+        std::vector<double> distance(nodes);
+        std::vector<int> parentArc(nodes);
+        std::vector<int> path;
+        while (volume < 1.0)
+        {
+            for (int k = 0; k < count && volume < 1.0; ++k)
+            {
+                double remaining = demand[k];
+                while (remaining > 0.0 && volume < 1.0)
+                {
+                    int sink = commodities[k].sink;
+                    if (!shortestPath(commodities[k].source, sink, length,
+                                      distance, parentArc))
+                    {
+                        std::cerr << "ERROR: Commodity cannot be routed."
+                                  << std::endl;
+                        throw std::logic_error("Commodity cannot be routed.");
+                    }
+
+                    // Send up to the smallest capacity on the path
+                    path.clear();
+                    double amount = remaining;
+                    for (int node = sink; node != commodities[k].source;)
+                    {
+                        int arc = parentArc[node];
+                        path.push_back(arc);
+                        amount = std::min(
+                            amount,
+                            static_cast<double>(network.getCapacity(arc)));
+                        node = network.getHead(network.getReverse(arc));
+                    }
+                    for (int arc : path)
+                    {
+                        double capacity = network.getCapacity(arc);
+                        flows[k][arc] += amount;
+                        double growth = epsilon * amount / capacity;
+                        volume += length[arc] * capacity * growth;
+                        length[arc] *= 1.0 + growth;
+                    }
+                    routed[k] += amount;
+                    remaining -= amount;
+                }
+            }
+        }
+
+        // Scale the flow down to fit the most congested arc
+        double congestion = 0.0;
+        for (int arc = 0; arc < arcCount; ++arc)
+        {
+            if (network.getCapacity(arc) <= 0)
+            {
+                continue;
+            }
+            double load = 0.0;
+            for (int k = 0; k < count; ++k)
+            {
+                load += flows[k][arc];
+            }
+            congestion = std::max(congestion,
+                                  load / network.getCapacity(arc));
+        }
+        double fraction = std::numeric_limits<double>::infinity();
+        for (int k = 0; k < count; ++k)
+        {
+            for (double &flow : flows[k])
+            {
+                flow /= congestion;
+            }
+            fraction = std::min(fraction, routed[k] / congestion /
+                                              commodities[k].demand);
+        }
+        return fraction;
+    }
+    catch (const std::exception &e)
+    {
+        // Output an error message if the calculation fails
+        std::cerr
+            << "ERROR: Error in calculateConcurrentFlow: "
+            << e.what()
+            << std::endl;
+        throw std::runtime_error("Error in calculateConcurrentFlow: " +
+                                 std::string(e.what()));
+    }
+}
+
+/**
+ * Get the flow of a commodity on an arc.
+ *
+ * Method Name: getFlow
+ *
+ * Purpose: Returns the flow of the commodity from the tail to the head
+ * of an input arc, minus its flow in the other direction.
+ *
+ * Parameters:
+ * - commodity: The index of the commodity.
+ * - inputArc: The index of the arc in the constructor list.
+ *
+ * Preconditions:
+ * - calculateConcurrentFlow was called.
+ *
+ * Postconditions:
+ * - The flow is returned.
+ * - An exception is thrown if an index is out of range.
+ *
+ * Returns: The net flow of the commodity on the arc.
+ */
+double MultiCommodityFlow::getFlow(int commodity, int inputArc) const
+{
+    // Check if the indices are within valid range
+    if (commodity < 0 || commodity >= static_cast<int>(flows.size()) ||
+        inputArc < 0 || inputArc >= static_cast<int>(arcs.size()))
+    {
+        std::cerr << "ERROR: Flow index is out of valid range." << std::endl;
+        throw std::out_of_range("Flow index is out of valid range.");
+    }
+
+    int arc = network.getInputArc(inputArc);
+    return flows[commodity][arc] - flows[commodity][network.getReverse(arc)];
+}
+
+/**
+ * Calculates the single-commodity maximum flows.
+ *
+ * Method Name: singleCommodityFlows
+ *
+ * Purpose: Solves every commodity alone on its own copy of the network
+ * with push-relabel, several commodities at the same time.
+ *
+ * Returns: The maximum flow of every commodity alone.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - An exception is thrown if a solve fails.
+ */
+std::vector<long long> MultiCommodityFlow::singleCommodityFlows() const
+{
+    int count = static_cast<int>(commodities.size());
+    int workers = std::min(threads, count);
+    std::vector<long long> values(count, 0);
+    std::vector<std::exception_ptr> errors(workers);
+
+    // Every thread takes every workers-th commodity on its own network
+    std::vector<std::thread> pool;
+    for (int worker = 0; worker < workers; ++worker)
+    {
+        pool.emplace_back([this, worker, workers, count, &values, &errors]()
+        {
+            try
+            {
+                FlowNetwork copy(nodes, arcs);
+                PushRelabel<> solver(copy);
+                for (int k = worker; k < count; k += workers)
+                {
+                    values[k] = solver.calculateMaxFlow(commodities[k].source,
+                                                        commodities[k].sink);
+                }
+            }
+            catch (...)
+            {
+                errors[worker] = std::current_exception();
+            }
+        });
+    }
+    for (std::thread &thread : pool)
+    {
+        thread.join();
+    }
+    for (const std::exception_ptr &error : errors)
+    {
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+    return values;
+}
+
+/**
+ * Finds a shortest path under the arc lengths.
+ *
+ * Method Name: shortestPath
+ *
+ * Purpose: Runs Dijkstra's algorithm with a binary heap over the arcs
+ * with positive capacity, stopping when the sink is settled.
+ *
+ * Parameters:
+ * - source: An integer representing the source node.
+ * - sink: An integer representing the sink node.
+ * - length: A constant reference to the length of every arc.
+ * - distance: A reference to a distance vector sized to the nodes.
+ * - parentArc: A reference to a vector that receives the arc into every
+ *   reached node.
+ *
+ * Returns: True if the sink is reachable.
+ *
+ * Preconditions:
+ * - Lengths are positive.
+ *
+ * Postconditions:
+ * - The path can be read back from the sink with parentArc.
+ */
+bool MultiCommodityFlow::shortestPath(int source,
+                                      int sink,
+                                      const std::vector<double> &length,
+                                      std::vector<double> &distance,
+                                      std::vector<int> &parentArc) const
+{
+    typedef std::pair<double, int> Entry;
+    std::fill(distance.begin(), distance.end(),
+              std::numeric_limits<double>::infinity());
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+    distance[source] = 0.0;
+    heap.push(Entry(0.0, source));
+
+    while (!heap.empty())
+    {
+        Entry top = heap.top();
+        heap.pop();
+        int node = top.second;
+        if (top.first > distance[node])
+        {
+            continue;
+        }
+        if (node == sink)
+        {
+            return true;
+        }
+
+        for (int arc = network.arcBegin(node); arc < network.arcEnd(node);
+             ++arc)
+        {
+            if (network.getCapacity(arc) <= 0)
+            {
+                continue;
+            }
+            int head = network.getHead(arc);
+            double candidate = top.first + length[arc];
+            if (candidate < distance[head])
+            {
+                distance[head] = candidate;
+                parentArc[head] = arc;
+                heap.push(Entry(candidate, head));
+            }
+        }
+    }
+    return false;
+}
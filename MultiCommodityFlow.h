@@ -0,0 +1,186 @@
+/*
+ * File: MultiCommodityFlow.h Author: Nicolas Gioanni Purpose:
+ * Declaration of the MultiCommodityFlow class for approximating the
+ * maximum concurrent flow of several commodities with the
+ * Garg-Konemann multiplicative weights method.
+ *
+ * Functionality/Features:
+ * - Declare methods for describing commodities by source, sink and
+ *   demand on a shared capacitated network.
+ * - Declare methods for finding a feasible flow that routes the same
+ *   fraction of every demand, within a factor 1 - epsilon of the best
+ *   fraction.
+ * - Declare methods for reading the flow of every commodity.
+ *
+ * Assumptions:
+ * - Every arc and every paired reverse arc with positive capacity can
+ *   carry flow of all commodities up to its capacity in total.
+ * - Demands are positive.
+ */
+
+#ifndef MULTICOMMODITYFLOW_H
+#define MULTICOMMODITYFLOW_H
+
+#include "FlowNetwork.h"
+#include <vector>
+
+// A commodity that has to be sent from its source to its sink
+struct Commodity
+{
+    // The node the commodity starts at
+    int source;
+
+    // The node the commodity has to reach
+    int sink;
+
+    // The amount of the commodity to send
+    long long demand;
+};
+
+class MultiCommodityFlow
+{
+public:
+    /**
+     * Constructor for the MultiCommodityFlow class.
+     *
+     * Method Name: MultiCommodityFlow
+     *
+     * Purpose: Builds the shared network and stores the commodities.
+     *
+     * Parameters:
+     * - nodes: An integer representing the number of nodes.
+     * - arcs: A constant reference to the arcs of the network.
+     * - commodities: A constant reference to the commodities.
+     * - threads: The number of single-commodity bounds to compute at
+     *   the same time, 0 to use every hardware thread.
+     *
+     * Preconditions:
+     * - Every node index is within the range of the nodes.
+     *
+     * Postconditions:
+     * - A new instance of the MultiCommodityFlow class is created.
+     * - An exception is thrown if an arc or commodity is invalid.
+     */
+    MultiCommodityFlow(int nodes,
+                       const std::vector<FlowArc> &arcs,
+                       const std::vector<Commodity> &commodities,
+                       int threads = 0);
+
+    /**
+     * Calculates an approximate maximum concurrent flow.
+     *
+     * Method Name: calculateConcurrentFlow
+     *
+     * Purpose: Scales the demands with single-commodity maximum flows
+     * so the optimum lies between 1 and the number of commodities, then
+     * routes every commodity in phases along shortest paths under arc
+     * lengths that grow exponentially with their load. The flow is
+     * finally scaled down to fit the capacities.
+     *
+     * Parameters:
+     * - epsilon: The accuracy, between 0 and 1 exclusive.
+     *
+     * Returns: The fraction of every demand that is routed at the same
+     * time, at least 1 - epsilon times the optimum.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The flow of every commodity is stored.
+     * - An exception is thrown if epsilon is invalid or solving fails.
+     */
+    double calculateConcurrentFlow(double epsilon);
+
+    /**
+     * Get the flow of a commodity on an arc.
+     *
+     * Method Name: getFlow
+     *
+     * Purpose: Returns the flow of the commodity from the tail to the
+     * head of an input arc, minus its flow in the other direction.
+     *
+     * Parameters:
+     * - commodity: The index of the commodity.
+     * - inputArc: The index of the arc in the constructor list.
+     *
+     * Preconditions:
+     * - calculateConcurrentFlow was called.
+     *
+     * Postconditions:
+     * - The flow is returned.
+     * - An exception is thrown if an index is out of range.
+     *
+     * Returns: The net flow of the commodity on the arc.
+     */
+    double getFlow(int commodity, int inputArc) const;
+
+private:
+    // The number of nodes
+    int nodes;
+
+    // The arcs as given, for the single-commodity bounds
+    std::vector<FlowArc> arcs;
+
+    // The shared network
+    FlowNetwork network;
+
+    // The commodities
+    std::vector<Commodity> commodities;
+
+    // The number of threads for the single-commodity bounds
+    int threads;
+
+    // The flow of every commodity on every network arc
+    std::vector<std::vector<double>> flows;
+
+    /**
+     * Calculates the single-commodity maximum flows.
+     *
+     * Method Name: singleCommodityFlows
+     *
+     * Purpose: Solves every commodity alone on its own copy of the
+     * network with push-relabel, several commodities at the same time.
+     *
+     * Returns: The maximum flow of every commodity alone.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - An exception is thrown if a solve fails.
+     */
+    std::vector<long long> singleCommodityFlows() const;
+
+    /**
+     * Finds a shortest path under the arc lengths.
+     *
+     * Method Name: shortestPath
+     *
+     * Purpose: Runs Dijkstra's algorithm with a binary heap over the
+     * arcs with positive capacity, stopping when the sink is settled.
+     *
+     * Parameters:
+     * - source: An integer representing the source node.
+     * - sink: An integer representing the sink node.
+     * - length: A constant reference to the length of every arc.
+     * - distance: A reference to a distance vector sized to the nodes.
+     * - parentArc: A reference to a vector that receives the arc into
+     *   every reached node.
+     *
+     * Returns: True if the sink is reachable.
+     *
+     * Preconditions:
+     * - Lengths are positive.
+     *
+     * Postconditions:
+     * - The path can be read back from the sink with parentArc.
+     */
+    bool shortestPath(int source,
+                      int sink,
+                      const std::vector<double> &length,
+                      std::vector<double> &distance,
+                      std::vector<int> &parentArc) const;
+};
+
+#endif
@@ -0,0 +1,261 @@
+/*
+ * File: ParametricMaxFlow.cpp Author: Nicolas Gioanni Purpose:
+ * Implementation of the ParametricMaxFlow class, providing methods for
+ * solving a monotone family of networks with one push-relabel run.
+ *
+ * Functionality/Features:
+ * - Build the network with parametric source and sink arcs.
+ * - Move from one parameter value to the next by re-solving from the
+ *   previous flow and distance labels.
+ * - Record the nested minimum cuts and their breakpoints.
+ *
+ * Assumptions:
+ * - Raising a source capacity only adds residual capacity out of the
+ *   source, and lowering a sink capacity only turns flow into excess,
+ *   so the labels of the previous value stay valid and the labels
+ *   only rise over the whole sequence.
+ */
+
+#include "ParametricMaxFlow.h"
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+/**
+ * Constructor for the ParametricMaxFlow class.
+ *
+ * Method Name: ParametricMaxFlow
+ *
+ * Purpose: Builds the network with a new source and sink node added
+ * after the given nodes.
+ *
+ * Parameters:
+ * - nodes: An integer representing the number of non-terminal nodes.
+ * - arcs: A constant reference to the fixed arcs between the
+ *   non-terminal nodes.
+ * - sourceArcs: A constant reference to the arcs from the source, each
+ *   with a non-negative slope.
+ * - sinkArcs: A constant reference to the arcs to the sink, each with
+ *   a non-positive slope.
+ *
+ * Preconditions:
+ * - Every node index is within the range of the nodes.
+ *
+ * Postconditions:
+ * - The network is built; the source is node "nodes" and the sink is
+ *   node "nodes + 1".
+ * - An exception is thrown if an arc is invalid.
+ */
+ParametricMaxFlow::ParametricMaxFlow(
+    int nodes,
+    const std::vector<FlowArc> &arcs,
+    const std::vector<ParametricArc> &sourceArcs,
+    const std::vector<ParametricArc> &sinkArcs)
+    : nodes(nodes), cutLevels(nodes, -1)
+{
+    int source = nodes;
+    int sink = nodes + 1;
+
+    // Check the direction of every slope
+    for (const ParametricArc &arc : sourceArcs)
+    {
+        if (arc.node < 0 || arc.node >= nodes || arc.slope < 0)
+        {
+            std::cerr
+                << "ERROR: Source arcs need a non-negative slope."
+                << std::endl;
+            throw std::
+                invalid_argument("Source arcs need a non-negative slope.");
+        }
+    }
+    for (const ParametricArc &arc : sinkArcs)
+    {
+        if (arc.node < 0 || arc.node >= nodes || arc.slope > 0)
+        {
+            std::cerr
+                << "ERROR: Sink arcs need a non-positive slope."
+                << std::endl;
+            throw std::
+                invalid_argument("Sink arcs need a non-positive slope.");
+        }
+    }
+
+    // Add the terminal arcs after the fixed arcs
+    std::vector<FlowArc> allArcs(arcs);
+    for (const ParametricArc &arc : sourceArcs)
+    {
+        allArcs.push_back({source, arc.node, 0, 0});
+        parametricArcs.push_back(arc);
+    }
+    for (const ParametricArc &arc : sinkArcs)
+    {
+        allArcs.push_back({arc.node, sink, 0, 0});
+        parametricArcs.push_back(arc);
+    }
+
+    network = std::make_unique<FlowNetwork>(nodes + 2, allArcs);
+    solver = std::make_unique<PushRelabel<>>(*network);
+    for (size_t i = arcs.size(); i < allArcs.size(); ++i)
+    {
+        parametricArcIndices.push_back(
+            network->getInputArc(static_cast<int>(i)));
+    }
+}
+
+/**
+ * Solves the network for every parameter value.
+ *
+ * Method Name: solve
+ *
+ * Purpose: Solves the first value from scratch and every later value
+ * by raising the source capacities and lowering the sink capacities of
+ * the solved network, keeping its distance labels.
+ *
+ * Parameters:
+ * - lambdas: A constant reference to the parameter values in strictly
+ *   increasing order.
+ *
+ * Returns: One result per parameter value.
+ *
+ * Preconditions:
+ * - The parameter values are strictly increasing.
+ *
+ * Postconditions:
+ * - The cut level of every node is recorded.
+ * - An exception is thrown if solving fails.
+ */
+std::vector<ParametricResult> ParametricMaxFlow::solve(
+    const std::vector<long long> &lambdas)
+{
+    try
+    {
+        // Check if the parameter values are increasing
+        for (size_t i = 1; i < lambdas.size(); ++i)
+        {
+            if (lambdas[i] <= lambdas[i - 1])
+            {
+                std::cerr
+                    << "ERROR: Parameter values must be increasing."
+                    << std::endl;
+                throw std::
+                    invalid_argument("Parameter values must be increasing.");
+            }
+        }
+
+        std::vector<ParametricResult> results;
+        std::fill(cutLevels.begin(), cutLevels.end(), -1);
+        int previousSize = -1;
+
+        for (size_t i = 0; i < lambdas.size(); ++i)
+        {
+            std::vector<long long> capacities = capacitiesAt(lambdas[i]);
+            long long flowValue;
+
+            if (i == 0)
+            {
+                // Solve the first value from scratch
+                for (size_t j = 0; j < capacities.size(); ++j)
+                {
+                    network->setCapacity(parametricArcIndices[j],
+                                         capacities[j]);
+                }
+                flowValue = solver->calculateMaxFlow(nodes, nodes + 1);
+            }
+            else
+            {
+                // Continue from the flow and labels of the last value
+                flowValue = solver->applyArcCapacityChanges(
+                    parametricArcIndices, capacities);
+            }
+
+            // The source sides only grow, so record when nodes join
+            std::vector<bool> sourceSide = solver->getSourceSide();
+            int size = 0;
+            for (int node = 0; node < nodes; ++node)
+            {
+                if (sourceSide[node])
+                {
+                    size++;
+                    if (cutLevels[node] == -1)
+                    {
+                        cutLevels[node] = static_cast<int>(i);
+                    }
+                }
+            }
+
+            results.push_back({lambdas[i],
+                               flowValue,
+                               size,
+                               i > 0 && size != previousSize});
+            previousSize = size;
+        }
+
+        return results;
+    }
+    catch (const std::exception &e)
+    {
+        // Output an error message if the parametric solve fails
+        std::cerr
+            << "ERROR: Error in solve: "
+            << e.what()
+            << std::endl;
+        throw std::runtime_error("Error in solve: " +
+                                 std::string(e.what()));
+    }
+}
+
+/**
+ * Get the parameter index at which every node joins the source side.
+ *
+ * Method Name: getCutLevels
+ *
+ * Purpose: Returns, for every non-terminal node, the index of the
+ * first parameter value whose minimum cut has the node on the source
+ * side. Because the cuts are nested this describes every cut of the
+ * last solve.
+ *
+ * Preconditions:
+ * - solve was called.
+ *
+ * Postconditions:
+ * - The cut levels are returned.
+ *
+ * Returns: The cut level of every node, -1 for nodes that never join
+ * the source side.
+ */
+const std::vector<int> &ParametricMaxFlow::getCutLevels() const
+{
+    return cutLevels;
+}
+
+/**
+ * Calculates the capacities of the parametric arcs.
+ *
+ * Method Name: capacitiesAt
+ *
+ * Purpose: Evaluates every parametric arc at a parameter value,
+ * clamping negative capacities to 0.
+ *
+ * Parameters:
+ * - lambda: The parameter value.
+ *
+ * Returns: The capacity of every parametric arc.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The capacities are returned in parametric arc order.
+ */
+std::vector<long long> ParametricMaxFlow::capacitiesAt(long long lambda)
+    const
+{
+    std::vector<long long> capacities;
+    capacities.reserve(parametricArcs.size());
+    for (const ParametricArc &arc : parametricArcs)
+    {
+        long long capacity = arc.base + arc.slope * lambda;
+        capacities.push_back(capacity > 0 ? capacity : 0);
+    }
+    return capacities;
+}
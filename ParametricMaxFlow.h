@@ -0,0 +1,181 @@
+/*
+ * File: ParametricMaxFlow.h Author: Nicolas Gioanni Purpose:
+ * Declaration of the ParametricMaxFlow class for solving a network
+ * for an increasing sequence of parameter values, where source arc
+ * capacities rise and sink arc capacities fall with the parameter
+ * (the Gallo-Grigoriadis-Tarjan setting).
+ *
+ * Functionality/Features:
+ * - Declare methods for describing the parametric source and sink
+ *   arcs of a network.
+ * - Declare methods for solving every parameter value, reusing the
+ *   flow and distance labels of the previous value.
+ * - Declare methods for reading the nested minimum cuts and the
+ *   parameter values where they change.
+ *
+ * Assumptions:
+ * - Parameter values and capacities are integers.
+ * - Source arc slopes are non-negative and sink arc slopes are
+ *   non-positive, so the minimum cuts are nested.
+ */
+
+#ifndef PARAMETRICMAXFLOW_H
+#define PARAMETRICMAXFLOW_H
+
+#include "FlowNetwork.h"
+#include "PushRelabel.h"
+#include <memory>
+#include <vector>
+
+// A terminal arc whose capacity is base + slope * lambda
+struct ParametricArc
+{
+    // The non-terminal end of the arc
+    int node;
+
+    // The capacity at lambda 0
+    long long base;
+
+    // The change of the capacity per unit of lambda
+    long long slope;
+};
+
+// The solution of the network for one parameter value
+struct ParametricResult
+{
+    // The parameter value
+    long long lambda;
+
+    // The value of the maximum flow
+    long long flowValue;
+
+    // The number of nodes on the source side of the minimum cut
+    int sourceSideSize;
+
+    // True if the minimum cut differs from the previous value's
+    bool breakpoint;
+};
+
+class ParametricMaxFlow
+{
+public:
+    /**
+     * Constructor for the ParametricMaxFlow class.
+     *
+     * Method Name: ParametricMaxFlow
+     *
+     * Purpose: Builds the network with a new source and sink node
+     * added after the given nodes.
+     *
+     * Parameters:
+     * - nodes: An integer representing the number of non-terminal
+     *   nodes.
+     * - arcs: A constant reference to the fixed arcs between the
+     *   non-terminal nodes.
+     * - sourceArcs: A constant reference to the arcs from the source,
+     *   each with a non-negative slope.
+     * - sinkArcs: A constant reference to the arcs to the sink, each
+     *   with a non-positive slope.
+     *
+     * Preconditions:
+     * - Every node index is within the range of the nodes.
+     *
+     * Postconditions:
+     * - The network is built; the source is node "nodes" and the
+     *   sink is node "nodes + 1".
+     * - An exception is thrown if an arc is invalid.
+     */
+    ParametricMaxFlow(int nodes,
+                      const std::vector<FlowArc> &arcs,
+                      const std::vector<ParametricArc> &sourceArcs,
+                      const std::vector<ParametricArc> &sinkArcs);
+
+    /**
+     * Solves the network for every parameter value.
+     *
+     * Method Name: solve
+     *
+     * Purpose: Solves the first value from scratch and every later
+     * value by raising the source capacities and lowering the sink
+     * capacities of the solved network, keeping its distance labels.
+     *
+     * Parameters:
+     * - lambdas: A constant reference to the parameter values in
+     *   strictly increasing order.
+     *
+     * Returns: One result per parameter value.
+     *
+     * Preconditions:
+     * - The parameter values are strictly increasing.
+     *
+     * Postconditions:
+     * - The cut level of every node is recorded.
+     * - An exception is thrown if solving fails.
+     */
+    std::vector<ParametricResult> solve(
+        const std::vector<long long> &lambdas);
+
+    /**
+     * Get the parameter index at which every node joins the source
+     * side.
+     *
+     * Method Name: getCutLevels
+     *
+     * Purpose: Returns, for every non-terminal node, the index of the
+     * first parameter value whose minimum cut has the node on the
+     * source side. Because the cuts are nested this describes every
+     * cut of the last solve.
+     *
+     * Preconditions:
+     * - solve was called.
+     *
+     * Postconditions:
+     * - The cut levels are returned.
+     *
+     * Returns: The cut level of every node, -1 for nodes that never
+     * join the source side.
+     */
+    const std::vector<int> &getCutLevels() const;
+
+private:
+    // The number of non-terminal nodes
+    int nodes;
+
+    // The network with the terminal arcs added
+    std::unique_ptr<FlowNetwork> network;
+
+    // The solver that keeps its labels between parameter values
+    std::unique_ptr<PushRelabel<>> solver;
+
+    // The parametric arcs, sources first and then sinks
+    std::vector<ParametricArc> parametricArcs;
+
+    // The network arc of every parametric arc
+    std::vector<int> parametricArcIndices;
+
+    // The first parameter index with each node on the source side
+    std::vector<int> cutLevels;
+
+    /**
+     * Calculates the capacities of the parametric arcs.
+     *
+     * Method Name: capacitiesAt
+     *
+     * Purpose: Evaluates every parametric arc at a parameter value,
+     * clamping negative capacities to 0.
+     *
+     * Parameters:
+     * - lambda: The parameter value.
+     *
+     * Returns: The capacity of every parametric arc.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The capacities are returned in parametric arc order.
+     */
+    std::vector<long long> capacitiesAt(long long lambda) const;
+};
+
+#endif
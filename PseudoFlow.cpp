@@ -0,0 +1,1152 @@
+/*
+ * File: PseudoFlow.cpp Author: Nicolas Gioanni Purpose: Implementation
+ * of the PseudoFlow class, providing methods for calculating minimum
+ * cuts and maximum flow with Hochbaum's highest-label pseudoflow
+ * algorithm.
+ *
+ * Functionality/Features:
+ * - Start from the pseudoflow that saturates every source and sink
+ *   arc, with every node a tree of its own.
+ * - Process the strong root with the highest label: merge its tree
+ *   into a tree one label lower through a residual arc, or relabel
+ *   the nodes of its tree that share its label.
+ * - Lift whole trees to the node count when their label has a gap
+ *   below it.
+ * - Recover a flow by returning excesses and deficits along the flow
+ *   and cancelling flow cycles.
+ * - Continue from the current trees and labels after source arcs grow
+ *   or sink arcs shrink.
+ *
+ * Assumptions:
+ * - Labels range from 0 to the node count. The source and sink are
+ *   never part of a tree and are not counted in the label counts.
+ * - Tree arcs point from a child to its parent, and the excess of a
+ *   tree is held by its root only.
+ */
+
+#include "PseudoFlow.h"
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+/**
+ * Constructor for the PseudoFlow class.
+ *
+ * Method Name: PseudoFlow
+ *
+ * Purpose: Initializes a new instance of the PseudoFlow class.
+ *
+ * Parameters:
+ * - network: A reference to the network to solve. The solver keeps
+ *   the pseudoflow, and later the flow, in the network.
+ *
+ * Preconditions:
+ * - The network is built.
+ *
+ * Postconditions:
+ * - A new instance of the PseudoFlow class is created.
+ */
+PseudoFlow::PseudoFlow(FlowNetwork &network)
+    : network(network),
+      source(-1),
+      sink(-1),
+      cutFound(false),
+      flowRecovered(false),
+      highestStrongLabel(0)
+{
+}
+
+/**
+ * Calculates the maximum flow in the flow network.
+ *
+ * Method Name: calculateMaxFlow
+ *
+ * Purpose: Calculates the minimum cut and then recovers a maximum flow
+ * from the pseudoflow.
+ *
+ * Parameters:
+ * - source: An integer representing the source node.
+ * - sink: An integer representing the sink node.
+ *
+ * Returns: The value of the maximum flow.
+ *
+ * Preconditions:
+ * - The source and sink nodes are within the valid range.
+ *
+ * Postconditions:
+ * - The network carries a maximum flow.
+ * - An exception is thrown if the calculation process fails.
+ */
+long long PseudoFlow::calculateMaxFlow(int source, int sink)
+{
+    try
+    {
+        calculateMinCut(source, sink);
+        return recoverFlow();
+    }
+    catch (const std::exception &e)
+    {
+        // Output an error message if max flow calculation fails
+        std::cerr
+            << "ERROR: Error in calculateMaxFlow: "
+            << e.what()
+            << std::endl;
+        throw std::runtime_error("Error in calculateMaxFlow: " +
+                                 std::string(e.what()));
+    }
+}
+
+/**
+ * Calculates the minimum cut of the flow network.
+ *
+ * Method Name: calculateMinCut
+ *
+ * Purpose: Saturates every source and sink arc and runs the first
+ * phase of the algorithm, which processes the strong root with the
+ * highest label until every strong node is labeled with the node
+ * count.
+ *
+ * Parameters:
+ * - source: An integer representing the source node.
+ * - sink: An integer representing the sink node.
+ *
+ * Returns: The capacity of the minimum cut.
+ *
+ * Preconditions:
+ * - The source and sink nodes are within the valid range.
+ *
+ * Postconditions:
+ * - The network carries a pseudoflow whose strong nodes are the
+ *   source side of a minimum cut.
+ * - An exception is thrown if the calculation process fails.
+ */
+long long PseudoFlow::calculateMinCut(int source, int sink)
+{
+    try
+    {
+        // Check if source and sink nodes are within valid range
+        int nodes = network.getNodes();
+        if (source < 0 ||
+            source >= nodes ||
+            sink < 0 ||
+            sink >= nodes ||
+            source == sink)
+        {
+            std::cerr
+                << "ERROR: Source or sink is out of valid range."
+                << std::endl;
+            throw std::
+                invalid_argument("Source or sink is out of valid range.");
+        }
+
+        this->source = source;
+        this->sink = sink;
+        cutFound = false;
+        flowRecovered = false;
+
+        // Every node starts as a tree of its own
+        network.resetFlow();
+        label.assign(nodes, 0);
+        excess.assign(nodes, 0);
+        parent.assign(nodes, -1);
+        parentArc.assign(nodes, -1);
+        firstChild.assign(nodes, -1);
+        nextSibling.assign(nodes, -1);
+        previousSibling.assign(nodes, -1);
+        nextScan.assign(nodes, -1);
+        currentArc.resize(nodes);
+        for (int node = 0; node < nodes; ++node)
+        {
+            currentArc[node] = network.arcBegin(node);
+        }
+        bucketFirst.assign(nodes + 1, -1);
+        bucketLast.assign(nodes + 1, -1);
+        nextInBucket.assign(nodes, -1);
+        labelCount.assign(nodes + 1, 0);
+
+        // Saturate the source arcs and then the sink arcs
+        for (int arc = network.arcBegin(source);
+             arc < network.arcEnd(source);
+             ++arc)
+        {
+            long long amount = network.getResidual(arc);
+            int head = network.getHead(arc);
+            if (amount > 0 && head != source)
+            {
+                network.push(arc, amount);
+                if (head != sink)
+                {
+                    excess[head] += amount;
+                }
+            }
+        }
+        for (int arc = network.arcBegin(sink);
+             arc < network.arcEnd(sink);
+             ++arc)
+        {
+            int toSink = network.getReverse(arc);
+            long long amount = network.getResidual(toSink);
+            int tail = network.getHead(arc);
+            if (amount > 0 && tail != source && tail != sink)
+            {
+                network.push(toSink, amount);
+                excess[tail] -= amount;
+            }
+        }
+
+        // Nodes with excess are strong roots at label 1
+        highestStrongLabel = 1;
+        for (int node = 0; node < nodes; ++node)
+        {
+            if (node == source || node == sink)
+            {
+                continue;
+            }
+            if (excess[node] > 0)
+            {
+                label[node] = 1;
+                ++labelCount[1];
+                addToStrongBucket(node);
+            }
+            else
+            {
+                ++labelCount[0];
+            }
+        }
+        label[source] = nodes;
+        label[sink] = 0;
+
+        runPhaseOne();
+        cutFound = true;
+        return cutCapacity();
+    }
+    catch (const std::exception &e)
+    {
+        // Output an error message if min cut calculation fails
+        std::cerr
+            << "ERROR: Error in calculateMinCut: "
+            << e.what()
+            << std::endl;
+        throw std::runtime_error("Error in calculateMinCut: " +
+                                 std::string(e.what()));
+    }
+}
+
+/**
+ * Raises source arcs and lowers sink arcs, then solves again.
+ *
+ * Method Name: applyTerminalCapacities
+ *
+ * Purpose: Changes the capacities of arcs leaving the source or
+ * entering the sink and continues the first phase from the current
+ * trees and labels. The new capacity of a source arc is pushed into
+ * its head, and flow above the new capacity of a sink arc is returned
+ * to its tail; the nodes that gain excess become roots.
+ *
+ * Parameters:
+ * - arcs: A constant reference to the indices of the changed arcs.
+ * - capacities: A constant reference to the new capacities, one per
+ *   changed arc.
+ *
+ * Returns: The capacity of the new minimum cut.
+ *
+ * Preconditions:
+ * - calculateMinCut was called and recoverFlow was not.
+ * - Source arcs only grow and sink arcs only shrink.
+ *
+ * Postconditions:
+ * - The strong nodes are the source side of the new minimum cut,
+ *   which contains the previous one.
+ * - An exception is thrown if a change is invalid.
+ */
+long long PseudoFlow::applyTerminalCapacities(
+    const std::vector<int> &arcs,
+    const std::vector<long long> &capacities)
+{
+    try
+    {
+        // Check if the trees of the last solve are still there
+        if (!cutFound || flowRecovered)
+        {
+            std::cerr << "ERROR: No pseudoflow to continue from." << std::endl;
+            throw std::logic_error("No pseudoflow to continue from.");
+        }
+        if (arcs.size() != capacities.size())
+        {
+            std::cerr
+                << "ERROR: Arc and capacity lists differ in size."
+                << std::endl;
+            throw std::
+                invalid_argument("Arc and capacity lists differ in size.");
+        }
+
+        // Move the changes into the excesses of the end nodes
+        std::vector<int> touched;
+        for (size_t i = 0; i < arcs.size(); ++i)
+        {
+            int arc = arcs[i];
+            if (arc < 0 || arc >= network.getArcs())
+            {
+                std::cerr << "ERROR: Arc is out of valid range." << std::endl;
+                throw std::out_of_range("Arc is out of valid range.");
+            }
+            int tail = network.getHead(network.getReverse(arc));
+            int head = network.getHead(arc);
+            long long capacity = network.getCapacity(arc);
+            if (tail == source && capacities[i] >= capacity)
+            {
+                network.setCapacity(arc, capacities[i]);
+                long long amount = network.getResidual(arc);
+                network.push(arc, amount);
+                if (head != sink && amount > 0)
+                {
+                    excess[head] += amount;
+                    touched.push_back(head);
+                }
+            }
+            else if (head == sink && tail != source &&
+                     capacities[i] >= 0 && capacities[i] <= capacity)
+            {
+                network.setCapacity(arc, capacities[i]);
+                long long amount = -network.getResidual(arc);
+                if (amount > 0)
+                {
+                    network.push(network.getReverse(arc), amount);
+                    excess[tail] += amount;
+                    touched.push_back(tail);
+                }
+            }
+            else
+            {
+                std::cerr
+                    << "ERROR: Terminal capacity change is Invalid."
+                    << std::endl;
+                throw std::
+                    invalid_argument("Terminal capacity change is Invalid.");
+            }
+        }
+
+        // Nodes that gained excess carry it as roots
+        std::sort(touched.begin(), touched.end());
+        touched.erase(std::unique(touched.begin(), touched.end()),
+                      touched.end());
+        int nodes = network.getNodes();
+        for (int node : touched)
+        {
+            makeRoot(node);
+            if (excess[node] > 0 && label[node] < nodes)
+            {
+                addToStrongBucket(node);
+                highestStrongLabel = std::max(highestStrongLabel,
+                                              label[node]);
+            }
+        }
+
+        runPhaseOne();
+        return cutCapacity();
+    }
+    catch (const std::exception &e)
+    {
+        // Output an error message if the re-solve fails
+        std::cerr
+            << "ERROR: Error in applyTerminalCapacities: "
+            << e.what()
+            << std::endl;
+        throw std::runtime_error("Error in applyTerminalCapacities: " +
+                                 std::string(e.what()));
+    }
+}
+
+/**
+ * Turns the pseudoflow into a maximum flow.
+ *
+ * Method Name: recoverFlow
+ *
+ * Purpose: Returns the excess of every strong node to the source and
+ * the deficit of every weak node to the sink along the flow,
+ * cancelling flow cycles met on the way.
+ *
+ * Returns: The value of the maximum flow.
+ *
+ * Preconditions:
+ * - calculateMinCut was called.
+ *
+ * Postconditions:
+ * - The network carries a maximum flow.
+ * - No further parametric changes are allowed.
+ * - An exception is thrown if the flow cannot be recovered.
+ */
+long long PseudoFlow::recoverFlow()
+{
+    try
+    {
+        // Check if there is a pseudoflow to recover from
+        if (!cutFound)
+        {
+            std::cerr << "ERROR: No pseudoflow to recover from." << std::endl;
+            throw std::logic_error("No pseudoflow to recover from.");
+        }
+
+        int nodes = network.getNodes();
+        if (!flowRecovered)
+        {
+            pathPosition.assign(nodes, -1);
+
+            // Send the deficits forward first, then the excesses back
+            for (int pass = 0; pass < 2; ++pass)
+            {
+                bool forward = pass == 0;
+                for (int node = 0; node < nodes; ++node)
+                {
+                    currentArc[node] = network.arcBegin(node);
+                }
+                for (int node = 0; node < nodes; ++node)
+                {
+                    if (node != source && node != sink &&
+                        (forward ? excess[node] < 0 : excess[node] > 0))
+                    {
+                        returnExcess(node, forward);
+                    }
+                }
+            }
+            flowRecovered = true;
+        }
+
+        long long flowValue = 0;
+        for (int arc = network.arcBegin(source);
+             arc < network.arcEnd(source);
+             ++arc)
+        {
+            flowValue += network.getFlow(arc);
+        }
+        return flowValue;
+    }
+    catch (const std::exception &e)
+    {
+        // Output an error message if flow recovery fails
+        std::cerr
+            << "ERROR: Error in recoverFlow: "
+            << e.what()
+            << std::endl;
+        throw std::runtime_error("Error in recoverFlow: " +
+                                 std::string(e.what()));
+    }
+}
+
+/**
+ * Get the source side of the minimum cut.
+ *
+ * Method Name: getSourceSide
+ *
+ * Purpose: Returns the source and every node labeled with the node
+ * count.
+ *
+ * Preconditions:
+ * - calculateMinCut was called.
+ *
+ * Postconditions:
+ * - The source side is returned.
+ *
+ * Returns: A vector with true for every node on the source side.
+ */
+std::vector<bool> PseudoFlow::getSourceSide() const
+{
+    int nodes = network.getNodes();
+    std::vector<bool> sourceSide(nodes, false);
+    if (!cutFound)
+    {
+        return sourceSide;
+    }
+    for (int node = 0; node < nodes; ++node)
+    {
+        sourceSide[node] = node == source || label[node] >= nodes;
+    }
+    return sourceSide;
+}
+
+/**
+ * Processes strong roots until none is left below the node count.
+ *
+ * Method Name: runPhaseOne
+ *
+ * Purpose: Repeatedly takes the strong root with the highest label and
+ * processes it.
+ *
+ * Preconditions:
+ * - The strong roots are in their buckets.
+ *
+ * Postconditions:
+ * - Every strong node is labeled with the node count.
+ */
+void PseudoFlow::runPhaseOne()
+{
+    int strongRoot;
+    while ((strongRoot = getHighestStrongRoot()) != -1)
+    {
+        processRoot(strongRoot);
+    }
+}
+
+/**
+ * Takes the strong root with the highest label.
+ *
+ * Method Name: getHighestStrongRoot
+ *
+ * Purpose: Removes the first root of the highest non-empty bucket.
+ * Roots whose label has no node one below are lifted to the node count
+ * with their trees, and roots at label 0 are moved up to 1.
+ *
+ * Returns: The strong root, -1 if there is none.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The root is no longer in a bucket.
+ */
+int PseudoFlow::getHighestStrongRoot()
+{
+    for (int level = highestStrongLabel; level > 0; --level)
+    {
+        while (bucketFirst[level] != -1)
+        {
+            highestStrongLabel = level;
+            int root = bucketFirst[level];
+            bucketFirst[level] = nextInBucket[root];
+            if (bucketFirst[level] == -1)
+            {
+                bucketLast[level] = -1;
+            }
+            nextInBucket[root] = -1;
+
+            // A gap below the label puts the tree on the source side
+            if (labelCount[level - 1] > 0)
+            {
+                return root;
+            }
+            liftAll(root);
+        }
+    }
+
+    if (bucketFirst[0] == -1)
+    {
+        return -1;
+    }
+
+    // Roots at label 0 are moved up so they can merge into label 0
+    while (bucketFirst[0] != -1)
+    {
+        int root = bucketFirst[0];
+        bucketFirst[0] = nextInBucket[root];
+        nextInBucket[root] = -1;
+        label[root] = 1;
+        --labelCount[0];
+        ++labelCount[1];
+        addToStrongBucket(root);
+    }
+    bucketLast[0] = -1;
+
+    highestStrongLabel = 1;
+    int root = bucketFirst[1];
+    bucketFirst[1] = nextInBucket[root];
+    if (bucketFirst[1] == -1)
+    {
+        bucketLast[1] = -1;
+    }
+    nextInBucket[root] = -1;
+    return root;
+}
+
+/**
+ * Processes one strong root.
+ *
+ * Method Name: processRoot
+ *
+ * Purpose: Scans the nodes of the strong tree that share the label of
+ * the root for a residual arc into a node one label lower. If one is
+ * found the tree is merged through it and the excess is pushed towards
+ * the new root; otherwise the scanned nodes are relabeled from the
+ * bottom up and the root goes back into a bucket.
+ *
+ * Parameters:
+ * - strongRoot: An integer representing the root.
+ *
+ * Preconditions:
+ * - The root is strong and not in a bucket.
+ *
+ * Postconditions:
+ * - The tree was merged or relabeled.
+ */
+void PseudoFlow::processRoot(int strongRoot)
+{
+    int strongNode = strongRoot;
+    nextScan[strongRoot] = firstChild[strongRoot];
+    int arc = findWeakNode(strongRoot);
+    if (arc != -1)
+    {
+        merge(network.getHead(arc), strongRoot, arc);
+        pushExcess(strongRoot);
+        return;
+    }
+    checkChildren(strongRoot);
+
+    // Walk down the nodes that share the label of the root
+    while (strongNode != -1)
+    {
+        while (nextScan[strongNode] != -1)
+        {
+            int child = nextScan[strongNode];
+            nextScan[strongNode] = nextSibling[child];
+            strongNode = child;
+            nextScan[strongNode] = firstChild[strongNode];
+
+            arc = findWeakNode(strongNode);
+            if (arc != -1)
+            {
+                merge(network.getHead(arc), strongNode, arc);
+                pushExcess(strongRoot);
+                return;
+            }
+            checkChildren(strongNode);
+        }
+
+        strongNode = parent[strongNode];
+        if (strongNode != -1)
+        {
+            checkChildren(strongNode);
+        }
+    }
+
+    // Every scanned node was relabeled
+    if (label[strongRoot] >= network.getNodes())
+    {
+        liftAll(strongRoot);
+        return;
+    }
+    addToStrongBucket(strongRoot);
+    ++highestStrongLabel;
+}
+
+/**
+ * Finds a residual arc into a node one label below the highest.
+ *
+ * Method Name: findWeakNode
+ *
+ * Purpose: Scans the arcs of the node from its current arc.
+ *
+ * Parameters:
+ * - node: An integer representing the strong node.
+ *
+ * Returns: The arc found, -1 if there is none.
+ *
+ * Preconditions:
+ * - The node is in the strong tree being processed.
+ *
+ * Postconditions:
+ * - The current arc of the node is advanced.
+ */
+int PseudoFlow::findWeakNode(int node)
+{
+    int target = highestStrongLabel - 1;
+    int end = network.arcEnd(node);
+    for (int &arc = currentArc[node]; arc < end; ++arc)
+    {
+        int head = network.getHead(arc);
+        if (label[head] == target && head != source && head != sink &&
+            network.getResidual(arc) > 0)
+        {
+            return arc;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Relabels a node if none of its children shares its label.
+ *
+ * Method Name: checkChildren
+ *
+ * Purpose: Moves the scan position of the node to the next child with
+ * the same label, or raises the label of the node by one if there is no
+ * such child.
+ *
+ * Parameters:
+ * - node: An integer representing the node.
+ *
+ * Preconditions:
+ * - The node is in the strong tree being processed.
+ *
+ * Postconditions:
+ * - The scan position or the label is updated.
+ */
+void PseudoFlow::checkChildren(int node)
+{
+    for (; nextScan[node] != -1; nextScan[node] = nextSibling[nextScan[node]])
+    {
+        if (label[nextScan[node]] == label[node])
+        {
+            return;
+        }
+    }
+
+    --labelCount[label[node]];
+    ++label[node];
+    ++labelCount[label[node]];
+    currentArc[node] = network.arcBegin(node);
+}
+
+/**
+ * Merges a strong tree into another tree.
+ *
+ * Method Name: merge
+ *
+ * Purpose: Hangs the strong node under the weak node and reverses the
+ * tree path from the strong node to its old root, so the old root
+ * becomes a descendant.
+ *
+ * Parameters:
+ * - weakNode: An integer representing the new parent.
+ * - strongNode: An integer representing the node that is hung.
+ * - arc: The arc from the strong node to the weak node.
+ *
+ * Preconditions:
+ * - The nodes are in different trees.
+ *
+ * Postconditions:
+ * - The two trees are one tree.
+ */
+void PseudoFlow::merge(int weakNode, int strongNode, int arc)
+{
+    int current = strongNode;
+    int newParent = weakNode;
+    int newArc = arc;
+
+    // Reverse the path up to the old root
+    while (parent[current] != -1)
+    {
+        int oldParent = parent[current];
+        int oldArc = parentArc[current];
+        breakRelationship(oldParent, current);
+        parentArc[current] = newArc;
+        addRelationship(newParent, current);
+        newParent = current;
+        current = oldParent;
+        newArc = network.getReverse(oldArc);
+    }
+
+    parentArc[current] = newArc;
+    addRelationship(newParent, current);
+}
+
+/**
+ * Pushes the excess of a former root towards the new root.
+ *
+ * Method Name: pushExcess
+ *
+ * Purpose: Pushes the excess up the tree, splitting off the subtree
+ * below every arc that cannot carry all of it as a new strong tree.
+ *
+ * Parameters:
+ * - strongRoot: An integer representing the former root.
+ *
+ * Preconditions:
+ * - The former root was just merged into another tree.
+ *
+ * Postconditions:
+ * - Only roots carry excess and new strong roots are in buckets.
+ */
+void PseudoFlow::pushExcess(int strongRoot)
+{
+    int current = strongRoot;
+    long long previousExcess = 1;
+
+    while (excess[current] > 0 && parent[current] != -1)
+    {
+        int up = parent[current];
+        int arc = parentArc[current];
+        previousExcess = excess[up];
+        long long residual = network.getResidual(arc);
+
+        if (residual >= excess[current])
+        {
+            network.push(arc, excess[current]);
+            excess[up] += excess[current];
+            excess[current] = 0;
+        }
+        else
+        {
+            // Saturate the arc and split off the rest as a strong tree
+            network.push(arc, residual);
+            excess[up] += residual;
+            excess[current] -= residual;
+            breakRelationship(up, current);
+            addToStrongBucket(current);
+        }
+        current = up;
+    }
+
+    if (excess[current] > 0 && previousExcess <= 0)
+    {
+        addToStrongBucket(current);
+    }
+}
+
+/**
+ * Lifts a whole tree to the node count.
+ *
+ * Method Name: liftAll
+ *
+ * Purpose: Labels every node of the tree with the node count, which
+ * puts it on the source side for good.
+ *
+ * Parameters:
+ * - root: An integer representing the root of the tree.
+ *
+ * Preconditions:
+ * - The root is not in a bucket.
+ *
+ * Postconditions:
+ * - Every node of the tree is labeled with the node count.
+ */
+void PseudoFlow::liftAll(int root)
+{
+    int nodes = network.getNodes();
+    int current = root;
+    nextScan[current] = firstChild[current];
+    --labelCount[label[current]];
+    label[current] = nodes;
+
+    while (current != -1)
+    {
+        while (nextScan[current] != -1)
+        {
+            int child = nextScan[current];
+            nextScan[current] = nextSibling[child];
+            current = child;
+            nextScan[current] = firstChild[current];
+            --labelCount[label[current]];
+            label[current] = nodes;
+        }
+        current = current == root ? -1 : parent[current];
+    }
+}
+
+/**
+ * Adds a strong root to the bucket of its label.
+ *
+ * Method Name: addToStrongBucket
+ *
+ * Purpose: Appends the root to its bucket unless it is labeled with
+ * the node count.
+ *
+ * Parameters:
+ * - root: An integer representing the root.
+ *
+ * Preconditions:
+ * - The root is strong and not in a bucket.
+ *
+ * Postconditions:
+ * - The root is in the bucket of its label.
+ */
+void PseudoFlow::addToStrongBucket(int root)
+{
+    int level = label[root];
+    if (level >= network.getNodes())
+    {
+        return;
+    }
+
+    nextInBucket[root] = -1;
+    if (bucketLast[level] == -1)
+    {
+        bucketFirst[level] = root;
+    }
+    else
+    {
+        nextInBucket[bucketLast[level]] = root;
+    }
+    bucketLast[level] = root;
+}
+
+/**
+ * Hangs a node under a parent.
+ *
+ * Method Name: addRelationship
+ *
+ * Purpose: Adds the node to the front of the children of the parent.
+ *
+ * Parameters:
+ * - newParent: An integer representing the parent.
+ * - child: An integer representing the node.
+ *
+ * Preconditions:
+ * - The node is a root.
+ *
+ * Postconditions:
+ * - The node is a child of the parent.
+ */
+void PseudoFlow::addRelationship(int newParent, int child)
+{
+    parent[child] = newParent;
+    previousSibling[child] = -1;
+    nextSibling[child] = firstChild[newParent];
+    if (firstChild[newParent] != -1)
+    {
+        previousSibling[firstChild[newParent]] = child;
+    }
+    firstChild[newParent] = child;
+}
+
+/**
+ * Cuts a node from its parent.
+ *
+ * Method Name: breakRelationship
+ *
+ * Purpose: Removes the node from the children of its parent.
+ *
+ * Parameters:
+ * - oldParent: An integer representing the parent.
+ * - child: An integer representing the node.
+ *
+ * Preconditions:
+ * - The node is a child of the parent.
+ *
+ * Postconditions:
+ * - The node is a root.
+ */
+void PseudoFlow::breakRelationship(int oldParent, int child)
+{
+    if (previousSibling[child] != -1)
+    {
+        nextSibling[previousSibling[child]] = nextSibling[child];
+    }
+    else
+    {
+        firstChild[oldParent] = nextSibling[child];
+    }
+    if (nextSibling[child] != -1)
+    {
+        previousSibling[nextSibling[child]] = previousSibling[child];
+    }
+
+    // A parent whose scan stands on the child moves past it
+    if (nextScan[oldParent] == child)
+    {
+        nextScan[oldParent] = nextSibling[child];
+    }
+
+    parent[child] = -1;
+    parentArc[child] = -1;
+    nextSibling[child] = -1;
+    previousSibling[child] = -1;
+}
+
+/**
+ * Cuts a node from its parent so it can carry excess.
+ *
+ * Method Name: makeRoot
+ *
+ * Purpose: Splits the subtree of the node off its tree.
+ *
+ * Parameters:
+ * - node: An integer representing the node.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The node is a root.
+ */
+void PseudoFlow::makeRoot(int node)
+{
+    if (parent[node] != -1)
+    {
+        breakRelationship(parent[node], node);
+    }
+}
+
+/**
+ * Returns the imbalance of a node to a terminal along the flow.
+ *
+ * Method Name: returnExcess
+ *
+ * Purpose: Follows the flow leaving the node, or entering it, to the
+ * sink or source or to a node with the opposite imbalance, lowering
+ * the flow on the path and cancelling cycles on the way.
+ *
+ * Parameters:
+ * - node: An integer representing the node with the imbalance.
+ * - forward: True to follow the flow leaving a node with a deficit,
+ *   false to follow the flow entering a node with excess.
+ *
+ * Preconditions:
+ * - The current arcs were reset for the direction.
+ *
+ * Postconditions:
+ * - The node has no imbalance.
+ * - An exception is thrown if no flow path is left.
+ */
+void PseudoFlow::returnExcess(int node, bool forward)
+{
+    int target = forward ? sink : source;
+    int other = forward ? source : sink;
+    std::vector<int> path;
+    std::vector<int> pathArcs;
+
+    // The flow an arc carries in the direction being followed
+    auto carried = [&](int arc)
+    {
+        return forward ? network.getFlow(arc)
+                       : network.getFlow(network.getReverse(arc));
+    };
+
+    // Lower the flow an arc carries in the direction being followed
+    auto lower = [&](int arc, long long amount)
+    {
+        network.push(forward ? network.getReverse(arc) : arc, amount);
+    };
+
+    while (excess[node] != 0)
+    {
+        path.assign(1, node);
+        pathArcs.clear();
+        pathPosition[node] = 0;
+
+        // Follow the flow until it ends at a terminal or an imbalance
+        int end;
+        while (true)
+        {
+            int current = path.back();
+            if (current == target ||
+                (current != node &&
+                 (forward ? excess[current] > 0 : excess[current] < 0)))
+            {
+                end = current;
+                break;
+            }
+
+            int arc = -1;
+            for (int &next = currentArc[current];
+                 next < network.arcEnd(current);
+                 ++next)
+            {
+                if (network.getHead(next) != other && carried(next) > 0)
+                {
+                    arc = next;
+                    break;
+                }
+            }
+            if (arc == -1)
+            {
+                for (int visited : path)
+                {
+                    pathPosition[visited] = -1;
+                }
+                std::cerr << "ERROR: Flow cannot be recovered." << std::endl;
+                throw std::runtime_error("Flow cannot be recovered.");
+            }
+
+            int head = network.getHead(arc);
+            if (pathPosition[head] == -1)
+            {
+                pathPosition[head] = static_cast<int>(path.size());
+                path.push_back(head);
+                pathArcs.push_back(arc);
+                continue;
+            }
+
+            // Cancel the flow cycle closed by the arc
+            long long amount = carried(arc);
+            for (size_t i = pathPosition[head]; i < pathArcs.size(); ++i)
+            {
+                amount = std::min(amount, carried(pathArcs[i]));
+            }
+            lower(arc, amount);
+            for (size_t i = pathPosition[head]; i < pathArcs.size(); ++i)
+            {
+                lower(pathArcs[i], amount);
+            }
+            while (path.back() != head)
+            {
+                pathPosition[path.back()] = -1;
+                path.pop_back();
+                pathArcs.pop_back();
+            }
+        }
+
+        // Move as much of the imbalance as the path allows
+        long long amount = excess[node] < 0 ? -excess[node] : excess[node];
+        if (end != target)
+        {
+            amount = std::min(amount, excess[end] < 0 ? -excess[end]
+                                                      : excess[end]);
+        }
+        for (int arc : pathArcs)
+        {
+            amount = std::min(amount, carried(arc));
+        }
+        for (int arc : pathArcs)
+        {
+            lower(arc, amount);
+        }
+        if (forward)
+        {
+            excess[node] += amount;
+            if (end != target)
+            {
+                excess[end] -= amount;
+            }
+        }
+        else
+        {
+            excess[node] -= amount;
+            if (end != target)
+            {
+                excess[end] += amount;
+            }
+        }
+
+        for (int visited : path)
+        {
+            pathPosition[visited] = -1;
+        }
+    }
+}
+
+/**
+ * Calculates the capacity of the cut given by the labels.
+ *
+ * Method Name: cutCapacity
+ *
+ * Purpose: Adds the capacities of the arcs leaving the source side.
+ *
+ * Returns: The capacity of the cut.
+ *
+ * Preconditions:
+ * - calculateMinCut was called.
+ *
+ * Postconditions:
+ * - The capacity is returned.
+ */
+long long PseudoFlow::cutCapacity() const
+{
+    int nodes = network.getNodes();
+    long long capacity = 0;
+    for (int node = 0; node < nodes; ++node)
+    {
+        if (node != source && label[node] < nodes)
+        {
+            continue;
+        }
+        for (int arc = network.arcBegin(node); arc < network.arcEnd(node);
+             ++arc)
+        {
+            int head = network.getHead(arc);
+            if (head != source && label[head] < nodes)
+            {
+                capacity += network.getCapacity(arc);
+            }
+        }
+    }
+    return capacity;
+}
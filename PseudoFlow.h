@@ -0,0 +1,506 @@
+/*
+ * File: PseudoFlow.h Author: Nicolas Gioanni Purpose: Declaration of
+ * the PseudoFlow class for calculating minimum cuts and maximum flow
+ * with Hochbaum's highest-label pseudoflow algorithm.
+ *
+ * Functionality/Features:
+ * - Declare methods for calculating the minimum cut by merging strong
+ *   trees with excess into weak trees with deficit, keeping the trees
+ *   normalized so only roots carry excess.
+ * - Declare methods for recovering a maximum flow from the final
+ *   pseudoflow.
+ * - Declare methods for the simple parametric extension, in which
+ *   source arcs grow and sink arcs shrink between solves.
+ *
+ * Assumptions:
+ * - The network is a FlowNetwork whose arcs are paired with reverse
+ *   arcs.
+ * - Capacities are non-negative integers.
+ */
+
+#ifndef PSEUDOFLOW_H
+#define PSEUDOFLOW_H
+
+#include "FlowNetwork.h"
+#include <vector>
+
+class PseudoFlow
+{
+public:
+    /**
+     * Constructor for the PseudoFlow class.
+     *
+     * Method Name: PseudoFlow
+     *
+     * Purpose: Initializes a new instance of the PseudoFlow class.
+     *
+     * Parameters:
+     * - network: A reference to the network to solve. The solver
+     *   keeps the pseudoflow, and later the flow, in the network.
+     *
+     * Preconditions:
+     * - The network is built.
+     *
+     * Postconditions:
+     * - A new instance of the PseudoFlow class is created.
+     */
+    PseudoFlow(FlowNetwork &network);
+
+    /**
+     * Calculates the maximum flow in the flow network.
+     *
+     * Method Name: calculateMaxFlow
+     *
+     * Purpose: Calculates the minimum cut and then recovers a maximum
+     * flow from the pseudoflow.
+     *
+     * Parameters:
+     * - source: An integer representing the source node.
+     * - sink: An integer representing the sink node.
+     *
+     * Returns: The value of the maximum flow.
+     *
+     * Preconditions:
+     * - The source and sink nodes are within the valid range.
+     *
+     * Postconditions:
+     * - The network carries a maximum flow.
+     * - An exception is thrown if the calculation process fails.
+     */
+    long long calculateMaxFlow(int source, int sink);
+
+    /**
+     * Calculates the minimum cut of the flow network.
+     *
+     * Method Name: calculateMinCut
+     *
+     * Purpose: Saturates every source and sink arc and runs the first
+     * phase of the algorithm, which processes the strong root with the
+     * highest label until every strong node is labeled with the node
+     * count.
+     *
+     * Parameters:
+     * - source: An integer representing the source node.
+     * - sink: An integer representing the sink node.
+     *
+     * Returns: The capacity of the minimum cut.
+     *
+     * Preconditions:
+     * - The source and sink nodes are within the valid range.
+     *
+     * Postconditions:
+     * - The network carries a pseudoflow whose strong nodes are the
+     *   source side of a minimum cut.
+     * - An exception is thrown if the calculation process fails.
+     */
+    long long calculateMinCut(int source, int sink);
+
+    /**
+     * Raises source arcs and lowers sink arcs, then solves again.
+     *
+     * Method Name: applyTerminalCapacities
+     *
+     * Purpose: Changes the capacities of arcs leaving the source or
+     * entering the sink and continues the first phase from the current
+     * trees and labels. The new capacity of a source arc is pushed
+     * into its head, and flow above the new capacity of a sink arc is
+     * returned to its tail; the nodes that gain excess become roots.
+     *
+     * Parameters:
+     * - arcs: A constant reference to the indices of the changed arcs.
+     * - capacities: A constant reference to the new capacities, one
+     *   per changed arc.
+     *
+     * Returns: The capacity of the new minimum cut.
+     *
+     * Preconditions:
+     * - calculateMinCut was called and recoverFlow was not.
+     * - Source arcs only grow and sink arcs only shrink.
+     *
+     * Postconditions:
+     * - The strong nodes are the source side of the new minimum cut,
+     *   which contains the previous one.
+     * - An exception is thrown if a change is invalid.
+     */
+    long long applyTerminalCapacities(
+        const std::vector<int> &arcs,
+        const std::vector<long long> &capacities);
+
+    /**
+     * Turns the pseudoflow into a maximum flow.
+     *
+     * Method Name: recoverFlow
+     *
+     * Purpose: Returns the excess of every strong node to the source
+     * and the deficit of every weak node to the sink along the flow,
+     * cancelling flow cycles met on the way.
+     *
+     * Returns: The value of the maximum flow.
+     *
+     * Preconditions:
+     * - calculateMinCut was called.
+     *
+     * Postconditions:
+     * - The network carries a maximum flow.
+     * - No further parametric changes are allowed.
+     * - An exception is thrown if the flow cannot be recovered.
+     */
+    long long recoverFlow();
+
+    /**
+     * Get the source side of the minimum cut.
+     *
+     * Method Name: getSourceSide
+     *
+     * Purpose: Returns the source and every node labeled with the node
+     * count.
+     *
+     * Preconditions:
+     * - calculateMinCut was called.
+     *
+     * Postconditions:
+     * - The source side is returned.
+     *
+     * Returns: A vector with true for every node on the source side.
+     */
+    std::vector<bool> getSourceSide() const;
+
+private:
+    // The network holding the pseudoflow
+    FlowNetwork &network;
+
+    // The source node of the last solve
+    int source;
+
+    // The sink node of the last solve
+    int sink;
+
+    // True once the first phase has run
+    bool cutFound;
+
+    // True once the flow was recovered
+    bool flowRecovered;
+
+    // The label of every node
+    std::vector<int> label;
+
+    // The flow into every node minus the flow out of it
+    std::vector<long long> excess;
+
+    // The tree parent of every node, -1 for roots
+    std::vector<int> parent;
+
+    // The arc from every node to its parent
+    std::vector<int> parentArc;
+
+    // The first child of every node, -1 if none
+    std::vector<int> firstChild;
+
+    // The next child of the same parent, -1 if none
+    std::vector<int> nextSibling;
+
+    // The previous child of the same parent, -1 if none
+    std::vector<int> previousSibling;
+
+    // The next child to visit while scanning a strong tree
+    std::vector<int> nextScan;
+
+    // The next arc to try from every node
+    std::vector<int> currentArc;
+
+    // The first strong root of every label
+    std::vector<int> bucketFirst;
+
+    // The last strong root of every label
+    std::vector<int> bucketLast;
+
+    // The next strong root in the same bucket
+    std::vector<int> nextInBucket;
+
+    // The number of nodes with every label
+    std::vector<int> labelCount;
+
+    // The highest label that may have a strong root
+    int highestStrongLabel;
+
+    // The position of every node on the flow path being returned, -1
+    // if it is not on it
+    std::vector<int> pathPosition;
+
+    /**
+     * Processes strong roots until none is left below the node count.
+     *
+     * Method Name: runPhaseOne
+     *
+     * Purpose: Repeatedly takes the strong root with the highest label
+     * and processes it.
+     *
+     * Preconditions:
+     * - The strong roots are in their buckets.
+     *
+     * Postconditions:
+     * - Every strong node is labeled with the node count.
+     */
+    void runPhaseOne();
+
+    /**
+     * Takes the strong root with the highest label.
+     *
+     * Method Name: getHighestStrongRoot
+     *
+     * Purpose: Removes the first root of the highest non-empty bucket.
+     * Roots whose label has no node one below are lifted to the node
+     * count with their trees, and roots at label 0 are moved up to 1.
+     *
+     * Returns: The strong root, -1 if there is none.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The root is no longer in a bucket.
+     */
+    int getHighestStrongRoot();
+
+    /**
+     * Processes one strong root.
+     *
+     * Method Name: processRoot
+     *
+     * Purpose: Scans the nodes of the strong tree that share the label
+     * of the root for a residual arc into a node one label lower. If
+     * one is found the tree is merged through it and the excess is
+     * pushed towards the new root; otherwise the scanned nodes are
+     * relabeled from the bottom up and the root goes back into a
+     * bucket.
+     *
+     * Parameters:
+     * - strongRoot: An integer representing the root.
+     *
+     * Preconditions:
+     * - The root is strong and not in a bucket.
+     *
+     * Postconditions:
+     * - The tree was merged or relabeled.
+     */
+    void processRoot(int strongRoot);
+
+    /**
+     * Finds a residual arc into a node one label below the highest.
+     *
+     * Method Name: findWeakNode
+     *
+     * Purpose: Scans the arcs of the node from its current arc.
+     *
+     * Parameters:
+     * - node: An integer representing the strong node.
+     *
+     * Returns: The arc found, -1 if there is none.
+     *
+     * Preconditions:
+     * - The node is in the strong tree being processed.
+     *
+     * Postconditions:
+     * - The current arc of the node is advanced.
+     */
+    int findWeakNode(int node);
+
+    /**
+     * Relabels a node if none of its children shares its label.
+     *
+     * Method Name: checkChildren
+     *
+     * Purpose: Moves the scan position of the node to the next child
+     * with the same label, or raises the label of the node by one if
+     * there is no such child.
+     *
+     * Parameters:
+     * - node: An integer representing the node.
+     *
+     * Preconditions:
+     * - The node is in the strong tree being processed.
+     *
+     * Postconditions:
+     * - The scan position or the label is updated.
+     */
+    void checkChildren(int node);
+
+    /**
+     * Merges a strong tree into another tree.
+     *
+     * Method Name: merge
+     *
+     * Purpose: Hangs the strong node under the weak node and reverses
+     * the tree path from the strong node to its old root, so the old
+     * root becomes a descendant.
+     *
+     * Parameters:
+     * - weakNode: An integer representing the new parent.
+     * - strongNode: An integer representing the node that is hung.
+     * - arc: The arc from the strong node to the weak node.
+     *
+     * Preconditions:
+     * - The nodes are in different trees.
+     *
+     * Postconditions:
+     * - The two trees are one tree.
+     */
+    void merge(int weakNode, int strongNode, int arc);
+
+    /**
+     * Pushes the excess of a former root towards the new root.
+     *
+     * Method Name: pushExcess
+     *
+     * Purpose: Pushes the excess up the tree, splitting off the
+     * subtree below every arc that cannot carry all of it as a new
+     * strong tree.
+     *
+     * Parameters:
+     * - strongRoot: An integer representing the former root.
+     *
+     * Preconditions:
+     * - The former root was just merged into another tree.
+     *
+     * Postconditions:
+     * - Only roots carry excess and new strong roots are in buckets.
+     */
+    void pushExcess(int strongRoot);
+
+    /**
+     * Lifts a whole tree to the node count.
+     *
+     * Method Name: liftAll
+     *
+     * Purpose: Labels every node of the tree with the node count, which
+     * puts it on the source side for good.
+     *
+     * Parameters:
+     * - root: An integer representing the root of the tree.
+     *
+     * Preconditions:
+     * - The root is not in a bucket.
+     *
+     * Postconditions:
+     * - Every node of the tree is labeled with the node count.
+     */
+    void liftAll(int root);
+
+    /**
+     * Adds a strong root to the bucket of its label.
+     *
+     * Method Name: addToStrongBucket
+     *
+     * Purpose: Appends the root to its bucket unless it is labeled with
+     * the node count.
+     *
+     * Parameters:
+     * - root: An integer representing the root.
+     *
+     * Preconditions:
+     * - The root is strong and not in a bucket.
+     *
+     * Postconditions:
+     * - The root is in the bucket of its label.
+     */
+    void addToStrongBucket(int root);
+
+    /**
+     * Hangs a node under a parent.
+     *
+     * Method Name: addRelationship
+     *
+     * Purpose: Adds the node to the front of the children of the
+     * parent.
+     *
+     * Parameters:
+     * - newParent: An integer representing the parent.
+     * - child: An integer representing the node.
+     *
+     * Preconditions:
+     * - The node is a root.
+     *
+     * Postconditions:
+     * - The node is a child of the parent.
+     */
+    void addRelationship(int newParent, int child);
+
+    /**
+     * Cuts a node from its parent.
+     *
+     * Method Name: breakRelationship
+     *
+     * Purpose: Removes the node from the children of its parent.
+     *
+     * Parameters:
+     * - oldParent: An integer representing the parent.
+     * - child: An integer representing the node.
+     *
+     * Preconditions:
+     * - The node is a child of the parent.
+     *
+     * Postconditions:
+     * - The node is a root.
+     */
+    void breakRelationship(int oldParent, int child);
+
+    /**
+     * Cuts a node from its parent so it can carry excess.
+     *
+     * Method Name: makeRoot
+     *
+     * Purpose: Splits the subtree of the node off its tree.
+     *
+     * Parameters:
+     * - node: An integer representing the node.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The node is a root.
+     */
+    void makeRoot(int node);
+
+    /**
+     * Returns the imbalance of a node to a terminal along the flow.
+     *
+     * Method Name: returnExcess
+     *
+     * Purpose: Follows the flow leaving the node, or entering it, to
+     * the sink or source or to a node with the opposite imbalance,
+     * lowering the flow on the path and cancelling cycles on the way.
+     *
+     * Parameters:
+     * - node: An integer representing the node with the imbalance.
+     * - forward: True to follow the flow leaving a node with a
+     *   deficit, false to follow the flow entering a node with excess.
+     *
+     * Preconditions:
+     * - The current arcs were reset for the direction.
+     *
+     * Postconditions:
+     * - The node has no imbalance.
+     * - An exception is thrown if no flow path is left.
+     */
+    void returnExcess(int node, bool forward);
+
+    /**
+     * Calculates the capacity of the cut given by the labels.
+     *
+     * Method Name: cutCapacity
+     *
+     * Purpose: Adds the capacities of the arcs leaving the source side.
+     *
+     * Returns: The capacity of the cut.
+     *
+     * Preconditions:
+     * - calculateMinCut was called.
+     *
+     * Postconditions:
+     * - The capacity is returned.
+     */
+    long long cutCapacity() const;
+};
+
+#endif
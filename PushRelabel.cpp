@@ -0,0 +1,935 @@
+/*
+ * File: PushRelabel.cpp Author: Nicolas Gioanni Purpose:
+ * Implementation of the PushRelabel class, providing methods for
+ * calculating and re-optimizing maximum flow with the highest-label
+ * push-relabel algorithm.
+ *
+ * Functionality/Features:
+ * - Discharge the highest-labeled active node first.
+ * - Use current arcs, the gap heuristic and periodic global
+ *   relabels.
+ * - Return excess that cannot reach the sink to the source, so the
+ *   result is a flow and not only a preflow.
+ * - Re-solve after capacity changes starting from the previous flow
+ *   and labels.
+ *
+ * Assumptions:
+ * - Labels range from 0 to twice the node count; the source keeps
+ *   the node count and the sink keeps 0.
+ */
+
+#include "PushRelabel.h"
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+/**
+ * Constructor for the PushRelabel class.
+ *
+ * Method Name: PushRelabel
+ *
+ * Purpose: Initializes a new instance of the PushRelabel class.
+ *
+ * Parameters:
+ * - network: A reference to the network to solve. The solver keeps
+ *   the flow in the network.
+ *
+ * Preconditions:
+ * - The network is built.
+ *
+ * Postconditions:
+ * - A new instance of the PushRelabel class is created.
+ * - The label, excess and bucket vectors are sized.
+ */
+template <typename Network>
+PushRelabel<Network>::PushRelabel(Network &network)
+    : network(network),
+      source(-1),
+      sink(-1),
+      solved(false),
+      label(network.getNodes(), 0),
+      excess(network.getNodes(), 0),
+      currentArc(network.getNodes(), 0),
+      buckets(2 * network.getNodes() + 1),
+      labelNodes(network.getNodes()),
+      labelPosition(network.getNodes(), -1),
+      highestLabel(0),
+      highestActive(-1),
+      relabelsSinceGlobal(0)
+{
+}
+
+/**
+ * Calculates the maximum flow in the flow network.
+ *
+ * Method Name: calculateMaxFlow
+ *
+ * Purpose: Removes any previous flow and calculates the maximum flow
+ * from the source to the sink node.
+ *
+ * Parameters:
+ * - source: An integer representing the source node.
+ * - sink: An integer representing the sink node.
+ *
+ * Returns: The value of the maximum flow.
+ *
+ * Preconditions:
+ * - The source and sink nodes are within the valid range.
+ *
+ * Postconditions:
+ * - The network carries a maximum flow.
+ * - The labels are kept for later re-solves.
+ * - An exception is thrown if the calculation process fails.
+ */
+template <typename Network>
+long long PushRelabel<Network>::calculateMaxFlow(int source, int sink)
+{
+    try
+    {
+        // Check if source and sink nodes are within valid range
+        int nodes = network.getNodes();
+        if (source < 0 ||
+            source >= nodes ||
+            sink < 0 ||
+            sink >= nodes ||
+            source == sink)
+        {
+            std::cerr
+                << "ERROR: Source or sink is out of valid range."
+                << std::endl;
+            throw std::
+                invalid_argument("Source or sink is out of valid range.");
+        }
+
+        this->source = source;
+        this->sink = sink;
+        solved = false;
+
+        // Start from zero flow and saturate every source arc
+        network.resetFlow();
+        std::fill(excess.begin(), excess.end(), 0);
+        for (int arc = network.arcBegin(source);
+             arc < network.arcEnd(source);
+             ++arc)
+        {
+            long long amount = network.getResidual(arc);
+            if (amount > 0)
+            {
+                network.push(arc, amount);
+                excess[source] -= amount;
+                excess[network.getHead(arc)] += amount;
+            }
+        }
+
+        // Label the nodes and push until no node is active
+        globalRelabel();
+        dischargeActiveNodes();
+
+        solved = true;
+        return excess[sink];
+    }
+    catch (const std::exception &e)
+    {
+        // Output an error message if max flow calculation fails
+        std::cerr
+            << "ERROR: Error in calculateMaxFlow: "
+            << e.what()
+            << std::endl;
+        throw std::runtime_error("Error in calculateMaxFlow: " +
+                                 std::string(e.what()));
+    }
+}
+
+/**
+ * Applies capacity changes and re-optimizes the flow.
+ *
+ * Method Name: applyCapacityChanges
+ *
+ * Purpose: Changes the capacities of the given arcs of a solved
+ * network. Flow above a lowered capacity is pushed back: the tail
+ * keeps it as excess and the missing inflow at the head is cancelled
+ * along the flow leaving it. The excess is then discharged with the
+ * labels of the previous solve; a new residual arc that breaks them
+ * only lowers the labels of the nodes behind it, until the repairs use
+ * up a relabel period and a global relabel takes over.
+ *
+ * Parameters:
+ * - changes: A constant reference to the capacity changes.
+ *
+ * Returns: The value of the new maximum flow.
+ *
+ * Preconditions:
+ * - calculateMaxFlow was called.
+ * - Every changed arc exists in the network.
+ *
+ * Postconditions:
+ * - The network carries a maximum flow for the new capacities.
+ * - An exception is thrown if a change is invalid.
+ */
+template <typename Network>
+long long PushRelabel<Network>::applyCapacityChanges(
+    const std::vector<CapacityChange> &changes)
+{
+    // Look up the changed arcs by their end nodes
+    std::vector<int> arcs;
+    std::vector<long long> capacities;
+    for (const CapacityChange &change : changes)
+    {
+        int arc = network.findArc(change.tail, change.head);
+        if (arc == -1)
+        {
+            std::cerr << "ERROR: Capacity change is Invalid." << std::endl;
+            throw std::invalid_argument("Capacity change is Invalid.");
+        }
+        arcs.push_back(arc);
+        capacities.push_back(change.capacity);
+    }
+
+    return applyArcCapacityChanges(arcs, capacities);
+}
+
+/**
+ * Applies capacity changes given by arc index and re-optimizes.
+ *
+ * Method Name: applyArcCapacityChanges
+ *
+ * Purpose: Works like applyCapacityChanges, but takes the arcs by their
+ * index in the network so callers that change the same arcs repeatedly
+ * do not have to look them up every time.
+ *
+ * Parameters:
+ * - arcs: A constant reference to the indices of the changed arcs.
+ * - capacities: A constant reference to the new capacities, one per
+ *   changed arc.
+ *
+ * Returns: The value of the new maximum flow.
+ *
+ * Preconditions:
+ * - calculateMaxFlow was called.
+ * - Both vectors have the same length.
+ *
+ * Postconditions:
+ * - The network carries a maximum flow for the new capacities.
+ * - An exception is thrown if a change is invalid.
+ */
+template <typename Network>
+long long PushRelabel<Network>::applyArcCapacityChanges(
+    const std::vector<int> &arcs,
+    const std::vector<long long> &capacities)
+{
+    try
+    {
+        // Check if there is a solved flow to start from
+        if (!solved)
+        {
+            std::cerr
+                << "ERROR: The network has not been solved yet."
+                << std::endl;
+            throw std::
+                logic_error("The network has not been solved yet.");
+        }
+        if (arcs.size() != capacities.size())
+        {
+            std::cerr
+                << "ERROR: Every changed arc needs one capacity."
+                << std::endl;
+            throw std::
+                invalid_argument("Every changed arc needs one capacity.");
+        }
+
+        // Every update gets a full relabel period of local repairs
+        std::vector<int> touched;
+        relabelsSinceGlobal = 0;
+
+        for (size_t i = 0; i < arcs.size(); ++i)
+        {
+            int arc = arcs[i];
+            if (arc < 0 || arc >= network.getArcs() || capacities[i] < 0)
+            {
+                std::cerr << "ERROR: Capacity change is Invalid." << std::endl;
+                throw std::
+                    invalid_argument("Capacity change is Invalid.");
+            }
+
+            int head = network.getHead(arc);
+            int tail = network.getHead(network.getReverse(arc));
+            long long oldResidual = network.getResidual(arc);
+            network.setCapacity(arc, capacities[i]);
+            touched.push_back(tail);
+
+            if (network.getResidual(arc) < 0)
+            {
+                // Push the flow above the new capacity back to the
+                // tail, leaving a deficit at the head
+                long long overflow = -network.getResidual(arc);
+                network.push(network.getReverse(arc), overflow);
+                excess[tail] += overflow;
+                excess[head] -= overflow;
+                if (head != source && head != sink && excess[head] < 0)
+                {
+                    cancelDeficit(head);
+                }
+            }
+            else if (oldResidual <= 0 &&
+                     network.getResidual(arc) > 0 &&
+                     tail != source &&
+                     label[tail] > label[head] + 1)
+            {
+                // The new residual arc breaks the labeling, so repair
+                // the labels that lead into it
+                lowerLabel(tail, label[head] + 1);
+            }
+        }
+
+        if (relabelsSinceGlobal > network.getNodes())
+        {
+            // The repairs grew as costly as the periodic global
+            // relabel, which takes over the rest of them
+            globalRelabel();
+        }
+        else
+        {
+            // Only the nodes that gained excess have work to do
+            for (int node : touched)
+            {
+                if (node != source && node != sink && excess[node] > 0)
+                {
+                    activate(node);
+                }
+            }
+        }
+
+        // Push along source arcs that gained capacity, then discharge
+        saturateSourceArcs();
+        dischargeActiveNodes();
+
+        return excess[sink];
+    }
+    catch (const std::exception &e)
+    {
+        // Output an error message if the re-solve fails
+        std::cerr
+            << "ERROR: Error in applyArcCapacityChanges: "
+            << e.what()
+            << std::endl;
+        throw std::runtime_error("Error in applyArcCapacityChanges: " +
+                                 std::string(e.what()));
+    }
+}
+
+/**
+ * Get the value of the current flow.
+ *
+ * Method Name: getFlowValue
+ *
+ * Purpose: Returns the flow that reaches the sink.
+ *
+ * Preconditions:
+ * - calculateMaxFlow was called.
+ *
+ * Postconditions:
+ * - The flow value is returned.
+ *
+ * Returns: The value of the current flow.
+ */
+template <typename Network>
+long long PushRelabel<Network>::getFlowValue() const
+{
+    return solved ? excess[sink] : 0;
+}
+
+/**
+ * Get the source side of a minimum cut.
+ *
+ * Method Name: getSourceSide
+ *
+ * Purpose: Returns the nodes reachable from the source in the residual
+ * network, which is the smallest source side of a minimum cut.
+ *
+ * Preconditions:
+ * - calculateMaxFlow was called.
+ *
+ * Postconditions:
+ * - The source side is returned.
+ *
+ * Returns: A vector with true for every node on the source side.
+ */
+template <typename Network>
+std::vector<bool> PushRelabel<Network>::getSourceSide() const
+{
+    std::vector<bool> sourceSide(network.getNodes(), false);
+    if (source < 0)
+    {
+        return sourceSide;
+    }
+
+    // Search the residual network from the source
+    std::vector<int> queue(1, source);
+    sourceSide[source] = true;
+    for (size_t front = 0; front < queue.size(); ++front)
+    {
+        int node = queue[front];
+        for (int arc = network.arcBegin(node);
+             arc < network.arcEnd(node);
+             ++arc)
+        {
+            int head = network.getHead(arc);
+            if (network.getResidual(arc) > 0 && !sourceSide[head])
+            {
+                sourceSide[head] = true;
+                queue.push_back(head);
+            }
+        }
+    }
+    return sourceSide;
+}
+
+/**
+ * Recomputes all labels as residual distances.
+ *
+ * Method Name: globalRelabel
+ *
+ * Purpose: Sets every label to its residual distance to the sink, or
+ * to the node count plus its distance to the source for nodes that
+ * cannot reach the sink, and refills the buckets.
+ *
+ * Preconditions:
+ * - The source and sink are set.
+ *
+ * Postconditions:
+ * - The labels are exact and valid.
+ * - The buckets hold every active node.
+ */
+template <typename Network>
+void PushRelabel<Network>::globalRelabel()
+{
+    int nodes = network.getNodes();
+    std::fill(label.begin(), label.end(), -1);
+    std::vector<int> queue;
+    queue.reserve(nodes);
+
+    // Search backwards from the sink, then from the source
+    label[sink] = 0;
+    label[source] = nodes;
+    for (int root : {sink, source})
+    {
+        queue.assign(1, root);
+        for (size_t front = 0; front < queue.size(); ++front)
+        {
+            int node = queue[front];
+            for (int arc = network.arcBegin(node);
+                 arc < network.arcEnd(node);
+                 ++arc)
+            {
+                int tail = network.getHead(arc);
+                if (label[tail] == -1 &&
+                    network.getResidual(network.getReverse(arc)) > 0)
+                {
+                    label[tail] = label[node] + 1;
+                    queue.push_back(tail);
+                }
+            }
+        }
+    }
+
+    // Rebuild the label lists and the buckets
+    for (std::vector<int> &list : labelNodes)
+    {
+        list.clear();
+    }
+    highestLabel = 0;
+    for (std::vector<int> &bucket : buckets)
+    {
+        bucket.clear();
+    }
+    highestActive = -1;
+    for (int node = 0; node < nodes; ++node)
+    {
+        if (label[node] == -1)
+        {
+            // The node can reach neither terminal
+            label[node] = 2 * nodes;
+        }
+        if (label[node] < nodes)
+        {
+            labelPosition[node] =
+                static_cast<int>(labelNodes[label[node]].size());
+            labelNodes[label[node]].push_back(node);
+            highestLabel = std::max(highestLabel, label[node]);
+        }
+        currentArc[node] = network.arcBegin(node);
+        if (node != source && node != sink && excess[node] > 0)
+        {
+            activate(node);
+        }
+    }
+    relabelsSinceGlobal = 0;
+}
+
+/**
+ * Saturates the source arcs that break the labeling.
+ *
+ * Method Name: saturateSourceArcs
+ *
+ * Purpose: Pushes the full residual capacity of every source arc whose
+ * head is labeled below the source minus one.
+ *
+ * Preconditions:
+ * - The labels of all other nodes are valid.
+ *
+ * Postconditions:
+ * - Every residual source arc is valid.
+ * - Heads that received excess are active.
+ */
+template <typename Network>
+void PushRelabel<Network>::saturateSourceArcs()
+{
+    for (int arc = network.arcBegin(source);
+         arc < network.arcEnd(source);
+         ++arc)
+    {
+        int head = network.getHead(arc);
+        long long amount = network.getResidual(arc);
+        if (amount > 0 && label[source] > label[head] + 1)
+        {
+            network.push(arc, amount);
+            excess[source] -= amount;
+            bool wasActive = excess[head] > 0;
+            excess[head] += amount;
+            if (!wasActive && head != sink && excess[head] > 0)
+            {
+                activate(head);
+            }
+        }
+    }
+}
+
+/**
+ * Discharges active nodes until none is left.
+ *
+ * Method Name: dischargeActiveNodes
+ *
+ * Purpose: Repeatedly discharges the active node with the highest
+ * label, running a global relabel after every node-count relabels.
+ *
+ * Preconditions:
+ * - The labels are valid and the buckets hold the active nodes.
+ *
+ * Postconditions:
+ * - No node other than the source and sink has excess.
+ */
+template <typename Network>
+void PushRelabel<Network>::dischargeActiveNodes()
+{
+    int nodes = network.getNodes();
+    while (highestActive >= 0)
+    {
+        std::vector<int> &bucket = buckets[highestActive];
+        if (bucket.empty())
+        {
+            // No label between the highest label in use and the node
+            // count has an active node
+            highestActive--;
+            if (highestActive < nodes && highestActive > highestLabel)
+            {
+                highestActive = highestLabel;
+            }
+            continue;
+        }
+
+        int node = bucket.back();
+        bucket.pop_back();
+
+        // Skip nodes that were emptied or moved since they were added
+        if (excess[node] <= 0)
+        {
+            continue;
+        }
+        if (label[node] != highestActive)
+        {
+            activate(node);
+            continue;
+        }
+
+        discharge(node);
+
+        // Refresh the labels once they have drifted far enough
+        if (relabelsSinceGlobal > nodes)
+        {
+            globalRelabel();
+        }
+    }
+}
+
+/**
+ * Discharges one node.
+ *
+ * Method Name: discharge
+ *
+ * Purpose: Pushes the excess of the node along admissible arcs,
+ * relabeling it whenever its arcs run out.
+ *
+ * Parameters:
+ * - node: An integer representing the node to discharge.
+ *
+ * Preconditions:
+ * - The node has excess and is not in a bucket.
+ *
+ * Postconditions:
+ * - The node has no excess, or it was relabeled and put back in a
+ *   bucket.
+ */
+template <typename Network>
+void PushRelabel<Network>::discharge(int node)
+{
+    int end = network.arcEnd(node);
+    while (excess[node] > 0)
+    {
+        // Relabel once every arc has been tried
+        if (currentArc[node] == end)
+        {
+            relabel(node);
+            activate(node);
+            return;
+        }
+
+        int arc = currentArc[node];
+        int head = network.getHead(arc);
+        long long residual = network.getResidual(arc);
+        if (residual > 0 && label[node] == label[head] + 1)
+        {
+            // Push as much excess as the arc allows
+            long long amount = std::min(excess[node], residual);
+            network.push(arc, amount);
+            excess[node] -= amount;
+            bool wasActive = excess[head] > 0;
+            excess[head] += amount;
+            if (!wasActive &&
+                head != source &&
+                head != sink &&
+                excess[head] > 0)
+            {
+                activate(head);
+            }
+            if (amount < residual)
+            {
+                // The arc still has room, so keep it current
+                continue;
+            }
+        }
+        ++currentArc[node];
+    }
+}
+
+/**
+ * Relabels one node.
+ *
+ * Method Name: relabel
+ *
+ * Purpose: Raises the label of the node to one more than the lowest
+ * label of a residual neighbor, lifting all nodes above an emptied
+ * label past the node count.
+ *
+ * Parameters:
+ * - node: An integer representing the node to relabel.
+ *
+ * Preconditions:
+ * - The node has no admissible arc.
+ *
+ * Postconditions:
+ * - The label of the node is raised.
+ */
+template <typename Network>
+void PushRelabel<Network>::relabel(int node)
+{
+    int nodes = network.getNodes();
+    int oldLabel = label[node];
+
+    // Find the lowest residual neighbor
+    int newLabel = 2 * nodes;
+    for (int arc = network.arcBegin(node); arc < network.arcEnd(node); ++arc)
+    {
+        if (network.getResidual(arc) > 0)
+        {
+            newLabel = std::min(newLabel, label[network.getHead(arc)] + 1);
+        }
+    }
+
+    setLabel(node, newLabel);
+    currentArc[node] = network.arcBegin(node);
+    relabelsSinceGlobal++;
+
+    // Close a gap if one opened
+    if (oldLabel < nodes && labelNodes[oldLabel].empty())
+    {
+        gap(oldLabel);
+    }
+}
+
+/**
+ * Lifts all nodes above an empty label.
+ *
+ * Method Name: gap
+ *
+ * Purpose: Lifts every node with a label between the empty label and
+ * the node count to the node count, since none of them can reach the
+ * sink, and moves their active nodes along. Only the labels up to the
+ * highest one in use are visited.
+ *
+ * Parameters:
+ * - emptyLabel: The label no node has any more.
+ *
+ * Preconditions:
+ * - No node has the empty label.
+ *
+ * Postconditions:
+ * - The lifted nodes are labeled with the node count.
+ * - No bucket between the empty label and the node count holds a
+ *   node.
+ */
+template <typename Network>
+void PushRelabel<Network>::gap(int emptyLabel)
+{
+    int nodes = network.getNodes();
+    int lifted = highestLabel;
+    for (int level = emptyLabel + 1; level <= lifted; ++level)
+    {
+        for (int node : labelNodes[level])
+        {
+            label[node] = nodes;
+            currentArc[node] = network.arcBegin(node);
+        }
+        labelNodes[level].clear();
+    }
+    highestLabel = emptyLabel - 1;
+
+    // Move the active nodes of the emptied labels to their labels now,
+    // so the search for the highest active node can skip them
+    for (int level = emptyLabel; level <= lifted; ++level)
+    {
+        std::vector<int> moved;
+        moved.swap(buckets[level]);
+        for (int node : moved)
+        {
+            if (node != source && node != sink && excess[node] > 0)
+            {
+                activate(node);
+            }
+        }
+    }
+}
+
+/**
+ * Sets the label of a node.
+ *
+ * Method Name: setLabel
+ *
+ * Purpose: Moves the node from the list of its old label to the list of
+ * the new one, for labels below the node count.
+ *
+ * Parameters:
+ * - node: An integer representing the node.
+ * - value: The new label.
+ *
+ * Preconditions:
+ * - The node is in the list of its label if that is below the node
+ *   count.
+ *
+ * Postconditions:
+ * - The node has the new label and is in its list.
+ */
+template <typename Network>
+void PushRelabel<Network>::setLabel(int node, int value)
+{
+    int nodes = network.getNodes();
+    if (label[node] < nodes)
+    {
+        // Fill the place of the node with the last one of the list
+        std::vector<int> &list = labelNodes[label[node]];
+        int last = list.back();
+        list[labelPosition[node]] = last;
+        labelPosition[last] = labelPosition[node];
+        list.pop_back();
+    }
+    label[node] = value;
+    if (value < nodes)
+    {
+        labelPosition[node] = static_cast<int>(labelNodes[value].size());
+        labelNodes[value].push_back(node);
+        highestLabel = std::max(highestLabel, value);
+    }
+}
+
+/**
+ * Adds a node to the bucket of its label.
+ *
+ * Method Name: activate
+ *
+ * Purpose: Adds a node that just received excess to the bucket of its
+ * label.
+ *
+ * Parameters:
+ * - node: An integer representing the node.
+ *
+ * Preconditions:
+ * - The node has excess and is not in a bucket.
+ *
+ * Postconditions:
+ * - The node is in the bucket of its label.
+ */
+template <typename Network>
+void PushRelabel<Network>::activate(int node)
+{
+    buckets[label[node]].push_back(node);
+    highestActive = std::max(highestActive, label[node]);
+}
+
+/**
+ * Cancels flow that a node sends but no longer receives.
+ *
+ * Method Name: cancelDeficit
+ *
+ * Purpose: Follows the flow leaving a node with negative excess and
+ * lowers it until the deficit is absorbed by the sink or by nodes with
+ * excess.
+ *
+ * Parameters:
+ * - node: An integer representing the node with the deficit.
+ *
+ * Preconditions:
+ * - The node has negative excess.
+ *
+ * Postconditions:
+ * - No node other than the source and sink has negative excess.
+ * - The labels are valid, unless more relabels than nodes were
+ *   counted since the last global relabel.
+ */
+template <typename Network>
+void PushRelabel<Network>::cancelDeficit(int node)
+{
+    std::vector<int> pending(1, node);
+    while (!pending.empty())
+    {
+        int current = pending.back();
+        pending.pop_back();
+
+        // Lower the outgoing flow until the deficit is gone
+        for (int arc = network.arcBegin(current);
+             arc < network.arcEnd(current) && excess[current] < 0;
+             ++arc)
+        {
+            long long flow = network.getFlow(arc);
+            if (flow <= 0)
+            {
+                continue;
+            }
+
+            int head = network.getHead(arc);
+            long long amount = std::min(-excess[current], flow);
+            bool wasSaturated = network.getResidual(arc) <= 0;
+            network.push(network.getReverse(arc), amount);
+            excess[current] += amount;
+            excess[head] -= amount;
+
+            if (wasSaturated && label[current] > label[head] + 1)
+            {
+                lowerLabel(current, label[head] + 1);
+            }
+            if (head != source && head != sink && excess[head] < 0)
+            {
+                pending.push_back(head);
+            }
+        }
+
+        // Conservation guarantees enough outgoing flow
+        if (excess[current] < 0)
+        {
+            std::cerr
+                << "ERROR: Flow conservation is violated."
+                << std::endl;
+            throw std::logic_error("Flow conservation is violated.");
+        }
+    }
+}
+
+/**
+ * Lowers a label and repairs the labels behind it.
+ *
+ * Method Name: lowerLabel
+ *
+ * Purpose: Lowers the label of a node, then lowers every node with a
+ * residual arc into a lowered node to one above it, breadth first,
+ * until the labeling is valid again. Only the nodes whose labels
+ * change are visited, so the cost follows the change and not the size
+ * of the network. Every lowered label counts as a relabel, and the
+ * repair stops once a relabel period is used up.
+ *
+ * Parameters:
+ * - node: An integer representing the node.
+ * - newLabel: The label to lower the node to.
+ *
+ * Preconditions:
+ * - The node is not the source.
+ *
+ * Postconditions:
+ * - The labels are valid, except for source arcs, which
+ *   saturateSourceArcs repairs, unless more relabels than nodes were
+ *   counted since the last global relabel.
+ * - The current arcs of the changed nodes and of the nodes that can
+ *   reach them start over.
+ */
+template <typename Network>
+void PushRelabel<Network>::lowerLabel(int node, int newLabel)
+{
+    int nodes = network.getNodes();
+    std::vector<int> pending;
+    auto lower = [&](int target, int value)
+    {
+        setLabel(target, value);
+        relabelsSinceGlobal++;
+        pending.push_back(target);
+    };
+
+    // Go breadth first, so every node is lowered at most once
+    if (newLabel < label[node])
+    {
+        lower(node, newLabel);
+    }
+    for (size_t front = 0; front < pending.size(); ++front)
+    {
+        // Past a relabel period the caller relabels globally instead
+        if (relabelsSinceGlobal > nodes)
+        {
+            return;
+        }
+        int current = pending[front];
+        int above = label[current] + 1;
+        int end = network.arcEnd(current);
+        currentArc[current] = network.arcBegin(current);
+
+        // Every node with a residual arc into the node may now be too
+        // high or have a new admissible arc
+        for (int arc = network.arcBegin(current); arc < end; ++arc)
+        {
+            int tail = network.getHead(arc);
+            if (tail == source ||
+                network.getResidual(network.getReverse(arc)) <= 0)
+            {
+                continue;
+            }
+            if (label[tail] > above)
+            {
+                lower(tail, above);
+            }
+            else if (label[tail] == above)
+            {
+                // The arc into the node is admissible again
+                currentArc[tail] = network.arcBegin(tail);
+            }
+        }
+    }
+}
+
+// The engine over the owned network and over caller arrays
+template class PushRelabel<FlowNetwork>;
+template class PushRelabel<CsrNetworkView>;
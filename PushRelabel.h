@@ -0,0 +1,431 @@
+/*
+ * File: PushRelabel.h Author: Nicolas Gioanni Purpose: Declaration of
+ * the PushRelabel class for calculating maximum flow with the
+ * highest-label push-relabel algorithm, and for re-solving after
+ * capacity changes without starting over.
+ *
+ * Functionality/Features:
+ * - Declare methods for calculating the maximum flow.
+ * - Declare methods for applying capacity changes to a solved
+ *   network and re-optimizing from the previous flow.
+ * - Declare methods for reading the flow value and the source side
+ *   of a minimum cut.
+ *
+ * Assumptions:
+ * - The network is a FlowNetwork, a CsrNetworkView over caller
+ *   arrays, or any type with the same arc methods, and its arcs are
+ *   paired with reverse arcs.
+ * - The class is a template over the network, defined in
+ *   PushRelabel.cpp for FlowNetwork and CsrNetworkView.
+ * - Capacities are integers, so the algorithm terminates.
+ */
+
+#ifndef PUSHRELABEL_H
+#define PUSHRELABEL_H
+
+#include "CsrNetworkView.h"
+#include "FlowNetwork.h"
+#include <vector>
+
+// A new capacity for the arc between two nodes
+struct CapacityChange
+{
+    // The node the arc leaves
+    int tail;
+
+    // The node the arc enters
+    int head;
+
+    // The new capacity of the arc
+    long long capacity;
+};
+
+template <typename Network = FlowNetwork>
+class PushRelabel
+{
+public:
+    /**
+     * Constructor for the PushRelabel class.
+     *
+     * Method Name: PushRelabel
+     *
+     * Purpose: Initializes a new instance of the PushRelabel class.
+     *
+     * Parameters:
+     * - network: A reference to the network to solve. The solver
+     *   keeps the flow in the network.
+     *
+     * Preconditions:
+     * - The network is built.
+     *
+     * Postconditions:
+     * - A new instance of the PushRelabel class is created.
+     * - The label, excess and bucket vectors are sized.
+     */
+    PushRelabel(Network &network);
+
+    /**
+     * Calculates the maximum flow in the flow network.
+     *
+     * Method Name: calculateMaxFlow
+     *
+     * Purpose: Removes any previous flow and calculates the maximum
+     * flow from the source to the sink node.
+     *
+     * Parameters:
+     * - source: An integer representing the source node.
+     * - sink: An integer representing the sink node.
+     *
+     * Returns: The value of the maximum flow.
+     *
+     * Preconditions:
+     * - The source and sink nodes are within the valid range.
+     *
+     * Postconditions:
+     * - The network carries a maximum flow.
+     * - The labels are kept for later re-solves.
+     * - An exception is thrown if the calculation process fails.
+     */
+    long long calculateMaxFlow(int source, int sink);
+
+    /**
+     * Applies capacity changes and re-optimizes the flow.
+     *
+     * Method Name: applyCapacityChanges
+     *
+     * Purpose: Changes the capacities of the given arcs of a solved
+     * network. Flow above a lowered capacity is pushed back: the
+     * tail keeps it as excess and the missing inflow at the head is
+     * cancelled along the flow leaving it. The excess is then
+     * discharged with the labels of the previous solve; a new
+     * residual arc that breaks them only lowers the labels of the
+     * nodes behind it, until the repairs use up a relabel period and a
+     * global relabel takes over.
+     *
+     * Parameters:
+     * - changes: A constant reference to the capacity changes.
+     *
+     * Returns: The value of the new maximum flow.
+     *
+     * Preconditions:
+     * - calculateMaxFlow was called.
+     * - Every changed arc exists in the network.
+     *
+     * Postconditions:
+     * - The network carries a maximum flow for the new capacities.
+     * - An exception is thrown if a change is invalid.
+     */
+    long long applyCapacityChanges(
+        const std::vector<CapacityChange> &changes);
+
+    /**
+     * Applies capacity changes given by arc index and re-optimizes.
+     *
+     * Method Name: applyArcCapacityChanges
+     *
+     * Purpose: Works like applyCapacityChanges, but takes the arcs by
+     * their index in the network so callers that change the same arcs
+     * repeatedly do not have to look them up every time.
+     *
+     * Parameters:
+     * - arcs: A constant reference to the indices of the changed arcs.
+     * - capacities: A constant reference to the new capacities, one
+     *   per changed arc.
+     *
+     * Returns: The value of the new maximum flow.
+     *
+     * Preconditions:
+     * - calculateMaxFlow was called.
+     * - Both vectors have the same length.
+     *
+     * Postconditions:
+     * - The network carries a maximum flow for the new capacities.
+     * - An exception is thrown if a change is invalid.
+     */
+    long long applyArcCapacityChanges(
+        const std::vector<int> &arcs,
+        const std::vector<long long> &capacities);
+
+    /**
+     * Get the value of the current flow.
+     *
+     * Method Name: getFlowValue
+     *
+     * Purpose: Returns the flow that reaches the sink.
+     *
+     * Preconditions:
+     * - calculateMaxFlow was called.
+     *
+     * Postconditions:
+     * - The flow value is returned.
+     *
+     * Returns: The value of the current flow.
+     */
+    long long getFlowValue() const;
+
+    /**
+     * Get the source side of a minimum cut.
+     *
+     * Method Name: getSourceSide
+     *
+     * Purpose: Returns the nodes reachable from the source in the
+     * residual network, which is the smallest source side of a
+     * minimum cut.
+     *
+     * Preconditions:
+     * - calculateMaxFlow was called.
+     *
+     * Postconditions:
+     * - The source side is returned.
+     *
+     * Returns: A vector with true for every node on the source side.
+     */
+    std::vector<bool> getSourceSide() const;
+
+private:
+    // The network holding the flow
+    Network &network;
+
+    // The source node of the last solve
+    int source;
+
+    // The sink node of the last solve
+    int sink;
+
+    // True once calculateMaxFlow has finished
+    bool solved;
+
+    // The distance label of every node
+    std::vector<int> label;
+
+    // The flow into every node minus the flow out of it
+    std::vector<long long> excess;
+
+    // The next arc to try from every node
+    std::vector<int> currentArc;
+
+    // The active nodes of every label
+    std::vector<std::vector<int>> buckets;
+
+    // The nodes with every label below the node count
+    std::vector<std::vector<int>> labelNodes;
+
+    // The position of every node in the list of its label
+    std::vector<int> labelPosition;
+
+    // No node is labeled above this label and below the node count
+    int highestLabel;
+
+    // The highest label that may have an active node
+    int highestActive;
+
+    // The number of relabels since the last global relabel
+    int relabelsSinceGlobal;
+
+    /**
+     * Recomputes all labels as residual distances.
+     *
+     * Method Name: globalRelabel
+     *
+     * Purpose: Sets every label to its residual distance to the sink,
+     * or to the node count plus its distance to the source for nodes
+     * that cannot reach the sink, and refills the buckets.
+     *
+     * Preconditions:
+     * - The source and sink are set.
+     *
+     * Postconditions:
+     * - The labels are exact and valid.
+     * - The buckets hold every active node.
+     */
+    void globalRelabel();
+
+    /**
+     * Saturates the source arcs that break the labeling.
+     *
+     * Method Name: saturateSourceArcs
+     *
+     * Purpose: Pushes the full residual capacity of every source arc
+     * whose head is labeled below the source minus one.
+     *
+     * Preconditions:
+     * - The labels of all other nodes are valid.
+     *
+     * Postconditions:
+     * - Every residual source arc is valid.
+     * - Heads that received excess are active.
+     */
+    void saturateSourceArcs();
+
+    /**
+     * Discharges active nodes until none is left.
+     *
+     * Method Name: dischargeActiveNodes
+     *
+     * Purpose: Repeatedly discharges the active node with the highest
+     * label, running a global relabel after every node-count
+     * relabels.
+     *
+     * Preconditions:
+     * - The labels are valid and the buckets hold the active nodes.
+     *
+     * Postconditions:
+     * - No node other than the source and sink has excess.
+     */
+    void dischargeActiveNodes();
+
+    /**
+     * Discharges one node.
+     *
+     * Method Name: discharge
+     *
+     * Purpose: Pushes the excess of the node along admissible arcs,
+     * relabeling it whenever its arcs run out.
+     *
+     * Parameters:
+     * - node: An integer representing the node to discharge.
+     *
+     * Preconditions:
+     * - The node has excess and is not in a bucket.
+     *
+     * Postconditions:
+     * - The node has no excess, or it was relabeled and put back in
+     *   a bucket.
+     */
+    void discharge(int node);
+
+    /**
+     * Relabels one node.
+     *
+     * Method Name: relabel
+     *
+     * Purpose: Raises the label of the node to one more than the
+     * lowest label of a residual neighbor, lifting all nodes above an
+     * emptied label past the node count.
+     *
+     * Parameters:
+     * - node: An integer representing the node to relabel.
+     *
+     * Preconditions:
+     * - The node has no admissible arc.
+     *
+     * Postconditions:
+     * - The label of the node is raised.
+     */
+    void relabel(int node);
+
+    /**
+     * Lifts all nodes above an empty label.
+     *
+     * Method Name: gap
+     *
+     * Purpose: Lifts every node with a label between the empty label
+     * and the node count to the node count, since none of them can
+     * reach the sink, and moves their active nodes along. Only the
+     * labels up to the highest one in use are visited.
+     *
+     * Parameters:
+     * - emptyLabel: The label no node has any more.
+     *
+     * Preconditions:
+     * - No node has the empty label.
+     *
+     * Postconditions:
+     * - The lifted nodes are labeled with the node count.
+     * - No bucket between the empty label and the node count holds a
+     *   node.
+     */
+    void gap(int emptyLabel);
+
+    /**
+     * Sets the label of a node.
+     *
+     * Method Name: setLabel
+     *
+     * Purpose: Moves the node from the list of its old label to the
+     * list of the new one, for labels below the node count.
+     *
+     * Parameters:
+     * - node: An integer representing the node.
+     * - value: The new label.
+     *
+     * Preconditions:
+     * - The node is in the list of its label if that is below the node
+     *   count.
+     *
+     * Postconditions:
+     * - The node has the new label and is in its list.
+     */
+    void setLabel(int node, int value);
+
+    /**
+     * Adds a node to the bucket of its label.
+     *
+     * Method Name: activate
+     *
+     * Purpose: Adds a node that just received excess to the bucket of
+     * its label.
+     *
+     * Parameters:
+     * - node: An integer representing the node.
+     *
+     * Preconditions:
+     * - The node has excess and is not in a bucket.
+     *
+     * Postconditions:
+     * - The node is in the bucket of its label.
+     */
+    void activate(int node);
+
+    /**
+     * Cancels flow that a node sends but no longer receives.
+     *
+     * Method Name: cancelDeficit
+     *
+     * Purpose: Follows the flow leaving a node with negative excess
+     * and lowers it until the deficit is absorbed by the sink or by
+     * nodes with excess.
+     *
+     * Parameters:
+     * - node: An integer representing the node with the deficit.
+     *
+     * Preconditions:
+     * - The node has negative excess.
+     *
+     * Postconditions:
+     * - No node other than the source and sink has negative excess.
+     * - The labels are valid, unless more relabels than nodes were
+     *   counted since the last global relabel.
+     */
+    void cancelDeficit(int node);
+
+    /**
+     * Lowers a label and repairs the labels behind it.
+     *
+     * Method Name: lowerLabel
+     *
+     * Purpose: Lowers the label of a node, then lowers every node with
+     * a residual arc into a lowered node to one above it, breadth
+     * first, until the labeling is valid again. Only the nodes whose
+     * labels change are visited, so the cost follows the change and not
+     * the size of the network. Every lowered label counts as a relabel,
+     * and the repair stops once a relabel period is used up.
+     *
+     * Parameters:
+     * - node: An integer representing the node.
+     * - newLabel: The label to lower the node to.
+     *
+     * Preconditions:
+     * - The node is not the source.
+     *
+     * Postconditions:
+     * - The labels are valid, except for source arcs, which
+     *   saturateSourceArcs repairs, unless more relabels than nodes
+     *   were counted since the last global relabel.
+     * - The current arcs of the changed nodes and of the nodes that
+     *   can reach them start over.
+     */
+    void lowerLabel(int node, int newLabel);
+};
+
+#endif
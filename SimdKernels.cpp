@@ -0,0 +1,793 @@
+/*
+ * File: SimdKernels.cpp Author: Nicolas Gioanni Purpose: Implementation
+ * of the SimdKernels class, providing one version of every kernel per
+ * instruction set and the table that selects between them.
+ *
+ * Functionality/Features:
+ * - Compile the SSE4.2, AVX2 and AVX-512 versions with function target
+ *   attributes, so the rest of the program needs no special flags.
+ * - Pick the table once with __builtin_cpu_supports and keep it in an
+ *   atomic pointer, so every call costs one indirect jump.
+ * - Reduce field products with the Mersenne shift-and-add identity on
+ *   64-bit lanes and finish with an unsigned minimum.
+ * - Write the batch matching once on GCC vector types and inline it into
+ *   every level, so each level builds it from its own instructions.
+ *
+ * Assumptions:
+ * - The vector versions handle whole vectors and leave the remainder
+ *   to the portable loops.
+ */
+
+#include "SimdKernels.h"
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_KERNELS_X86 1
+#include <immintrin.h>
+#else
+#define SIMD_KERNELS_X86 0
+#endif
+
+namespace
+{
+    // The Mersenne prime 2^31 - 1, the order of the field
+    const std::uint32_t fieldPrime = 0x7fffffffU;
+
+    // The kernels of one level
+    struct KernelTable
+    {
+        // The level of the kernels
+        int level;
+
+        // The row union kernel
+        void (*orWords)(std::uint64_t *, const std::uint64_t *, int);
+
+        // The common word search kernel
+        int (*findCommonWord)(const std::uint64_t *,
+                              const std::uint64_t *,
+                              int,
+                              int);
+
+        // The field row update kernel
+        void (*addScaledRow)(std::uint32_t *,
+                             const std::uint32_t *,
+                             std::uint32_t,
+                             int);
+
+        // The batch matching kernel
+        void (*matchBatch)(const std::uint32_t *, std::uint32_t *);
+    };
+
+    // Four, eight and sixteen graphs of a batch, one 32-bit word each
+    typedef std::uint32_t LaneWord4 __attribute__((vector_size(16)));
+    typedef std::uint32_t LaneWord8 __attribute__((vector_size(32)));
+    typedef std::uint32_t LaneWord16 __attribute__((vector_size(64)));
+
+    // Returns true if some lane of a vector is nonzero
+    template <typename LaneWord>
+    __attribute__((always_inline)) inline bool anyLane(const LaneWord &word)
+    {
+        std::uint64_t halves[sizeof(LaneWord) / 8];
+        std::memcpy(halves, &word, sizeof(LaneWord));
+        std::uint64_t any = 0;
+        for (std::uint64_t half : halves)
+        {
+            any |= half;
+        }
+        return any != 0;
+    }
+
+    // Lane-parallel matching of one vector of graphs of a batch, inlined
+    // into every level so the vectors use the instructions of that level
+    template <typename LaneWord>
+    __attribute__((always_inline)) inline void
+    matchLanes(const std::uint32_t *rows, std::uint32_t *leftMates)
+    {
+        const int nodes = SimdKernels::BATCH_NODES;
+        const int stride = SimdKernels::BATCH_LANES;
+        const LaneWord zero = {};
+        LaneWord row[nodes];
+        LaneWord leftMate[nodes];
+        LaneWord reached[nodes];
+        for (int node = 0; node < nodes; ++node)
+        {
+            std::memcpy(&row[node], rows + node * stride, sizeof(LaneWord));
+        }
+
+        // Match every left node to its lowest free neighbor
+        LaneWord freeRight = zero + ((1U << nodes) - 1);
+        for (int left = 0; left < nodes; ++left)
+        {
+            LaneWord open = row[left] & freeRight;
+            leftMate[left] = open & -open;
+            freeRight &= ~leftMate[left];
+        }
+
+        // Every round grows each graph by one path until none is left
+        for (int round = 0; round < nodes; ++round)
+        {
+            LaneWord frontier = zero;
+            for (int left = 0; left < nodes; ++left)
+            {
+                frontier |= (LaneWord)(leftMate[left] == zero) &
+                            (LaneWord)(row[left] != zero) & (1U << left);
+                reached[left] = zero;
+            }
+
+            // Search breadth first in every graph until a free right
+            // node is reached; every right node remembers the one left
+            // node that reached it first
+            LaneWord visited = zero;
+            LaneWord found = zero;
+            LaneWord active = (LaneWord)(frontier != zero);
+            int levels = 0;
+            while (levels < nodes && anyLane(active))
+            {
+                LaneWord seen = visited;
+                for (int left = 0; left < nodes; ++left)
+                {
+                    LaneWord at = active &
+                                  (LaneWord)((frontier & (1U << left)) != zero);
+                    reached[left] |= at & row[left] & ~visited;
+                    visited |= reached[left];
+                }
+                LaneWord fresh = visited & ~seen;
+                LaneWord next = zero;
+                for (int left = 0; left < nodes; ++left)
+                {
+                    next |= (LaneWord)((leftMate[left] & fresh) != zero) &
+                            (1U << left);
+                }
+                LaneWord open = fresh & freeRight;
+                found |= open & -open;
+                active &= (LaneWord)(found == zero) &
+                          (LaneWord)(next != zero);
+                frontier = next;
+                ++levels;
+            }
+            if (!anyLane(found))
+            {
+                break;
+            }
+
+            // Flip the matching along the path back from the free node
+            freeRight &= ~found;
+            LaneWord current = found;
+            for (int step = 0; step < levels; ++step)
+            {
+                LaneWord previous = zero;
+                for (int left = 0; left < nodes; ++left)
+                {
+                    LaneWord at =
+                        (LaneWord)((reached[left] & current) != zero);
+                    previous |= at & leftMate[left];
+                    leftMate[left] = (leftMate[left] & ~at) | (current & at);
+                }
+                current = previous;
+            }
+        }
+
+        for (int node = 0; node < nodes; ++node)
+        {
+            std::memcpy(leftMates + node * stride, &leftMate[node],
+                        sizeof(LaneWord));
+        }
+    }
+
+    // Matches a whole batch one vector of graphs at a time
+    template <typename LaneWord>
+    __attribute__((always_inline)) inline void
+    matchBatchBody(const std::uint32_t *rows, std::uint32_t *leftMates)
+    {
+        const int width = sizeof(LaneWord) / 4;
+        for (int lane = 0; lane < SimdKernels::BATCH_LANES; lane += width)
+        {
+            matchLanes<LaneWord>(rows + lane, leftMates + lane);
+        }
+    }
+
+    // Portable row union
+    void orWordsGeneric(std::uint64_t *target,
+                        const std::uint64_t *source,
+                        int count)
+    {
+        for (int k = 0; k < count; ++k)
+        {
+            target[k] |= source[k];
+        }
+    }
+
+    // Portable common word search
+    int findCommonWordGeneric(const std::uint64_t *first,
+                              const std::uint64_t *second,
+                              int from,
+                              int count)
+    {
+        while (from < count && (first[from] & second[from]) == 0)
+        {
+            ++from;
+        }
+        return from;
+    }
+
+    // Portable field row update
+    void addScaledRowGeneric(std::uint32_t *target,
+                             const std::uint32_t *source,
+                             std::uint32_t factor,
+                             int count)
+    {
+        for (int k = 0; k < count; ++k)
+        {
+            std::uint64_t product = static_cast<std::uint64_t>(factor) *
+                                    source[k];
+            std::uint64_t folded = (product & fieldPrime) + (product >> 31);
+            std::uint32_t reduced = static_cast<std::uint32_t>(
+                folded >= fieldPrime ? folded - fieldPrime : folded);
+            std::uint32_t sum = target[k] + reduced;
+            target[k] = sum >= fieldPrime ? sum - fieldPrime : sum;
+        }
+    }
+
+    // Portable batch matching, four graphs per vector
+    void matchBatchGeneric(const std::uint32_t *rows,
+                           std::uint32_t *leftMates)
+    {
+        matchBatchBody<LaneWord4>(rows, leftMates);
+    }
+
+    const KernelTable genericTable = {SimdKernels::GENERIC,
+                                      orWordsGeneric,
+                                      findCommonWordGeneric,
+                                      addScaledRowGeneric,
+                                      matchBatchGeneric};
+
+#if SIMD_KERNELS_X86
+    // SSE4.2 batch matching, four graphs per vector
+    __attribute__((target("sse4.2"))) void
+    matchBatchSse42(const std::uint32_t *rows,
+                    std::uint32_t *leftMates)
+    {
+        matchBatchBody<LaneWord4>(rows, leftMates);
+    }
+
+    // AVX2 batch matching, eight graphs per vector
+    __attribute__((target("avx2"))) void
+    matchBatchAvx2(const std::uint32_t *rows,
+                   std::uint32_t *leftMates)
+    {
+        matchBatchBody<LaneWord8>(rows, leftMates);
+    }
+
+    // AVX-512 batch matching, sixteen graphs per vector
+    __attribute__((target("avx512f"))) void
+    matchBatchAvx512(const std::uint32_t *rows,
+                     std::uint32_t *leftMates)
+    {
+        matchBatchBody<LaneWord16>(rows, leftMates);
+    }
+
+    // SSE4.2 row union, two words per step
+    __attribute__((target("sse4.2"))) void
+    orWordsSse42(std::uint64_t *target, const std::uint64_t *source,
+                 int count)
+    {
+        int k = 0;
+        for (; k + 2 <= count; k += 2)
+        {
+            __m128i *out = reinterpret_cast<__m128i *>(target + k);
+            __m128i in = _mm_loadu_si128(
+                reinterpret_cast<const __m128i *>(source + k));
+            _mm_storeu_si128(out, _mm_or_si128(_mm_loadu_si128(out), in));
+        }
+        orWordsGeneric(target + k, source + k, count - k);
+    }
+
+    // SSE4.2 common word search, two words per test
+    __attribute__((target("sse4.2"))) int
+    findCommonWordSse42(const std::uint64_t *first,
+                        const std::uint64_t *second,
+                        int from,
+                        int count)
+    {
+        for (; from + 2 <= count; from += 2)
+        {
+            __m128i a = _mm_loadu_si128(
+                reinterpret_cast<const __m128i *>(first + from));
+            __m128i b = _mm_loadu_si128(
+                reinterpret_cast<const __m128i *>(second + from));
+            if (!_mm_testz_si128(a, b))
+            {
+                break;
+            }
+        }
+        return findCommonWordGeneric(first, second, from, count);
+    }
+
+    // SSE4.2 field row update, four elements per step
+    __attribute__((target("sse4.2"))) void
+    addScaledRowSse42(std::uint32_t *target,
+                      const std::uint32_t *source,
+                      std::uint32_t factor,
+                      int count)
+    {
+        const __m128i prime = _mm_set1_epi32(static_cast<int>(fieldPrime));
+        const __m128i low = _mm_set1_epi64x(fieldPrime);
+        const __m128i scale = _mm_set1_epi64x(factor);
+        int k = 0;
+        for (; k + 4 <= count; k += 4)
+        {
+            __m128i in = _mm_loadu_si128(
+                reinterpret_cast<const __m128i *>(source + k));
+
+            // Even lanes in place, odd lanes shifted down to even
+            __m128i even = _mm_mul_epu32(in, scale);
+            __m128i odd = _mm_mul_epu32(_mm_srli_epi64(in, 32), scale);
+            even = _mm_add_epi64(_mm_and_si128(even, low),
+                                 _mm_srli_epi64(even, 31));
+            odd = _mm_add_epi64(_mm_and_si128(odd, low),
+                                _mm_srli_epi64(odd, 31));
+            __m128i product = _mm_or_si128(even, _mm_slli_epi64(odd, 32));
+            product = _mm_min_epu32(product, _mm_sub_epi32(product, prime));
+
+            __m128i *out = reinterpret_cast<__m128i *>(target + k);
+            __m128i sum = _mm_add_epi32(_mm_loadu_si128(out), product);
+            _mm_storeu_si128(out,
+                             _mm_min_epu32(sum, _mm_sub_epi32(sum, prime)));
+        }
+        addScaledRowGeneric(target + k, source + k, factor, count - k);
+    }
+
+    // AVX2 row union, four words per step
+    __attribute__((target("avx2"))) void
+    orWordsAvx2(std::uint64_t *target, const std::uint64_t *source,
+                int count)
+    {
+        int k = 0;
+        for (; k + 4 <= count; k += 4)
+        {
+            __m256i *out = reinterpret_cast<__m256i *>(target + k);
+            __m256i in = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i *>(source + k));
+            _mm256_storeu_si256(out,
+                                _mm256_or_si256(_mm256_loadu_si256(out), in));
+        }
+        orWordsGeneric(target + k, source + k, count - k);
+    }
+
+    // AVX2 common word search, four words per test
+    __attribute__((target("avx2"))) int
+    findCommonWordAvx2(const std::uint64_t *first,
+                       const std::uint64_t *second,
+                       int from,
+                       int count)
+    {
+        for (; from + 4 <= count; from += 4)
+        {
+            __m256i a = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i *>(first + from));
+            __m256i b = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i *>(second + from));
+            if (!_mm256_testz_si256(a, b))
+            {
+                break;
+            }
+        }
+        return findCommonWordGeneric(first, second, from, count);
+    }
+
+    // AVX2 field row update, eight elements per step
+    __attribute__((target("avx2"))) void
+    addScaledRowAvx2(std::uint32_t *target,
+                     const std::uint32_t *source,
+                     std::uint32_t factor,
+                     int count)
+    {
+        const __m256i prime =
+            _mm256_set1_epi32(static_cast<int>(fieldPrime));
+        const __m256i low = _mm256_set1_epi64x(fieldPrime);
+        const __m256i scale = _mm256_set1_epi64x(factor);
+        int k = 0;
+        for (; k + 8 <= count; k += 8)
+        {
+            __m256i in = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i *>(source + k));
+
+            // Even lanes in place, odd lanes shifted down to even
+            __m256i even = _mm256_mul_epu32(in, scale);
+            __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(in, 32), scale);
+            even = _mm256_add_epi64(_mm256_and_si256(even, low),
+                                    _mm256_srli_epi64(even, 31));
+            odd = _mm256_add_epi64(_mm256_and_si256(odd, low),
+                                   _mm256_srli_epi64(odd, 31));
+            __m256i product =
+                _mm256_or_si256(even, _mm256_slli_epi64(odd, 32));
+            product = _mm256_min_epu32(product,
+                                       _mm256_sub_epi32(product, prime));
+
+            __m256i *out = reinterpret_cast<__m256i *>(target + k);
+            __m256i sum = _mm256_add_epi32(_mm256_loadu_si256(out), product);
+            _mm256_storeu_si256(
+                out, _mm256_min_epu32(sum, _mm256_sub_epi32(sum, prime)));
+        }
+        addScaledRowGeneric(target + k, source + k, factor, count - k);
+    }
+
+    // Older GCC headers build the AVX-512 intrinsics on a
+    // self-initialized undefined vector, which -Wmaybe-uninitialized
+    // reports wrongly
+#if !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+    // AVX-512 row union, eight words per step
+    __attribute__((target("avx512f"))) void
+    orWordsAvx512(std::uint64_t *target, const std::uint64_t *source,
+                  int count)
+    {
+        int k = 0;
+        for (; k + 8 <= count; k += 8)
+        {
+            __m512i in = _mm512_loadu_si512(source + k);
+            _mm512_storeu_si512(
+                target + k, _mm512_or_si512(_mm512_loadu_si512(target + k),
+                                            in));
+        }
+        orWordsGeneric(target + k, source + k, count - k);
+    }
+
+    // AVX-512 common word search, eight words per test
+    __attribute__((target("avx512f"))) int
+    findCommonWordAvx512(const std::uint64_t *first,
+                         const std::uint64_t *second,
+                         int from,
+                         int count)
+    {
+        for (; from + 8 <= count; from += 8)
+        {
+            __m512i a = _mm512_loadu_si512(first + from);
+            __m512i b = _mm512_loadu_si512(second + from);
+            __mmask8 common = _mm512_test_epi64_mask(a, b);
+            if (common != 0)
+            {
+                return from + __builtin_ctz(common);
+            }
+        }
+        return findCommonWordGeneric(first, second, from, count);
+    }
+
+    // AVX-512 field row update, sixteen elements per step
+    __attribute__((target("avx512f"))) void
+    addScaledRowAvx512(std::uint32_t *target,
+                       const std::uint32_t *source,
+                       std::uint32_t factor,
+                       int count)
+    {
+        const __m512i prime =
+            _mm512_set1_epi32(static_cast<int>(fieldPrime));
+        const __m512i low = _mm512_set1_epi64(fieldPrime);
+        const __m512i scale = _mm512_set1_epi64(factor);
+        int k = 0;
+        for (; k + 16 <= count; k += 16)
+        {
+            __m512i in = _mm512_loadu_si512(source + k);
+
+            // Even lanes in place, odd lanes shifted down to even
+            __m512i even = _mm512_mul_epu32(in, scale);
+            __m512i odd = _mm512_mul_epu32(_mm512_srli_epi64(in, 32), scale);
+            even = _mm512_add_epi64(_mm512_and_si512(even, low),
+                                    _mm512_srli_epi64(even, 31));
+            odd = _mm512_add_epi64(_mm512_and_si512(odd, low),
+                                   _mm512_srli_epi64(odd, 31));
+            __m512i product =
+                _mm512_or_si512(even, _mm512_slli_epi64(odd, 32));
+            product = _mm512_min_epu32(product,
+                                       _mm512_sub_epi32(product, prime));
+
+            __m512i sum =
+                _mm512_add_epi32(_mm512_loadu_si512(target + k), product);
+            _mm512_storeu_si512(
+                target + k,
+                _mm512_min_epu32(sum, _mm512_sub_epi32(sum, prime)));
+        }
+        addScaledRowGeneric(target + k, source + k, factor, count - k);
+    }
+
+#if !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+    const KernelTable sse42Table = {SimdKernels::SSE42,
+                                    orWordsSse42,
+                                    findCommonWordSse42,
+                                    addScaledRowSse42,
+                                    matchBatchSse42};
+
+    const KernelTable avx2Table = {SimdKernels::AVX2,
+                                   orWordsAvx2,
+                                   findCommonWordAvx2,
+                                   addScaledRowAvx2,
+                                   matchBatchAvx2};
+
+    const KernelTable avx512Table = {SimdKernels::AVX512,
+                                     orWordsAvx512,
+                                     findCommonWordAvx512,
+                                     addScaledRowAvx512,
+                                     matchBatchAvx512};
+#endif
+
+    // Returns the table of a level
+    const KernelTable *tableOf(int level)
+    {
+#if SIMD_KERNELS_X86
+        switch (level)
+        {
+        case SimdKernels::SSE42:
+            return &sse42Table;
+        case SimdKernels::AVX2:
+            return &avx2Table;
+        case SimdKernels::AVX512:
+            return &avx512Table;
+        default:
+            break;
+        }
+#else
+        (void)level;
+#endif
+        return &genericTable;
+    }
+
+    // The table in use, chosen on the first call
+    std::atomic<const KernelTable *> activeTable(nullptr);
+
+    // Returns the table in use
+    const KernelTable *active()
+    {
+        const KernelTable *table = activeTable.load(std::memory_order_acquire);
+        if (table == nullptr)
+        {
+            table = tableOf(SimdKernels::detectLevel());
+            activeTable.store(table, std::memory_order_release);
+        }
+        return table;
+    }
+}
+
+/**
+ * ORs a row of words into another.
+ *
+ * Method Name: orWords
+ *
+ * Purpose: Sets target[k] to target[k] | source[k] for every word.
+ *
+ * Parameters:
+ * - target: A pointer to the words to update.
+ * - source: A pointer to the words to add.
+ * - count: The number of words.
+ *
+ * Preconditions:
+ * - Both rows hold count words.
+ *
+ * Postconditions:
+ * - The target holds the union.
+ */
+void SimdKernels::orWords(std::uint64_t *target,
+                          const std::uint64_t *source,
+                          int count)
+{
+    active()->orWords(target, source, count);
+}
+
+/**
+ * Finds the first word two rows have in common.
+ *
+ * Method Name: findCommonWord
+ *
+ * Purpose: Scans from a start word for the first k where first[k] &
+ * second[k] is nonzero.
+ *
+ * Parameters:
+ * - first: A pointer to the first row.
+ * - second: A pointer to the second row.
+ * - from: The word to start at.
+ * - count: The number of words in a row.
+ *
+ * Returns: The index of the word, count if there is none.
+ *
+ * Preconditions:
+ * - Both rows hold count words.
+ *
+ * Postconditions:
+ * - The index is returned.
+ */
+int SimdKernels::findCommonWord(const std::uint64_t *first,
+                                const std::uint64_t *second,
+                                int from,
+                                int count)
+{
+    return active()->findCommonWord(first, second, from, count);
+}
+
+/**
+ * Adds a multiple of a row over the Mersenne field.
+ *
+ * Method Name: addScaledRow
+ *
+ * Purpose: Sets target[k] to target[k] + factor * source[k] modulo
+ * 2^31 - 1 for every element.
+ *
+ * Parameters:
+ * - target: A pointer to the elements to update.
+ * - source: A pointer to the elements to add.
+ * - factor: The multiple, below 2^31 - 1.
+ * - count: The number of elements.
+ *
+ * Preconditions:
+ * - Every element is below 2^31 - 1.
+ *
+ * Postconditions:
+ * - Every target element is below 2^31 - 1.
+ */
+void SimdKernels::addScaledRow(std::uint32_t *target,
+                               const std::uint32_t *source,
+                               std::uint32_t factor,
+                               int count)
+{
+    active()->addScaledRow(target, source, factor, count);
+}
+
+/**
+ * Matches a batch of tiny graphs.
+ *
+ * Method Name: matchBatch
+ *
+ * Purpose: Calculates a maximum matching of every graph of a batch in
+ * lockstep. Every array holds BATCH_NODES rows of BATCH_LANES words,
+ * and word lane of row node belongs to graph lane.
+ *
+ * Parameters:
+ * - rows: A pointer to the right neighbors of every left node as a mask.
+ * - leftMates: A pointer to the right partner of every left node as a
+ *   one-bit mask, 0 for a free node.
+ *
+ * Preconditions:
+ * - Every row mask is below 2^BATCH_NODES.
+ *
+ * Postconditions:
+ * - The left partners describe a maximum matching of every graph.
+ */
+void SimdKernels::matchBatch(const std::uint32_t *rows,
+                             std::uint32_t *leftMates)
+{
+    active()->matchBatch(rows, leftMates);
+}
+
+/**
+ * Get the level of the kernels in use.
+ *
+ * Method Name: getLevel
+ *
+ * Purpose: Returns the forced level, or the detected level if none was
+ * forced.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The level is returned.
+ *
+ * Returns: One of GENERIC, SSE42, AVX2 and AVX512.
+ */
+int SimdKernels::getLevel()
+{
+    return active()->level;
+}
+
+/**
+ * Detects the widest supported level.
+ *
+ * Method Name: detectLevel
+ *
+ * Purpose: Asks the processor through CPUID which of the compiled levels
+ * it can run.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The level is returned.
+ *
+ * Returns: The widest level the processor supports.
+ */
+int SimdKernels::detectLevel()
+{
+#if SIMD_KERNELS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+    {
+        return AVX512;
+    }
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return AVX2;
+    }
+    if (__builtin_cpu_supports("sse4.2"))
+    {
+        return SSE42;
+    }
+#endif
+    return GENERIC;
+}
+
+/**
+ * Forces the kernels to a level.
+ *
+ * Method Name: forceLevel
+ *
+ * Purpose: Selects the kernels of a level for every later call, so the
+ * levels can be compared in one binary.
+ *
+ * Parameters:
+ * - level: The level to use, or -1 to go back to the detected one.
+ *
+ * Preconditions:
+ * - No kernel is running on another thread.
+ *
+ * Postconditions:
+ * - The kernels of the level are used.
+ * - An exception is thrown if the processor cannot run the level.
+ */
+void SimdKernels::forceLevel(int level)
+{
+    int detected = detectLevel();
+    if (level == -1)
+    {
+        level = detected;
+    }
+
+    // Check if the level exists and the processor can run it
+    if (level < GENERIC || level > AVX512 || level > detected)
+    {
+        std::cerr << "ERROR: SIMD level is not supported." << std::endl;
+        throw std::invalid_argument("SIMD level is not supported.");
+    }
+    activeTable.store(tableOf(level), std::memory_order_release);
+}
+
+/**
+ * Get the name of a level.
+ *
+ * Method Name: getLevelName
+ *
+ * Purpose: Returns a printable name for reports.
+ *
+ * Parameters:
+ * - level: The level.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The name is returned.
+ *
+ * Returns: The name of the level, "unknown" if it is not a level.
+ */
+const char *SimdKernels::getLevelName(int level)
+{
+    switch (level)
+    {
+    case GENERIC:
+        return "generic";
+    case SSE42:
+        return "sse4.2";
+    case AVX2:
+        return "avx2";
+    case AVX512:
+        return "avx512";
+    default:
+        return "unknown";
+    }
+}
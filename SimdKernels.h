@@ -0,0 +1,223 @@
+/*
+ * File: SimdKernels.h Author: Nicolas Gioanni Purpose: Declaration of
+ * the SimdKernels class for running the vector kernels of the dense
+ * engines with the widest instruction set the processor supports.
+ *
+ * Functionality/Features:
+ * - Declare the bitset kernels used by the dense matching searches and
+ *   the field kernel used by dense elimination.
+ * - Declare the batch kernel that matches sixteen tiny graphs at once,
+ *   one graph per 32-bit vector lane.
+ * - Declare methods for detecting the instruction set once at startup
+ *   and for forcing a narrower one for benchmarking.
+ *
+ * Assumptions:
+ * - Every kernel is compiled for SSE4.2, AVX2 and AVX-512 next to a
+ *   portable version in one binary, and only the selected one runs.
+ * - On compilers or processors without x86 target attributes only the
+ *   portable version exists.
+ * - All versions give identical results.
+ */
+
+#ifndef SIMDKERNELS_H
+#define SIMDKERNELS_H
+
+#include <cstdint>
+
+class SimdKernels
+{
+public:
+    // The portable kernels
+    static constexpr int GENERIC = 0;
+
+    // The 128-bit SSE4.2 kernels
+    static constexpr int SSE42 = 1;
+
+    // The 256-bit AVX2 kernels
+    static constexpr int AVX2 = 2;
+
+    // The 512-bit AVX-512 kernels
+    static constexpr int AVX512 = 3;
+
+    // The number of graphs matched by one batch kernel call
+    static constexpr int BATCH_LANES = 16;
+
+    // The number of nodes per side of a batch graph
+    static constexpr int BATCH_NODES = 16;
+
+    /**
+     * ORs a row of words into another.
+     *
+     * Method Name: orWords
+     *
+     * Purpose: Sets target[k] to target[k] | source[k] for every word.
+     *
+     * Parameters:
+     * - target: A pointer to the words to update.
+     * - source: A pointer to the words to add.
+     * - count: The number of words.
+     *
+     * Preconditions:
+     * - Both rows hold count words.
+     *
+     * Postconditions:
+     * - The target holds the union.
+     */
+    static void orWords(std::uint64_t *target,
+                        const std::uint64_t *source,
+                        int count);
+
+    /**
+     * Finds the first word two rows have in common.
+     *
+     * Method Name: findCommonWord
+     *
+     * Purpose: Scans from a start word for the first k where
+     * first[k] & second[k] is nonzero.
+     *
+     * Parameters:
+     * - first: A pointer to the first row.
+     * - second: A pointer to the second row.
+     * - from: The word to start at.
+     * - count: The number of words in a row.
+     *
+     * Returns: The index of the word, count if there is none.
+     *
+     * Preconditions:
+     * - Both rows hold count words.
+     *
+     * Postconditions:
+     * - The index is returned.
+     */
+    static int findCommonWord(const std::uint64_t *first,
+                              const std::uint64_t *second,
+                              int from,
+                              int count);
+
+    /**
+     * Adds a multiple of a row over the Mersenne field.
+     *
+     * Method Name: addScaledRow
+     *
+     * Purpose: Sets target[k] to target[k] + factor * source[k] modulo
+     * 2^31 - 1 for every element.
+     *
+     * Parameters:
+     * - target: A pointer to the elements to update.
+     * - source: A pointer to the elements to add.
+     * - factor: The multiple, below 2^31 - 1.
+     * - count: The number of elements.
+     *
+     * Preconditions:
+     * - Every element is below 2^31 - 1.
+     *
+     * Postconditions:
+     * - Every target element is below 2^31 - 1.
+     */
+    static void addScaledRow(std::uint32_t *target,
+                             const std::uint32_t *source,
+                             std::uint32_t factor,
+                             int count);
+
+    /**
+     * Matches a batch of tiny graphs.
+     *
+     * Method Name: matchBatch
+     *
+     * Purpose: Calculates a maximum matching of every graph of a batch
+     * in lockstep. Every array holds BATCH_NODES rows of BATCH_LANES
+     * words, and word lane of row node belongs to graph lane.
+     *
+     * Parameters:
+     * - rows: A pointer to the right neighbors of every left node as a
+     *   mask.
+     * - leftMates: A pointer to the right partner of every left node as
+     *   a one-bit mask, 0 for a free node.
+     *
+     * Preconditions:
+     * - Every row mask is below 2^BATCH_NODES.
+     *
+     * Postconditions:
+     * - The left partners describe a maximum matching of every graph.
+     */
+    static void matchBatch(const std::uint32_t *rows,
+                           std::uint32_t *leftMates);
+
+    /**
+     * Get the level of the kernels in use.
+     *
+     * Method Name: getLevel
+     *
+     * Purpose: Returns the forced level, or the detected level if none
+     * was forced.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The level is returned.
+     *
+     * Returns: One of GENERIC, SSE42, AVX2 and AVX512.
+     */
+    static int getLevel();
+
+    /**
+     * Detects the widest supported level.
+     *
+     * Method Name: detectLevel
+     *
+     * Purpose: Asks the processor through CPUID which of the compiled
+     * levels it can run.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The level is returned.
+     *
+     * Returns: The widest level the processor supports.
+     */
+    static int detectLevel();
+
+    /**
+     * Forces the kernels to a level.
+     *
+     * Method Name: forceLevel
+     *
+     * Purpose: Selects the kernels of a level for every later call, so
+     * the levels can be compared in one binary.
+     *
+     * Parameters:
+     * - level: The level to use, or -1 to go back to the detected one.
+     *
+     * Preconditions:
+     * - No kernel is running on another thread.
+     *
+     * Postconditions:
+     * - The kernels of the level are used.
+     * - An exception is thrown if the processor cannot run the level.
+     */
+    static void forceLevel(int level);
+
+    /**
+     * Get the name of a level.
+     *
+     * Method Name: getLevelName
+     *
+     * Purpose: Returns a printable name for reports.
+     *
+     * Parameters:
+     * - level: The level.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The name is returned.
+     *
+     * Returns: The name of the level, "unknown" if it is not a level.
+     */
+    static const char *getLevelName(int level);
+};
+
+#endif
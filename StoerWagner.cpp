@@ -0,0 +1,407 @@
+/*
+ * File: StoerWagner.cpp Author: Nicolas Gioanni Purpose:
+ * Implementation of the StoerWagner class, providing methods for
+ * calculating the global minimum cut of an undirected graph.
+ *
+ * Functionality/Features:
+ * - Order the nodes by maximum adjacency with an addressable heap.
+ * - Merge the last two nodes of every ordering by linking their edge
+ *   lists instead of rebuilding the graph.
+ *
+ * Assumptions:
+ * - Edges inside a merged node are dropped, and parallel edges added
+ *   up, the first time their list is scanned after a merge.
+ */
+
+#include "StoerWagner.h"
+#include <climits>
+#include <iostream>
+#include <stdexcept>
+
+/**
+ * Constructor for the StoerWagner class.
+ *
+ * Method Name: StoerWagner
+ *
+ * Purpose: Initializes a new instance of the StoerWagner class.
+ *
+ * Parameters:
+ * - nodes: An integer representing the number of nodes.
+ * - edges: A constant reference to the undirected edges. The capacity
+ *   of an edge is used in both directions and its reverse capacity is
+ *   ignored.
+ *
+ * Preconditions:
+ * - Every edge is within the range of the nodes.
+ *
+ * Postconditions:
+ * - A new instance of the StoerWagner class is created.
+ * - An exception is thrown if an edge is invalid.
+ */
+StoerWagner::StoerWagner(int nodes, const std::vector<FlowArc> &edges)
+    : nodes(nodes), edges(nodes)
+{
+    for (const FlowArc &edge : edges)
+    {
+        // Check if the edge is valid
+        if (edge.tail < 0 || edge.tail >= nodes ||
+            edge.head < 0 || edge.head >= nodes ||
+            edge.capacity < 0)
+        {
+            std::cerr << "ERROR: Edge is Invalid." << std::endl;
+            throw std::invalid_argument("Edge is Invalid.");
+        }
+        if (edge.tail != edge.head)
+        {
+            this->edges[edge.tail].push_back({edge.head, edge.capacity});
+            this->edges[edge.head].push_back({edge.tail, edge.capacity});
+        }
+    }
+}
+
+/**
+ * Calculates the global minimum cut.
+ *
+ * Method Name: calculateMinCut
+ *
+ * Purpose: Runs one maximum adjacency ordering per node, keeping the
+ * cut around the last node of every ordering and merging it into the
+ * node before it.
+ *
+ * Returns: The capacity of the global minimum cut.
+ *
+ * Preconditions:
+ * - The graph has at least two nodes.
+ *
+ * Postconditions:
+ * - One side of the cut is recorded.
+ * - An exception is thrown if the calculation process fails.
+ */
+long long StoerWagner::calculateMinCut()
+{
+    try
+    {
+        // Check if there is a cut at all
+        if (nodes < 2)
+        {
+            std::cerr
+                << "ERROR: A cut needs at least two nodes."
+                << std::endl;
+            throw std::invalid_argument("A cut needs at least two nodes.");
+        }
+
+        // Work on a copy so the graph can be cut again
+        std::vector<std::vector<std::pair<int, long long>>> merged = edges;
+        std::vector<std::vector<int>> members(nodes);
+        mergedInto.resize(nodes);
+        for (int node = 0; node < nodes; ++node)
+        {
+            mergedInto[node] = node;
+            members[node].push_back(node);
+        }
+        key.assign(nodes, 0);
+        heapPosition.assign(nodes, -1);
+        std::vector<int> slot(nodes, -1);
+
+        long long best = LLONG_MAX;
+        std::vector<int> bestSide;
+
+        for (int remaining = nodes; remaining > 1; --remaining)
+        {
+            // Start an ordering with every unmerged node
+            heap.clear();
+            for (int node = 0; node < nodes; ++node)
+            {
+                if (mergedInto[node] == node)
+                {
+                    key[node] = 0;
+                    heapPush(node);
+                }
+            }
+
+            // Take the most connected node until all are ordered
+            int previous = -1;
+            int last = -1;
+            while (!heap.empty())
+            {
+                previous = last;
+                last = heapPop();
+
+                // Point the edges at merged nodes, dropping the ones
+                // inside the node and adding up parallel ones, so the
+                // lists shrink as the graph does
+                std::vector<std::pair<int, long long>> &list = merged[last];
+                size_t kept = 0;
+                for (size_t i = 0; i < list.size(); ++i)
+                {
+                    int other = findMerged(list[i].first);
+                    if (other == last)
+                    {
+                        continue;
+                    }
+                    if (slot[other] >= 0)
+                    {
+                        list[slot[other]].second += list[i].second;
+                        continue;
+                    }
+                    slot[other] = static_cast<int>(kept);
+                    list[kept++] = {other, list[i].second};
+                }
+                list.resize(kept);
+
+                for (const std::pair<int, long long> &edge : list)
+                {
+                    slot[edge.first] = -1;
+                    if (heapPosition[edge.first] >= 0)
+                    {
+                        heapIncrease(edge.first, edge.second);
+                    }
+                }
+            }
+
+            // The last node is cut from the rest by its key
+            if (key[last] < best)
+            {
+                best = key[last];
+                bestSide = members[last];
+            }
+
+            // Merge the last node into the one ordered before it
+            mergedInto[last] = previous;
+            merged[previous].insert(merged[previous].end(),
+                                    merged[last].begin(),
+                                    merged[last].end());
+            merged[last].clear();
+            members[previous].insert(members[previous].end(),
+                                     members[last].begin(),
+                                     members[last].end());
+            members[last].clear();
+        }
+
+        cutSide.assign(nodes, false);
+        for (int node : bestSide)
+        {
+            cutSide[node] = true;
+        }
+        return best;
+    }
+    catch (const std::exception &e)
+    {
+        // Output an error message if the calculation fails
+        std::cerr
+            << "ERROR: Error in calculateMinCut: "
+            << e.what()
+            << std::endl;
+        throw std::runtime_error("Error in calculateMinCut: " +
+                                 std::string(e.what()));
+    }
+}
+
+/**
+ * Get one side of the global minimum cut.
+ *
+ * Method Name: getCutSide
+ *
+ * Purpose: Returns the nodes on one side of the minimum cut.
+ *
+ * Preconditions:
+ * - calculateMinCut was called.
+ *
+ * Postconditions:
+ * - The side is returned.
+ *
+ * Returns: A vector with true for every node on the side.
+ */
+const std::vector<bool> &StoerWagner::getCutSide() const
+{
+    return cutSide;
+}
+
+/**
+ * Find the node a node was merged into.
+ *
+ * Method Name: findMerged
+ *
+ * Purpose: Follows the merge links to the node that now stands for the
+ * given node, shortening the links on the way.
+ *
+ * Parameters:
+ * - node: An integer representing the node.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The merge links on the way are shortened.
+ *
+ * Returns: The node that stands for the node.
+ */
+int StoerWagner::findMerged(int node)
+{
+    int root = node;
+    while (mergedInto[root] != root)
+    {
+        root = mergedInto[root];
+    }
+    while (mergedInto[node] != root)
+    {
+        int next = mergedInto[node];
+        mergedInto[node] = root;
+        node = next;
+    }
+    return root;
+}
+
+/**
+ * Adds a node to the heap.
+ *
+ * Method Name: heapPush
+ *
+ * Purpose: Inserts the node with its current key.
+ *
+ * Parameters:
+ * - node: An integer representing the node.
+ *
+ * Preconditions:
+ * - The node is not in the heap.
+ *
+ * Postconditions:
+ * - The node is in the heap.
+ */
+void StoerWagner::heapPush(int node)
+{
+    heap.push_back(node);
+    heapPosition[node] = static_cast<int>(heap.size()) - 1;
+    siftUp(heapPosition[node]);
+}
+
+/**
+ * Removes the node with the largest key from the heap.
+ *
+ * Method Name: heapPop
+ *
+ * Purpose: Removes and returns the top of the heap.
+ *
+ * Preconditions:
+ * - The heap is not empty.
+ *
+ * Postconditions:
+ * - The node is no longer in the heap.
+ *
+ * Returns: The node with the largest key.
+ */
+int StoerWagner::heapPop()
+{
+    int top = heap[0];
+    heapPosition[top] = -1;
+    int last = heap.back();
+    heap.pop_back();
+    if (!heap.empty())
+    {
+        heap[0] = last;
+        heapPosition[last] = 0;
+        siftDown(0);
+    }
+    return top;
+}
+
+/**
+ * Raises the key of a node in the heap.
+ *
+ * Method Name: heapIncrease
+ *
+ * Purpose: Adds to the key of the node and moves it up the heap.
+ *
+ * Parameters:
+ * - node: An integer representing the node.
+ * - amount: The non-negative amount to add.
+ *
+ * Preconditions:
+ * - The node is in the heap.
+ *
+ * Postconditions:
+ * - The heap order is restored.
+ */
+void StoerWagner::heapIncrease(int node, long long amount)
+{
+    key[node] += amount;
+    siftUp(heapPosition[node]);
+}
+
+/**
+ * Moves a heap entry up to its place.
+ *
+ * Method Name: siftUp
+ *
+ * Purpose: Swaps the entry with its parent while its key is larger.
+ *
+ * Parameters:
+ * - position: The position of the entry in the heap.
+ *
+ * Preconditions:
+ * - The heap is ordered except for the entry.
+ *
+ * Postconditions:
+ * - The heap is ordered.
+ */
+void StoerWagner::siftUp(int position)
+{
+    int node = heap[position];
+    while (position > 0)
+    {
+        int parent = (position - 1) / 2;
+        if (key[heap[parent]] >= key[node])
+        {
+            break;
+        }
+        heap[position] = heap[parent];
+        heapPosition[heap[position]] = position;
+        position = parent;
+    }
+    heap[position] = node;
+    heapPosition[node] = position;
+}
+
+/**
+ * Moves a heap entry down to its place.
+ *
+ * Method Name: siftDown
+ *
+ * Purpose: Swaps the entry with its larger child while that child's key
+ * is larger.
+ *
+ * Parameters:
+ * - position: The position of the entry in the heap.
+ *
+ * Preconditions:
+ * - The heap is ordered except for the entry.
+ *
+ * Postconditions:
+ * - The heap is ordered.
+ */
+void StoerWagner::siftDown(int position)
+{
+    int size = static_cast<int>(heap.size());
+    int node = heap[position];
+    while (true)
+    {
+        int child = 2 * position + 1;
+        if (child >= size)
+        {
+            break;
+        }
+        if (child + 1 < size && key[heap[child + 1]] > key[heap[child]])
+        {
+            child++;
+        }
+        if (key[heap[child]] <= key[node])
+        {
+            break;
+        }
+        heap[position] = heap[child];
+        heapPosition[heap[position]] = position;
+        position = child;
+    }
+    heap[position] = node;
+    heapPosition[node] = position;
+}
@@ -0,0 +1,221 @@
+/*
+ * File: StoerWagner.h Author: Nicolas Gioanni Purpose: Declaration of
+ * the StoerWagner class for calculating the global minimum cut of an
+ * undirected graph with the Stoer-Wagner algorithm.
+ *
+ * Functionality/Features:
+ * - Declare methods for calculating the smallest cut over all
+ *   partitions of the nodes with maximum adjacency orderings.
+ * - Declare methods for reading one side of that cut.
+ *
+ * Assumptions:
+ * - The graph is undirected; the capacity of every edge is usable in
+ *   both directions.
+ * - Capacities are non-negative integers.
+ */
+
+#ifndef STOERWAGNER_H
+#define STOERWAGNER_H
+
+#include "FlowNetwork.h"
+#include <utility>
+#include <vector>
+
+class StoerWagner
+{
+public:
+    /**
+     * Constructor for the StoerWagner class.
+     *
+     * Method Name: StoerWagner
+     *
+     * Purpose: Initializes a new instance of the StoerWagner class.
+     *
+     * Parameters:
+     * - nodes: An integer representing the number of nodes.
+     * - edges: A constant reference to the undirected edges. The
+     *   capacity of an edge is used in both directions and its reverse
+     *   capacity is ignored.
+     *
+     * Preconditions:
+     * - Every edge is within the range of the nodes.
+     *
+     * Postconditions:
+     * - A new instance of the StoerWagner class is created.
+     * - An exception is thrown if an edge is invalid.
+     */
+    StoerWagner(int nodes, const std::vector<FlowArc> &edges);
+
+    /**
+     * Calculates the global minimum cut.
+     *
+     * Method Name: calculateMinCut
+     *
+     * Purpose: Runs one maximum adjacency ordering per node, keeping
+     * the cut around the last node of every ordering and merging it
+     * into the node before it.
+     *
+     * Returns: The capacity of the global minimum cut.
+     *
+     * Preconditions:
+     * - The graph has at least two nodes.
+     *
+     * Postconditions:
+     * - One side of the cut is recorded.
+     * - An exception is thrown if the calculation process fails.
+     */
+    long long calculateMinCut();
+
+    /**
+     * Get one side of the global minimum cut.
+     *
+     * Method Name: getCutSide
+     *
+     * Purpose: Returns the nodes on one side of the minimum cut.
+     *
+     * Preconditions:
+     * - calculateMinCut was called.
+     *
+     * Postconditions:
+     * - The side is returned.
+     *
+     * Returns: A vector with true for every node on the side.
+     */
+    const std::vector<bool> &getCutSide() const;
+
+private:
+    // The number of nodes
+    int nodes;
+
+    // The edges of every node as the other end and the capacity
+    std::vector<std::vector<std::pair<int, long long>>> edges;
+
+    // One side of the best cut
+    std::vector<bool> cutSide;
+
+    // The node every node was merged into, itself if not merged
+    std::vector<int> mergedInto;
+
+    // The connection of every node to the ordered nodes
+    std::vector<long long> key;
+
+    // The heap of unordered nodes, largest key first
+    std::vector<int> heap;
+
+    // The position of every node in the heap, -1 if not in it
+    std::vector<int> heapPosition;
+
+    /**
+     * Find the node a node was merged into.
+     *
+     * Method Name: findMerged
+     *
+     * Purpose: Follows the merge links to the node that now stands for
+     * the given node, shortening the links on the way.
+     *
+     * Parameters:
+     * - node: An integer representing the node.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The merge links on the way are shortened.
+     *
+     * Returns: The node that stands for the node.
+     */
+    int findMerged(int node);
+
+    /**
+     * Adds a node to the heap.
+     *
+     * Method Name: heapPush
+     *
+     * Purpose: Inserts the node with its current key.
+     *
+     * Parameters:
+     * - node: An integer representing the node.
+     *
+     * Preconditions:
+     * - The node is not in the heap.
+     *
+     * Postconditions:
+     * - The node is in the heap.
+     */
+    void heapPush(int node);
+
+    /**
+     * Removes the node with the largest key from the heap.
+     *
+     * Method Name: heapPop
+     *
+     * Purpose: Removes and returns the top of the heap.
+     *
+     * Preconditions:
+     * - The heap is not empty.
+     *
+     * Postconditions:
+     * - The node is no longer in the heap.
+     *
+     * Returns: The node with the largest key.
+     */
+    int heapPop();
+
+    /**
+     * Raises the key of a node in the heap.
+     *
+     * Method Name: heapIncrease
+     *
+     * Purpose: Adds to the key of the node and moves it up the heap.
+     *
+     * Parameters:
+     * - node: An integer representing the node.
+     * - amount: The non-negative amount to add.
+     *
+     * Preconditions:
+     * - The node is in the heap.
+     *
+     * Postconditions:
+     * - The heap order is restored.
+     */
+    void heapIncrease(int node, long long amount);
+
+    /**
+     * Moves a heap entry up to its place.
+     *
+     * Method Name: siftUp
+     *
+     * Purpose: Swaps the entry with its parent while its key is larger.
+     *
+     * Parameters:
+     * - position: The position of the entry in the heap.
+     *
+     * Preconditions:
+     * - The heap is ordered except for the entry.
+     *
+     * Postconditions:
+     * - The heap is ordered.
+     */
+    void siftUp(int position);
+
+    /**
+     * Moves a heap entry down to its place.
+     *
+     * Method Name: siftDown
+     *
+     * Purpose: Swaps the entry with its larger child while that child's
+     * key is larger.
+     *
+     * Parameters:
+     * - position: The position of the entry in the heap.
+     *
+     * Preconditions:
+     * - The heap is ordered except for the entry.
+     *
+     * Postconditions:
+     * - The heap is ordered.
+     */
+    void siftDown(int position);
+};
+
+#endif
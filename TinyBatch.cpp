@@ -0,0 +1,231 @@
+/*
+ * File: TinyBatch.cpp Author: Nicolas Gioanni Purpose: Implementation
+ * of the TinyBatch class, providing methods for calculating maximum
+ * matchings of many small bipartite graphs at once.
+ *
+ * Functionality/Features:
+ * - Keep the graphs as a structure of arrays, so row node of all lanes
+ *   is one vector load in the kernel.
+ * - Hand the whole batch to SimdKernels::matchBatch, which searches
+ *   augmenting paths in every lane in lockstep with masks instead of
+ *   branches.
+ * - Read partners back from one-bit masks with a trailing zero count.
+ *
+ * Assumptions:
+ * - The kernel keeps every partner as a one-bit mask, so flipping a
+ *   path needs no per-lane indexing.
+ * - Only the left partners are stored; a right partner is found by a
+ *   scan of at most NODES words.
+ */
+
+#include "TinyBatch.h"
+#include <iostream>
+#include <stdexcept>
+
+/**
+ * Constructor for the TinyBatch class.
+ *
+ * Method Name: TinyBatch
+ *
+ * Purpose: Starts with a batch of graphs without edges.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - A new instance of the TinyBatch class is created.
+ */
+TinyBatch::TinyBatch()
+{
+    clear();
+}
+
+/**
+ * Clears the batch.
+ *
+ * Method Name: clear
+ *
+ * Purpose: Removes every edge and every partner of every graph.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - Every graph has no edges and every node is free.
+ */
+void TinyBatch::clear()
+{
+    for (int index = 0; index < NODES * LANES; ++index)
+    {
+        rows[index] = 0;
+        leftMates[index] = 0;
+    }
+}
+
+/**
+ * Adds an edge to a graph.
+ *
+ * Method Name: addEdge
+ *
+ * Purpose: Sets the bit of the right node in the row of the left node of
+ * one graph.
+ *
+ * Parameters:
+ * - lane: An integer representing the graph.
+ * - left: An integer representing the left node.
+ * - right: An integer representing the right node.
+ *
+ * Preconditions:
+ * - The lane is below LANES and both nodes are below NODES.
+ *
+ * Postconditions:
+ * - The edge is in the graph.
+ * - An exception is thrown if a value is out of range.
+ */
+void TinyBatch::addEdge(int lane, int left, int right)
+{
+    checkRange(lane, left);
+    checkRange(lane, right);
+    rows[left * LANES + lane] |= 1U << right;
+}
+
+/**
+ * Calculates a maximum matching of every graph.
+ *
+ * Method Name: calculateMaxMatchings
+ *
+ * Purpose: Runs the batch kernel of the widest supported level over all
+ * lanes at once.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - The matching of every graph is maximum.
+ */
+void TinyBatch::calculateMaxMatchings()
+{
+    SimdKernels::matchBatch(rows, leftMates);
+}
+
+/**
+ * Get the size of the matching of a graph.
+ *
+ * Method Name: getMatchingSize
+ *
+ * Purpose: Counts the matched left nodes of one graph.
+ *
+ * Parameters:
+ * - lane: An integer representing the graph.
+ *
+ * Preconditions:
+ * - calculateMaxMatchings was called.
+ *
+ * Postconditions:
+ * - The size is returned.
+ * - An exception is thrown if the lane is out of range.
+ *
+ * Returns: The number of matched pairs of the graph.
+ */
+int TinyBatch::getMatchingSize(int lane) const
+{
+    checkRange(lane, 0);
+    int size = 0;
+    for (int left = 0; left < NODES; ++left)
+    {
+        if (leftMates[left * LANES + lane] != 0)
+        {
+            ++size;
+        }
+    }
+    return size;
+}
+
+/**
+ * Get the partner of a left node.
+ *
+ * Method Name: getLeftMatch
+ *
+ * Purpose: Returns the right partner of a left node of one graph.
+ *
+ * Parameters:
+ * - lane: An integer representing the graph.
+ * - left: An integer representing the left node.
+ *
+ * Preconditions:
+ * - calculateMaxMatchings was called.
+ *
+ * Postconditions:
+ * - The partner is returned.
+ * - An exception is thrown if a value is out of range.
+ *
+ * Returns: The right partner, -1 for a free node.
+ */
+int TinyBatch::getLeftMatch(int lane, int left) const
+{
+    checkRange(lane, left);
+    std::uint32_t mate = leftMates[left * LANES + lane];
+    return mate == 0 ? -1 : __builtin_ctz(mate);
+}
+
+/**
+ * Get the partner of a right node.
+ *
+ * Method Name: getRightMatch
+ *
+ * Purpose: Returns the left partner of a right node of one graph by
+ * scanning the left partners.
+ *
+ * Parameters:
+ * - lane: An integer representing the graph.
+ * - right: An integer representing the right node.
+ *
+ * Preconditions:
+ * - calculateMaxMatchings was called.
+ *
+ * Postconditions:
+ * - The partner is returned.
+ * - An exception is thrown if a value is out of range.
+ *
+ * Returns: The left partner, -1 for a free node.
+ */
+int TinyBatch::getRightMatch(int lane, int right) const
+{
+    checkRange(lane, right);
+    for (int left = 0; left < NODES; ++left)
+    {
+        if (leftMates[left * LANES + lane] == 1U << right)
+        {
+            return left;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Checks a lane and a node.
+ *
+ * Method Name: checkRange
+ *
+ * Purpose: Verifies that a lane and a node index are in range.
+ *
+ * Parameters:
+ * - lane: An integer representing the graph.
+ * - node: An integer representing the node.
+ *
+ * Preconditions:
+ * - None.
+ *
+ * Postconditions:
+ * - An exception is thrown if a value is out of range.
+ */
+void TinyBatch::checkRange(int lane, int node)
+{
+    // Check if the lane and node are within valid range
+    if (lane < 0 || lane >= LANES || node < 0 || node >= NODES)
+    {
+        std::cerr << "ERROR: Batch lane or node is out of valid range."
+                  << std::endl;
+        throw std::out_of_range("Batch lane or node is out of valid range.");
+    }
+}
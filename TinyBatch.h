@@ -0,0 +1,196 @@
+/*
+ * File: TinyBatch.h Author: Nicolas Gioanni Purpose: Declaration of the
+ * TinyBatch class for calculating maximum matchings of many small
+ * bipartite graphs at once, one graph per vector lane.
+ *
+ * Functionality/Features:
+ * - Declare methods for loading up to LANES graphs of up to NODES nodes
+ *   per side into a structure of arrays, where row node of every graph
+ *   is one contiguous run of LANES words.
+ * - Declare methods for matching the whole batch with one SimdKernels
+ *   call and for reading the matching of every graph.
+ *
+ * Assumptions:
+ * - Graphs smaller than NODES simply leave the extra nodes without
+ *   edges, and unused lanes stay empty.
+ * - All state lives inside the object, which fits on the stack; the
+ *   object can be reused for many batches by calling clear.
+ */
+
+#ifndef TINYBATCH_H
+#define TINYBATCH_H
+
+#include "SimdKernels.h"
+#include <cstdint>
+
+class TinyBatch
+{
+public:
+    // The number of graphs in a batch
+    static constexpr int LANES = SimdKernels::BATCH_LANES;
+
+    // The largest number of nodes per side of a graph
+    static constexpr int NODES = SimdKernels::BATCH_NODES;
+
+    /**
+     * Constructor for the TinyBatch class.
+     *
+     * Method Name: TinyBatch
+     *
+     * Purpose: Starts with a batch of graphs without edges.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - A new instance of the TinyBatch class is created.
+     */
+    TinyBatch();
+
+    /**
+     * Clears the batch.
+     *
+     * Method Name: clear
+     *
+     * Purpose: Removes every edge and every partner of every graph.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - Every graph has no edges and every node is free.
+     */
+    void clear();
+
+    /**
+     * Adds an edge to a graph.
+     *
+     * Method Name: addEdge
+     *
+     * Purpose: Sets the bit of the right node in the row of the left
+     * node of one graph.
+     *
+     * Parameters:
+     * - lane: An integer representing the graph.
+     * - left: An integer representing the left node.
+     * - right: An integer representing the right node.
+     *
+     * Preconditions:
+     * - The lane is below LANES and both nodes are below NODES.
+     *
+     * Postconditions:
+     * - The edge is in the graph.
+     * - An exception is thrown if a value is out of range.
+     */
+    void addEdge(int lane, int left, int right);
+
+    /**
+     * Calculates a maximum matching of every graph.
+     *
+     * Method Name: calculateMaxMatchings
+     *
+     * Purpose: Runs the batch kernel of the widest supported level over
+     * all lanes at once.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - The matching of every graph is maximum.
+     */
+    void calculateMaxMatchings();
+
+    /**
+     * Get the size of the matching of a graph.
+     *
+     * Method Name: getMatchingSize
+     *
+     * Purpose: Counts the matched left nodes of one graph.
+     *
+     * Parameters:
+     * - lane: An integer representing the graph.
+     *
+     * Preconditions:
+     * - calculateMaxMatchings was called.
+     *
+     * Postconditions:
+     * - The size is returned.
+     * - An exception is thrown if the lane is out of range.
+     *
+     * Returns: The number of matched pairs of the graph.
+     */
+    int getMatchingSize(int lane) const;
+
+    /**
+     * Get the partner of a left node.
+     *
+     * Method Name: getLeftMatch
+     *
+     * Purpose: Returns the right partner of a left node of one graph.
+     *
+     * Parameters:
+     * - lane: An integer representing the graph.
+     * - left: An integer representing the left node.
+     *
+     * Preconditions:
+     * - calculateMaxMatchings was called.
+     *
+     * Postconditions:
+     * - The partner is returned.
+     * - An exception is thrown if a value is out of range.
+     *
+     * Returns: The right partner, -1 for a free node.
+     */
+    int getLeftMatch(int lane, int left) const;
+
+    /**
+     * Get the partner of a right node.
+     *
+     * Method Name: getRightMatch
+     *
+     * Purpose: Returns the left partner of a right node of one graph by
+     * scanning the left partners.
+     *
+     * Parameters:
+     * - lane: An integer representing the graph.
+     * - right: An integer representing the right node.
+     *
+     * Preconditions:
+     * - calculateMaxMatchings was called.
+     *
+     * Postconditions:
+     * - The partner is returned.
+     * - An exception is thrown if a value is out of range.
+     *
+     * Returns: The left partner, -1 for a free node.
+     */
+    int getRightMatch(int lane, int right) const;
+
+private:
+    // The right neighbors of every left node, one word per lane
+    alignas(64) std::uint32_t rows[NODES * LANES];
+
+    // The right partner of every left node as a one-bit mask
+    alignas(64) std::uint32_t leftMates[NODES * LANES];
+
+    /**
+     * Checks a lane and a node.
+     *
+     * Method Name: checkRange
+     *
+     * Purpose: Verifies that a lane and a node index are in range.
+     *
+     * Parameters:
+     * - lane: An integer representing the graph.
+     * - node: An integer representing the node.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - An exception is thrown if a value is out of range.
+     */
+    static void checkRange(int lane, int node);
+};
+
+#endif
@@ -0,0 +1,351 @@
+/*
+ * File: TinyMatching.h Author: Nicolas Gioanni Purpose: Declaration and
+ * definition of the TinyMatching class template for calculating maximum
+ * matchings of small bipartite graphs without any heap allocation.
+ *
+ * Functionality/Features:
+ * - Declare methods for loading a graph of up to Capacity nodes per
+ *   side as one row of 64-bit masks per left node.
+ * - Declare methods for calculating a maximum matching with augmenting
+ *   paths whose neighbor choice is a mask AND NOT visited followed by a
+ *   trailing zero count.
+ * - Declare methods for reading the matched partner of every node.
+ *
+ * Assumptions:
+ * - Capacity is 64, 128 or 256 and is fixed at compile time, so every
+ *   loop over a row has a constant trip count of one to four words.
+ * - All state lives inside the object, which fits on the stack; the
+ *   object can be reused for many graphs by calling clear.
+ * - The class is a template, so it is defined entirely in this header.
+ */
+
+#ifndef TINYMATCHING_H
+#define TINYMATCHING_H
+
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+
+template <int Capacity>
+class TinyMatching
+{
+    static_assert(Capacity == 64 || Capacity == 128 || Capacity == 256,
+                  "TinyMatching supports 64, 128 or 256 nodes per side.");
+
+public:
+    /**
+     * Constructor for the TinyMatching class.
+     *
+     * Method Name: TinyMatching
+     *
+     * Purpose: Starts with an empty graph of no nodes.
+     *
+     * Preconditions:
+     * - None.
+     *
+     * Postconditions:
+     * - A new instance of the TinyMatching class is created.
+     */
+    TinyMatching() : leftNodes(0), rightNodes(0) {}
+
+    /**
+     * Clears the graph.
+     *
+     * Method Name: clear
+     *
+     * Purpose: Removes every edge and sets the size of both sides.
+     *
+     * Parameters:
+     * - leftNodes: An integer representing the number of left nodes.
+     * - rightNodes: An integer representing the number of right nodes.
+     *
+     * Preconditions:
+     * - Both sizes are between 0 and Capacity.
+     *
+     * Postconditions:
+     * - The graph has no edges and every node is free.
+     * - An exception is thrown if a size is out of range.
+     */
+    void clear(int leftNodes, int rightNodes)
+    {
+        // Check if the sizes fit the capacity
+        if (leftNodes < 0 || leftNodes > Capacity ||
+            rightNodes < 0 || rightNodes > Capacity)
+        {
+            std::cerr << "ERROR: Tiny graph size is out of valid range."
+                      << std::endl;
+            throw std::out_of_range("Tiny graph size is out of valid range.");
+        }
+
+        this->leftNodes = leftNodes;
+        this->rightNodes = rightNodes;
+        for (int node = 0; node < leftNodes; ++node)
+        {
+            for (int word = 0; word < WORDS; ++word)
+            {
+                adjacency[node][word] = 0;
+            }
+        }
+    }
+
+    /**
+     * Adds an edge.
+     *
+     * Method Name: addEdge
+     *
+     * Purpose: Sets the bit of the right node in the row of the left
+     * node.
+     *
+     * Parameters:
+     * - left: An integer representing the left node.
+     * - right: An integer representing the right node.
+     *
+     * Preconditions:
+     * - Both nodes are within the sizes given to clear.
+     *
+     * Postconditions:
+     * - The edge is in the graph.
+     * - An exception is thrown if a node is out of range.
+     */
+    void addEdge(int left, int right)
+    {
+        // Check if the nodes are within valid range
+        if (left < 0 || left >= leftNodes || right < 0 || right >= rightNodes)
+        {
+            std::cerr << "ERROR: Tiny graph node is out of valid range."
+                      << std::endl;
+            throw std::out_of_range("Tiny graph node is out of valid range.");
+        }
+
+        adjacency[left][right >> 6] |= 1ULL << (right & 63);
+    }
+
+    /**
+     * Calculates a maximum matching.
+     *
+     * Method Name: calculateMaxMatching
+     *
+     * Purpose: Matches every left node to its lowest free neighbor,
+     * then searches augmenting paths from the free left nodes in
+     * passes. Right nodes tried in a pass stay blocked for the rest of
+     * the pass, and passes repeat until one finds no path.
+     *
+     * Returns: The size of the maximum matching.
+     *
+     * Preconditions:
+     * - clear was called.
+     *
+     * Postconditions:
+     * - The matching is maximum.
+     */
+    int calculateMaxMatching()
+    {
+        for (int word = 0; word < WORDS; ++word)
+        {
+            int low = word * 64;
+            freeRight[word] = rightNodes >= low + 64 ? ~0ULL
+                              : rightNodes > low
+                                  ? (1ULL << (rightNodes - low)) - 1
+                                  : 0;
+        }
+        for (int right = 0; right < rightNodes; ++right)
+        {
+            rightMatch[right] = -1;
+        }
+
+        // Match every left node to its lowest free neighbor and list the
+        // ones left over
+        int size = 0;
+        int freeLeft[Capacity];
+        int freeCount = 0;
+        for (int node = 0; node < leftNodes; ++node)
+        {
+            leftMatch[node] = -1;
+            for (int word = 0; word < WORDS; ++word)
+            {
+                std::uint64_t common = adjacency[node][word] & freeRight[word];
+                if (common != 0)
+                {
+                    // Clear the lowest bit directly, off the count's path
+                    int right = word * 64 + __builtin_ctzll(common);
+                    leftMatch[node] = right;
+                    rightMatch[right] = node;
+                    freeRight[word] &= ~(common & (~common + 1));
+                    ++size;
+                    break;
+                }
+            }
+            if (leftMatch[node] == -1)
+            {
+                freeLeft[freeCount++] = node;
+            }
+        }
+
+        // Augment in passes; a pass that finds nothing proves the
+        // matching maximum, since its failed searches all saw the same
+        // matching
+        for (bool grown = freeCount > 0; grown;)
+        {
+            grown = false;
+            std::uint64_t visited[WORDS] = {};
+            int kept = 0;
+            for (int index = 0; index < freeCount; ++index)
+            {
+                if (augmentFrom(freeLeft[index], visited))
+                {
+                    ++size;
+                    grown = true;
+                }
+                else
+                {
+                    freeLeft[kept++] = freeLeft[index];
+                }
+            }
+            freeCount = kept;
+            grown = grown && freeCount > 0;
+        }
+        return size;
+    }
+
+    /**
+     * Get the partner of a left node.
+     *
+     * Method Name: getLeftMatch
+     *
+     * Purpose: Returns the right partner of the left node.
+     *
+     * Parameters:
+     * - left: An integer representing the left node.
+     *
+     * Preconditions:
+     * - calculateMaxMatching was called and the node is in range.
+     *
+     * Postconditions:
+     * - The partner is returned.
+     *
+     * Returns: The right partner, -1 for a free node.
+     */
+    int getLeftMatch(int left) const
+    {
+        return leftMatch[left];
+    }
+
+    /**
+     * Get the partner of a right node.
+     *
+     * Method Name: getRightMatch
+     *
+     * Purpose: Returns the left partner of the right node.
+     *
+     * Parameters:
+     * - right: An integer representing the right node.
+     *
+     * Preconditions:
+     * - calculateMaxMatching was called and the node is in range.
+     *
+     * Postconditions:
+     * - The partner is returned.
+     *
+     * Returns: The left partner, -1 for a free node.
+     */
+    int getRightMatch(int right) const
+    {
+        return rightMatch[right];
+    }
+
+private:
+    // The number of 64-bit words in a row
+    static constexpr int WORDS = Capacity / 64;
+
+    // The number of left nodes in use
+    int leftNodes;
+
+    // The number of right nodes in use
+    int rightNodes;
+
+    // The neighbors of every left node as a row of masks
+    std::uint64_t adjacency[Capacity][WORDS];
+
+    // The right partner of every left node
+    int leftMatch[Capacity];
+
+    // The left partner of every right node
+    int rightMatch[Capacity];
+
+    // The right nodes without a partner
+    std::uint64_t freeRight[WORDS];
+
+    /**
+     * Augments along one path from a free left node.
+     *
+     * Method Name: augmentFrom
+     *
+     * Purpose: Searches depth first with an explicit path, always taking
+     * the lowest neighbor that is not yet visited, and flips the
+     * matching along the first path that ends at a free right node.
+     *
+     * Parameters:
+     * - root: An integer representing the free left node.
+     * - visited: The right nodes already tried.
+     *
+     * Returns: True if the matching grew.
+     *
+     * Preconditions:
+     * - The root is free.
+     *
+     * Postconditions:
+     * - Every right node tried is marked in visited.
+     */
+    bool augmentFrom(int root, std::uint64_t *visited)
+    {
+        int leftPath[Capacity];
+        int rightPath[Capacity];
+        int depth = 0;
+        leftPath[0] = root;
+        while (depth >= 0)
+        {
+            // Prefer a free neighbor, else the lowest unvisited one
+            const std::uint64_t *row = adjacency[leftPath[depth]];
+            int right = -1;
+            for (int word = 0; word < WORDS && right == -1; ++word)
+            {
+                std::uint64_t open = row[word] & freeRight[word];
+                if (open != 0)
+                {
+                    right = word * 64 + __builtin_ctzll(open);
+                }
+            }
+            for (int word = 0; word < WORDS && right == -1; ++word)
+            {
+                std::uint64_t open = row[word] & ~visited[word];
+                if (open != 0)
+                {
+                    right = word * 64 + __builtin_ctzll(open);
+                }
+            }
+            if (right == -1)
+            {
+                --depth;
+                continue;
+            }
+            visited[right >> 6] |= 1ULL << (right & 63);
+            rightPath[depth] = right;
+
+            if (rightMatch[right] == -1)
+            {
+                // Flip the matching along the path
+                freeRight[right >> 6] &= ~(1ULL << (right & 63));
+                for (int step = 0; step <= depth; ++step)
+                {
+                    leftMatch[leftPath[step]] = rightPath[step];
+                    rightMatch[rightPath[step]] = leftPath[step];
+                }
+                return true;
+            }
+            leftPath[++depth] = rightMatch[right];
+        }
+        return false;
+    }
+};
+
+#endif